@@ -222,6 +222,31 @@ public:
         return m_bit_buffer & lsb_mask<T>(min(count, m_bit_count));
     }
 
+    /// Tops up the bit buffer with as many whole bytes as fit, unless it already holds at least `count` bits.
+    /// Unlike peek_bits(), running out of data is not an error here, callers have to check buffered_bit_count().
+    /// This allows hot loops to refill once and then decode several short codes straight from buffered_bits().
+    ErrorOr<void> fill_buffer(size_t count)
+    {
+        // Refills only read whole bytes, so asking for more than this could never be satisfied.
+        VERIFY(count <= bit_buffer_size - bits_per_byte + 1);
+
+        while (count > m_bit_count) {
+            if (m_stream->is_eof()) {
+                if (m_unsatisfiable_read_behavior == UnsatisfiableReadBehavior::FillWithZero)
+                    m_bit_count = count;
+                break;
+            }
+            TRY(read_whole_bytes_into_buffer());
+        }
+
+        return {};
+    }
+
+    ALWAYS_INLINE size_t buffered_bit_count() const { return m_bit_count; }
+
+    /// All bits past buffered_bit_count() are zero.
+    ALWAYS_INLINE BufferType buffered_bits() const { return m_bit_buffer; }
+
     ALWAYS_INLINE void discard_previously_peeked_bits(u8 count)
     {
         // We allow "retrieving" more bits than we can provide, but we need to make sure that we don't underflow the current bit counter.
@@ -260,15 +285,22 @@ private:
                 return Error::from_string_literal("Reached end-of-stream without collecting the required number of bits");
             }
 
-            size_t bits_to_read = bit_buffer_size - m_bit_count;
-            size_t bytes_to_read = bits_to_read / bits_per_byte;
+            TRY(read_whole_bytes_into_buffer());
+        }
 
-            BufferType buffer = 0;
-            auto bytes = TRY(m_stream->read_some({ &buffer, bytes_to_read }));
+        return {};
+    }
 
-            m_bit_buffer |= (buffer << m_bit_count);
-            m_bit_count += bytes.size() * bits_per_byte;
-        }
+    ALWAYS_INLINE ErrorOr<void> read_whole_bytes_into_buffer()
+    {
+        size_t bits_to_read = bit_buffer_size - m_bit_count;
+        size_t bytes_to_read = bits_to_read / bits_per_byte;
+
+        BufferType buffer = 0;
+        auto bytes = TRY(m_stream->read_some({ &buffer, bytes_to_read }));
+
+        m_bit_buffer |= (buffer << m_bit_count);
+        m_bit_count += bytes.size() * bits_per_byte;
 
         return {};
     }
@@ -150,12 +150,7 @@ size_t CircularBuffer::write(ReadonlyBytes bytes)
             break;
 
         auto const written_bytes = bytes.slice(bytes.size() - remaining).copy_trimmed_to(next_span);
-
-        m_used_space += written_bytes;
-
-        m_seekback_limit += written_bytes;
-        if (m_seekback_limit > capacity())
-            m_seekback_limit = capacity();
+        commit_written_bytes(written_bytes);
 
         remaining -= written_bytes;
     }
@@ -163,6 +158,26 @@ size_t CircularBuffer::write(ReadonlyBytes bytes)
     return bytes.size() - remaining;
 }
 
+Bytes CircularBuffer::next_write_span_with_seekback(size_t& seekback_size)
+{
+    auto const write_span = next_write_span();
+    auto const write_offset = static_cast<size_t>(write_span.data() - m_buffer.data());
+
+    seekback_size = min(write_offset, m_seekback_limit);
+    return m_buffer.span().slice(write_offset - seekback_size, seekback_size + write_span.size());
+}
+
+void CircularBuffer::commit_written_bytes(size_t written_bytes)
+{
+    VERIFY(written_bytes <= empty_space());
+
+    m_used_space += written_bytes;
+
+    m_seekback_limit += written_bytes;
+    if (m_seekback_limit > capacity())
+        m_seekback_limit = capacity();
+}
+
 Bytes CircularBuffer::read(Bytes bytes)
 {
     auto remaining = bytes.size();
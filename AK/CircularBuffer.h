@@ -36,6 +36,12 @@ public:
 
     ErrorOr<size_t> copy_from_seekback(size_t distance, size_t length);
 
+    /// For producers that generate their data in place, like decompressors: Returns the free space after the write pointer
+    /// that can be written to in one go, preceded by as much of the seekback history as is stored contiguously in front of it.
+    /// Written bytes only become part of the buffer once they are committed with `commit_written_bytes()`.
+    [[nodiscard]] Bytes next_write_span_with_seekback(size_t& seekback_size);
+    void commit_written_bytes(size_t);
+
     [[nodiscard]] size_t empty_space() const;
     [[nodiscard]] size_t used_space() const;
     [[nodiscard]] size_t capacity() const;
@@ -18,3 +18,5 @@
 #define PR_SET_NO_TRANSITION_TO_EXECUTABLE_FROM_WRITABLE_PROT 10
 #define PR_SET_JAILED_UNTIL_EXIT 11
 #define PR_SET_JAILED_UNTIL_EXEC 12
+#define PR_SET_THREAD_PREFERRED_CPU 13
+#define PR_GET_THREAD_PREFERRED_CPU 14
@@ -5,96 +5,138 @@
  */
 
 #include <AK/IntrusiveList.h>
+#include <AK/QuickSort.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
+#include <Kernel/Memory/MemoryManager.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/WorkQueue.h>
 
 namespace Kernel {
 
 struct CacheEntry {
+    // Clean entries live on one of two LRU lists. Blocks that were only touched once since
+    // they were brought into the cache sit on the probation list, and are the first to be
+    // evicted. Only blocks that are touched again get promoted to the protected list, so a
+    // single sequential scan can't push the working set out of the cache.
+    enum class List : u8 {
+        Free,
+        Probation,
+        Protected,
+        Dirty,
+    };
+
     IntrusiveListNode<CacheEntry> list_node;
     BlockBasedFileSystem::BlockIndex block_index { 0 };
     u8* data { nullptr };
     bool has_data { false };
+    bool referenced_again { false };
+    List list { List::Free };
+};
+
+struct DiskCacheChunk {
+    NonnullOwnPtr<KBuffer> block_data;
+    NonnullOwnPtr<KBuffer> entries_buffer;
 };
 
 class DiskCache {
 public:
-    static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
-        : m_cached_block_data(move(cached_block_data))
-        , m_entries(move(entries_buffer))
+    // NOTE: Every shard starts out with one chunk, which adds up to a little more than the 10000 entries
+    //       the cache used to have before it could grow.
+    static constexpr size_t EntriesPerChunk = 1280;
+    static constexpr size_t MinimumChunkCount = 1;
+    static constexpr size_t MaximumChunkCount = 64;
+    static constexpr size_t MaximumWriteClusterSize = 64;
+
+    static ErrorOr<NonnullOwnPtr<DiskCache>> try_create(BlockBasedFileSystem& fs)
     {
-        for (size_t i = 0; i < EntryCount; ++i) {
-            entries()[i].data = m_cached_block_data->data() + i * fs.logical_block_size();
-            m_clean_list.append(entries()[i]);
-        }
+        auto cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(fs.logical_block_size())));
+        for (size_t i = 0; i < MinimumChunkCount; ++i)
+            TRY(cache->try_grow());
+        return cache;
     }
 
     ~DiskCache() = default;
 
     bool is_dirty() const { return !m_dirty_list.is_empty(); }
-    bool entry_is_dirty(CacheEntry const& entry) const { return m_dirty_list.contains(entry); }
+    bool entry_is_dirty(CacheEntry const& entry) const { return entry.list == CacheEntry::List::Dirty; }
 
     void mark_all_clean()
     {
         while (auto* entry = m_dirty_list.first())
-            m_clean_list.prepend(*entry);
+            mark_clean(*entry);
     }
 
     void mark_dirty(CacheEntry& entry)
     {
-        m_dirty_list.prepend(entry);
+        move_to_list(entry, CacheEntry::List::Dirty);
     }
 
     void mark_clean(CacheEntry& entry)
     {
-        m_clean_list.prepend(entry);
+        move_to_list(entry, entry.referenced_again ? CacheEntry::List::Protected : CacheEntry::List::Probation);
     }
 
-    CacheEntry* get(BlockBasedFileSystem::BlockIndex block_index) const
+    // Looks up an entry without counting it as a reference to the block, so it's not promoted.
+    CacheEntry* find(BlockBasedFileSystem::BlockIndex block_index)
     {
         auto it = m_hash.find(block_index);
         if (it == m_hash.end())
             return nullptr;
-        auto& entry = const_cast<CacheEntry&>(*it->value);
-        VERIFY(entry.block_index == block_index);
-        if (!entry_is_dirty(entry) && (m_clean_list.first() != &entry)) {
-            // Cache hit! Promote the entry to the front of the list.
-            m_clean_list.prepend(entry);
+        VERIFY(it->value->block_index == block_index);
+        return it->value;
+    }
+
+    CacheEntry* get(BlockBasedFileSystem::BlockIndex block_index)
+    {
+        auto* found_entry = find(block_index);
+        if (!found_entry)
+            return nullptr;
+        auto& entry = *found_entry;
+        entry.referenced_again = true;
+        if (!entry_is_dirty(entry)) {
+            // Cache hit! Promote the entry to the front of the protected list.
+            move_to_list(entry, CacheEntry::List::Protected);
         }
         return &entry;
     }
 
-    ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index, BlockBasedFileSystem& fs) const
+    ErrorOr<CacheEntry*> ensure(BlockBasedFileSystem::BlockIndex block_index, BlockBasedFileSystem& fs)
     {
-        if (auto* entry = get(block_index))
+        if (auto* entry = get(block_index)) {
+            ++m_hits;
             return entry;
-
-        if (m_clean_list.is_empty()) {
-            // Not a single clean entry! Flush writes and try again.
-            // NOTE: We want to make sure we only call FileBackedFileSystem flush here,
-            //       not some FileBackedFileSystem subclass flush!
-            fs.flush_writes_impl();
-            return ensure(block_index, fs);
         }
+        ++m_misses;
+        return allocate_entry(block_index, fs);
+    }
 
-        VERIFY(m_clean_list.last());
-        auto& new_entry = *m_clean_list.last();
-        m_clean_list.prepend(new_entry);
-
-        m_hash.remove(new_entry.block_index);
-        TRY(m_hash.try_set(block_index, &new_entry));
+    // Like ensure(), but for writes. Writing a block doesn't tell us that it's going to be read again, so it
+    // must not count as the second reference that promotes the entry to the protected list.
+    ErrorOr<CacheEntry*> ensure_for_write(BlockBasedFileSystem::BlockIndex block_index, BlockBasedFileSystem& fs)
+    {
+        if (auto* entry = find(block_index)) {
+            ++m_hits;
+            return entry;
+        }
+        ++m_misses;
+        return allocate_entry(block_index, fs);
+    }
 
-        new_entry.block_index = block_index;
-        new_entry.has_data = false;
+    bool contains(BlockBasedFileSystem::BlockIndex block_index) const { return m_hash.contains(block_index); }
 
-        return &new_entry;
+    ErrorOr<void> insert_read_ahead_block(BlockBasedFileSystem::BlockIndex block_index, ReadonlyBytes data, BlockBasedFileSystem& fs)
+    {
+        VERIFY(data.size() == m_block_size);
+        if (contains(block_index))
+            return {};
+        auto* entry = TRY(allocate_entry(block_index, fs));
+        memcpy(entry->data, data.data(), m_block_size);
+        entry->has_data = true;
+        ++m_read_ahead_blocks;
+        return {};
     }
 
-    CacheEntry const* entries() const { return (CacheEntry const*)m_entries->data(); }
-    CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
-
     template<typename Callback>
     void for_each_dirty_entry(Callback callback)
     {
@@ -102,15 +144,271 @@ public:
             callback(entry);
     }
 
+    size_t flush_dirty_entries(BlockBasedFileSystem& fs)
+    {
+        Vector<CacheEntry*> dirty_entries;
+        if (dirty_entries.try_ensure_capacity(m_list_sizes[to_underlying(CacheEntry::List::Dirty)]).is_error()) {
+            // We can't sort the dirty entries, so just write them out one by one.
+            size_t count = 0;
+            for_each_dirty_entry([&](CacheEntry& entry) {
+                write_entry(fs, entry);
+                ++count;
+            });
+            mark_all_clean();
+            return count;
+        }
+
+        for_each_dirty_entry([&](CacheEntry& entry) {
+            dirty_entries.unchecked_append(&entry);
+        });
+        quick_sort(dirty_entries, [](auto* a, auto* b) { return a->block_index < b->block_index; });
+
+        // Merge runs of neighboring blocks, so each run turns into a single device request.
+        for (size_t run_start = 0; run_start < dirty_entries.size();) {
+            size_t run_length = 1;
+            while (run_start + run_length < dirty_entries.size()
+                && run_length < MaximumWriteClusterSize
+                && dirty_entries[run_start + run_length]->block_index.value() == dirty_entries[run_start]->block_index.value() + run_length)
+                ++run_length;
+            write_entries(fs, dirty_entries.span().slice(run_start, run_length));
+            run_start += run_length;
+        }
+
+        mark_all_clean();
+        return dirty_entries.size();
+    }
+
+    enum class MemoryPressure {
+        Low,
+        Normal,
+        High,
+    };
+
+    static MemoryPressure current_memory_pressure()
+    {
+        auto info = MM.get_system_memory_info();
+        auto available_pages = min(info.physical_pages - info.physical_pages_used, info.physical_pages_uncommitted);
+        if (available_pages < info.physical_pages / 16)
+            return MemoryPressure::High;
+        if (available_pages > info.physical_pages / 4)
+            return MemoryPressure::Low;
+        return MemoryPressure::Normal;
+    }
+
+    // Gives a chunk of the cache back to the system. Unlike adapt_to_memory_pressure(), this also works
+    // for a cache that isn't seeing any misses.
+    void release_memory(BlockBasedFileSystem& fs)
+    {
+        shrink_if_possible(fs);
+    }
+
+    BlockBasedFileSystem::DiskCacheStatistics statistics() const
+    {
+        return {
+            .hits = m_hits,
+            .misses = m_misses,
+            .evictions = m_evictions,
+            .read_ahead_blocks = m_read_ahead_blocks,
+            .cached_blocks = capacity() - m_list_sizes[to_underlying(CacheEntry::List::Free)],
+            .capacity = capacity(),
+        };
+    }
+
 private:
-    NonnullOwnPtr<KBuffer> m_cached_block_data;
-
-    // NOTE: m_entries must be declared before m_dirty_list and m_clean_list because their entries are allocated from it.
-    // We need to ensure that the destructors of m_dirty_list and m_clean_list are called before m_entries is destroyed.
-    NonnullOwnPtr<KBuffer> m_entries;
-    mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
-    mutable IntrusiveList<&CacheEntry::list_node> m_clean_list;
-    mutable HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
+    explicit DiskCache(size_t block_size)
+        : m_block_size(block_size)
+    {
+    }
+
+    size_t capacity() const { return m_chunks.size() * EntriesPerChunk; }
+
+    static Span<CacheEntry> entries_of(DiskCacheChunk& chunk)
+    {
+        return { reinterpret_cast<CacheEntry*>(chunk.entries_buffer->data()), EntriesPerChunk };
+    }
+
+    IntrusiveList<&CacheEntry::list_node>& list_for(CacheEntry::List list)
+    {
+        switch (list) {
+        case CacheEntry::List::Free:
+            return m_free_list;
+        case CacheEntry::List::Probation:
+            return m_probation_list;
+        case CacheEntry::List::Protected:
+            return m_protected_list;
+        case CacheEntry::List::Dirty:
+            return m_dirty_list;
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+    void move_to_list(CacheEntry& entry, CacheEntry::List list)
+    {
+        --m_list_sizes[to_underlying(entry.list)];
+        ++m_list_sizes[to_underlying(list)];
+        entry.list = list;
+        list_for(list).prepend(entry);
+
+        if (list == CacheEntry::List::Protected)
+            balance_protected_list();
+    }
+
+    void balance_protected_list()
+    {
+        // Don't let the protected list take over the whole cache, otherwise blocks
+        // that are new to the cache would never get a chance to prove themselves.
+        auto maximum_protected_size = capacity() - capacity() / 4;
+        while (m_list_sizes[to_underlying(CacheEntry::List::Protected)] > maximum_protected_size) {
+            auto* entry = m_protected_list.last();
+            VERIFY(entry);
+            entry->referenced_again = false;
+            --m_list_sizes[to_underlying(CacheEntry::List::Protected)];
+            ++m_list_sizes[to_underlying(CacheEntry::List::Probation)];
+            entry->list = CacheEntry::List::Probation;
+            m_probation_list.prepend(*entry);
+        }
+    }
+
+    CacheEntry* take_entry_for_reuse()
+    {
+        if (auto* entry = m_free_list.first())
+            return entry;
+
+        auto* victim = m_probation_list.last();
+        if (!victim)
+            victim = m_protected_list.last();
+        if (!victim)
+            return nullptr;
+
+        m_hash.remove(victim->block_index);
+        ++m_evictions;
+        return victim;
+    }
+
+    ErrorOr<CacheEntry*> allocate_entry(BlockBasedFileSystem::BlockIndex block_index, BlockBasedFileSystem& fs)
+    {
+        adapt_to_memory_pressure(fs);
+
+        auto* new_entry = take_entry_for_reuse();
+        if (!new_entry) {
+            // Not a single clean entry! Flush writes and try again.
+            flush_dirty_entries(fs);
+            new_entry = take_entry_for_reuse();
+            VERIFY(new_entry);
+        }
+
+        TRY(m_hash.try_set(block_index, new_entry));
+
+        new_entry->block_index = block_index;
+        new_entry->has_data = false;
+        new_entry->referenced_again = false;
+        move_to_list(*new_entry, CacheEntry::List::Probation);
+
+        return new_entry;
+    }
+
+    void write_entry(BlockBasedFileSystem& fs, CacheEntry& entry)
+    {
+        auto base_offset = entry.block_index.value() * m_block_size;
+        auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
+        [[maybe_unused]] auto rc = fs.file_description().write(base_offset, entry_data_buffer, m_block_size);
+        fs.did_write_to_device(entry.block_index);
+    }
+
+    void write_entries(BlockBasedFileSystem& fs, Span<CacheEntry*> run)
+    {
+        if (run.size() == 1) {
+            write_entry(fs, *run[0]);
+            return;
+        }
+
+        auto buffer_or_error = ByteBuffer::create_uninitialized(run.size() * m_block_size);
+        if (buffer_or_error.is_error()) {
+            for (auto* entry : run)
+                write_entry(fs, *entry);
+            return;
+        }
+        auto buffer = buffer_or_error.release_value();
+        for (size_t i = 0; i < run.size(); ++i)
+            memcpy(buffer.data() + i * m_block_size, run[i]->data, m_block_size);
+
+        auto base_offset = run[0]->block_index.value() * m_block_size;
+        auto run_data_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer.data());
+        [[maybe_unused]] auto rc = fs.file_description().write(base_offset, run_data_buffer, buffer.size());
+        for (auto* entry : run)
+            fs.did_write_to_device(entry->block_index);
+    }
+
+    void adapt_to_memory_pressure(BlockBasedFileSystem& fs)
+    {
+        // Only bother resizing once we would otherwise have to evict something.
+        if (!m_free_list.is_empty())
+            return;
+
+        auto memory_pressure = current_memory_pressure();
+        if (memory_pressure == MemoryPressure::High) {
+            shrink_if_possible(fs);
+            return;
+        }
+
+        if (m_chunks.size() < MaximumChunkCount && memory_pressure == MemoryPressure::Low) {
+            if (auto result = try_grow(); result.is_error())
+                dbgln_if(BBFS_DEBUG, "DiskCache: Failed to grow cache: {}", result.error());
+        }
+    }
+
+    ErrorOr<void> try_grow()
+    {
+        auto block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, EntriesPerChunk * m_block_size, Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+        auto entries_buffer = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, EntriesPerChunk * sizeof(CacheEntry), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
+        auto chunk = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCacheChunk { move(block_data), move(entries_buffer) }));
+        TRY(m_chunks.try_append(move(chunk)));
+
+        auto& new_chunk = *m_chunks.last();
+        auto entries = entries_of(new_chunk);
+        for (size_t i = 0; i < EntriesPerChunk; ++i) {
+            auto& entry = *new (&entries[i]) CacheEntry;
+            entry.data = new_chunk.block_data->data() + i * m_block_size;
+            ++m_list_sizes[to_underlying(CacheEntry::List::Free)];
+            m_free_list.append(entry);
+        }
+        dbgln_if(BBFS_DEBUG, "DiskCache: Grew to {} entries", capacity());
+        return {};
+    }
+
+    void shrink_if_possible(BlockBasedFileSystem& fs)
+    {
+        if (m_chunks.size() <= MinimumChunkCount)
+            return;
+        auto chunk = m_chunks.take_last();
+        for (auto& entry : entries_of(*chunk)) {
+            if (entry_is_dirty(entry))
+                write_entry(fs, entry);
+            if (entry.list != CacheEntry::List::Free)
+                m_hash.remove(entry.block_index);
+            --m_list_sizes[to_underlying(entry.list)];
+            entry.list_node.remove();
+            entry.~CacheEntry();
+        }
+        dbgln_if(BBFS_DEBUG, "DiskCache: Shrunk to {} entries", capacity());
+    }
+
+    size_t m_block_size { 0 };
+
+    // NOTE: m_chunks must be declared before the lists because their entries are allocated from it.
+    // We need to ensure that the destructors of the lists are called before the chunks are destroyed.
+    Vector<NonnullOwnPtr<DiskCacheChunk>> m_chunks;
+    IntrusiveList<&CacheEntry::list_node> m_free_list;
+    IntrusiveList<&CacheEntry::list_node> m_probation_list;
+    IntrusiveList<&CacheEntry::list_node> m_protected_list;
+    IntrusiveList<&CacheEntry::list_node> m_dirty_list;
+    Array<size_t, 4> m_list_sizes {};
+    HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
+
+    u64 m_hits { 0 };
+    u64 m_misses { 0 };
+    u64 m_evictions { 0 };
+    u64 m_read_ahead_blocks { 0 };
 };
 
 BlockBasedFileSystem::BlockBasedFileSystem(OpenFileDescription& file_description)
@@ -126,13 +424,12 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     VERIFY(m_lock.is_locked());
     VERIFY(!is_initialized_while_locked());
     VERIFY(logical_block_size() != 0);
-    auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCache::EntryCount * logical_block_size(), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
-    auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCache::EntryCount * sizeof(CacheEntry), Memory::Region::Access::ReadWrite, AllocationStrategy::AllocateNow));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
-
-    m_cache.with_exclusive([&](auto& cache) {
-        cache = move(disk_cache);
-    });
+    for (auto& shard : m_cache_shards) {
+        auto disk_cache = TRY(DiskCache::try_create(*this));
+        shard.with_exclusive([&](auto& cache) {
+            cache = move(disk_cache);
+        });
+    }
     return {};
 }
 
@@ -149,19 +446,23 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
 
     TRY(data.read(buffered_data.bytes()));
 
-    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+    return cache_for(index).with_exclusive([&](auto& cache) -> ErrorOr<void> {
         if (!allow_cache) {
             flush_specific_block_if_needed(index);
             u64 base_offset = index.value() * logical_block_size() + offset;
             auto nwritten = TRY(file_description().write(base_offset, data, count));
+            did_write_to_device(index);
             VERIFY(nwritten == count);
             return {};
         }
 
-        auto entry = TRY(cache->ensure(index, *this));
-        if (count < logical_block_size()) {
+        auto* entry = TRY(cache->ensure_for_write(index, *this));
+        if (count < logical_block_size() && !entry->has_data) {
             // Fill the cache first.
-            TRY(read_block(index, nullptr, logical_block_size()));
+            auto base_offset = index.value() * logical_block_size();
+            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
+            auto nread = TRY(file_description().read(entry_data_buffer, base_offset, logical_block_size()));
+            VERIFY(nread == logical_block_size());
         }
         memcpy(entry->data + offset, buffered_data.data(), count);
 
@@ -223,7 +524,7 @@ ErrorOr<void> BlockBasedFileSystem::read_block(BlockIndex index, UserOrKernelBuf
     VERIFY(offset + count <= logical_block_size());
     dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem::read_block {}", index);
 
-    return m_cache.with_exclusive([&](auto& cache) -> ErrorOr<void> {
+    return cache_for(index).with_exclusive([&](auto& cache) -> ErrorOr<void> {
         if (!allow_cache) {
             const_cast<BlockBasedFileSystem*>(this)->flush_specific_block_if_needed(index);
             u64 base_offset = index.value() * logical_block_size() + offset;
@@ -262,12 +563,85 @@ ErrorOr<void> BlockBasedFileSystem::read_blocks(BlockIndex index, unsigned count
     return {};
 }
 
+void BlockBasedFileSystem::read_ahead_blocks(Vector<BlockIndex> blocks) const
+{
+    if (blocks.is_empty())
+        return;
+
+    auto& self = const_cast<BlockBasedFileSystem&>(*this);
+    auto result = g_io_work->try_queue([fs = NonnullRefPtr<BlockBasedFileSystem> { self }, blocks = move(blocks)]() {
+        fs->do_read_ahead(blocks);
+    });
+    if (result.is_error())
+        dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem: Failed to queue read-ahead: {}", result.error());
+}
+
+void BlockBasedFileSystem::do_read_ahead(Vector<BlockIndex> const& blocks)
+{
+    static constexpr size_t maximum_read_ahead_run = 64;
+
+    auto is_cached = [&](BlockIndex index) {
+        return cache_for(index).with_exclusive([&](auto& cache) { return cache->contains(index); });
+    };
+
+    for (size_t run_start = 0; run_start < blocks.size();) {
+        size_t run_length = 1;
+        while (run_start + run_length < blocks.size()
+            && run_length < maximum_read_ahead_run
+            && blocks[run_start + run_length].value() == blocks[run_start].value() + run_length)
+            ++run_length;
+
+        auto run = blocks.span().slice(run_start, run_length);
+        run_start += run_length;
+
+        // Trim blocks that are already cached from both ends of the run.
+        while (!run.is_empty() && is_cached(run.first()))
+            run = run.slice(1);
+        while (!run.is_empty() && is_cached(run.last()))
+            run = run.trim(run.size() - 1);
+        if (run.is_empty())
+            continue;
+
+        auto buffer_or_error = ByteBuffer::create_uninitialized(run.size() * logical_block_size());
+        if (buffer_or_error.is_error())
+            return;
+        auto buffer = buffer_or_error.release_value();
+
+        // Remember the write generations of the blocks before reading them, a write that finishes after this
+        // point may or may not be reflected in what we read.
+        Array<u64, maximum_read_ahead_run> write_generations;
+        for (size_t i = 0; i < run.size(); ++i)
+            write_generations[i] = write_generation_of(run[i]).load(AK::MemoryOrder::memory_order_relaxed);
+
+        auto run_data_buffer = UserOrKernelBuffer::for_kernel_buffer(buffer.data());
+        auto nread_or_error = file_description().read(run_data_buffer, run.first().value() * logical_block_size(), buffer.size());
+        if (nread_or_error.is_error() || nread_or_error.value() != buffer.size())
+            return;
+
+        dbgln_if(BBFS_DEBUG, "BlockBasedFileSystem: Read ahead {} blocks starting at {}", run.size(), run.first());
+
+        for (size_t i = 0; i < run.size(); ++i) {
+            auto index = run[i];
+            auto result = cache_for(index).with_exclusive([&](auto& cache) -> ErrorOr<void> {
+                // If this block was written to the device while we were reading it, the data we just read may
+                // already be stale. Checking this while holding the shard lock ensures that no write of this
+                // block can slip in between the check and the insertion.
+                if (write_generation_of(index).load(AK::MemoryOrder::memory_order_relaxed) != write_generations[i])
+                    return {};
+                return cache->insert_read_ahead_block(index, buffer.bytes().slice(i * logical_block_size(), logical_block_size()), *this);
+            });
+            if (result.is_error())
+                return;
+        }
+    }
+}
+
 void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
 {
-    m_cache.with_exclusive([&](auto& cache) {
+    cache_for(index).with_exclusive([&](auto& cache) {
         if (!cache->is_dirty())
             return;
-        auto* entry = cache->get(index);
+        auto* entry = cache->find(index);
         if (!entry)
             return;
         if (!cache->entry_is_dirty(*entry))
@@ -275,24 +649,46 @@ void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
         size_t base_offset = entry->block_index.value() * logical_block_size();
         auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry->data);
         (void)file_description().write(base_offset, entry_data_buffer, logical_block_size());
+        did_write_to_device(index);
     });
 }
 
 void BlockBasedFileSystem::flush_writes_impl()
 {
+    // This runs every second from the SyncTask, so it's also where caches that have grown large
+    // give memory back once the system runs low on it.
+    bool is_under_memory_pressure = DiskCache::current_memory_pressure() == DiskCache::MemoryPressure::High;
+
     size_t count = 0;
-    m_cache.with_exclusive([&](auto& cache) {
-        if (!cache->is_dirty())
-            return;
-        cache->for_each_dirty_entry([&](CacheEntry& entry) {
-            auto base_offset = entry.block_index.value() * logical_block_size();
-            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
-            [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, logical_block_size());
-            ++count;
+    for (auto& shard : m_cache_shards) {
+        shard.with_exclusive([&](auto& cache) {
+            if (cache->is_dirty())
+                count += cache->flush_dirty_entries(*this);
+            if (is_under_memory_pressure)
+                cache->release_memory(*this);
         });
-        cache->mark_all_clean();
+    }
+    if (count > 0)
         dbgln("{}: Flushed {} blocks to disk", class_name(), count);
-    });
+}
+
+BlockBasedFileSystem::DiskCacheStatistics BlockBasedFileSystem::disk_cache_statistics() const
+{
+    DiskCacheStatistics total;
+    for (auto& shard : m_cache_shards) {
+        shard.with_exclusive([&](auto& cache) {
+            if (!cache)
+                return;
+            auto statistics = cache->statistics();
+            total.hits += statistics.hits;
+            total.misses += statistics.misses;
+            total.evictions += statistics.evictions;
+            total.read_ahead_blocks += statistics.read_ahead_blocks;
+            total.cached_blocks += statistics.cached_blocks;
+            total.capacity += statistics.capacity;
+        });
+    }
+    return total;
 }
 
 ErrorOr<void> BlockBasedFileSystem::flush_writes()
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <Kernel/FileSystem/FileBackedFileSystem.h>
 #include <Kernel/Locking/MutexProtected.h>
 
@@ -22,6 +24,18 @@ public:
     virtual ErrorOr<void> flush_writes() override;
     void flush_writes_impl();
 
+    struct DiskCacheStatistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+        u64 read_ahead_blocks { 0 };
+        size_t cached_blocks { 0 };
+        size_t capacity { 0 };
+    };
+    DiskCacheStatistics disk_cache_statistics() const;
+
+    virtual bool is_block_based() const override { return true; }
+
 protected:
     explicit BlockBasedFileSystem(OpenFileDescription&);
 
@@ -36,15 +50,35 @@ protected:
     ErrorOr<void> raw_read_blocks(BlockIndex index, size_t count, UserOrKernelBuffer&);
     ErrorOr<void> raw_write_blocks(BlockIndex index, size_t count, UserOrKernelBuffer const&);
 
+    // Asynchronously pulls the given blocks into the cache. Runs of contiguous blocks are read with a single device request.
+    void read_ahead_blocks(Vector<BlockIndex> blocks) const;
+
     ErrorOr<void> write_block(BlockIndex, UserOrKernelBuffer const&, size_t count, u64 offset = 0, bool allow_cache = true);
     ErrorOr<void> write_blocks(BlockIndex, unsigned count, UserOrKernelBuffer const&, bool allow_cache = true);
 
     u64 m_device_block_size { 512 };
 
 private:
+    friend class DiskCache;
+
     void flush_specific_block_if_needed(BlockIndex index);
+    void do_read_ahead(Vector<BlockIndex> const& blocks);
+
+    static constexpr size_t WriteGenerationBucketCount = 256;
+    Atomic<u64>& write_generation_of(BlockIndex index) const { return m_write_generations[index.value() % WriteGenerationBucketCount]; }
+    void did_write_to_device(BlockIndex index) { write_generation_of(index).fetch_add(1, AK::MemoryOrder::memory_order_relaxed); }
+
+    // The cache is split into shards by ranges of block indices, so accesses to unrelated blocks don't contend on the
+    // same lock, while runs of neighboring blocks still end up in the same shard and can be written out together.
+    static constexpr size_t DiskCacheShardCount = 8;
+    static constexpr size_t DiskCacheShardGranularity = 64;
+    MutexProtected<OwnPtr<DiskCache>>& cache_for(BlockIndex index) const { return m_cache_shards[(index.value() / DiskCacheShardGranularity) % DiskCacheShardCount]; }
+
+    mutable Array<MutexProtected<OwnPtr<DiskCache>>, DiskCacheShardCount> m_cache_shards;
 
-    mutable MutexProtected<OwnPtr<DiskCache>> m_cache;
+    // Bumped whenever a block is written to the device, so read-ahead can tell that the data it read for that block may
+    // be stale. Blocks that are WriteGenerationBucketCount apart share a counter, which at worst makes read-ahead skip a block.
+    mutable Array<Atomic<u64>, WriteGenerationBucketCount> m_write_generations {};
 };
 
 }
@@ -531,9 +531,41 @@ ErrorOr<size_t> Ext2FSInode::read_bytes_locked(off_t offset, size_t count, UserO
         nread += num_bytes_to_copy;
     }
 
+    if (description && allow_cache) {
+        if (auto range = description->update_read_ahead(offset, nread, block_size); range.has_value())
+            read_ahead(*range);
+    }
+
     return nread;
 }
 
+void Ext2FSInode::read_ahead(OpenFileDescription::ReadAheadRange const& range) const
+{
+    VERIFY(m_inode_lock.is_locked());
+    VERIFY(size() > 0);
+
+    auto const block_size = fs().logical_block_size();
+    u64 const last_block_logical_index = (size() - 1) / block_size;
+
+    Vector<BlockBasedFileSystem::BlockIndex> blocks;
+    for (u64 logical_index = range.first_block_index; logical_index < range.first_block_index + range.block_count; ++logical_index) {
+        if (logical_index > last_block_logical_index)
+            break;
+        auto block_index_or_error = m_block_view.get_block(logical_index);
+        if (block_index_or_error.is_error())
+            break;
+        auto block_index = block_index_or_error.release_value();
+        if (block_index.value() == 0) {
+            // Holes don't need to be read.
+            continue;
+        }
+        if (blocks.try_append(block_index).is_error())
+            break;
+    }
+
+    fs().read_ahead_blocks(move(blocks));
+}
+
 ErrorOr<void> Ext2FSInode::resize(u64 new_size)
 {
     VERIFY(m_inode_lock.is_locked());
@@ -12,6 +12,7 @@
 #include <Kernel/FileSystem/Ext2FS/DirectoryEntry.h>
 #include <Kernel/FileSystem/Ext2FS/FileSystem.h>
 #include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/OpenFileDescription.h>
 #include <Kernel/UnixTypes.h>
 
 namespace Kernel {
@@ -71,6 +72,8 @@ private:
 
     ErrorOr<Ext2FS::BlockList> compute_block_list(BlockBasedFileSystem::BlockIndex, BlockBasedFileSystem::BlockIndex) const;
 
+    void read_ahead(OpenFileDescription::ReadAheadRange const&) const;
+
     ErrorOr<void> free_all_blocks();
 
     u64 singly_indirect_block_capacity() const
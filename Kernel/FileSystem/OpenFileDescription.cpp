@@ -563,6 +563,42 @@ off_t OpenFileDescription::offset() const
     return m_state.with([](auto& state) { return state.current_offset; });
 }
 
+Optional<OpenFileDescription::ReadAheadRange> OpenFileDescription::update_read_ahead(u64 offset, size_t nread, size_t block_size)
+{
+    static constexpr u32 initial_read_ahead_window = 4;
+    static constexpr u32 maximum_read_ahead_window = 64;
+
+    if (nread == 0)
+        return {};
+
+    return m_state.with([&](auto& state) -> Optional<ReadAheadRange> {
+        if (offset != state.read_ahead_next_offset) {
+            // This is a random access, start over.
+            state.read_ahead_window = 0;
+            state.read_ahead_next_block_index = 0;
+        }
+        state.read_ahead_next_offset = offset + nread;
+
+        if (state.read_ahead_window == 0)
+            state.read_ahead_window = initial_read_ahead_window;
+        else
+            state.read_ahead_window = min(state.read_ahead_window * 2, maximum_read_ahead_window);
+
+        u64 first_block_after_read = (offset + nread - 1) / block_size + 1;
+        u64 first_block_index = max(first_block_after_read, state.read_ahead_next_block_index);
+        u64 end_block_index = first_block_after_read + state.read_ahead_window;
+        if (first_block_index >= end_block_index)
+            return {};
+
+        // Don't bother issuing tiny requests, wait until a good part of the window has been consumed.
+        if (end_block_index - first_block_index < state.read_ahead_window / 2)
+            return {};
+
+        state.read_ahead_next_block_index = end_block_index;
+        return ReadAheadRange { first_block_index, static_cast<size_t>(end_block_index - first_block_index) };
+    });
+}
+
 RefPtr<Custody const> OpenFileDescription::custody() const
 {
     return m_state.with([](auto& state) { return state.custody; });
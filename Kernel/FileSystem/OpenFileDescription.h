@@ -8,6 +8,7 @@
 
 #include <AK/AtomicRefCounted.h>
 #include <AK/Badge.h>
+#include <AK/Optional.h>
 #include <AK/RefPtr.h>
 #include <Kernel/FileSystem/Custody.h>
 #include <Kernel/FileSystem/FIFO.h>
@@ -129,6 +130,15 @@ public:
 
     off_t offset() const;
 
+    struct ReadAheadRange {
+        u64 first_block_index { 0 };
+        size_t block_count { 0 };
+    };
+
+    // Called by file systems after `nread` bytes were read at `offset`. If this description is being
+    // read sequentially, returns the range of logical blocks that is worth reading ahead.
+    Optional<ReadAheadRange> update_read_ahead(u64 offset, size_t nread, size_t block_size);
+
     ErrorOr<void> chown(Credentials const& credentials, UserID, GroupID);
 
     FileBlockerSet& blocker_set();
@@ -161,6 +171,9 @@ private:
         bool should_append : 1 { false };
         bool direct : 1 { false };
         FIFO::Direction fifo_direction : 2 { FIFO::Direction::Neither };
+        u64 read_ahead_next_offset { 0 };
+        u64 read_ahead_next_block_index { 0 };
+        u32 read_ahead_window { 0 };
     };
 
     SpinlockProtected<State, LockRank::None> m_state {};
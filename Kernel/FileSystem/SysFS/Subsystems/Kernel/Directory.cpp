@@ -25,6 +25,7 @@
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Processes.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Profile.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/RequestPanic.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Scheduler.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/SystemStatistics.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Uptime.h>
 
@@ -41,6 +42,7 @@ UNMAP_AFTER_INIT NonnullRefPtr<SysFSGlobalKernelStatsDirectory> SysFSGlobalKerne
         list.append(SysFSCPUInformation::must_create(*global_kernel_stats_directory));
         list.append(SysFSKernelLog::must_create(*global_kernel_stats_directory));
         list.append(SysFSInterrupts::must_create(*global_kernel_stats_directory));
+        list.append(SysFSSchedulerStatistics::must_create(*global_kernel_stats_directory));
         list.append(SysFSKeymap::must_create(*global_kernel_stats_directory));
         list.append(SysFSUptime::must_create(*global_kernel_stats_directory));
         list.append(SysFSProfile::must_create(*global_kernel_stats_directory));
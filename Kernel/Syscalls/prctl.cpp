@@ -5,6 +5,7 @@
  */
 
 #include <Kernel/API/prctl_numbers.h>
+#include <Kernel/Arch/Processor.h>
 #include <Kernel/Tasks/Process.h>
 
 namespace Kernel {
@@ -95,6 +96,26 @@ ErrorOr<FlatPtr> Process::sys$prctl(int option, FlatPtr arg1, FlatPtr arg2, Flat
         }));
         return 0;
     }
+    case PR_SET_THREAD_PREFERRED_CPU: {
+        TRY(require_promise(Pledge::thread));
+        int thread_id = static_cast<int>(arg1);
+        // A negative processor number removes the hint.
+        auto cpu = static_cast<int>(arg2);
+        if (cpu >= 0 && static_cast<u32>(cpu) >= Processor::count())
+            return EINVAL;
+        auto thread = TRY(get_thread_from_thread_list(thread_id));
+        thread->set_preferred_cpu(cpu < 0 ? Optional<u32> {} : static_cast<u32>(cpu));
+        return 0;
+    }
+    case PR_GET_THREAD_PREFERRED_CPU: {
+        TRY(require_promise(Pledge::thread));
+        int thread_id = static_cast<int>(arg1);
+        auto thread = TRY(get_thread_from_thread_list(thread_id));
+        auto cpu = thread->preferred_cpu();
+        if (!cpu.has_value())
+            return ENOENT;
+        return *cpu;
+    }
     case PR_SET_NO_TRANSITION_TO_EXECUTABLE_FROM_WRITABLE_PROT: {
         TRY(require_promise(Pledge::prot_exec));
         with_mutable_protected_data([](auto& protected_data) {
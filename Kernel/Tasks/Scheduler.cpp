@@ -47,7 +47,33 @@ struct ThreadReadyQueues {
     Array<ThreadReadyQueue, count> queues;
 };
 
-static Singleton<RecursiveSpinlockProtected<ThreadReadyQueues, LockRank::None>> g_ready_queues;
+// Each processor's ready queues are protected by their own lock. Taking a thread off them, whether
+// to run it or to steal it, doesn't require g_scheduler_lock. Queueing a thread does, since it is
+// part of a thread state transition.
+struct ProcessorReadyQueues {
+    Thread* take_runnable_thread(u32 affinity_mask);
+    Thread* peek_runnable_thread(u32 affinity_mask);
+    void enqueue(Thread&, u32 priority, u32 cpu);
+    bool dequeue(Thread&, bool check_affinity);
+
+    RecursiveSpinlockProtected<ThreadReadyQueues, LockRank::None> ready_queues;
+
+    // These are only used for balancing decisions and statistics, so they
+    // can be read without holding the ready queue lock.
+    Atomic<u32> depth { 0 };
+    Atomic<u64> stolen_count { 0 };
+    Atomic<u64> lost_count { 0 };
+
+private:
+    template<typename Callback>
+    static Thread* find_runnable_thread(ThreadReadyQueues&, u32 affinity_mask, Callback);
+};
+
+// Thread affinity is a bitmask of processors, so there can't be more
+// ready queues than there are bits in it.
+static constexpr size_t max_ready_queue_processors = sizeof(u32) * 8;
+
+static Singleton<Array<ProcessorReadyQueues, max_ready_queue_processors>> g_ready_queues;
 
 static RecursiveSpinlockProtected<TotalTimeScheduled, LockRank::None> g_total_time_scheduled {};
 
@@ -56,7 +82,7 @@ static void dump_thread_list(bool = false);
 static inline u32 thread_priority_to_priority_index(u32 thread_priority)
 {
     // Converts the priority in the range of THREAD_PRIORITY_MIN...THREAD_PRIORITY_MAX
-    // to a index into g_ready_queues where 0 is the highest priority bucket
+    // to a index into ThreadReadyQueues::queues where 0 is the highest priority bucket
     VERIFY(thread_priority >= THREAD_PRIORITY_MIN && thread_priority <= THREAD_PRIORITY_MAX);
     constexpr u32 thread_priority_count = THREAD_PRIORITY_MAX - THREAD_PRIORITY_MIN + 1;
     static_assert(thread_priority_count > 0);
@@ -65,82 +91,111 @@ static inline u32 thread_priority_to_priority_index(u32 thread_priority)
     return priority_bucket;
 }
 
-Thread& Scheduler::pull_next_runnable_thread()
+static inline ProcessorReadyQueues& ready_queues_for_processor(u32 cpu)
 {
-    auto affinity_mask = 1u << Processor::current_id();
-
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread& {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                thread.m_runnable_priority = -1;
-                ready_queue.thread_list.remove(thread);
-                if (ready_queue.thread_list.is_empty())
-                    ready_queues.mask &= ~(1u << priority);
-                // Mark it as active because we are using this thread. This is similar
-                // to comparing it with Processor::current_thread, but when there are
-                // multiple processors there's no easy way to check whether the thread
-                // is actually still needed. This prevents accidental finalization when
-                // a thread is no longer in Running state, but running on another core.
-
-                // We need to mark it active here so that this thread won't be
-                // scheduled on another core if it were to be queued before actually
-                // switching to it.
-                // FIXME: Figure out a better way maybe?
-                thread.set_active(true);
-                return thread;
-            }
-            priority_mask &= ~(1u << priority);
-        }
+    VERIFY(cpu < max_ready_queue_processors);
+    return (*g_ready_queues)[cpu];
+}
 
-        auto* idle_thread = Processor::idle_thread();
-        idle_thread->set_active(true);
-        return *idle_thread;
-    });
+static u32 select_processor_for(Thread const& thread)
+{
+    auto affinity = thread.affinity();
+    VERIFY(affinity != 0);
+
+    auto is_allowed = [&](u32 cpu) {
+        return cpu < max_ready_queue_processors && (affinity & (1u << cpu));
+    };
+
+    // An explicit hint (set with PR_SET_THREAD_PREFERRED_CPU) always wins, as long as it doesn't violate the affinity mask.
+    if (auto preferred_cpu = thread.preferred_cpu(); preferred_cpu.has_value() && is_allowed(*preferred_cpu))
+        return *preferred_cpu;
+
+    // Otherwise keep the thread on the processor it last ran on, its caches are most likely still warm there.
+    if (thread.times_scheduled() > 0 && is_allowed(thread.cpu()))
+        return thread.cpu();
+
+    // Threads that have never run start out on the processor that made them runnable.
+    if (auto current_cpu = Processor::current_id(); is_allowed(current_cpu))
+        return current_cpu;
+
+    return bit_scan_forward(affinity) - 1;
 }
 
-Thread* Scheduler::peek_next_runnable_thread()
+template<typename Callback>
+Thread* ProcessorReadyQueues::find_runnable_thread(ThreadReadyQueues& queues, u32 affinity_mask, Callback callback)
 {
-    auto affinity_mask = 1u << Processor::current_id();
-
-    return g_ready_queues->with([&](auto& ready_queues) -> Thread* {
-        auto priority_mask = ready_queues.mask;
-        while (priority_mask != 0) {
-            auto priority = bit_scan_forward(priority_mask);
-            VERIFY(priority > 0);
-            auto& ready_queue = ready_queues.queues[--priority];
-            for (auto& thread : ready_queue.thread_list) {
-                VERIFY(thread.m_runnable_priority == (int)priority);
-                if (thread.is_active())
-                    continue;
-                if (!(thread.affinity() & affinity_mask))
-                    continue;
-                return &thread;
-            }
-            priority_mask &= ~(1u << priority);
+    auto priority_mask = queues.mask;
+    while (priority_mask != 0) {
+        auto priority = bit_scan_forward(priority_mask);
+        VERIFY(priority > 0);
+        auto& ready_queue = queues.queues[--priority];
+        for (auto& thread : ready_queue.thread_list) {
+            VERIFY(thread.m_runnable_priority == (int)priority);
+            if (thread.is_active())
+                continue;
+            if (!(thread.affinity() & affinity_mask))
+                continue;
+            callback(thread, ready_queue, priority);
+            return &thread;
         }
+        priority_mask &= ~(1u << priority);
+    }
+    return nullptr;
+}
 
-        // Unlike in pull_next_runnable_thread() we don't want to fall back to
-        // the idle thread. We just want to see if we have any other thread ready
-        // to be scheduled.
-        return nullptr;
+Thread* ProcessorReadyQueues::take_runnable_thread(u32 affinity_mask)
+{
+    return ready_queues.with([&](auto& queues) -> Thread* {
+        return find_runnable_thread(queues, affinity_mask, [&](Thread& thread, ThreadReadyQueue& ready_queue, u32 priority) {
+            thread.m_runnable_priority = -1;
+            thread.m_runnable_cpu = -1;
+            ready_queue.thread_list.remove(thread);
+            if (ready_queue.thread_list.is_empty())
+                queues.mask &= ~(1u << priority);
+            depth.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+            // Mark it as active because we are using this thread. This is similar
+            // to comparing it with Processor::current_thread, but when there are
+            // multiple processors there's no easy way to check whether the thread
+            // is actually still needed. This prevents accidental finalization when
+            // a thread is no longer in Running state, but running on another core.
+
+            // We need to mark it active here so that this thread won't be
+            // scheduled on another core if it were to be queued before actually
+            // switching to it.
+            // FIXME: Figure out a better way maybe?
+            thread.set_active(true);
+        });
     });
 }
 
-bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
+Thread* ProcessorReadyQueues::peek_runnable_thread(u32 affinity_mask)
 {
-    if (thread.is_idle_thread())
-        return true;
+    return ready_queues.with([&](auto& queues) -> Thread* {
+        return find_runnable_thread(queues, affinity_mask, [](auto&, auto&, auto) {});
+    });
+}
 
-    return g_ready_queues->with([&](auto& ready_queues) {
+void ProcessorReadyQueues::enqueue(Thread& thread, u32 priority, u32 cpu)
+{
+    ready_queues.with([&](auto& queues) {
+        VERIFY(thread.m_runnable_priority < 0);
+        VERIFY(thread.m_runnable_cpu < 0);
+        thread.m_runnable_priority = (int)priority;
+        thread.m_runnable_cpu = (int)cpu;
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        auto& ready_queue = queues.queues[priority];
+        bool was_empty = ready_queue.thread_list.is_empty();
+        ready_queue.thread_list.append(thread);
+        if (was_empty)
+            queues.mask |= (1u << priority);
+        depth.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    });
+}
+
+bool ProcessorReadyQueues::dequeue(Thread& thread, bool check_affinity)
+{
+    return ready_queues.with([&](auto& queues) {
+        // Another processor may have taken the thread off this queue since we looked at it.
         auto priority = thread.m_runnable_priority;
         if (priority < 0) {
             VERIFY(!thread.m_ready_queue_node.is_in_list());
@@ -150,33 +205,134 @@ bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
         if (check_affinity && !(thread.affinity() & (1 << Processor::current_id())))
             return false;
 
-        VERIFY(ready_queues.mask & (1u << priority));
-        auto& ready_queue = ready_queues.queues[priority];
+        VERIFY(queues.mask & (1u << priority));
+        auto& ready_queue = queues.queues[priority];
         thread.m_runnable_priority = -1;
+        thread.m_runnable_cpu = -1;
         ready_queue.thread_list.remove(thread);
         if (ready_queue.thread_list.is_empty())
-            ready_queues.mask &= ~(1u << priority);
+            queues.mask &= ~(1u << priority);
+        depth.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
         return true;
     });
 }
 
+template<typename Callback>
+static Thread* steal_from_other_processors(u32 cpu, Callback callback)
+{
+    // Try the most loaded processor first, then everyone else in order.
+    Optional<u32> busiest_cpu;
+    u32 busiest_depth = 0;
+    for (u32 victim = 0; victim < max_ready_queue_processors; ++victim) {
+        if (victim == cpu)
+            continue;
+        auto depth = ready_queues_for_processor(victim).depth.load(AK::MemoryOrder::memory_order_relaxed);
+        if (depth > busiest_depth) {
+            busiest_cpu = victim;
+            busiest_depth = depth;
+        }
+    }
+    if (!busiest_cpu.has_value())
+        return nullptr;
+
+    if (auto* thread = callback(*busiest_cpu))
+        return thread;
+
+    for (u32 victim = 0; victim < max_ready_queue_processors; ++victim) {
+        if (victim == cpu || victim == *busiest_cpu)
+            continue;
+        if (ready_queues_for_processor(victim).depth.load(AK::MemoryOrder::memory_order_relaxed) == 0)
+            continue;
+        if (auto* thread = callback(victim))
+            return thread;
+    }
+    return nullptr;
+}
+
+Thread& Scheduler::pull_next_runnable_thread()
+{
+    auto cpu = Processor::current_id();
+    auto affinity_mask = 1u << cpu;
+
+    auto& local_queues = ready_queues_for_processor(cpu);
+    if (auto* thread = local_queues.take_runnable_thread(affinity_mask))
+        return *thread;
+
+    // Our own queue is empty, see if there is work queued up on another processor.
+    auto* stolen_thread = steal_from_other_processors(cpu, [&](u32 victim) -> Thread* {
+        auto& victim_queues = ready_queues_for_processor(victim);
+        auto* thread = victim_queues.take_runnable_thread(affinity_mask);
+        if (thread) {
+            dbgln_if(SCHEDULER_DEBUG, "Scheduler[{}]: Stole {} from processor {}", cpu, *thread, victim);
+            victim_queues.lost_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            local_queues.stolen_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        }
+        return thread;
+    });
+    if (stolen_thread)
+        return *stolen_thread;
+
+    auto* idle_thread = Processor::idle_thread();
+    idle_thread->set_active(true);
+    return *idle_thread;
+}
+
+Thread* Scheduler::peek_next_runnable_thread()
+{
+    auto cpu = Processor::current_id();
+    auto affinity_mask = 1u << cpu;
+
+    // Unlike in pull_next_runnable_thread() we don't want to fall back to
+    // the idle thread. We just want to see if we have any other thread ready
+    // to be scheduled, either locally or by stealing it.
+    if (auto* thread = ready_queues_for_processor(cpu).peek_runnable_thread(affinity_mask))
+        return thread;
+
+    return steal_from_other_processors(cpu, [&](u32 victim) {
+        return ready_queues_for_processor(victim).peek_runnable_thread(affinity_mask);
+    });
+}
+
+bool Scheduler::dequeue_runnable_thread(Thread& thread, bool check_affinity)
+{
+    if (thread.is_idle_thread())
+        return true;
+
+    auto cpu = thread.m_runnable_cpu.load(AK::MemoryOrder::memory_order_relaxed);
+    if (cpu < 0) {
+        VERIFY(thread.m_runnable_priority < 0);
+        VERIFY(!thread.m_ready_queue_node.is_in_list());
+        return false;
+    }
+
+    return ready_queues_for_processor(cpu).dequeue(thread, check_affinity);
+}
+
 void Scheduler::enqueue_runnable_thread(Thread& thread)
 {
     VERIFY(g_scheduler_lock.is_locked_by_current_processor());
     if (thread.is_idle_thread())
         return;
     auto priority = thread_priority_to_priority_index(thread.priority());
+    auto cpu = select_processor_for(thread);
 
-    g_ready_queues->with([&](auto& ready_queues) {
-        VERIFY(thread.m_runnable_priority < 0);
-        thread.m_runnable_priority = (int)priority;
-        VERIFY(!thread.m_ready_queue_node.is_in_list());
-        auto& ready_queue = ready_queues.queues[priority];
-        bool was_empty = ready_queue.thread_list.is_empty();
-        ready_queue.thread_list.append(thread);
-        if (was_empty)
-            ready_queues.mask |= (1u << priority);
-    });
+    ready_queues_for_processor(cpu).enqueue(thread, priority, cpu);
+}
+
+ErrorOr<void> Scheduler::try_for_each_ready_queue(Function<ErrorOr<void>(ReadyQueueStatistics const&)> callback)
+{
+    auto processor_count = min(max(Processor::count(), 1u), max_ready_queue_processors);
+    for (u32 cpu = 0; cpu < processor_count; ++cpu) {
+        auto& processor_queues = ready_queues_for_processor(cpu);
+        ReadyQueueStatistics statistics {
+            .processor = cpu,
+            .depth = processor_queues.depth.load(AK::MemoryOrder::memory_order_relaxed),
+            .stolen_count = processor_queues.stolen_count.load(AK::MemoryOrder::memory_order_relaxed),
+            .lost_count = processor_queues.lost_count.load(AK::MemoryOrder::memory_order_relaxed),
+        };
+        TRY(callback(statistics));
+    }
+    return {};
 }
 
 UNMAP_AFTER_INIT void Scheduler::start()
@@ -218,13 +374,29 @@ ScheduleResult Scheduler::pick_next()
             Processor::set_current_in_scheduler(false);
         });
 
+    // Picking (or stealing) the next thread only takes the lock of the ready queue it comes from,
+    // so processors looking for work don't contend on g_scheduler_lock.
+    auto* next_thread = &pull_next_runnable_thread();
+
     SpinlockLocker lock(g_scheduler_lock);
 
     if constexpr (SCHEDULER_RUNNABLE_DEBUG) {
         dump_thread_list();
     }
 
-    auto& thread_to_schedule = pull_next_runnable_thread();
+    // We didn't hold the scheduler lock while picking the thread, so it may have been killed,
+    // or had its affinity changed, in the meantime. Hand it back and pick another one.
+    while (!next_thread->is_idle_thread()
+        && (next_thread->state() != Thread::State::Runnable || !(next_thread->affinity() & (1u << Processor::current_id())))) {
+        next_thread->set_active(false);
+        if (next_thread->state() == Thread::State::Runnable)
+            enqueue_runnable_thread(*next_thread);
+        else if (next_thread->state() == Thread::State::Dying)
+            notify_finalizer();
+        next_thread = &pull_next_runnable_thread();
+    }
+
+    auto& thread_to_schedule = *next_thread;
     if constexpr (SCHEDULER_DEBUG) {
         dbgln("Scheduler[{}]: Switch to {} @ {:p}",
             Processor::current_id(),
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Assertions.h>
+#include <AK/Error.h>
 #include <AK/Function.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Types.h>
@@ -30,6 +31,13 @@ struct TotalTimeScheduled {
     u64 total_kernel { 0 };
 };
 
+struct ReadyQueueStatistics {
+    u32 processor { 0 };
+    u32 depth { 0 };
+    u64 stolen_count { 0 };
+    u64 lost_count { 0 };
+};
+
 enum class ScheduleResult {
     Success,
     NoRunnableThreadFound,
@@ -68,6 +76,7 @@ public:
     static bool is_initialized();
     static TotalTimeScheduled get_total_time_scheduled();
     static void add_time_scheduled(u64, bool);
+    static ErrorOr<void> try_for_each_ready_queue(Function<ErrorOr<void>(ReadyQueueStatistics const&)>);
 };
 
 }
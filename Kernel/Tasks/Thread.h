@@ -64,6 +64,7 @@ class Thread
     friend class Process;
     friend class Scheduler;
     friend struct ThreadReadyQueue;
+    friend struct ProcessorReadyQueues;
 
 public:
     static Thread* current()
@@ -781,6 +782,17 @@ public:
     u32 affinity() const { return m_cpu_affinity; }
     void set_affinity(u32 affinity) { m_cpu_affinity = affinity; }
 
+    // A soft preference for the processor whose ready queue this thread should be placed on.
+    // Unlike the affinity mask this is only a hint; idle processors may still steal the thread.
+    Optional<u32> preferred_cpu() const
+    {
+        auto cpu = m_preferred_cpu.load(AK::MemoryOrder::memory_order_relaxed);
+        if (cpu < 0)
+            return {};
+        return static_cast<u32>(cpu);
+    }
+    void set_preferred_cpu(Optional<u32> cpu) { m_preferred_cpu.store(cpu.has_value() ? static_cast<int>(*cpu) : -1, AK::MemoryOrder::memory_order_relaxed); }
+
     RegisterState& get_register_dump_from_stack();
     RegisterState const& get_register_dump_from_stack() const { return const_cast<Thread*>(this)->get_register_dump_from_stack(); }
 
@@ -1100,6 +1112,7 @@ private:
 
     IntrusiveListNode<Thread> m_process_thread_list_node;
     int m_runnable_priority { -1 };
+    Atomic<int> m_runnable_cpu { -1 };
 
     friend class DeprecatedWaitQueue;
 
@@ -1174,6 +1187,7 @@ private:
     IntrusiveListNode<Thread> m_ready_queue_node;
     Atomic<u32> m_cpu { 0 };
     u32 m_cpu_affinity { THREAD_AFFINITY_DEFAULT };
+    Atomic<int> m_preferred_cpu { -1 };
     Optional<u64> m_last_time_scheduled;
     Atomic<u64> m_total_time_scheduled_user { 0 };
     Atomic<u64> m_total_time_scheduled_kernel { 0 };
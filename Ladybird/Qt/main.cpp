@@ -168,7 +168,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     // FIXME: Create an abstraction to re-spawn the RequestServer and re-hook up its client hooks to each tab on crash
     auto request_server_paths = TRY(get_paths_for_helper_process("RequestServer"sv));
-    auto protocol_client = TRY(launch_request_server_process(request_server_paths, s_serenity_resource_root, certificates));
+    auto protocol_client = TRY(launch_request_server_process(request_server_paths, s_serenity_resource_root, certificates, enable_http_cache ? Ladybird::EnableHTTPCache::Yes : Ladybird::EnableHTTPCache::No));
     app.request_server_client = move(protocol_client);
 
     StringBuilder command_line_builder;
@@ -10,12 +10,14 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <LibTLS/Certificate.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/GeminiProtocol.h>
 #include <RequestServer/HttpProtocol.h>
 #include <RequestServer/HttpsProtocol.h>
@@ -39,11 +41,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     StringView serenity_resource_root;
     Vector<ByteString> certificates;
     StringView mach_server_name;
+    bool enable_http_disk_cache = false;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(serenity_resource_root, "Absolute path to directory for serenity resources", "serenity-resource-root", 'r', "serenity-resource-root");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
+    args_parser.add_option(enable_http_disk_cache, "Enable HTTP disk cache", "enable-http-disk-cache");
     args_parser.parse(arguments);
 
     // Ensure the certificates are read out here.
@@ -59,6 +63,12 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         Core::Platform::register_with_mach_server(mach_server_name);
 #endif
 
+    if (enable_http_disk_cache) {
+        auto cache_directory = ByteString::formatted("{}/Ladybird/HTTPCache", Core::StandardPaths::cache_directory());
+        if (auto result = RequestServer::DiskCache::enable(move(cache_directory)); result.is_error())
+            warnln("Unable to enable the HTTP disk cache: {}", result.error());
+    }
+
     RequestServer::GeminiProtocol::install();
     RequestServer::HttpProtocol::install();
     RequestServer::HttpsProtocol::install();
@@ -105,6 +105,7 @@ set(JPEG2000_DEBUG ON)
 set(JPEGXL_DEBUG ON)
 set(JPEG_DEBUG ON)
 set(JS_BYTECODE_DEBUG ON)
+set(JS_JIT_DEBUG ON)
 set(JS_MODULE_DEBUG ON)
 set(KEYBOARD_DEBUG ON)
 set(KEYBOARD_SHORTCUTS_DEBUG ON)
@@ -62,6 +62,32 @@ TEST_CASE(canonical_code_complex)
         EXPECT_EQ(TRY_OR_FAIL(huffman.read_symbol(bit_stream)), output_byte);
 }
 
+TEST_CASE(canonical_code_long_codes)
+{
+    // Codes of every length up to 15 bits, so that symbols are decoded from both levels of the lookup table.
+    Array<u8, 16> const code {
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 15
+    };
+    Array<u32, 20> const symbols {
+        15, 0, 14, 9, 10, 1, 2, 13, 11, 12, 15, 15, 3, 8, 7, 4, 5, 6, 0, 14
+    };
+
+    auto const huffman = TRY_OR_FAIL(Compress::CanonicalCode::from_bytes(code));
+
+    AllocatingMemoryStream encoded;
+    {
+        LittleEndianOutputBitStream bit_stream { MaybeOwned<Stream>(encoded) };
+        for (auto symbol : symbols)
+            TRY_OR_FAIL(huffman.write_symbol(bit_stream, symbol));
+        TRY_OR_FAIL(bit_stream.align_to_byte_boundary());
+        TRY_OR_FAIL(bit_stream.flush_buffer_to_stream());
+    }
+
+    LittleEndianInputBitStream bit_stream { MaybeOwned<Stream>(encoded) };
+    for (auto symbol : symbols)
+        EXPECT_EQ(TRY_OR_FAIL(huffman.read_symbol(bit_stream)), symbol);
+}
+
 TEST_CASE(invalid_canonical_code)
 {
     Array<u8, 257> code;
@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/Array.h>
+#include <AK/MemoryStream.h>
 #include <AK/Random.h>
 #include <LibCompress/Gzip.h>
 
@@ -94,6 +95,26 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_parallel_round_trip)
+{
+    // Repeat a block of the maximum back reference distance, so every chunk can only be compressed by referring to the data before it.
+    auto pattern = ByteBuffer::create_uninitialized(32 * KiB).release_value();
+    fill_with_random(pattern);
+    ByteBuffer original;
+    for (size_t i = 0; i < 10; ++i)
+        original.append(pattern);
+
+    FixedMemoryStream input { original.bytes() };
+    AllocatingMemoryStream output;
+    TRY_OR_FAIL(Compress::GzipCompressor::compress_in_parallel(input, output, 4));
+
+    auto compressed = TRY_OR_FAIL(output.read_until_eof());
+    EXPECT(compressed.size() < 2 * pattern.size());
+
+    auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
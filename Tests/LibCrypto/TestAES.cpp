@@ -306,6 +306,35 @@ TEST_CASE(test_AES_CTR_256bit_encrypt_36bytes_with_high_counter)
     test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(out));
 }
 
+TEST_CASE(test_AES_CTR_many_blocks_match_single_blocks)
+{
+    // Longer than the batch of blocks CTR encrypts at once, and not a whole number of blocks.
+    u8 key[16];
+    u8 ivec[16];
+    u8 in[300];
+    for (size_t i = 0; i < sizeof(key); ++i)
+        key[i] = i * 11 + 1;
+    for (size_t i = 0; i < sizeof(ivec); ++i)
+        ivec[i] = 0xff - (i == 0);
+    for (size_t i = 0; i < sizeof(in); ++i)
+        in[i] = i * 7 + 2;
+
+    Crypto::Cipher::AESCipher cipher(ReadonlyBytes { key, sizeof(key) }, 128);
+    u8 expected[sizeof(in)];
+    u8 counter[16];
+    memcpy(counter, ivec, sizeof(counter));
+    for (size_t offset = 0; offset < sizeof(in); offset += 16) {
+        Crypto::Cipher::AESCipherBlock block(counter, sizeof(counter));
+        cipher.encrypt_block(block, block);
+        for (size_t i = 0; i < 16 && offset + i < sizeof(in); ++i)
+            expected[offset + i] = in[offset + i] ^ block.bytes()[i];
+        Bytes counter_bytes { counter, sizeof(counter) };
+        Crypto::Cipher::IncrementInplace {}(counter_bytes);
+    }
+
+    test_aes_ctr_encrypt(AS_BB(key), AS_BB(ivec), AS_BB(in), AS_BB(expected));
+}
+
 static auto test_aes_ctr_decrypt = [](auto key, auto ivec, auto in, auto out_expected) {
     // nonce is already included in ivec.
     Crypto::Cipher::AESCipher::CTRMode cipher(key, 8 * key.size(), Crypto::Cipher::Intent::Decryption);
@@ -201,6 +201,36 @@ TEST_CASE(test_unsigned_bigint_multiplication_with_big_numbers2)
     EXPECT_EQ(result.words(), expected_result);
 }
 
+TEST_CASE(test_unsigned_bigint_karatsuba_multiplication)
+{
+    // These are long enough to be split in halves, and the longer one into pieces as long as the shorter one.
+    auto one = Crypto::UnsignedBigInteger(1);
+    auto num1 = one.shift_left(3200).minus(one);
+    auto num2 = one.shift_left(2048).minus(one);
+
+    auto expected_product = one.shift_left(5248).minus(one.shift_left(3200)).minus(one.shift_left(2048)).plus(one);
+    EXPECT_EQ(num1.multiplied_by(num2), expected_product);
+    EXPECT_EQ(num2.multiplied_by(num1), expected_product);
+
+    auto expected_square = one.shift_left(6400).minus(one.shift_left(3201)).plus(one);
+    EXPECT_EQ(num1.multiplied_by(num1), expected_square);
+}
+
+TEST_CASE(test_unsigned_bigint_squaring_matches_multiplication)
+{
+    auto num1 = bigint_fibonacci(5000);
+    auto num2 = num1;
+    auto num3 = bigint_fibonacci(4000);
+
+    auto square = num1.multiplied_by(num1);
+    EXPECT_EQ(square, num1.multiplied_by(num2));
+
+    auto product = num1.multiplied_by(num3);
+    auto division_result = product.divided_by(num3);
+    EXPECT_EQ(division_result.quotient, num1);
+    EXPECT_EQ(division_result.remainder, Crypto::UnsignedBigInteger(0));
+}
+
 TEST_CASE(test_unsigned_bigint_simple_division)
 {
     Crypto::UnsignedBigInteger num1(27194);
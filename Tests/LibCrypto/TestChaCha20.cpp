@@ -138,3 +138,25 @@ TEST_CASE(test_vector_3)
 
     test_chacha20(key, nonce, initial_block_counter, plaintext, ciphertext);
 }
+
+TEST_CASE(test_many_blocks_match_single_blocks)
+{
+    // Long enough to use every batch size, with the block counter carrying into the nonce in the middle of a batch.
+    Array<u8, 32> key;
+    for (size_t i = 0; i < key.size(); ++i)
+        key[i] = i * 13 + 5;
+    Array<u8, 8> nonce { 1, 2, 3, 4, 5, 6, 7, 8 };
+    u32 initial_block_counter { 0xfffffffa };
+    Array<u8, 13 * 64 + 5> plaintext;
+    for (size_t i = 0; i < plaintext.size(); ++i)
+        plaintext[i] = i * 7 + 2;
+
+    Array<u8, plaintext.size()> ciphertext;
+    Crypto::Cipher::ChaCha20 cipher(key, nonce, initial_block_counter);
+    for (size_t offset = 0; offset < plaintext.size(); offset += 64) {
+        auto length = min<size_t>(64, plaintext.size() - offset);
+        cipher.encrypt(plaintext.span().slice(offset, length), ciphertext.span().slice(offset, length));
+    }
+
+    test_chacha20(key, nonce, initial_block_counter, plaintext, ciphertext);
+}
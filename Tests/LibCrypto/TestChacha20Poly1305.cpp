@@ -207,3 +207,29 @@ TEST_CASE(test_aead_encrypt_and_decrypt)
     EXPECT(Crypto::AEAD::ChaCha20Poly1305::verify_tag(encrypted, decrypted));
     EXPECT_EQ(decrypted.bytes().slice(0, encrypted.bytes().size() - 16), plaintext.bytes());
 }
+
+TEST_CASE(test_aead_block_aligned_lengths)
+{
+    // No padding goes into the tag when the AAD and the ciphertext are a whole number of 16-byte blocks.
+    u8 aad[16] = { 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e, 0x5f };
+    u8 key[32] = {
+        0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+        0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f
+    };
+    u8 nonce[12] = { 0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47 };
+    u8 plaintext[1024];
+    for (size_t i = 0; i < sizeof(plaintext); ++i)
+        plaintext[i] = i * 7 + 2;
+    u8 expected_tag[16] = {
+        0x3c, 0x98, 0xed, 0x92, 0x21, 0x43, 0x64, 0x2d, 0x6e, 0xb1, 0xde, 0x3b, 0x0c, 0x0d, 0x2c, 0x3f
+    };
+
+    Crypto::AEAD::ChaCha20Poly1305 aead(ReadonlyBytes { key, 32 }, ReadonlyBytes { nonce, 12 });
+    auto encrypted = MUST(aead.encrypt(ReadonlyBytes { aad, 16 }, ReadonlyBytes { plaintext, sizeof(plaintext) }));
+    EXPECT_EQ(encrypted.size(), sizeof(plaintext) + 16);
+    EXPECT_EQ(encrypted.bytes().slice_from_end(16), ReadonlyBytes(expected_tag, 16));
+
+    auto decrypted = MUST(aead.decrypt(ReadonlyBytes { aad, 16 }, encrypted.bytes().slice(0, sizeof(plaintext))));
+    EXPECT(Crypto::AEAD::ChaCha20Poly1305::verify_tag(encrypted, decrypted));
+    EXPECT_EQ(decrypted.bytes().slice(0, sizeof(plaintext)), ReadonlyBytes(plaintext, sizeof(plaintext)));
+}
@@ -64,3 +64,14 @@ TEST_CASE(test_crc32)
     do_test("The quick brown fox jumps over the lazy dog"sv.bytes(), 0x414FA339);
     do_test("various CRC algorithms input data"sv.bytes(), 0x9BD366AE);
 }
+
+TEST_CASE(test_crc32_combine)
+{
+    auto input = "The quick brown fox jumps over the lazy dog"sv.bytes();
+
+    for (size_t split = 0; split <= input.size(); ++split) {
+        auto first = Crypto::Checksum::CRC32(input.trim(split)).digest();
+        auto second = Crypto::Checksum::CRC32(input.slice(split)).digest();
+        EXPECT_EQ(Crypto::Checksum::CRC32::combine(first, second, input.size() - split), 0x414FA339u);
+    }
+}
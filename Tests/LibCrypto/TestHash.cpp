@@ -325,3 +325,53 @@ TEST_CASE(test_ghash_galois_field_multiply2)
     Crypto::Authentication::galois_multiply(z, x, y);
     EXPECT(memcmp(result, z, 4 * sizeof(u32)) == 0);
 }
+
+TEST_CASE(test_ghash_multiple_blocks_match_galois_field_multiply)
+{
+    // Long enough for GHash to fold several blocks into the tag at once, and not a whole number of blocks.
+    u8 key[16];
+    u8 aad[37];
+    u8 cipher[301];
+    for (size_t i = 0; i < sizeof(key); ++i)
+        key[i] = i * 17 + 3;
+    for (size_t i = 0; i < sizeof(aad); ++i)
+        aad[i] = i * 29 + 7;
+    for (size_t i = 0; i < sizeof(cipher); ++i)
+        cipher[i] = i * 13 + 5;
+
+    auto load_block = [](u8 const* data, size_t size, u32 (&block)[4]) {
+        u8 padded[16] {};
+        memcpy(padded, data, min(size, sizeof(padded)));
+        for (size_t i = 0; i < 4; ++i)
+            block[i] = AK::convert_between_host_and_big_endian(ByteReader::load32(padded + i * 4));
+    };
+
+    u32 h[4];
+    load_block(key, sizeof(key), h);
+
+    u32 expected[4] { 0, 0, 0, 0 };
+    auto add_block = [&](u32 const (&block)[4]) {
+        for (size_t i = 0; i < 4; ++i)
+            expected[i] ^= block[i];
+        Crypto::Authentication::galois_multiply(expected, h, expected);
+    };
+    auto add_data = [&](u8 const* data, size_t size) {
+        for (size_t offset = 0; offset < size; offset += 16) {
+            u32 block[4];
+            load_block(data + offset, size - offset, block);
+            add_block(block);
+        }
+    };
+    add_data(aad, sizeof(aad));
+    add_data(cipher, sizeof(cipher));
+    u32 lengths[4] { 0, 8 * sizeof(aad), 0, 8 * sizeof(cipher) };
+    add_block(lengths);
+
+    u8 expected_bytes[16];
+    for (size_t i = 0; i < 4; ++i)
+        ByteReader::store(expected_bytes + i * 4, AK::convert_between_host_and_big_endian(expected[i]));
+
+    Crypto::Authentication::GHash ghash(ReadonlyBytes { key, sizeof(key) });
+    auto tag = ghash.process({ aad, sizeof(aad) }, { cipher, sizeof(cipher) });
+    EXPECT(memcmp(expected_bytes, tag.data, sizeof(expected_bytes)) == 0);
+}
@@ -1429,6 +1429,55 @@ TEST_CASE(test_png)
     TRY_OR_FAIL(expect_single_frame(*plugin_decoder));
 }
 
+TEST_CASE(test_png_partial_frames)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/buggie.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+
+    int next_expected_y = 0;
+    plugin_decoder->set_partial_frame_callback([&](Gfx::Bitmap const& bitmap, Gfx::IntRect const& rect) {
+        EXPECT_EQ(rect.y(), next_expected_y);
+        EXPECT_EQ(rect.width(), bitmap.width());
+        next_expected_y = rect.bottom();
+    });
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(next_expected_y, frame.image->height());
+}
+
+TEST_CASE(test_png_interlaced_partial_frames)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/interlaced.png"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+
+    int next_expected_y = 0;
+    RefPtr<Gfx::Bitmap> reported_pixels;
+    plugin_decoder->set_partial_frame_callback([&](Gfx::Bitmap const& bitmap, Gfx::IntRect const& rect) {
+        EXPECT_EQ(rect.y(), next_expected_y);
+        EXPECT_EQ(rect.width(), bitmap.width());
+        next_expected_y = rect.bottom();
+
+        if (!reported_pixels)
+            reported_pixels = MUST(Gfx::Bitmap::create(bitmap.format(), bitmap.size()));
+        for (int y = rect.top(); y < rect.bottom(); ++y) {
+            for (int x = rect.left(); x < rect.right(); ++x)
+                reported_pixels->set_pixel(x, y, bitmap.get_pixel(x, y));
+        }
+    });
+
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(45, 75));
+    EXPECT_EQ(next_expected_y, frame.image->height());
+
+    // Pixels must not change anymore once they have been reported.
+    for (int y = 0; y < frame.image->height(); ++y) {
+        for (int x = 0; x < frame.image->width(); ++x) {
+            EXPECT_EQ(reported_pixels->get_pixel(x, y), frame.image->get_pixel(x, y));
+            EXPECT_EQ(frame.image->get_pixel(x, y), Gfx::Color((x * 5) & 0xff, (y * 3) & 0xff, 128));
+        }
+    }
+}
+
 TEST_CASE(test_exif)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("png/exif.png"sv)));
@@ -1220,3 +1220,49 @@ TEST_CASE(mismatching_brackets)
         EXPECT_EQ(re.parser_result.error, regex::Error::MismatchingBracket);
     }
 }
+
+TEST_CASE(lazy_dfa_matches_backtracking_results)
+{
+    {
+        // Alternation priority and lazy quantifiers decide the match end, not the longest match.
+        Regex<ECMA262> re("(?:a|ab)(?:c|bcd)"sv);
+        auto result = re.match("abcd"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "abcd"sv);
+    }
+    {
+        Regex<ECMA262> re("a+?b*?"sv, ECMAScriptFlags::Global);
+        auto result = re.match("aab"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 2u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "a"sv);
+        EXPECT_EQ(result.matches[1].view.to_byte_string(), "a"sv);
+    }
+    {
+        Regex<ECMA262> re("\\bfo+\\b"sv, ECMAScriptFlags::Global);
+        auto result = re.match("foo xfoo fooo"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.size(), 2u);
+        EXPECT_EQ(result.matches[0].view.to_byte_string(), "foo"sv);
+        EXPECT_EQ(result.matches[1].view.to_byte_string(), "fooo"sv);
+        EXPECT_EQ(result.matches[1].global_offset, 9u);
+    }
+    {
+        Regex<ECMA262> re("^(?:x|y)+$"sv);
+        EXPECT_EQ(re.has_match("xyyx"sv), true);
+        EXPECT_EQ(re.has_match("xyzx"sv), false);
+    }
+    {
+        // Capture groups still come from the VM once the DFA found a match.
+        Regex<ECMA262> re("[a-z]+(ing)"sv, ECMAScriptFlags::Global);
+        auto result = re.match("some searching"sv);
+        EXPECT_EQ(result.success, true);
+        EXPECT_EQ(result.matches.first().view.to_byte_string(), "searching"sv);
+        EXPECT_EQ(result.capture_group_matches.first()[0].view.to_byte_string(), "ing"sv);
+    }
+    {
+        // Without the DFA, this takes exponential time to backtrack.
+        Regex<ECMA262> re("^(?:a|aa)*c"sv);
+        EXPECT_EQ(re.has_match("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab"sv), false);
+    }
+}
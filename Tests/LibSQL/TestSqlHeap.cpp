@@ -192,3 +192,109 @@ TEST_CASE(heap_free_storage)
     auto new_heap_size = MUST(heap->file_size_in_bytes());
     EXPECT(new_heap_size <= heap_size);
 }
+
+TEST_CASE(heap_page_cache)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    auto storage_block_id = heap->request_new_block_index();
+
+    // Write large storage spanning multiple blocks
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE * 4));
+    auto long_string = builder.string_view();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, long_string.bytes()));
+    MUST(heap->flush());
+
+    // Written back blocks stay cached, so reading them back doesn't need to go to the file
+    auto misses = heap->page_cache_misses();
+    auto stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    EXPECT_EQ(heap->page_cache_misses(), misses);
+    EXPECT(heap->page_cache_hits() >= 4u);
+
+    // Shrinking the cache evicts blocks, which are then read from the file again
+    heap->set_page_cache_capacity(2);
+    EXPECT_EQ(heap->page_cache_size(), 2u);
+    stored_long_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(long_string.bytes(), stored_long_string.bytes());
+    EXPECT(heap->page_cache_misses() > misses);
+    EXPECT_EQ(heap->page_cache_size(), 2u);
+}
+
+TEST_CASE(heap_group_commit)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    heap->set_group_commit_size(3);
+    MUST(heap->flush());
+    auto heap_size = MUST(heap->file_size_in_bytes());
+
+    StringBuilder builder;
+    MUST(builder.try_append_repeated('x', SQL::Block::DATA_SIZE));
+    auto string = builder.string_view();
+
+    // The first two commits are held back
+    for (auto i = 0; i < 2; ++i) {
+        TRY_OR_FAIL(heap->write_storage(heap->request_new_block_index(), string.bytes()));
+        MUST(heap->commit());
+        EXPECT(heap->has_pending_commits());
+        EXPECT_EQ(MUST(heap->file_size_in_bytes()), heap_size);
+    }
+
+    // ...and written back together with the third one
+    auto storage_block_id = heap->request_new_block_index();
+    TRY_OR_FAIL(heap->write_storage(storage_block_id, string.bytes()));
+    MUST(heap->commit());
+    EXPECT(!heap->has_pending_commits());
+    EXPECT_EQ(MUST(heap->file_size_in_bytes()), heap_size + 3 * SQL::Block::SIZE);
+
+    auto stored_string = TRY_OR_FAIL(heap->read_storage(storage_block_id));
+    EXPECT_EQ(string.bytes(), stored_string.bytes());
+
+    // Committing without any changes doesn't count towards the group
+    MUST(heap->commit());
+    EXPECT(!heap->has_pending_commits());
+}
+
+TEST_CASE(heap_when_written_back)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    auto heap = create_heap();
+    heap->set_group_commit_size(2);
+    heap->set_sync_policy(SQL::Heap::SyncPolicy::OnWriteBack);
+
+    // Nothing is pending, so there is nothing to wait for
+    auto written_back = false;
+    heap->when_written_back([&](ErrorOr<void> result) { written_back = !result.is_error(); });
+    EXPECT(written_back);
+
+    // A held back commit is only reported once it has been written back together with the rest of its group
+    TRY_OR_FAIL(heap->write_storage(heap->request_new_block_index(), "first"sv.bytes()));
+    MUST(heap->commit());
+    written_back = false;
+    heap->when_written_back([&](ErrorOr<void> result) { written_back = !result.is_error(); });
+    EXPECT(!written_back);
+
+    TRY_OR_FAIL(heap->write_storage(heap->request_new_block_index(), "second"sv.bytes()));
+    MUST(heap->commit());
+    EXPECT(written_back);
+    EXPECT(!heap->has_pending_commits());
+}
+
+TEST_CASE(heap_sync_on_write_back)
+{
+    ScopeGuard guard([]() { MUST(Core::System::unlink(db_path)); });
+    {
+        auto heap = create_heap();
+        heap->set_sync_policy(SQL::Heap::SyncPolicy::OnWriteBack);
+        TRY_OR_FAIL(heap->write_storage(heap->request_new_block_index(), "data"sv.bytes()));
+        MUST(heap->commit());
+        EXPECT(!heap->has_pending_commits());
+    }
+    {
+        auto heap = create_heap();
+        auto stored_data = TRY_OR_FAIL(heap->read_storage(1));
+        EXPECT_EQ(StringView { stored_data.bytes() }, "data"sv);
+    }
+}
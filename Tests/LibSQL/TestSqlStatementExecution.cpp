@@ -384,6 +384,90 @@ TEST_CASE(select_inner_join)
     EXPECT_EQ(result[0].row[2].to_byte_string(), "Test_12");
 }
 
+TEST_CASE(select_inner_join_with_pushed_down_predicate)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+    auto result = execute(database,
+        "INSERT INTO TestSchema.TestTable1 ( TextColumn1, IntColumn ) VALUES "
+        "( 'Test_1', 42 ), "
+        "( 'Test_2', 43 ), "
+        "( 'Test_3', 44 ), "
+        "( 'Test_4', 42 );");
+    EXPECT(result.size() == 4);
+    result = execute(database,
+        "INSERT INTO TestSchema.TestTable2 ( TextColumn2, IntColumn ) VALUES "
+        "( 'Test_10', 42 ), "
+        "( 'Test_11', 43 ), "
+        "( 'Test_12', 42 ), "
+        "( 'Test_13', 47 );");
+    EXPECT(result.size() == 4);
+
+    result = execute(database,
+        "SELECT TestTable1.IntColumn, TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE TestTable1.IntColumn = TestTable2.IntColumn "
+        "ORDER BY TextColumn1, TextColumn2;");
+    EXPECT_EQ(result.size(), 5u);
+
+    result = execute(database,
+        "SELECT TestTable1.IntColumn, TextColumn1, TextColumn2 "
+        "FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+        "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND (TextColumn2 != 'Test_12') "
+        "ORDER BY TextColumn1, TextColumn2;");
+    EXPECT_EQ(result.size(), 3u);
+
+    auto expect_row = [&](size_t index, i32 int_column, StringView text_column1, StringView text_column2) {
+        EXPECT_EQ(result[index].row[0].to_int<i32>(), int_column);
+        EXPECT_EQ(result[index].row[1].to_byte_string(), text_column1);
+        EXPECT_EQ(result[index].row[2].to_byte_string(), text_column2);
+    };
+    expect_row(0, 42, "Test_1"sv, "Test_10"sv);
+    expect_row(1, 43, "Test_2"sv, "Test_11"sv);
+    expect_row(2, 42, "Test_4"sv, "Test_10"sv);
+}
+
+TEST_CASE(explain_select)
+{
+    ScopeGuard guard([]() { unlink(db_name); });
+    auto database = MUST(SQL::Database::create(db_name));
+    MUST(database->open());
+    create_two_tables(database);
+
+    auto expect_plan = [&](ByteString const& sql, Vector<StringView> const& expected_plan) {
+        auto result = execute(database, sql);
+        EXPECT_EQ(result.command(), SQL::SQLCommand::Explain);
+        EXPECT_EQ(result.size(), expected_plan.size());
+
+        for (size_t i = 0; i < min(result.size(), expected_plan.size()); ++i)
+            EXPECT_EQ(result[i].row[0].to_byte_string(), expected_plan[i]);
+    };
+
+    expect_plan("EXPLAIN SELECT * FROM TestSchema.TestTable1;",
+        { "SCAN TESTSCHEMA.TESTTABLE1"sv });
+
+    expect_plan("EXPLAIN SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2;",
+        { "SCAN TESTSCHEMA.TESTTABLE1"sv, "NESTED LOOP JOIN TESTSCHEMA.TESTTABLE2"sv });
+
+    expect_plan("EXPLAIN QUERY PLAN SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 "
+                "WHERE (TestTable1.IntColumn = TestTable2.IntColumn) AND (TextColumn2 != 'Test_12') AND (TextColumn1 < TextColumn2) AND (1 = 1);",
+        {
+            "SCAN TESTSCHEMA.TESTTABLE1"sv,
+            "HASH JOIN TESTSCHEMA.TESTTABLE2 ON TESTTABLE1.INTCOLUMN = TESTTABLE2.INTCOLUMN"sv,
+            "  PUSHED-DOWN PREDICATES: 1"sv,
+            "  JOIN PREDICATES: 1"sv,
+            "RESIDUAL PREDICATES: 1"sv,
+        });
+
+    expect_plan("EXPLAIN SELECT * FROM TestSchema.TestTable1, TestSchema.TestTable2 WHERE TextColumn1 = TextColumn2;",
+        {
+            "SCAN TESTSCHEMA.TESTTABLE1"sv,
+            "HASH JOIN TESTSCHEMA.TESTTABLE2 ON TESTTABLE1.TEXTCOLUMN1 = TESTTABLE2.TEXTCOLUMN2"sv,
+        });
+}
+
 TEST_CASE(select_with_like)
 {
     ScopeGuard guard([]() { unlink(db_name); });
@@ -783,3 +783,24 @@ TEST_CASE(describe_table)
     validate("DESCRIBE TABLE TableName;"sv, {}, "TABLENAME"sv);
     validate("DESCRIBE TABLE SchemaName.TableName;"sv, "SCHEMANAME"sv, "TABLENAME"sv);
 }
+
+TEST_CASE(explain)
+{
+    EXPECT(parse("EXPLAIN"sv).is_error());
+    EXPECT(parse("EXPLAIN;"sv).is_error());
+    EXPECT(parse("EXPLAIN QUERY SELECT * FROM table_name;"sv).is_error());
+    EXPECT(parse("EXPLAIN DELETE FROM table_name;"sv).is_error());
+
+    auto validate = [](StringView sql, StringView expected_table) {
+        auto statement = TRY_OR_FAIL(parse(sql));
+        EXPECT(is<SQL::AST::Explain>(*statement));
+
+        auto const& explain_statement = static_cast<const SQL::AST::Explain&>(*statement);
+        auto const& table_or_subquery_list = explain_statement.select_statement()->table_or_subquery_list();
+        EXPECT_EQ(table_or_subquery_list.size(), 1u);
+        EXPECT_EQ(table_or_subquery_list[0]->table_name(), expected_table);
+    };
+
+    validate("EXPLAIN SELECT * FROM TableName;"sv, "TABLENAME"sv);
+    validate("EXPLAIN QUERY PLAN SELECT * FROM TableName;"sv, "TABLENAME"sv);
+}
@@ -82,3 +82,62 @@ TEST_CASE(test_TLS_hello_handshake)
 
     loop.exec();
 }
+
+TEST_CASE(test_TLS_session_resumption)
+{
+    Core::EventLoop loop;
+    auto root_certificates = TRY_OR_FAIL(load_certificates());
+
+    Optional<TLS::Session> session;
+    {
+        TLS::Options options;
+        options.set_root_certificates(root_certificates);
+        options.set_new_session_handler([&](TLS::Session const& new_session) {
+            session = new_session;
+        });
+
+        auto tls = TRY_OR_FAIL(TLS::TLSv12::connect(DEFAULT_SERVER, port, move(options)));
+        EXPECT(tls->is_established());
+        EXPECT(!tls->is_resumed_session());
+    }
+
+    EXPECT(session.has_value());
+    EXPECT(!session->has_expired());
+
+    Optional<TLS::Session> resumed_session;
+    {
+        TLS::Options options;
+        options.set_root_certificates(root_certificates);
+        options.set_session_to_resume(session.value());
+        options.set_new_session_handler([&](TLS::Session const& new_session) {
+            resumed_session = new_session;
+        });
+
+        auto tls = TRY_OR_FAIL(TLS::TLSv12::connect(DEFAULT_SERVER, port, move(options)));
+        EXPECT(tls->is_established());
+        EXPECT(tls->is_resumed_session());
+    }
+
+    EXPECT(resumed_session.has_value());
+    EXPECT_EQ(resumed_session->master_key, session->master_key);
+
+    // The server may reissue the ticket when the session is resumed. The session then lives on for as long as the new
+    // ticket's lifetime hint says, otherwise it still expires when it would have before.
+    if (resumed_session->ticket != session->ticket)
+        EXPECT(resumed_session->expiry > session->expiry);
+    else
+        EXPECT_EQ(resumed_session->expiry, session->expiry);
+
+    // An expired session isn't offered to the server, so we get a full handshake.
+    session->expiry = UnixDateTime::now() - Duration::from_seconds(1);
+    EXPECT(session->has_expired());
+    {
+        TLS::Options options;
+        options.set_root_certificates(root_certificates);
+        options.set_session_to_resume(session.release_value());
+
+        auto tls = TRY_OR_FAIL(TLS::TLSv12::connect(DEFAULT_SERVER, port, move(options)));
+        EXPECT(tls->is_established());
+        EXPECT(!tls->is_resumed_session());
+    }
+}
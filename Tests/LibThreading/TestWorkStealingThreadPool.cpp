@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/WorkStealingThreadPool.h>
+
+TEST_CASE(submitted_tasks_all_run)
+{
+    Threading::WorkStealingThreadPool pool { 4 };
+    Atomic<size_t> counter { 0 };
+
+    for (size_t i = 0; i < 1000; ++i)
+        pool.submit([&counter] { counter.fetch_add(1); });
+    pool.wait_for_all();
+
+    EXPECT_EQ(counter.load(), 1000u);
+}
+
+TEST_CASE(tasks_can_submit_more_tasks)
+{
+    Threading::WorkStealingThreadPool pool { 4 };
+    Atomic<size_t> counter { 0 };
+
+    for (size_t i = 0; i < 100; ++i) {
+        pool.submit([&pool, &counter] {
+            for (size_t j = 0; j < 10; ++j)
+                pool.submit([&counter] { counter.fetch_add(1); });
+        });
+    }
+    pool.wait_for_all();
+
+    EXPECT_EQ(counter.load(), 1000u);
+}
+
+TEST_CASE(parallel_for_visits_every_item_once)
+{
+    Threading::WorkStealingThreadPool pool { 4 };
+    Vector<int> items;
+    for (int i = 0; i < 10000; ++i)
+        items.append(i);
+
+    pool.parallel_for(items.span(), [](int& item) { item *= 2; });
+
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(items[i], i * 2);
+}
+
+TEST_CASE(parallel_for_range_respects_grain_size)
+{
+    Threading::WorkStealingThreadPool pool { 4 };
+    Atomic<size_t> chunk_count { 0 };
+    Atomic<size_t> total { 0 };
+
+    pool.parallel_for_range(
+        100, [&](size_t begin, size_t end) {
+            chunk_count.fetch_add(1);
+            total.fetch_add(end - begin);
+        },
+        50);
+
+    EXPECT_EQ(chunk_count.load(), 2u);
+    EXPECT_EQ(total.load(), 100u);
+}
+
+TEST_CASE(parallel_reduce_sums_in_order)
+{
+    Threading::WorkStealingThreadPool pool { 4 };
+    Vector<u64> items;
+    for (u64 i = 1; i <= 100000; ++i)
+        items.append(i);
+
+    auto sum = pool.parallel_reduce(
+        items.span(), u64 { 0 }, [](u64 accumulator, u64 item) { return accumulator + item; }, [](u64 left, u64 right) { return left + right; });
+    EXPECT_EQ(sum, 100000ull * 100001ull / 2);
+
+    // Concatenation is associative but not commutative, so this checks that chunks are combined in order.
+    Vector<u64> small_items { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    auto digits = pool.parallel_reduce(
+        small_items.span(), u64 { 0 }, [](u64 accumulator, u64 item) { return accumulator * 10 + item; },
+        [](u64 left, u64 right) {
+            u64 scale = 1;
+            for (auto value = right; value > 0; value /= 10)
+                scale *= 10;
+            return left * scale + right;
+        });
+    EXPECT_EQ(digits, 123456789u);
+}
+
+TEST_CASE(nested_parallel_for_does_not_deadlock)
+{
+    Threading::WorkStealingThreadPool pool { 2 };
+    Atomic<size_t> counter { 0 };
+
+    pool.parallel_for_range(16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            pool.parallel_for_range(16, [&](size_t inner_begin, size_t inner_end) {
+                counter.fetch_add(inner_end - inner_begin);
+            });
+        }
+    });
+
+    EXPECT_EQ(counter.load(), 256u);
+}
+
+TEST_CASE(empty_ranges_do_nothing)
+{
+    Threading::WorkStealingThreadPool pool { 2 };
+    bool called = false;
+
+    pool.parallel_for_range(0, [&](size_t, size_t) { called = true; });
+    EXPECT(!called);
+
+    Vector<int> items;
+    auto sum = pool.parallel_reduce(items.span(), 42, [](int accumulator, int item) { return accumulator + item; }, [](int left, int right) { return left + right; });
+    EXPECT_EQ(sum, 42);
+}
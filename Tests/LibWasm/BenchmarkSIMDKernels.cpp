@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Random.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/SIMDKernels.h>
+
+using namespace Wasm::SIMDKernels;
+
+// Lane patterns the WebAssembly SIMD spec tests keep coming back to: zero, one, all ones, the signed and
+// unsigned limits of every lane width, and NaNs, infinities and negative zero for the float lanes.
+static constexpr u64 interesting_patterns[] = {
+    0x0000000000000000,
+    0x0101010101010101,
+    0xffffffffffffffff,
+    0x7f7f7f7f80808080,
+    0x7fff80007fff8000,
+    0x7fffffff80000000,
+    0x8000000000000000,
+    0x00ff00ff00ff00ff,
+    0x0001ffff8001fffe,
+    0x7fc000007f800000,
+    0xff80000080000000,
+    0x7ff8000000000000,
+    0x0f0e0d0c0b0a0908,
+    0x1f10ff8007060504,
+};
+
+static Vector<u128> make_inputs(size_t count)
+{
+    Vector<u128> inputs;
+    inputs.ensure_capacity(count);
+    for (auto low : interesting_patterns) {
+        for (auto high : interesting_patterns)
+            inputs.append(u128(low, high));
+    }
+    while (inputs.size() < count)
+        inputs.append(u128(get_random<u64>(), get_random<u64>()));
+    return inputs;
+}
+
+static Vector<u128> const s_inputs = make_inputs(1024);
+
+TEST_CASE(kernels_match_generic_operators)
+{
+    auto sets = available_kernel_sets();
+    auto& generic = sets.first().kernels;
+
+    for (auto& set : sets.span().slice(1)) {
+        for (size_t i = 0; i < s_inputs.size(); ++i) {
+            auto lhs = s_inputs[i];
+            auto rhs = s_inputs[(i * 7 + 1) % s_inputs.size()];
+#define M(kernel, ...)                                                                                             \
+    if (set.kernels.kernel(lhs, rhs) != generic.kernel(lhs, rhs))                                                  \
+        FAIL(ByteString::formatted("{} {} differs for {:032x} and {:032x}", set.name, #kernel##sv, lhs, rhs));
+            ENUMERATE_BINARY_SIMD_KERNELS(M)
+#undef M
+#define M(kernel, ...)                                                                                \
+    if (set.kernels.kernel(lhs) != generic.kernel(lhs))                                               \
+        FAIL(ByteString::formatted("{} {} differs for {:032x}", set.name, #kernel##sv, lhs));
+            ENUMERATE_UNARY_SIMD_KERNELS(M)
+            ENUMERATE_MASK_SIMD_KERNELS(M)
+#undef M
+        }
+    }
+}
+
+// One benchmark per opcode family, run once with the portable kernels and once with the ones the interpreter dispatches to.
+#define ENUMERATE_BENCHMARKED_FAMILIES(F)                                                                    \
+    F(comparisons, M(i8x16_eq) M(i8x16_lt_u) M(i16x8_gt_s) M(i32x4_le_u) M(i64x2_gt_s) M(f32x4_lt) M(f64x2_ne)) \
+    F(saturating_arithmetic,                                                                                 \
+        M(i8x16_add_sat_s) M(i8x16_sub_sat_u) M(i16x8_add_sat_u) M(i16x8_sub_sat_s) M(i8x16_avgr_u))         \
+    F(min_max, M(i8x16_min_s) M(i8x16_max_u) M(i16x8_min_u) M(i32x4_max_s) M(i32x4_min_u))                   \
+    F(multiplication,                                                                                        \
+        M(i16x8_mul) M(i32x4_mul) M(i16x8_q15mulr_sat_s) M(i32x4_dot_i16x8_s) M(i32x4_extmul_high_i16x8_u))  \
+    F(narrow_and_swizzle,                                                                                    \
+        M(i8x16_narrow_i16x8_s) M(i8x16_narrow_i16x8_u) M(i16x8_narrow_i32x4_u) M(i8x16_swizzle))
+
+#define ENUMERATE_BENCHMARKED_UNARY_FAMILIES(F)                                                      \
+    F(extend,                                                                                        \
+        M(i16x8_extend_low_i8x16_s) M(i32x4_extend_high_i16x8_u) M(i64x2_extend_low_i32x4_s)         \
+            M(i16x8_extadd_pairwise_i8x16_u))                                                        \
+    F(abs_and_popcnt, M(i8x16_abs) M(i16x8_abs) M(i32x4_abs) M(i8x16_popcnt))
+
+#define ENUMERATE_BENCHMARKED_MASK_FAMILIES(F) \
+    F(lane_masks, M(i8x16_all_true) M(i32x4_all_true) M(i8x16_bitmask) M(i16x8_bitmask) M(i64x2_bitmask))
+
+static constexpr size_t iterations = 2000;
+
+#define DEFINE_BENCHMARKS(family, kernel_set, kernel_invocations)         \
+    BENCHMARK_CASE(family##_##kernel_set)                                 \
+    {                                                                     \
+        auto& kernels = kernel_set##_kernel_set();                        \
+        u128 accumulator = 0;                                             \
+        for (size_t iteration = 0; iteration < iterations; ++iteration) { \
+            for (size_t i = 1; i < s_inputs.size(); ++i) {                \
+                auto lhs = s_inputs[i - 1];                               \
+                auto rhs = s_inputs[i];                                   \
+                kernel_invocations                                        \
+            }                                                             \
+        }                                                                 \
+        AK::taint_for_optimizer(accumulator);                             \
+    }
+
+static Kernels const& generic_kernel_set() { return available_kernel_sets().first().kernels; }
+static Kernels const& dispatched_kernel_set() { return dispatched_kernels; }
+
+#define M(name) accumulator ^= kernels.name(lhs, rhs);
+#define F(family, invocations)                      \
+    DEFINE_BENCHMARKS(family, generic, invocations) \
+    DEFINE_BENCHMARKS(family, dispatched, invocations)
+ENUMERATE_BENCHMARKED_FAMILIES(F)
+#undef M
+
+#define M(name) accumulator ^= kernels.name(lhs ^ rhs);
+ENUMERATE_BENCHMARKED_UNARY_FAMILIES(F)
+#undef M
+
+#define M(name) accumulator += static_cast<u32>(kernels.name(lhs ^ rhs));
+ENUMERATE_BENCHMARKED_MASK_FAMILIES(F)
+#undef M
+#undef F
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibTest/TestCase.h>
+#include <LibWasm/AbstractMachine/AbstractMachine.h>
+#include <LibWasm/Types.h>
+
+// A module whose functions all have the type (i32) -> i32:
+//
+// (func (export "sum") (param i32) (result i32) (local i32)
+//   block
+//     loop
+//       local.get 0
+//       i32.eqz
+//       br_if 1
+//       local.get 1
+//       local.get 0
+//       i32.add
+//       local.set 1
+//       local.get 0
+//       i32.const -1
+//       i32.add
+//       local.set 0
+//       br 0
+//     end
+//   end
+//   local.get 1)
+//
+// (func (export "classify") (param i32) (result i32)
+//   block
+//     block
+//       block
+//         local.get 0
+//         br_table 0 1 2
+//       end
+//       i32.const 10
+//       return
+//     end
+//     i32.const 20
+//     return
+//   end
+//   i32.const 30)
+//
+// (func (export "branch_with_value") (param i32) (result i32)
+//   block (result i32)
+//     i32.const 1
+//     i32.const 2
+//     local.get 0
+//     local.get 0
+//     i32.const 5
+//     i32.gt_s
+//     br_if 0
+//     i32.add
+//     i32.add
+//   end)
+//
+// (func (export "branch_out_of_function") (param i32) (result i32)
+//   block
+//     local.get 0
+//     local.get 0
+//     br_if 1
+//     drop
+//   end
+//   i32.const 7)
+//
+// (func (export "simd_add_abs") (param i32) (result i32)
+//   local.get 0
+//   i32x4.splat
+//   local.get 0
+//   i32x4.splat
+//   i32x4.add
+//   i32x4.abs
+//   i32x4.extract_lane 0)
+//
+// (func (export "simd_bitmask") (param i32) (result i32)
+//   local.get 0
+//   i32x4.splat
+//   i32x4.bitmask)
+// clang-format off
+static constexpr u8 branches_module[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    // Types
+    0x01, 0x06, 0x01, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    // Functions
+    0x03, 0x07, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // Exports
+    0x07, 0x5d, 0x06,
+    0x03, 's', 'u', 'm', 0x00, 0x00,
+    0x08, 'c', 'l', 'a', 's', 's', 'i', 'f', 'y', 0x00, 0x01,
+    0x11, 'b', 'r', 'a', 'n', 'c', 'h', '_', 'w', 'i', 't', 'h', '_', 'v', 'a', 'l', 'u', 'e', 0x00, 0x02,
+    0x16, 'b', 'r', 'a', 'n', 'c', 'h', '_', 'o', 'u', 't', '_', 'o', 'f', '_', 'f', 'u', 'n', 'c', 't', 'i', 'o', 'n', 0x00, 0x03,
+    0x0c, 's', 'i', 'm', 'd', '_', 'a', 'd', 'd', '_', 'a', 'b', 's', 0x00, 0x04,
+    0x0c, 's', 'i', 'm', 'd', '_', 'b', 'i', 't', 'm', 'a', 's', 'k', 0x00, 0x05,
+    // Code
+    0x0a, 0x80, 0x01, 0x06,
+    0x21, 0x01, 0x01, 0x7f,
+    0x02, 0x40, 0x03, 0x40, 0x20, 0x00, 0x45, 0x0d, 0x01, 0x20, 0x01, 0x20, 0x00, 0x6a, 0x21, 0x01,
+    0x20, 0x00, 0x41, 0x7f, 0x6a, 0x21, 0x00, 0x0c, 0x00, 0x0b, 0x0b, 0x20, 0x01, 0x0b,
+    0x1a, 0x00,
+    0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x20, 0x00, 0x0e, 0x02, 0x00, 0x01, 0x02, 0x0b, 0x41, 0x0a,
+    0x0f, 0x0b, 0x41, 0x14, 0x0f, 0x0b, 0x41, 0x1e, 0x0b,
+    0x14, 0x00,
+    0x02, 0x7f, 0x41, 0x01, 0x41, 0x02, 0x20, 0x00, 0x20, 0x00, 0x41, 0x05, 0x4a, 0x0d, 0x00, 0x6a,
+    0x6a, 0x0b, 0x0b,
+    0x0e, 0x00,
+    0x02, 0x40, 0x20, 0x00, 0x20, 0x00, 0x0d, 0x01, 0x1a, 0x0b, 0x41, 0x07, 0x0b,
+    0x13, 0x00,
+    0x20, 0x00, 0xfd, 0x11, 0x20, 0x00, 0xfd, 0x11, 0xfd, 0xae, 0x01, 0xfd, 0xa0, 0x01, 0xfd, 0x1b,
+    0x00, 0x0b,
+    0x09, 0x00,
+    0x20, 0x00, 0xfd, 0x11, 0xfd, 0xa4, 0x01, 0x0b,
+};
+// clang-format on
+
+struct InstantiatedModule {
+    Wasm::AbstractMachine machine;
+    RefPtr<Wasm::Module> module;
+    OwnPtr<Wasm::ModuleInstance> instance;
+};
+
+static NonnullOwnPtr<InstantiatedModule> instantiate(bool limit_instruction_count)
+{
+    FixedMemoryStream stream { ReadonlyBytes { branches_module, sizeof(branches_module) } };
+    auto instantiated = make<InstantiatedModule>();
+    instantiated->module = MUST(Wasm::Module::parse(stream));
+    // Limiting the instruction count makes the interpreter run instructions one by one instead of using threaded dispatch.
+    if (limit_instruction_count)
+        instantiated->machine.enable_instruction_count_limit();
+    instantiated->instance = MUST(instantiated->machine.instantiate(*instantiated->module, {}));
+    return instantiated;
+}
+
+static i32 invoke(InstantiatedModule& instantiated, StringView name, i32 argument)
+{
+    for (auto& entry : instantiated.instance->exports()) {
+        if (entry.name() != name)
+            continue;
+        auto address = entry.value().get<Wasm::FunctionAddress>();
+        auto result = instantiated.machine.invoke(address, { Wasm::Value(argument) });
+        VERIFY(!result.is_trap());
+        VERIFY(result.values().size() == 1);
+        return result.values().first().to<i32>();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static void expect_results(StringView name, Vector<i32> const& arguments, Vector<i32> const& expected_results)
+{
+    auto threaded = instantiate(false);
+    auto stepped = instantiate(true);
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        EXPECT_EQ(invoke(*threaded, name, arguments[i]), expected_results[i]);
+        EXPECT_EQ(invoke(*stepped, name, arguments[i]), expected_results[i]);
+    }
+}
+
+TEST_CASE(loop_with_branches)
+{
+    expect_results("sum"sv, { 0, 1, 10, 1000 }, { 0, 1, 55, 500500 });
+}
+
+TEST_CASE(br_table)
+{
+    expect_results("classify"sv, { 0, 1, 2, 3, -1 }, { 10, 20, 30, 30, 30 });
+}
+
+TEST_CASE(branch_drops_operands_below_its_result)
+{
+    expect_results("branch_with_value"sv, { 10, 6, 5, 1 }, { 10, 6, 8, 4 });
+}
+
+TEST_CASE(branch_out_of_function)
+{
+    expect_results("branch_out_of_function"sv, { 0, 5, -3 }, { 7, 5, -3 });
+}
+
+TEST_CASE(simd_kernels)
+{
+    expect_results("simd_add_abs"sv, { 0, 3, -5, NumericLimits<i32>::min() }, { 0, 6, 10, 0 });
+    expect_results("simd_bitmask"sv, { 0, 1, -1 }, { 0, 0, 0xf });
+}
+
+TEST_CASE(compiled_expression_is_reused)
+{
+    // The first call pre-decodes each function, the later ones must get the same results out of that.
+    auto threaded = instantiate(false);
+    i32 const classes[] = { 10, 20, 30 };
+    for (i32 i = 0; i < 3; ++i) {
+        EXPECT_EQ(invoke(*threaded, "sum"sv, 100), 5050);
+        EXPECT_EQ(invoke(*threaded, "classify"sv, i), classes[i]);
+    }
+}
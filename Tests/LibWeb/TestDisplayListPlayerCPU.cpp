@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/DisplayListPlayerCPU.h>
+#include <LibWeb/Painting/DisplayListRecorder.h>
+
+namespace Web::Painting {
+
+static Gfx::IntRect const target_rect { 0, 0, 2 * DisplayListPlayerCPU::tile_size, 2 * DisplayListPlayerCPU::tile_size };
+static Gfx::IntRect const square_rect { 10, 10, 50, 50 };
+
+static void paint_frame(Gfx::Bitmap& target, TileCache& tile_cache, Color square_color)
+{
+    auto display_list = DisplayList::create();
+    DisplayListRecorder recorder(*display_list);
+    recorder.fill_rect(target_rect, Color::White);
+    recorder.fill_rect(square_rect, square_color);
+
+    DisplayListPlayerCPU player(target);
+    player.execute_in_tiles(*display_list, &tile_cache);
+}
+
+TEST_CASE(unchanged_tiles_are_reused)
+{
+    auto target = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, target_rect.size()));
+    TileCache tile_cache;
+
+    paint_frame(*target, tile_cache, Color::Red);
+    EXPECT_EQ(tile_cache.reused_tile_count(), 0u);
+
+    target->fill(Color::Black);
+    paint_frame(*target, tile_cache, Color::Red);
+    EXPECT_EQ(tile_cache.reused_tile_count(), 4u);
+    EXPECT_EQ(target->get_pixel(square_rect.center()), Color::Red);
+    EXPECT_EQ(target->get_pixel(target_rect.center()), Color::White);
+}
+
+TEST_CASE(changed_command_invalidates_its_tile)
+{
+    auto target = TRY_OR_FAIL(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, target_rect.size()));
+    TileCache tile_cache;
+
+    paint_frame(*target, tile_cache, Color::Red);
+    paint_frame(*target, tile_cache, Color::Blue);
+    // Only the tile containing the square has to be painted again.
+    EXPECT_EQ(tile_cache.reused_tile_count(), 3u);
+    EXPECT_EQ(target->get_pixel(square_rect.center()), Color::Blue);
+    EXPECT_EQ(target->get_pixel(target_rect.center()), Color::White);
+
+    paint_frame(*target, tile_cache, Color::Blue);
+    EXPECT_EQ(tile_cache.reused_tile_count(), 4u);
+    EXPECT_EQ(target->get_pixel(square_rect.center()), Color::Blue);
+}
+
+}
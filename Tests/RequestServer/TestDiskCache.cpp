@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <RequestServer/DiskCache.h>
+
+using RequestServer::DiskCache;
+
+// Mon, 01 Jan 2024 12:00:00 GMT
+static UnixDateTime const response_time = UnixDateTime::from_unix_time_parts(2024, 1, 1, 12, 0, 0, 0);
+static UnixDateTime const request_time = response_time - Duration::from_seconds(2);
+
+static HTTP::HeaderMap make_headers(std::initializer_list<HTTP::Header> headers)
+{
+    HTTP::HeaderMap header_map;
+    for (auto const& header : headers)
+        header_map.set(header.name, header.value);
+    return header_map;
+}
+
+static i64 freshness_lifetime(std::initializer_list<HTTP::Header> headers, u32 status_code = 200)
+{
+    return DiskCache::freshness_lifetime(status_code, make_headers(headers), response_time);
+}
+
+TEST_CASE(freshness_lifetime_precedence)
+{
+    // A shared cache prefers s-maxage over max-age, and both over Expires.
+    EXPECT_EQ(freshness_lifetime({ { "Cache-Control", "max-age=60, s-maxage=600" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" }, { "Expires", "Mon, 01 Jan 2024 13:00:00 GMT" } }), 600);
+    EXPECT_EQ(freshness_lifetime({ { "Cache-Control", "max-age=60" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" }, { "Expires", "Mon, 01 Jan 2024 13:00:00 GMT" } }), 60);
+    EXPECT_EQ(freshness_lifetime({ { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" }, { "Expires", "Mon, 01 Jan 2024 13:00:00 GMT" } }), 3600);
+
+    // Expires is relative to Date, or to when we received the response if there is no Date.
+    EXPECT_EQ(freshness_lifetime({ { "Date", "Mon, 01 Jan 2024 12:30:00 GMT" }, { "Expires", "Mon, 01 Jan 2024 13:00:00 GMT" } }), 1800);
+    EXPECT_EQ(freshness_lifetime({ { "Expires", "Mon, 01 Jan 2024 12:10:00 GMT" } }), 600);
+
+    // Invalid dates represent a time in the past.
+    EXPECT_EQ(freshness_lifetime({ { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" }, { "Expires", "0" } }), 0);
+
+    // no-cache responses have to be validated every time, whatever their lifetime.
+    EXPECT_EQ(freshness_lifetime({ { "Cache-Control", "no-cache, max-age=600" } }), 0);
+}
+
+TEST_CASE(heuristic_freshness)
+{
+    // A tenth of the time since the last modification.
+    EXPECT_EQ(freshness_lifetime({ { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" }, { "Last-Modified", "Fri, 22 Dec 2023 12:00:00 GMT" } }), 24 * 60 * 60);
+
+    // ...but at most a week.
+    EXPECT_EQ(freshness_lifetime({ { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" }, { "Last-Modified", "Sat, 01 Jan 2000 12:00:00 GMT" } }), 7 * 24 * 60 * 60);
+
+    // Only some status codes may be cached heuristically, unless the response is marked as public.
+    EXPECT_EQ(freshness_lifetime({ { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" }, { "Last-Modified", "Fri, 22 Dec 2023 12:00:00 GMT" } }, 302), 0);
+    EXPECT_EQ(freshness_lifetime({ { "Cache-Control", "public" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" }, { "Last-Modified", "Fri, 22 Dec 2023 12:00:00 GMT" } }, 302), 24 * 60 * 60);
+
+    // Without Last-Modified, there is nothing to guess from.
+    EXPECT_EQ(freshness_lifetime({ { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" } }), 0);
+}
+
+TEST_CASE(current_age)
+{
+    auto now = response_time + Duration::from_seconds(100);
+    auto current_age = [&](std::initializer_list<HTTP::Header> headers) {
+        return DiskCache::current_age(make_headers(headers), request_time, response_time, now);
+    };
+
+    // The time the request took, plus the time the response spent in the cache.
+    EXPECT_EQ(current_age({ { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" } }), 102);
+    EXPECT_EQ(current_age({}), 102);
+
+    // The age that upstream caches reported.
+    EXPECT_EQ(current_age({ { "Age", "30" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" } }), 132);
+    EXPECT_EQ(current_age({ { "Age", "invalid" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" } }), 102);
+
+    // A Date in the past makes the response older, whichever is larger wins.
+    EXPECT_EQ(current_age({ { "Date", "Mon, 01 Jan 2024 11:59:10 GMT" } }), 150);
+    EXPECT_EQ(current_age({ { "Age", "60" }, { "Date", "Mon, 01 Jan 2024 11:59:10 GMT" } }), 162);
+}
+
+TEST_CASE(is_fresh)
+{
+    auto is_fresh = [&](std::initializer_list<HTTP::Header> headers, UnixDateTime now) {
+        return DiskCache::is_fresh(200, make_headers(headers), request_time, response_time, now);
+    };
+
+    auto now = response_time + Duration::from_seconds(100);
+    EXPECT(is_fresh({ { "Cache-Control", "max-age=120" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" } }, now));
+    EXPECT(!is_fresh({ { "Cache-Control", "max-age=120" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" } }, now + Duration::from_seconds(20)));
+    EXPECT(!is_fresh({ { "Age", "30" }, { "Cache-Control", "max-age=120" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" } }, now));
+    EXPECT(is_fresh({ { "Age", "30" }, { "Cache-Control", "max-age=60, s-maxage=600" }, { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" } }, now));
+    EXPECT(!is_fresh({ { "Cache-Control", "no-cache, max-age=600" } }, now));
+}
+
+TEST_CASE(is_storable)
+{
+    auto is_storable = [](std::initializer_list<HTTP::Header> headers, u32 status_code = 200) {
+        return DiskCache::is_storable(status_code, make_headers(headers));
+    };
+
+    EXPECT(is_storable({ { "Cache-Control", "max-age=60" } }));
+    EXPECT(is_storable({ { "Cache-Control", "s-maxage=60" } }));
+    EXPECT(is_storable({ { "Expires", "Mon, 01 Jan 2024 13:00:00 GMT" } }));
+    EXPECT(is_storable({ { "ETag", "\"abc\"" } }));
+    EXPECT(is_storable({ { "Last-Modified", "Fri, 22 Dec 2023 12:00:00 GMT" } }));
+
+    // A response that can be neither fresh nor validated isn't worth keeping.
+    EXPECT(!is_storable({}));
+
+    EXPECT(!is_storable({ { "Cache-Control", "no-store, max-age=60" } }));
+
+    // This cache is shared by all clients, so responses meant for a single user aren't stored.
+    EXPECT(!is_storable({ { "Cache-Control", "private, max-age=60" } }));
+    EXPECT(!is_storable({ { "Cache-Control", "private" }, { "ETag", "\"abc\"" } }));
+
+    // Only some status codes may be stored without an explicit lifetime, unless the response is marked as public.
+    EXPECT(!is_storable({ { "ETag", "\"abc\"" } }, 302));
+    EXPECT(is_storable({ { "Cache-Control", "max-age=60" } }, 302));
+    EXPECT(is_storable({ { "Cache-Control", "public" }, { "ETag", "\"abc\"" } }, 302));
+
+    EXPECT(!is_storable({ { "Cache-Control", "max-age=60" } }, 206));
+    EXPECT(!is_storable({ { "Cache-Control", "max-age=60" } }, 304));
+
+    EXPECT(is_storable({ { "Cache-Control", "max-age=60" }, { "Vary", "Accept-Encoding" } }));
+    EXPECT(!is_storable({ { "Cache-Control", "max-age=60" }, { "Vary", "Accept-Encoding, Cookie" } }));
+}
+
+TEST_CASE(freshen_with_not_modified_response)
+{
+    auto stored_headers = make_headers({
+        { "Cache-Control", "max-age=60" },
+        { "Content-Length", "10" },
+        { "Content-Type", "text/html" },
+        { "Date", "Mon, 01 Jan 2024 12:00:00 GMT" },
+        { "ETag", "\"abc\"" },
+    });
+    auto not_modified_headers = make_headers({
+        { "Cache-Control", "max-age=600" },
+        { "Connection", "keep-alive" },
+        { "Content-Length", "0" },
+        { "Date", "Mon, 01 Jan 2024 13:00:00 GMT" },
+    });
+
+    auto now = response_time + Duration::from_seconds(3600);
+    EXPECT(!DiskCache::is_fresh(200, stored_headers, request_time, response_time, now));
+
+    auto headers = DiskCache::freshened_headers(stored_headers, not_modified_headers);
+    EXPECT_EQ(headers.get("Cache-Control"), "max-age=600"sv);
+    EXPECT_EQ(headers.get("Date"), "Mon, 01 Jan 2024 13:00:00 GMT"sv);
+
+    // Headers the 304 response doesn't mention are kept, and the body's Content-Length is never replaced.
+    EXPECT_EQ(headers.get("Content-Type"), "text/html"sv);
+    EXPECT_EQ(headers.get("ETag"), "\"abc\""sv);
+    EXPECT_EQ(headers.get("Content-Length"), "10"sv);
+    EXPECT(!headers.contains("Connection"));
+
+    // The freshened response is as old as the 304 response.
+    auto new_response_time = now;
+    auto new_request_time = now - Duration::from_seconds(1);
+    EXPECT(DiskCache::is_fresh(200, headers, new_request_time, new_response_time, now + Duration::from_seconds(100)));
+}
@@ -62,9 +62,11 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     }
 
     if (non_zero_symbols == 1) { // special case - only 1 symbol
-        code.m_prefix_table[0] = PrefixTableEntry { static_cast<u16>(last_non_zero), 1u };
-        code.m_prefix_table[1] = code.m_prefix_table[0];
-        code.m_max_prefixed_code_length = 1;
+        TRY(code.m_table.try_resize(2));
+        code.m_table[0] = TableEntry { static_cast<u16>(last_non_zero), 1 };
+        code.m_table[1] = code.m_table[0];
+        code.m_primary_table_bits = 1;
+        code.m_max_code_length = 1;
 
         if (code.m_bit_codes.size() < static_cast<size_t>(last_non_zero + 1)) {
             TRY(code.m_bit_codes.try_resize(last_non_zero + 1));
@@ -77,24 +79,17 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
     }
 
     struct PrefixCode {
-        u16 symbol_code { 0 };
         u16 symbol_value { 0 };
-        u16 code_length { 0 };
+        u16 reversed_symbol_code { 0 };
+        u8 code_length { 0 };
     };
-    Array<PrefixCode, 1 << CanonicalCode::max_allowed_prefixed_code_length> prefix_codes;
-    size_t number_of_prefix_codes = 0;
-
-    code.m_first_symbol_of_length_after.append(0);
-    code.m_offset_to_first_symbol_index.append(0);
+    Vector<PrefixCode, 288> prefix_codes;
 
     auto next_code = 0;
-    for (size_t code_length = 1; code_length <= 15; ++code_length) {
+    for (size_t code_length = 1; code_length <= max_code_length; ++code_length) {
         next_code <<= 1;
         auto start_bit = 1 << code_length;
 
-        auto first_code_at_length = next_code;
-        auto first_symbol_index_at_length = code.m_symbol_values.size();
-
         for (size_t symbol = 0; symbol < bytes.size(); ++symbol) {
             if (bytes[symbol] != code_length)
                 continue;
@@ -102,20 +97,6 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             if (next_code > start_bit)
                 return Error::from_string_literal("Failed to decode code lengths");
 
-            code.m_symbol_values.append(symbol);
-
-            if (code_length <= CanonicalCode::max_allowed_prefixed_code_length) {
-                if (number_of_prefix_codes >= prefix_codes.size())
-                    return Error::from_string_literal("Invalid canonical Huffman code");
-
-                auto& prefix_code = prefix_codes[number_of_prefix_codes++];
-                prefix_code.symbol_code = next_code;
-                prefix_code.symbol_value = symbol;
-                prefix_code.code_length = code_length;
-
-                code.m_max_prefixed_code_length = code_length;
-            }
-
             if (code.m_bit_codes.size() < symbol + 1) {
                 TRY(code.m_bit_codes.try_resize(symbol + 1));
                 TRY(code.m_bit_code_lengths.try_resize(symbol + 1));
@@ -123,33 +104,52 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
             code.m_bit_codes[symbol] = fast_reverse16(start_bit | next_code, code_length); // DEFLATE writes huffman encoded symbols as lsb-first
             code.m_bit_code_lengths[symbol] = code_length;
 
+            TRY(prefix_codes.try_append({ static_cast<u16>(symbol), code.m_bit_codes[symbol], static_cast<u8>(code_length) }));
+            code.m_max_code_length = code_length;
+
             next_code++;
         }
-
-        u32 sentinel = next_code;
-        code.m_first_symbol_of_length_after.append(sentinel);
-        VERIFY(code.m_first_symbol_of_length_after[code_length] == sentinel);
-
-        if (code.m_symbol_values.size() > first_symbol_index_at_length)
-            code.m_offset_to_first_symbol_index.append(first_symbol_index_at_length - first_code_at_length);
-        else
-            code.m_offset_to_first_symbol_index.append(0); // Never evaluated.
     }
 
-    if (next_code != (1 << 15))
+    if (next_code != (1 << max_code_length))
         return Error::from_string_literal("Failed to decode code lengths");
 
-    for (auto [symbol_code, symbol_value, code_length] : prefix_codes) {
-        if (code_length == 0 || code_length > CanonicalCode::max_allowed_prefixed_code_length)
-            break;
+    // The codes are complete now, so every possible index into the tables will be filled below.
+    code.m_primary_table_bits = min(code.m_max_code_length, max_primary_table_bits);
+    auto const primary_table_size = 1u << code.m_primary_table_bits;
+    auto const primary_table_mask = primary_table_size - 1;
 
-        auto shift = code.m_max_prefixed_code_length - code_length;
-        symbol_code <<= shift;
+    // Each secondary table is indexed by as many bits as the longest code sharing its prefix has after it.
+    Array<u8, 1 << max_primary_table_bits> secondary_table_bits {};
+    for (auto const& prefix_code : prefix_codes) {
+        if (prefix_code.code_length <= code.m_primary_table_bits)
+            continue;
+        auto& bits = secondary_table_bits[prefix_code.reversed_symbol_code & primary_table_mask];
+        bits = max<u8>(bits, prefix_code.code_length - code.m_primary_table_bits);
+    }
+
+    TRY(code.m_table.try_resize(primary_table_size));
+    size_t table_size = primary_table_size;
+    for (size_t prefix = 0; prefix < primary_table_size; ++prefix) {
+        if (secondary_table_bits[prefix] == 0)
+            continue;
+        code.m_table[prefix] = TableEntry { static_cast<u16>(table_size), secondary_table_bits[prefix], true };
+        table_size += 1u << secondary_table_bits[prefix];
+    }
+    TRY(code.m_table.try_resize(table_size));
 
-        for (size_t j = 0; j < (1u << shift); ++j) {
-            auto index = fast_reverse16(symbol_code + j, code.m_max_prefixed_code_length);
-            code.m_prefix_table[index] = PrefixTableEntry { symbol_value, code_length };
+    for (auto [symbol_value, reversed_symbol_code, code_length] : prefix_codes) {
+        // Codes are read lsb-first, so all indices that end in a code's bits decode to its symbol.
+        if (code_length <= code.m_primary_table_bits) {
+            for (size_t index = reversed_symbol_code; index < primary_table_size; index += 1u << code_length)
+                code.m_table[index] = TableEntry { symbol_value, code_length };
+            continue;
         }
+
+        auto const link = code.m_table[reversed_symbol_code & primary_table_mask];
+        auto const secondary_code_length = code_length - code.m_primary_table_bits;
+        for (size_t index = reversed_symbol_code >> code.m_primary_table_bits; index < (1u << link.code_length); index += 1u << secondary_code_length)
+            code.m_table[link.symbol_value + index] = TableEntry { symbol_value, code_length };
     }
 
     return code;
@@ -157,25 +157,16 @@ ErrorOr<CanonicalCode> CanonicalCode::from_bytes(ReadonlyBytes bytes)
 
 ErrorOr<u32> CanonicalCode::read_symbol(LittleEndianInputBitStream& stream) const
 {
-    auto prefix = TRY(stream.peek_bits<size_t>(m_max_prefixed_code_length));
-
-    if (auto [symbol_value, code_length] = m_prefix_table[prefix]; code_length != 0) {
-        stream.discard_previously_peeked_bits(code_length);
-        return symbol_value;
-    }
+    // The last code of a stream may be followed by fewer bits than the longest code has, so only
+    // running out of bits in the middle of the code that was actually found is an error.
+    TRY(stream.fill_buffer(m_max_code_length));
 
-    auto code_bits = TRY(stream.read_bits<u16>(m_max_prefixed_code_length + 1));
-    code_bits = fast_reverse16(code_bits, m_max_prefixed_code_length + 1);
-
-    for (size_t i = m_max_prefixed_code_length + 1; i <= 15; ++i) {
-        if (code_bits < m_first_symbol_of_length_after[i]) {
-            auto symbol_index = (uint16_t)(m_offset_to_first_symbol_index[i] + code_bits);
-            return m_symbol_values[symbol_index];
-        }
-        code_bits = code_bits << 1 | TRY(stream.read_bit());
-    }
+    auto [symbol_value, code_length, is_link] = lookup(stream.buffered_bits());
+    if (code_length > stream.buffered_bit_count())
+        return Error::from_string_literal("Reached end-of-stream without collecting the required number of bits");
 
-    return Error::from_string_literal("Symbol exceeds maximum symbol number");
+    stream.discard_previously_peeked_bits(code_length);
+    return symbol_value;
 }
 
 DeflateDecompressor::CompressedBlock::CompressedBlock(DeflateDecompressor& decompressor, CanonicalCode literal_codes, Optional<CanonicalCode> distance_codes)
@@ -185,11 +176,120 @@ DeflateDecompressor::CompressedBlock::CompressedBlock(DeflateDecompressor& decom
 {
 }
 
+ErrorOr<size_t> DeflateDecompressor::CompressedBlock::decode_in_place()
+{
+    auto& input_stream = *m_decompressor.m_input_stream;
+    auto& output_buffer = m_decompressor.m_output_buffer;
+
+    // A literal/length code and its extra bits, followed by a distance code and its extra bits.
+    static constexpr size_t max_bits_per_symbol = 2 * CanonicalCode::max_code_length + 5 + 13;
+
+    // Every iteration writes at most one back reference, and copies may overrun it by up to a word.
+    static constexpr size_t output_margin = max_back_reference_length + sizeof(u64);
+
+    size_t decoded_bytes = 0;
+    u8* history_start = nullptr;
+    u8* output_start = nullptr;
+    u8* output_limit = nullptr;
+    u8* output = nullptr;
+
+    auto commit_output = [&] {
+        output_buffer.commit_written_bytes(output - output_start);
+        decoded_bytes += output - output_start;
+    };
+    auto acquire_output_window = [&] {
+        size_t seekback_size = 0;
+        auto window = output_buffer.next_write_span_with_seekback(seekback_size);
+        if (window.size() - seekback_size < output_margin)
+            return false;
+
+        history_start = window.data();
+        output_start = window.data() + seekback_size;
+        output_limit = window.data() + window.size() - output_margin;
+        output = output_start;
+        return true;
+    };
+
+    if (!acquire_output_window())
+        return 0;
+
+    while (output < output_limit) {
+        // After a refill, several literals usually fit into the buffer before the next one is needed.
+        if (input_stream.buffered_bit_count() < max_bits_per_symbol) {
+            TRY(input_stream.fill_buffer(max_bits_per_symbol));
+            if (input_stream.buffered_bit_count() < max_bits_per_symbol)
+                break;
+        }
+
+        auto const symbol = m_literal_codes.read_buffered_symbol(input_stream);
+        if (symbol < EndOfBlock) {
+            *output++ = symbol;
+            continue;
+        }
+
+        if (symbol == EndOfBlock) {
+            m_eof = true;
+            break;
+        }
+
+        if (symbol >= 286)
+            return Error::from_string_literal("Invalid deflate literal/length symbol");
+
+        if (!m_distance_codes.has_value())
+            return Error::from_string_literal("Distance codes have not been initialized");
+
+        auto const length = TRY(m_decompressor.decode_length(symbol));
+        auto const distance_symbol = m_distance_codes->read_buffered_symbol(input_stream);
+        if (distance_symbol >= 30)
+            return Error::from_string_literal("Invalid deflate distance symbol");
+
+        auto const distance = TRY(m_decompressor.decode_distance(distance_symbol));
+
+        if (distance > static_cast<size_t>(output - history_start)) [[unlikely]] {
+            // The source wraps around the end of the buffer or lies beyond the seekback limit,
+            // so let the buffer deal with it after handing over everything we have so far.
+            commit_output();
+            auto copied_length = TRY(output_buffer.copy_from_seekback(distance, length));
+            VERIFY(copied_length == length);
+            decoded_bytes += length;
+
+            if (!acquire_output_window())
+                return decoded_bytes;
+            continue;
+        }
+
+        u8 const* source = output - distance;
+        u8* const output_end = output + length;
+        if (distance >= sizeof(u64)) {
+            // The source is always at least a word behind, so each word only reads bytes that have been written already.
+            do {
+                __builtin_memcpy(output, source, sizeof(u64));
+                output += sizeof(u64);
+                source += sizeof(u64);
+            } while (output < output_end);
+        } else if (distance == 1) {
+            __builtin_memset(output, *source, length);
+        } else {
+            for (; output < output_end; ++output, ++source)
+                *output = *source;
+        }
+        output = output_end;
+    }
+
+    commit_output();
+    return decoded_bytes;
+}
+
 ErrorOr<bool> DeflateDecompressor::CompressedBlock::try_read_more()
 {
     if (m_eof == true)
         return false;
 
+    // Decode as much as possible straight into the output buffer first, and only fall back to
+    // decoding one symbol at a time near the end of the buffer or of the input.
+    if (auto decoded_bytes = TRY(decode_in_place()); decoded_bytes > 0 || m_eof)
+        return decoded_bytes > 0;
+
     auto const symbol = TRY(m_literal_codes.read_symbol(*m_decompressor.m_input_stream));
 
     if (symbol >= 286)
@@ -250,7 +350,9 @@ ErrorOr<bool> DeflateDecompressor::UncompressedBlock::try_read_more()
 
 ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::construct(MaybeOwned<LittleEndianInputBitStream> stream)
 {
-    auto output_buffer = TRY(CircularBuffer::create_empty(32 * KiB));
+    // Back references copy whole words at a time when decoding in place, which can scribble over a few bytes past their end.
+    // Those bytes are the oldest part of the window, so make the buffer slightly larger than the maximum back reference distance.
+    auto output_buffer = TRY(CircularBuffer::create_empty(32 * KiB + sizeof(u64)));
     return TRY(adopt_nonnull_own_or_enomem(new (nothrow) DeflateDecompressor(move(stream), move(output_buffer))));
 }
 
@@ -495,6 +597,8 @@ DeflateCompressor::DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>
 {
     m_symbol_frequencies.fill(0);
     m_distance_frequencies.fill(0);
+    for (auto& slot : m_hash_head) // initialize chained hash table
+        slot = empty_slot;
 }
 
 DeflateCompressor::~DeflateCompressor()
@@ -586,7 +690,7 @@ size_t DeflateCompressor::find_back_match(size_t start, u16 hash, size_t previou
             break; // no remaining candidates
 
         VERIFY(candidate < start);
-        if (start - candidate > window_size)
+        if (start - candidate > max_back_reference_distance)
             break; // outside the window
 
         auto match_length = compare_match_candidate(start, candidate, previous_match_length, maximum_match_length);
@@ -614,10 +718,6 @@ ALWAYS_INLINE u8 DeflateCompressor::distance_to_base(u16 distance)
 
 void DeflateCompressor::lz77_compress_block()
 {
-    for (auto& slot : m_hash_head) { // initialize chained hash table
-        slot = empty_slot;
-    }
-
     auto insert_hash = [&](auto pos, auto hash) {
         auto window_pos = pos % window_size;
         m_hash_prev[window_pos] = m_hash_head[hash];
@@ -648,6 +748,11 @@ void DeflateCompressor::lz77_compress_block()
 
     // our block starts at block_size and is m_pending_block_size in length
     auto block_end = block_size + m_pending_block_size;
+
+    // the hash chains already cover the history, except for the bytes that weren't followed by enough data to be hashed
+    for (auto position = block_size - m_unhashed_history_size; position < min(block_size, block_end - min_match_length + 1); position++)
+        insert_hash(position, hash_sequence(&m_rolling_window[position]));
+
     size_t current_position;
     for (current_position = block_size; current_position < block_end - min_match_length + 1; current_position++) {
         auto hash = hash_sequence(&m_rolling_window[current_position]);
@@ -956,17 +1061,62 @@ ErrorOr<void> DeflateCompressor::flush()
     if (m_finished)
         TRY(m_output_stream->align_to_byte_boundary());
 
+    // keep the end of the data seen so far as the search window for the next block
+    auto history_size = min(m_history_size + m_pending_block_size, block_size);
+    memmove(m_rolling_window + block_size - history_size, m_rolling_window + block_size + m_pending_block_size - history_size, history_size);
+    m_history_size = history_size;
+
+    // slide the hash chains along with the data, so the next block doesn't have to hash the history again
+    auto slide_position = [&](u16 position) -> u16 {
+        if (position == empty_slot || position < m_pending_block_size + block_size - history_size)
+            return empty_slot;
+        return position - m_pending_block_size;
+    };
+    for (auto& slot : m_hash_head)
+        slot = slide_position(slot);
+    for (auto position = block_size - history_size; position < block_size; position++)
+        m_hash_prev[position] = slide_position(m_hash_prev[position + m_pending_block_size]);
+    m_unhashed_history_size = min(m_unhashed_history_size + m_pending_block_size, min_match_length - 1);
+
     // reset all block specific members
     m_pending_block_size = 0;
     m_pending_symbol_size = 0;
     m_symbol_frequencies.fill(0);
     m_distance_frequencies.fill(0);
-    // On the final block this copy will potentially produce an invalid search window, but since its the final block we dont care
-    pending_block().copy_trimmed_to({ m_rolling_window, block_size });
 
     return {};
 }
 
+ErrorOr<void> DeflateCompressor::sync_flush()
+{
+    VERIFY(!m_finished);
+    if (m_pending_block_size != 0)
+        TRY(flush());
+
+    // an empty uncompressed block aligns the output to a byte boundary without ending the deflate stream
+    TRY(m_output_stream->write_bits(0b000u, 3));
+    TRY(m_output_stream->align_to_byte_boundary());
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0));
+    TRY(m_output_stream->write_value<LittleEndian<u16>>(0xFFFF));
+    TRY(m_output_stream->flush_buffer_to_stream());
+
+    // the stream is continued by whoever appends to our output, so nothing else may be written from here on
+    m_finished = true;
+    return {};
+}
+
+void DeflateCompressor::set_dictionary(ReadonlyBytes dictionary)
+{
+    VERIFY(m_pending_block_size == 0);
+    m_history_size = min(dictionary.size(), block_size);
+    dictionary.slice(dictionary.size() - m_history_size).copy_to({ m_rolling_window + block_size - m_history_size, m_history_size });
+
+    // the dictionary replaces all previous history, so it has to be hashed from scratch
+    for (auto& slot : m_hash_head)
+        slot = empty_slot;
+    m_unhashed_history_size = m_history_size;
+}
+
 ErrorOr<void> DeflateCompressor::final_flush()
 {
     VERIFY(!m_finished);
@@ -987,4 +1137,16 @@ ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, Compres
     return output_stream->read_until_eof();
 }
 
+ErrorOr<ByteBuffer> DeflateCompressor::compress_chunk(ReadonlyBytes dictionary, ReadonlyBytes bytes, CompressionLevel compression_level)
+{
+    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
+    auto deflate_stream = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(*output_stream), compression_level));
+
+    deflate_stream->set_dictionary(dictionary);
+    TRY(deflate_stream->write_until_depleted(bytes));
+    TRY(deflate_stream->sync_flush());
+
+    return output_stream->read_until_eof();
+}
+
 }
@@ -30,22 +30,42 @@ public:
 
     static ErrorOr<CanonicalCode> from_bytes(ReadonlyBytes);
 
-private:
-    static constexpr size_t max_allowed_prefixed_code_length = 8;
-
-    struct PrefixTableEntry {
-        u16 symbol_value { 0 };
-        u16 code_length { 0 };
-    };
+    static constexpr size_t max_code_length = 15;
 
-    // Decompression - indexed by code
-    Vector<u16, 286> m_symbol_values;
+    // Decodes a symbol from the bits that are already buffered in the stream.
+    // The caller has to make sure that enough bits are buffered for the longest code.
+    ALWAYS_INLINE u32 read_buffered_symbol(LittleEndianInputBitStream& stream) const
+    {
+        auto entry = lookup(stream.buffered_bits());
+        stream.discard_previously_peeked_bits(entry.code_length);
+        return entry.symbol_value;
+    }
 
-    Vector<u32, 16> m_first_symbol_of_length_after;
-    Vector<u16, 16> m_offset_to_first_symbol_index;
+private:
+    static constexpr size_t max_primary_table_bits = 9;
+
+    // Codes of up to m_primary_table_bits bits are decoded with a single lookup. All longer codes sharing
+    // the same first m_primary_table_bits bits are resolved by a second lookup in a table of their own.
+    struct TableEntry {
+        u16 symbol_value { 0 }; // For links to a secondary table, the index where that table starts.
+        u8 code_length { 0 };   // For links to a secondary table, the number of bits in its index.
+        bool is_link { false };
+    };
 
-    Array<PrefixTableEntry, 1 << max_allowed_prefixed_code_length> m_prefix_table {};
-    size_t m_max_prefixed_code_length { 0 };
+    ALWAYS_INLINE TableEntry lookup(u64 bits) const
+    {
+        auto entry = m_table[bits & ((1u << m_primary_table_bits) - 1)];
+        if (entry.is_link) [[unlikely]] {
+            auto secondary_index = (bits >> m_primary_table_bits) & ((1u << entry.code_length) - 1);
+            entry = m_table[entry.symbol_value + secondary_index];
+        }
+        return entry;
+    }
+
+    // Decompression - indexed by the next bits of the stream
+    Vector<TableEntry, 1 << max_primary_table_bits> m_table;
+    size_t m_primary_table_bits { 0 };
+    size_t m_max_code_length { 0 };
 
     // Compression - indexed by symbol
     // Deflate uses a maximum of 288 symbols (maximum of 32 for distances),
@@ -71,6 +91,8 @@ private:
         ErrorOr<bool> try_read_more();
 
     private:
+        ErrorOr<size_t> decode_in_place();
+
         bool m_eof { false };
 
         DeflateDecompressor& m_decompressor;
@@ -140,6 +162,7 @@ public:
     static constexpr size_t max_huffman_distances = 32;
     static constexpr size_t min_match_length = 4;   // matches smaller than these are not worth the size of the back reference
     static constexpr size_t max_match_length = 258; // matches longer than these cannot be encoded using huffman codes
+    static constexpr size_t max_back_reference_distance = 32 * KiB;
     static constexpr u16 empty_slot = UINT16_MAX;
 
     struct CompressionConstants {
@@ -178,6 +201,11 @@ public:
 
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
 
+    // Compresses `bytes` into non-final blocks that end on a byte boundary, so the results for consecutive pieces of data can be
+    // concatenated into one deflate stream (which still has to be terminated by a final block). `dictionary` is the data that
+    // precedes `bytes` in that stream, its last 32 KiB can be referenced by the compressed data.
+    static ErrorOr<ByteBuffer> compress_chunk(ReadonlyBytes dictionary, ReadonlyBytes bytes, CompressionLevel = CompressionLevel::GOOD);
+
 private:
     DeflateCompressor(NonnullOwnPtr<LittleEndianOutputBitStream>, CompressionLevel = CompressionLevel::GOOD);
 
@@ -205,13 +233,20 @@ private:
     size_t fixed_block_length();
     size_t dynamic_block_length(Array<u8, max_huffman_literals> const& literal_bit_lengths, Array<u8, max_huffman_distances> const& distance_bit_lengths, Array<u8, 19> const& code_lengths_bit_lengths, Array<u16, 19> const& code_lengths_frequencies, size_t code_lengths_count);
     ErrorOr<void> flush();
+    ErrorOr<void> sync_flush();
+
+    void set_dictionary(ReadonlyBytes);
 
     bool m_finished { false };
     CompressionLevel m_compression_level;
     CompressionConstants m_compression_constants;
     NonnullOwnPtr<LittleEndianOutputBitStream> m_output_stream;
 
+    // The pending block is preceded by up to block_size bytes of history, which back references can point into.
+    // The hash chains are kept across blocks, only the last m_unhashed_history_size bytes of the history aren't in them yet.
     u8 m_rolling_window[window_size];
+    size_t m_history_size { 0 };
+    size_t m_unhashed_history_size { 0 };
     size_t m_pending_block_size { 0 };
 
     struct [[gnu::packed]] {
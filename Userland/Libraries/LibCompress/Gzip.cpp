@@ -11,6 +11,7 @@
 #include <AK/MemoryStream.h>
 #include <AK/String.h>
 #include <LibCore/DateTime.h>
+#include <LibThreading/WorkStealingThreadPool.h>
 
 namespace Compress {
 
@@ -194,7 +195,7 @@ ErrorOr<Bytes> GzipCompressor::read_some(Bytes)
     return Error::from_errno(EBADF);
 }
 
-ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+ErrorOr<void> GzipCompressor::write_header(Stream& stream)
 {
     BlockHeader header;
     header.identification_1 = 0x1f;
@@ -204,7 +205,13 @@ ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
     header.modification_time = 0;
     header.extra_flags = 3;      // DEFLATE sets 2 for maximum compression and 4 for minimum compression
     header.operating_system = 3; // unix
-    TRY(m_output_stream->write_until_depleted({ &header, sizeof(header) }));
+    TRY(stream.write_until_depleted({ &header, sizeof(header) }));
+    return {};
+}
+
+ErrorOr<size_t> GzipCompressor::write_some(ReadonlyBytes bytes)
+{
+    TRY(write_header(*m_output_stream));
     auto compressed_stream = TRY(DeflateCompressor::construct(MaybeOwned(*m_output_stream)));
     TRY(compressed_stream->write_until_depleted(bytes));
     TRY(compressed_stream->final_flush());
@@ -239,4 +246,79 @@ ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes)
     return output_stream->read_until_eof();
 }
 
+ErrorOr<void> GzipCompressor::compress_in_parallel(Stream& input, Stream& output, size_t thread_count)
+{
+    struct Chunk {
+        ReadonlyBytes dictionary;
+        ReadonlyBytes data;
+        ErrorOr<ByteBuffer> compressed { ByteBuffer {} };
+        u32 crc32 { 0 };
+    };
+
+    constexpr size_t dictionary_size = DeflateCompressor::max_back_reference_distance;
+
+    // The calling thread compresses chunks as well, so it only needs thread_count - 1 helpers.
+    Threading::WorkStealingThreadPool thread_pool { max(thread_count, 2uz) - 1 };
+
+    // Input is read in batches of one chunk per thread. The end of the previous batch is kept in front of the current one,
+    // so that the first chunk of a batch has a dictionary as well.
+    auto batch_size = max(thread_count, 1uz) * parallel_chunk_size;
+    auto buffer = TRY(ByteBuffer::create_uninitialized(dictionary_size + batch_size));
+    auto batch = buffer.bytes().slice(dictionary_size);
+    size_t dictionary_length = 0;
+
+    Vector<Chunk> chunks;
+    TRY(chunks.try_resize(ceil_div(batch_size, parallel_chunk_size)));
+
+    u32 crc32 = 0;
+    u32 total_size = 0;
+
+    TRY(write_header(output));
+
+    while (true) {
+        size_t batch_length = 0;
+        while (batch_length < batch.size() && !input.is_eof())
+            batch_length += TRY(input.read_some(batch.slice(batch_length))).size();
+        if (batch_length == 0)
+            break;
+
+        auto chunk_count = ceil_div(batch_length, parallel_chunk_size);
+        for (size_t i = 0; i < chunk_count; ++i) {
+            auto start = dictionary_size + i * parallel_chunk_size;
+            auto dictionary_start = max(start - dictionary_size, dictionary_size - dictionary_length);
+            chunks[i].dictionary = buffer.bytes().slice(dictionary_start, start - dictionary_start);
+            chunks[i].data = buffer.bytes().slice(start, min(parallel_chunk_size, dictionary_size + batch_length - start));
+        }
+
+        thread_pool.parallel_for_range(chunk_count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                chunks[i].compressed = DeflateCompressor::compress_chunk(chunks[i].dictionary, chunks[i].data);
+                chunks[i].crc32 = Crypto::Checksum::CRC32 { chunks[i].data }.digest();
+            }
+        });
+
+        for (size_t i = 0; i < chunk_count; ++i) {
+            auto compressed = TRY(move(chunks[i].compressed));
+            TRY(output.write_until_depleted(compressed));
+            crc32 = Crypto::Checksum::CRC32::combine(crc32, chunks[i].crc32, chunks[i].data.size());
+        }
+        total_size += batch_length;
+
+        auto new_dictionary_length = min(dictionary_length + batch_length, dictionary_size);
+        memmove(buffer.data() + dictionary_size - new_dictionary_length, buffer.data() + dictionary_size + batch_length - new_dictionary_length, new_dictionary_length);
+        dictionary_length = new_dictionary_length;
+
+        if (batch_length < batch.size())
+            break;
+    }
+
+    // Every chunk ends with a non-final block, so the deflate stream still has to be terminated by an empty final block.
+    auto final_block = TRY(DeflateCompressor::construct(MaybeOwned<Stream>(output)));
+    TRY(final_block->final_flush());
+
+    TRY(output.write_value<LittleEndian<u32>>(crc32));
+    TRY(output.write_value<LittleEndian<u32>>(total_size));
+    return {};
+}
+
 }
@@ -93,7 +93,14 @@ public:
 
     static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes);
 
+    // Compresses all of `input` into a single gzip member. The input is split into chunks that are compressed on up to
+    // `thread_count` threads at once, each using the end of the data before it as its dictionary.
+    static constexpr size_t parallel_chunk_size = 128 * KiB;
+    static ErrorOr<void> compress_in_parallel(Stream& input, Stream& output, size_t thread_count);
+
 private:
+    static ErrorOr<void> write_header(Stream&);
+
     MaybeOwned<Stream> m_output_stream;
 };
 
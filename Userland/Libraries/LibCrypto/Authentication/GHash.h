@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/ByteReader.h>
+#include <AK/CPUFeatures.h>
 #include <AK/Endian.h>
 #include <AK/Types.h>
 #include <LibCrypto/Hash/HashFunction.h>
@@ -43,6 +44,7 @@ public:
         for (size_t i = 0; i < 16; i += 4) {
             m_key[i / 4] = AK::convert_between_host_and_big_endian(ByteReader::load32(key.offset(i)));
         }
+        compute_key_powers();
     }
 
     constexpr static size_t digest_size() { return TagType::Size; }
@@ -54,10 +56,22 @@ public:
     }
 #endif
 
-    TagType process(ReadonlyBytes aad, ReadonlyBytes cipher);
+    TagType process(ReadonlyBytes aad, ReadonlyBytes cipher) { return (this->*process_dispatched)(aad, cipher); }
 
 private:
+    static constexpr size_t blocks_per_aggregated_multiplication = 8;
+
+    void compute_key_powers();
+
+    template<CPUFeatures>
+    TagType process_impl(ReadonlyBytes aad, ReadonlyBytes cipher);
+
+    static TagType (GHash::* const process_dispatched)(ReadonlyBytes aad, ReadonlyBytes cipher);
+
     u32 m_key[4];
+
+    // H^1, H^2, ..., H^8, which let the carry-less multiplication path fold several blocks into the tag with a single reduction.
+    u32 m_key_powers[blocks_per_aggregated_multiplication][4];
 };
 
 }
@@ -10,214 +10,226 @@
 
 namespace Crypto::Authentication {
 
+using DoubleWord = unsigned __int128;
+
+static constexpr u64 mask_44_bits = 0xFFFFFFFFFFF;
+static constexpr u64 mask_42_bits = 0x3FFFFFFFFFF;
+
+ALWAYS_INLINE static u64 load_little_endian(u8 const* data)
+{
+    return AK::convert_between_host_and_little_endian(ByteReader::load64(data));
+}
+
+// Adds a * b to the product d, where d is not reduced yet.
+// Limbs of a * b that go past 2^130 wrap around to the bottom multiplied by 5, since 2^130 = 5 (mod 2^130 - 5).
+// The limbs of b are 44 bits apart in the top limb of a 130-bit number, so that also contributes a factor of 4.
+ALWAYS_INLINE static void multiply_accumulate(DoubleWord (&d)[3], u64 const (&a)[3], u64 const (&b)[3])
+{
+    u64 b1_times_20 = b[1] * 20;
+    u64 b2_times_20 = b[2] * 20;
+
+    d[0] += static_cast<DoubleWord>(a[0]) * b[0] + static_cast<DoubleWord>(a[1]) * b2_times_20 + static_cast<DoubleWord>(a[2]) * b1_times_20;
+    d[1] += static_cast<DoubleWord>(a[0]) * b[1] + static_cast<DoubleWord>(a[1]) * b[0] + static_cast<DoubleWord>(a[2]) * b2_times_20;
+    d[2] += static_cast<DoubleWord>(a[0]) * b[2] + static_cast<DoubleWord>(a[1]) * b[1] + static_cast<DoubleWord>(a[2]) * b[0];
+}
+
+// Carries the product d back into 44-bit limbs. The result is only partially reduced,
+// which is enough to multiply it again.
+ALWAYS_INLINE static void carry(DoubleWord (&d)[3], u64 (&h)[3])
+{
+    u64 c = static_cast<u64>(d[0] >> 44);
+    h[0] = static_cast<u64>(d[0]) & mask_44_bits;
+    d[1] += c;
+    c = static_cast<u64>(d[1] >> 44);
+    h[1] = static_cast<u64>(d[1]) & mask_44_bits;
+    d[2] += c;
+    c = static_cast<u64>(d[2] >> 42);
+    h[2] = static_cast<u64>(d[2]) & mask_42_bits;
+    h[0] += c * 5;
+    c = h[0] >> 44;
+    h[0] &= mask_44_bits;
+    h[1] += c;
+}
+
+// Reads a 16-byte block as a little-endian number and adds 2^128 if high_bit is set.
+ALWAYS_INLINE static void load_block(u8 const* data, u64 high_bit, u64 (&m)[3])
+{
+    u64 t0 = load_little_endian(data);
+    u64 t1 = load_little_endian(data + 8);
+
+    m[0] = t0 & mask_44_bits;
+    m[1] = ((t0 >> 44) | (t1 << 20)) & mask_44_bits;
+    m[2] = ((t1 >> 24) & mask_42_bits) | high_bit;
+}
+
 Poly1305::Poly1305(ReadonlyBytes key)
 {
-    for (size_t i = 0; i < 16; i += 4) {
-        m_state.r[i / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(key.offset(i)));
-    }
+    u64 t0 = load_little_endian(key.offset(0));
+    u64 t1 = load_little_endian(key.offset(8));
 
     // r[3], r[7], r[11], and r[15] are required to have their top four bits clear (be smaller than 16)
     // r[4], r[8], and r[12] are required to have their bottom two bits clear (be divisible by 4)
-    m_state.r[0] &= 0x0FFFFFFF;
-    m_state.r[1] &= 0x0FFFFFFC;
-    m_state.r[2] &= 0x0FFFFFFC;
-    m_state.r[3] &= 0x0FFFFFFC;
-
-    for (size_t i = 16; i < 32; i += 4) {
-        m_state.s[(i - 16) / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(key.offset(i)));
+    auto& r = m_state.r_powers[0];
+    r[0] = t0 & 0xFFC0FFFFFFF;
+    r[1] = ((t0 >> 44) | (t1 << 20)) & 0xFFFFFC0FFFF;
+    r[2] = (t1 >> 24) & 0x00FFFFFFC0F;
+
+    for (size_t i = 1; i < 4; ++i) {
+        DoubleWord d[3] {};
+        multiply_accumulate(d, m_state.r_powers[i - 1], r);
+        carry(d, m_state.r_powers[i]);
     }
+
+    m_state.s[0] = load_little_endian(key.offset(16));
+    m_state.s[1] = load_little_endian(key.offset(24));
 }
 
 void Poly1305::update(ReadonlyBytes message)
 {
+    if (message.is_empty())
+        return;
+
     size_t offset = 0;
-    while (offset < message.size()) {
-        u32 n = min(message.size() - offset, 16 - m_state.block_count);
-        memcpy(m_state.blocks + m_state.block_count, message.offset_pointer(offset), n);
+    if (m_state.block_count != 0) {
+        u32 n = min(message.size(), 16 - m_state.block_count);
+        memcpy(m_state.blocks + m_state.block_count, message.data(), n);
         m_state.block_count += n;
         offset += n;
 
-        if (m_state.block_count == 16) {
-            process_block();
-            m_state.block_count = 0;
-        }
+        if (m_state.block_count < 16)
+            return;
+
+        process_blocks(m_state.blocks, 1, 1ull << 40);
+        m_state.block_count = 0;
     }
+
+    // Whole blocks are read straight from the message, only the rest is buffered.
+    size_t block_count = (message.size() - offset) / 16;
+    process_blocks(message.offset_pointer(offset), block_count, 1ull << 40);
+    offset += block_count * 16;
+
+    m_state.block_count = message.size() - offset;
+    memcpy(m_state.blocks, message.offset_pointer(offset), m_state.block_count);
 }
 
-void Poly1305::process_block()
+// For every block: h = (h + block) * r (mod 2^130 - 5).
+// Four blocks at a time, that is h = (h + block_1) * r^4 + block_2 * r^3 + block_3 * r^2 + block_4 * r,
+// where the four multiplications are independent and share a single reduction.
+void Poly1305::process_blocks(u8 const* data, size_t block_count, u64 high_bit)
 {
-    u32 a[5];
-    u8 n = m_state.block_count;
-
-    // Add one bit beyond the number of octets.  For a 16-byte block,
-    // this is equivalent to adding 2^128 to the number.  For the shorter
-    // block, it can be 2^120, 2^112, or any power of two that is evenly
-    // divisible by 8, all the way down to 2^8.
-    m_state.blocks[n++] = 0x01;
-
-    // If the block is not 17 bytes long (the last block), pad it with zeros.
-    // This is meaningless if you are treating the blocks as numbers.
-    while (n < 17) {
-        m_state.blocks[n++] = 0x00;
+    auto& h = m_state.h;
+    auto const& r_powers = m_state.r_powers;
+
+    for (; block_count >= 4; block_count -= 4, data += 64) {
+        u64 m[4][3];
+        for (size_t i = 0; i < 4; ++i)
+            load_block(data + i * 16, high_bit, m[i]);
+        m[0][0] += h[0];
+        m[0][1] += h[1];
+        m[0][2] += h[2];
+
+        DoubleWord d[3] {};
+        multiply_accumulate(d, m[0], r_powers[3]);
+        multiply_accumulate(d, m[1], r_powers[2]);
+        multiply_accumulate(d, m[2], r_powers[1]);
+        multiply_accumulate(d, m[3], r_powers[0]);
+        carry(d, h);
     }
 
-    // Read the block as a little-endian number.
-    for (size_t i = 0; i < 16; i += 4) {
-        a[i / 4] = AK::convert_between_host_and_little_endian(ByteReader::load32(m_state.blocks + i));
+    for (; block_count > 0; --block_count, data += 16) {
+        u64 m[3];
+        load_block(data, high_bit, m);
+        m[0] += h[0];
+        m[1] += h[1];
+        m[2] += h[2];
+
+        DoubleWord d[3] {};
+        multiply_accumulate(d, m, r_powers[0]);
+        carry(d, h);
     }
-    a[4] = m_state.blocks[16];
-
-    // Add this number to the accumulator.
-    m_state.a[0] += a[0];
-    m_state.a[1] += a[1];
-    m_state.a[2] += a[2];
-    m_state.a[3] += a[3];
-    m_state.a[4] += a[4];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    a[0] = m_state.a[0] & 0xFFFFFFFF;
-    a[1] = m_state.a[1] & 0xFFFFFFFF;
-    a[2] = m_state.a[2] & 0xFFFFFFFF;
-    a[3] = m_state.a[3] & 0xFFFFFFFF;
-    a[4] = m_state.a[4] & 0xFFFFFFFF;
-
-    // Multiply by r
-    m_state.a[0] = (u64)a[0] * m_state.r[0];
-    m_state.a[1] = (u64)a[0] * m_state.r[1] + (u64)a[1] * m_state.r[0];
-    m_state.a[2] = (u64)a[0] * m_state.r[2] + (u64)a[1] * m_state.r[1] + (u64)a[2] * m_state.r[0];
-    m_state.a[3] = (u64)a[0] * m_state.r[3] + (u64)a[1] * m_state.r[2] + (u64)a[2] * m_state.r[1] + (u64)a[3] * m_state.r[0];
-    m_state.a[4] = (u64)a[1] * m_state.r[3] + (u64)a[2] * m_state.r[2] + (u64)a[3] * m_state.r[1] + (u64)a[4] * m_state.r[0];
-    m_state.a[5] = (u64)a[2] * m_state.r[3] + (u64)a[3] * m_state.r[2] + (u64)a[4] * m_state.r[1];
-    m_state.a[6] = (u64)a[3] * m_state.r[3] + (u64)a[4] * m_state.r[2];
-    m_state.a[7] = (u64)a[4] * m_state.r[3];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-    m_state.a[5] += m_state.a[4] >> 32;
-    m_state.a[6] += m_state.a[5] >> 32;
-    m_state.a[7] += m_state.a[6] >> 32;
-
-    // Save the high part of the accumulator
-    a[0] = m_state.a[4] & 0xFFFFFFFC;
-    a[1] = m_state.a[5] & 0xFFFFFFFF;
-    a[2] = m_state.a[6] & 0xFFFFFFFF;
-    a[3] = m_state.a[7] & 0xFFFFFFFF;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
-
-    // Fast modular reduction (first pass)
-    m_state.a[0] += a[0];
-    m_state.a[0] += (a[0] >> 2) | (a[1] << 30);
-    m_state.a[1] += a[1];
-    m_state.a[1] += (a[1] >> 2) | (a[2] << 30);
-    m_state.a[2] += a[2];
-    m_state.a[2] += (a[2] >> 2) | (a[3] << 30);
-    m_state.a[3] += a[3];
-    m_state.a[3] += (a[3] >> 2);
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Save the high part of the accumulator
-    a[0] = m_state.a[4] & 0xFFFFFFFC;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
-
-    // Fast modular reduction (second pass)
-    m_state.a[0] += a[0];
-    m_state.a[0] += a[0] >> 2;
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    m_state.a[0] &= 0xFFFFFFFF;
-    m_state.a[1] &= 0xFFFFFFFF;
-    m_state.a[2] &= 0xFFFFFFFF;
-    m_state.a[3] &= 0xFFFFFFFF;
-    m_state.a[4] &= 0x00000003;
 }
 
 ErrorOr<ByteBuffer> Poly1305::digest()
 {
-    if (m_state.block_count != 0)
-        process_block();
-
-    u32 b[4];
-
-    // Save the accumulator
-    b[0] = m_state.a[0] & 0xFFFFFFFF;
-    b[1] = m_state.a[1] & 0xFFFFFFFF;
-    b[2] = m_state.a[2] & 0xFFFFFFFF;
-    b[3] = m_state.a[3] & 0xFFFFFFFF;
-
-    // Compute a + 5
-    m_state.a[0] += 5;
+    if (m_state.block_count != 0) {
+        // Add one bit beyond the number of octets.  For a 16-byte block,
+        // this is equivalent to adding 2^128 to the number.  For the shorter
+        // block, it can be 2^120, 2^112, or any power of two that is evenly
+        // divisible by 8, all the way down to 2^8.
+        u8 n = m_state.block_count;
+        m_state.blocks[n++] = 0x01;
+
+        // If the block is not 16 bytes long (the last block), pad it with zeros.
+        // This is meaningless if you are treating the blocks as numbers.
+        while (n < 16)
+            m_state.blocks[n++] = 0x00;
+
+        process_blocks(m_state.blocks, 1, 0);
+    }
 
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
+    u64 h0 = m_state.h[0];
+    u64 h1 = m_state.h[1];
+    u64 h2 = m_state.h[2];
+
+    // Fully carry the accumulator
+    u64 c = h1 >> 44;
+    h1 &= mask_44_bits;
+    h2 += c;
+    c = h2 >> 42;
+    h2 &= mask_42_bits;
+    h0 += c * 5;
+    c = h0 >> 44;
+    h0 &= mask_44_bits;
+    h1 += c;
+    c = h1 >> 44;
+    h1 &= mask_44_bits;
+    h2 += c;
+    c = h2 >> 42;
+    h2 &= mask_42_bits;
+    h0 += c * 5;
+    c = h0 >> 44;
+    h0 &= mask_44_bits;
+    h1 += c;
+
+    // Compute a + 5 - 2^130
+    u64 g0 = h0 + 5;
+    c = g0 >> 44;
+    g0 &= mask_44_bits;
+    u64 g1 = h1 + c;
+    c = g1 >> 44;
+    g1 &= mask_44_bits;
+    u64 g2 = h2 + c - (1ull << 42);
 
     // Select mask based on (a + 5) >= 2^130
-    u32 mask = ((m_state.a[4] & 0x04) >> 2) - 1;
+    u64 mask = (g2 >> 63) - 1;
 
     // Select based on mask
-    m_state.a[0] = (m_state.a[0] & ~mask) | (b[0] & mask);
-    m_state.a[1] = (m_state.a[1] & ~mask) | (b[1] & mask);
-    m_state.a[2] = (m_state.a[2] & ~mask) | (b[2] & mask);
-    m_state.a[3] = (m_state.a[3] & ~mask) | (b[3] & mask);
+    h0 = (h0 & ~mask) | (g0 & mask);
+    h1 = (h1 & ~mask) | (g1 & mask);
+    h2 = (h2 & ~mask) | (g2 & mask);
 
     // Finally, the value of the secret key "s" is added to the accumulator,
     // and the 128 least significant bits are serialized in little-endian
     // order to form the tag.
-    m_state.a[0] += m_state.s[0];
-    m_state.a[1] += m_state.s[1];
-    m_state.a[2] += m_state.s[2];
-    m_state.a[3] += m_state.s[3];
-
-    // Carry
-    m_state.a[1] += m_state.a[0] >> 32;
-    m_state.a[2] += m_state.a[1] >> 32;
-    m_state.a[3] += m_state.a[2] >> 32;
-    m_state.a[4] += m_state.a[3] >> 32;
-
-    // Only consider the least significant bits
-    b[0] = m_state.a[0] & 0xFFFFFFFF;
-    b[1] = m_state.a[1] & 0xFFFFFFFF;
-    b[2] = m_state.a[2] & 0xFFFFFFFF;
-    b[3] = m_state.a[3] & 0xFFFFFFFF;
+    u64 s0 = m_state.s[0];
+    u64 s1 = m_state.s[1];
+    h0 += s0 & mask_44_bits;
+    c = h0 >> 44;
+    h0 &= mask_44_bits;
+    h1 += (((s0 >> 44) | (s1 << 20)) & mask_44_bits) + c;
+    c = h1 >> 44;
+    h1 &= mask_44_bits;
+    h2 += ((s1 >> 24) & mask_42_bits) + c;
+
+    u64 tag[2] {
+        h0 | (h1 << 44),
+        (h1 >> 20) | (h2 << 24),
+    };
 
     ByteBuffer output = TRY(ByteBuffer::create_uninitialized(16));
 
-    for (auto i = 0; i < 4; i++) {
-        ByteReader::store(output.offset_pointer(i * 4), AK::convert_between_host_and_little_endian(b[i]));
+    for (auto i = 0; i < 2; i++) {
+        ByteReader::store(output.offset_pointer(i * 8), AK::convert_between_host_and_little_endian(tag[i]));
     }
 
     return output;
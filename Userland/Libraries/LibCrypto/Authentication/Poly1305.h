@@ -10,11 +10,14 @@
 
 namespace Crypto::Authentication {
 
+// Numbers modulo 2^130 - 5 are stored in three limbs of 44, 44 and 42 bits, so that products of limbs
+// fit into 128 bits with plenty of room to spare, and several of them can be summed before carrying.
 struct State {
-    u32 r[4] {};
-    u32 s[4] {};
-    u64 a[8] {};
-    u8 blocks[17] {};
+    // r, r^2, r^3 and r^4, used to process several blocks per reduction.
+    u64 r_powers[4][3] {};
+    u64 s[2] {};
+    u64 h[3] {};
+    u8 blocks[16] {};
     u8 block_count {};
 };
 
@@ -26,7 +29,7 @@ public:
     ErrorOr<ByteBuffer> digest();
 
 private:
-    void process_block();
+    void process_blocks(u8 const* data, size_t block_count, u64 high_bit);
 
     State m_state;
 };
@@ -9,38 +9,266 @@
 
 namespace Crypto {
 
+using Word = UnsignedBigInteger::Word;
+using DoubleWord = u64;
+static_assert(sizeof(DoubleWord) == 2 * sizeof(Word));
+
+// Below these sizes (in words), the quadratic algorithms are faster than Karatsuba's.
+static constexpr size_t karatsuba_multiplication_threshold = 32;
+static constexpr size_t karatsuba_squaring_threshold = 48;
+
+// output[0, left_length + right_length) = left * right
+static void schoolbook_multiply(Word const* left, size_t left_length, Word const* right, size_t right_length, Word* output)
+{
+    __builtin_memset(output, 0, left_length * sizeof(Word));
+    for (size_t j = 0; j < right_length; ++j) {
+        DoubleWord carry = 0;
+        DoubleWord multiplier = right[j];
+        for (size_t i = 0; i < left_length; ++i) {
+            // (2^32 - 1)^2 + 2 * (2^32 - 1) = 2^64 - 1, so this can't overflow.
+            DoubleWord product = left[i] * multiplier + output[i + j] + carry;
+            output[i + j] = static_cast<Word>(product);
+            carry = product >> UnsignedBigInteger::BITS_IN_WORD;
+        }
+        output[left_length + j] = static_cast<Word>(carry);
+    }
+}
+
+// output[0, 2 * length) = value * value
+static void schoolbook_square(Word const* value, size_t length, Word* output)
+{
+    // Every product value[i] * value[j] with i != j appears twice, so sum them once and double that.
+    __builtin_memset(output, 0, 2 * length * sizeof(Word));
+    for (size_t i = 0; i < length; ++i) {
+        DoubleWord carry = 0;
+        DoubleWord multiplier = value[i];
+        for (size_t j = i + 1; j < length; ++j) {
+            DoubleWord product = value[j] * multiplier + output[i + j] + carry;
+            output[i + j] = static_cast<Word>(product);
+            carry = product >> UnsignedBigInteger::BITS_IN_WORD;
+        }
+        output[i + length] = static_cast<Word>(carry);
+    }
+
+    Word shifted_out = 0;
+    for (size_t i = 0; i < 2 * length; ++i) {
+        Word word = output[i];
+        output[i] = (word << 1) | shifted_out;
+        shifted_out = word >> (UnsignedBigInteger::BITS_IN_WORD - 1);
+    }
+
+    DoubleWord carry = 0;
+    for (size_t i = 0; i < length; ++i) {
+        DoubleWord square = static_cast<DoubleWord>(value[i]) * value[i];
+        DoubleWord low = static_cast<DoubleWord>(output[2 * i]) + static_cast<Word>(square) + carry;
+        output[2 * i] = static_cast<Word>(low);
+        DoubleWord high = static_cast<DoubleWord>(output[2 * i + 1]) + (square >> UnsignedBigInteger::BITS_IN_WORD) + (low >> UnsignedBigInteger::BITS_IN_WORD);
+        output[2 * i + 1] = static_cast<Word>(high);
+        carry = high >> UnsignedBigInteger::BITS_IN_WORD;
+    }
+}
+
+// accumulator[0, accumulator_length) += value[0, value_length), returns the carry out of the accumulator.
+static Word add_words(Word* accumulator, size_t accumulator_length, Word const* value, size_t value_length)
+{
+    DoubleWord carry = 0;
+    size_t i = 0;
+    for (; i < value_length; ++i) {
+        DoubleWord sum = static_cast<DoubleWord>(accumulator[i]) + value[i] + carry;
+        accumulator[i] = static_cast<Word>(sum);
+        carry = sum >> UnsignedBigInteger::BITS_IN_WORD;
+    }
+    for (; carry != 0 && i < accumulator_length; ++i) {
+        DoubleWord sum = static_cast<DoubleWord>(accumulator[i]) + carry;
+        accumulator[i] = static_cast<Word>(sum);
+        carry = sum >> UnsignedBigInteger::BITS_IN_WORD;
+    }
+    return static_cast<Word>(carry);
+}
+
+// accumulator[0, accumulator_length) -= value[0, value_length), the result must not be negative.
+static void subtract_words(Word* accumulator, size_t accumulator_length, Word const* value, size_t value_length)
+{
+    Word borrow = 0;
+    size_t i = 0;
+    for (; i < value_length; ++i) {
+        DoubleWord difference = static_cast<DoubleWord>(accumulator[i]) - value[i] - borrow;
+        accumulator[i] = static_cast<Word>(difference);
+        borrow = (difference >> UnsignedBigInteger::BITS_IN_WORD) != 0;
+    }
+    for (; borrow != 0 && i < accumulator_length; ++i) {
+        borrow = accumulator[i] == 0;
+        --accumulator[i];
+    }
+    VERIFY(borrow == 0);
+}
+
+static size_t karatsuba_scratch_length(size_t length, size_t threshold)
+{
+    size_t scratch_length = 0;
+    while (length >= threshold) {
+        size_t high_length = length - length / 2;
+        // Room for the two sums of halves and their product, then whatever the recursion on that product needs.
+        scratch_length += 4 * (high_length + 1);
+        length = high_length + 1;
+    }
+    return scratch_length;
+}
+
+/**
+ * Karatsuba's algorithm, with l = left, r = right and B = 2^(32 * low_length):
+ *     l * r = (l1 * B + l0) * (r1 * B + r0)
+ *           = l1 * r1 * B^2 + ((l0 + l1) * (r0 + r1) - l0 * r0 - l1 * r1) * B + l0 * r0
+ * which needs three half-sized multiplications instead of four, for a complexity of O(N^log2(3)).
+ * When left and right are the same number, all three multiplications are squares.
+ */
+static void multiply_same_length(Word const* left, Word const* right, size_t length, Word* output, Word* scratch)
+{
+    bool is_square = left == right;
+    if (length < (is_square ? karatsuba_squaring_threshold : karatsuba_multiplication_threshold)) {
+        if (is_square)
+            schoolbook_square(left, length, output);
+        else
+            schoolbook_multiply(left, length, right, length, output);
+        return;
+    }
+
+    size_t low_length = length / 2;
+    size_t high_length = length - low_length;
+    size_t sum_length = high_length + 1;
+
+    // l0 * r0 and l1 * r1 go straight into their places in the output.
+    multiply_same_length(left, right, low_length, output, scratch);
+    multiply_same_length(left + low_length, right + low_length, high_length, output + 2 * low_length, scratch);
+
+    Word* left_sum = scratch;
+    Word* right_sum = scratch + sum_length;
+    Word* middle = scratch + 2 * sum_length;
+    Word* rest_of_scratch = middle + 2 * sum_length;
+
+    __builtin_memcpy(left_sum, left + low_length, high_length * sizeof(Word));
+    left_sum[high_length] = add_words(left_sum, high_length, left, low_length);
+    if (!is_square) {
+        __builtin_memcpy(right_sum, right + low_length, high_length * sizeof(Word));
+        right_sum[high_length] = add_words(right_sum, high_length, right, low_length);
+    }
+
+    multiply_same_length(left_sum, is_square ? left_sum : right_sum, sum_length, middle, rest_of_scratch);
+    subtract_words(middle, 2 * sum_length, output, 2 * low_length);
+    subtract_words(middle, 2 * sum_length, output + 2 * low_length, 2 * high_length);
+
+    // The middle term is less than 2^(32 * length + 1), so the words past the end of the output are zero.
+    size_t output_length = 2 * length;
+    size_t middle_length = min(2 * sum_length, output_length - low_length);
+    auto carry = add_words(output + low_length, output_length - low_length, middle, middle_length);
+    VERIFY(carry == 0);
+}
+
+static size_t multiplication_scratch_length(size_t longer_length, size_t shorter_length)
+{
+    if (shorter_length < karatsuba_multiplication_threshold)
+        return 0;
+    size_t scratch_length = karatsuba_scratch_length(shorter_length, karatsuba_multiplication_threshold);
+    if (longer_length != shorter_length)
+        scratch_length += 3 * shorter_length;
+    return scratch_length;
+}
+
+static void multiply(Word const* left, size_t left_length, Word const* right, size_t right_length, Word* output, Word* scratch)
+{
+    if (left_length < right_length) {
+        swap(left, right);
+        swap(left_length, right_length);
+    }
+
+    if (right_length < karatsuba_multiplication_threshold) {
+        schoolbook_multiply(left, left_length, right, right_length, output);
+        return;
+    }
+
+    if (left_length == right_length) {
+        multiply_same_length(left, right, right_length, output, scratch);
+        return;
+    }
+
+    // Split the longer number into pieces as long as the shorter one, and add up their products.
+    // The last piece is padded with zeros to keep all multiplications balanced.
+    Word* product = scratch;
+    Word* padded_piece = scratch + 2 * right_length;
+    Word* rest_of_scratch = padded_piece + right_length;
+
+    size_t output_length = left_length + right_length;
+    __builtin_memset(output, 0, output_length * sizeof(Word));
+    for (size_t offset = 0; offset < left_length; offset += right_length) {
+        auto piece = left + offset;
+        size_t piece_length = min(right_length, left_length - offset);
+        if (piece_length < right_length) {
+            __builtin_memcpy(padded_piece, piece, piece_length * sizeof(Word));
+            __builtin_memset(padded_piece + piece_length, 0, (right_length - piece_length) * sizeof(Word));
+            piece = padded_piece;
+        }
+        multiply_same_length(piece, right, right_length, product, rest_of_scratch);
+        add_words(output + offset, output_length - offset, product, min(2 * right_length, output_length - offset));
+    }
+}
+
 /**
- * Complexity: O(N^2) where N is the number of words in the larger number
+ * Complexity: O(N^2) where N is the number of words in the smaller number, and
+ * O(N^1.58) once both numbers are larger than karatsuba_multiplication_threshold words.
  * Multiplication method:
- * An integer is equal to the sum of the powers of two
- * according to the indices of its 'on' bits.
- * So to multiple x*y, we go over each '1' bit in x (say the i'th bit),
- * and add y<<i to the result.
+ * The product of every pair of words is added to the result at the sum of their indices,
+ * using 64-bit multiplications. Large numbers are split in halves, see multiply_same_length().
  */
 FLATTEN void UnsignedBigIntegerAlgorithms::multiply_without_allocation(
     UnsignedBigInteger const& left,
     UnsignedBigInteger const& right,
-    UnsignedBigInteger& temp_shift_result,
-    UnsignedBigInteger& temp_shift_plus,
-    UnsignedBigInteger& temp_shift,
+    UnsignedBigInteger& temp_scratch,
     UnsignedBigInteger& output)
 {
+    if (&left == &right) {
+        square_without_allocation(left, temp_scratch, output);
+        return;
+    }
+
+    VERIFY(&output != &left && &output != &right);
+
+    size_t left_length = left.trimmed_length();
+    size_t right_length = right.trimmed_length();
+
     output.set_to_0();
+    if (left_length == 0 || right_length == 0)
+        return;
 
-    // iterate all bits
-    for (size_t word_index = 0; word_index < left.length(); ++word_index) {
-        for (size_t bit_index = 0; bit_index < UnsignedBigInteger::BITS_IN_WORD; ++bit_index) {
-            // If the bit is off - skip over it
-            if (!(left.m_words[word_index] & (1 << bit_index)))
-                continue;
+    temp_scratch.m_words.resize_and_keep_capacity(multiplication_scratch_length(max(left_length, right_length), min(left_length, right_length)));
+    output.m_words.resize_and_keep_capacity(left_length + right_length);
 
-            size_t shift_amount = word_index * UnsignedBigInteger::BITS_IN_WORD + bit_index;
+    multiply(left.m_words.data(), left_length, right.m_words.data(), right_length, output.m_words.data(), temp_scratch.m_words.data());
+    output.clamp_to_trimmed_length();
+}
 
-            // output += (right << shift_amount);
-            shift_left_without_allocation(right, shift_amount, temp_shift_result, temp_shift_plus, temp_shift);
-            add_into_accumulator_without_allocation(output, temp_shift);
-        }
-    }
+/**
+ * Complexity: Same as multiplication, with about half the word multiplications.
+ * Squaring method:
+ * Each cross product value[i] * value[j] is computed once and doubled, then the squares of each word are added.
+ */
+FLATTEN void UnsignedBigIntegerAlgorithms::square_without_allocation(
+    UnsignedBigInteger const& value,
+    UnsignedBigInteger& temp_scratch,
+    UnsignedBigInteger& output)
+{
+    VERIFY(&output != &value);
+
+    size_t length = value.trimmed_length();
+
+    output.set_to_0();
+    if (length == 0)
+        return;
+
+    temp_scratch.m_words.resize_and_keep_capacity(karatsuba_scratch_length(length, karatsuba_squaring_threshold));
+    output.m_words.resize_and_keep_capacity(2 * length);
+
+    multiply_same_length(value.m_words.data(), value.m_words.data(), length, output.m_words.data(), temp_scratch.m_words.data());
+    output.clamp_to_trimmed_length();
 }
 
 }
@@ -16,6 +16,8 @@
 
 namespace Crypto::Checksum {
 
+static constexpr u32 ethernet_polynomial = 0xEDB88320;
+
 #if defined(__ARM_ACLE) && __ARM_ARCH >= 8 && defined(__ARM_FEATURE_CRC32)
 void CRC32::update(ReadonlyBytes span)
 {
@@ -50,8 +52,6 @@ void CRC32::update(ReadonlyBytes span)
 
 #else
 
-static constexpr size_t ethernet_polynomial = 0xEDB88320;
-
 #    if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
 
 // This implements Intel's slicing-by-8 algorithm. Their original paper is no longer on their website,
@@ -174,4 +174,43 @@ u32 CRC32::digest()
     return ~m_state;
 }
 
+// The bit-reflected representation used by CRC32 stores the coefficient of x^0 in the most significant bit.
+static constexpr u32 polynomial_one = 1u << 31;
+
+// Multiplies two polynomials modulo the CRC32 polynomial.
+static constexpr u32 multiply_modulo_polynomial(u32 a, u32 b)
+{
+    u32 product = 0;
+    for (u32 bit = polynomial_one; bit != 0; bit >>= 1) {
+        if (a & bit)
+            product ^= b;
+        b = (b >> 1) ^ ((b & 1) * ethernet_polynomial);
+    }
+    return product;
+}
+
+// x^(2^n) modulo the CRC32 polynomial. Since x^(2^32) == x modulo this polynomial, the powers repeat after 32 entries.
+static constexpr auto generate_power_table()
+{
+    Array<u32, 32> powers {};
+    powers[0] = polynomial_one >> 1;
+    for (size_t i = 1; i < powers.size(); ++i)
+        powers[i] = multiply_modulo_polynomial(powers[i - 1], powers[i - 1]);
+    return powers;
+}
+
+static constexpr auto power_table = generate_power_table();
+
+u32 CRC32::combine(u32 first_checksum, u32 second_checksum, u64 second_length)
+{
+    // Appending n bytes to a message multiplies its CRC by x^(8n), after which the CRC of the appended bytes can simply be added.
+    // The pre- and post-conditioning with ~0 cancels out between the two checksums, so this works on the final digests.
+    u32 shift = polynomial_one;
+    for (size_t n = 3; second_length != 0; second_length >>= 1, ++n) {
+        if (second_length & 1)
+            shift = multiply_modulo_polynomial(power_table[n % power_table.size()], shift);
+    }
+    return multiply_modulo_polynomial(shift, first_checksum) ^ second_checksum;
+}
+
 }
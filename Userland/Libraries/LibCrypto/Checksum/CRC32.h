@@ -29,6 +29,9 @@ public:
     virtual void update(ReadonlyBytes data) override;
     virtual u32 digest() override;
 
+    // Returns the CRC32 of the concatenation of two pieces of data, given the CRC32 of both pieces and the length of the second one.
+    static u32 combine(u32 first_checksum, u32 second_checksum, u64 second_length);
+
 private:
     u32 m_state { ~0u };
 };
@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
 #include <AK/ByteReader.h>
 #include <AK/Endian.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <LibCrypto/Cipher/ChaCha20.h>
 
 namespace Crypto::Cipher {
@@ -111,9 +114,123 @@ void ChaCha20::do_quarter_round(u32& a, u32& b, u32& c, u32& d)
     rotl(b, 7);
 }
 
-void ChaCha20::run_cipher(ReadonlyBytes input, Bytes output)
+template<typename VectorType>
+ALWAYS_INLINE static VectorType rotate_left(VectorType x, u32 n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static void quarter_round(VectorType& a, VectorType& b, VectorType& c, VectorType& d)
+{
+    a += b;
+    d = rotate_left(d ^ a, 16);
+    c += d;
+    b = rotate_left(b ^ c, 12);
+    a += b;
+    d = rotate_left(d ^ a, 8);
+    c += d;
+    b = rotate_left(b ^ c, 7);
+}
+
+// Generates one keystream block per vector lane, with consecutive block counters, and XORs them into the output.
+// Word i of every block lives in vector i, so the quarter rounds are the same as for a single block.
+template<typename VectorType>
+ALWAYS_INLINE static void xor_keystream_blocks(u32 const (&state)[16], u8 const* input, u8* output)
+{
+    constexpr size_t lane_count = sizeof(VectorType) / sizeof(u32);
+
+    VectorType lane_offsets;
+    for (size_t lane = 0; lane < lane_count; ++lane)
+        lane_offsets[lane] = lane;
+
+    VectorType initial[16];
+    for (size_t i = 0; i < 16; ++i)
+        initial[i] = VectorType {} + state[i];
+
+    // Increment the block counter, and carry over to word 13 (lanes that wrapped around compare as -1)
+    initial[12] += lane_offsets;
+    initial[13] -= bit_cast<VectorType>(initial[12] < lane_offsets);
+
+    VectorType x[16];
+    for (size_t i = 0; i < 16; ++i)
+        x[i] = initial[i];
+
+    for (u32 i = 0; i < 20; i += 2) {
+        quarter_round(x[0], x[4], x[8], x[12]);
+        quarter_round(x[1], x[5], x[9], x[13]);
+        quarter_round(x[2], x[6], x[10], x[14]);
+        quarter_round(x[3], x[7], x[11], x[15]);
+
+        quarter_round(x[0], x[5], x[10], x[15]);
+        quarter_round(x[1], x[6], x[11], x[12]);
+        quarter_round(x[2], x[7], x[8], x[13]);
+        quarter_round(x[3], x[4], x[9], x[14]);
+    }
+
+    for (size_t i = 0; i < 16; ++i)
+        x[i] += initial[i];
+
+    for (size_t lane = 0; lane < lane_count; ++lane) {
+        u32 block[16];
+        for (size_t i = 0; i < 16; ++i)
+            block[i] = AK::convert_between_host_and_little_endian(x[i][lane]);
+
+        for (size_t i = 0; i < 64; i += 16) {
+            auto key_block = AK::SIMD::load_unaligned<AK::SIMD::u32x4>(reinterpret_cast<u8 const*>(block) + i);
+            auto input_block = AK::SIMD::load_unaligned<AK::SIMD::u32x4>(input + lane * 64 + i);
+            AK::SIMD::store_unaligned(output + lane * 64 + i, input_block ^ key_block);
+        }
+    }
+}
+
+template<typename VectorType>
+ALWAYS_INLINE static size_t xor_keystream(u32 (&state)[16], ReadonlyBytes input, Bytes output)
 {
+    constexpr size_t lane_count = sizeof(VectorType) / sizeof(u32);
+    constexpr size_t stride = lane_count * 64;
+
     size_t offset = 0;
+    for (; input.size() - offset >= stride; offset += stride) {
+        xor_keystream_blocks<VectorType>(state, input.offset_pointer(offset), output.offset_pointer(offset));
+
+        u64 counter = ((static_cast<u64>(state[13]) << 32) | state[12]) + lane_count;
+        state[12] = static_cast<u32>(counter);
+        state[13] = static_cast<u32>(counter >> 32);
+    }
+    return offset;
+}
+
+template<>
+size_t ChaCha20::run_cipher_blocks_impl<CPUFeatures::None>(ReadonlyBytes input, Bytes output)
+{
+    return xor_keystream<AK::SIMD::u32x4>(m_state, input, output);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+template<>
+[[gnu::target("avx2")]] size_t ChaCha20::run_cipher_blocks_impl<CPUFeatures::X86_AVX2>(ReadonlyBytes input, Bytes output)
+{
+    size_t offset = xor_keystream<AK::SIMD::u32x8>(m_state, input, output);
+    return offset + xor_keystream<AK::SIMD::u32x4>(m_state, input.slice(offset), output.slice(offset));
+}
+#endif
+
+decltype(ChaCha20::run_cipher_blocks_dispatched) ChaCha20::run_cipher_blocks_dispatched = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+        if (has_flag(features, CPUFeatures::X86_AVX2))
+            return &ChaCha20::run_cipher_blocks_impl<CPUFeatures::X86_AVX2>;
+    }
+
+    return &ChaCha20::run_cipher_blocks_impl<CPUFeatures::None>;
+}();
+
+void ChaCha20::run_cipher(ReadonlyBytes input, Bytes output)
+{
+    // Whole blocks are handled several at a time, the rest one block at a time below.
+    size_t offset = (this->*run_cipher_blocks_dispatched)(input, output);
     size_t block_offset = 0;
     while (offset < input.size()) {
         if (block_offset == 0 || block_offset >= 64) {
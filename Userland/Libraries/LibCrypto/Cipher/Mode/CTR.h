@@ -170,6 +170,41 @@ protected:
         size_t offset { 0 };
         auto block_size = cipher.block_size();
 
+        if constexpr (requires(ReadonlyBytes blocks_in, Bytes blocks_out) { cipher.encrypt_blocks(blocks_in, blocks_out); }) {
+            // Encrypt several counter blocks in one go, so the cipher can work on them in parallel.
+            constexpr size_t blocks_per_batch = 8;
+            u8 key_stream[blocks_per_batch * T::BlockType::block_size()];
+
+            while (length > 0) {
+                auto batch_size = min(length, sizeof(key_stream));
+                auto batch_blocks = ceil_div(batch_size, block_size);
+                for (size_t i = 0; i < batch_blocks; ++i) {
+                    __builtin_memcpy(key_stream + i * block_size, iv.data(), block_size);
+                    increment(iv);
+                }
+
+                Bytes key_stream_bytes { key_stream, batch_blocks * block_size };
+                cipher.encrypt_blocks(key_stream_bytes, key_stream_bytes);
+
+                VERIFY(offset + batch_size <= out.size());
+                auto* output = out.offset_pointer(offset);
+                if (in) {
+                    auto const* input = in->offset_pointer(offset);
+                    for (size_t i = 0; i < batch_size; ++i)
+                        output[i] = input[i] ^ key_stream[i];
+                } else {
+                    __builtin_memcpy(output, key_stream, batch_size);
+                }
+
+                length -= batch_size;
+                offset += batch_size;
+            }
+
+            if (ivec_out)
+                __builtin_memcpy(ivec_out->data(), iv.data(), min(ivec_out->size(), IV_length()));
+            return;
+        }
+
         while (length > 0) {
             m_cipher_block.overwrite(iv.slice(0, block_size));
 
@@ -5,10 +5,13 @@
  */
 
 #include <AK/Checked.h>
+#include <AK/SIMDExtras.h>
 #include <LibGfx/CMYKBitmap.h>
 
 namespace Gfx {
 
+using AK::SIMD::u32x8;
+
 ErrorOr<NonnullRefPtr<CMYKBitmap>> CMYKBitmap::create_with_size(IntSize const& size)
 {
     VERIFY(size.width() >= 0 && size.height() >= 0);
@@ -27,10 +30,26 @@ ErrorOr<RefPtr<Bitmap>> CMYKBitmap::to_low_quality_rgb() const
         m_rgb_bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { m_size.width(), m_size.height() }));
 
         for (int y = 0; y < m_size.height(); ++y) {
-            for (int x = 0; x < m_size.width(); ++x) {
-                auto const& cmyk = scanline(y)[x];
+            auto const* cmyk_scanline = scanline(y);
+            auto* rgb_scanline = m_rgb_bitmap->scanline(y);
+
+            int x = 0;
+            for (; x + 8 <= m_size.width(); x += 8) {
+                static_assert(sizeof(CMYK) == sizeof(u32));
+                auto const pixels = AK::SIMD::load_unaligned<u32x8>(cmyk_scanline + x);
+                auto const k = 255 - (pixels >> 24);
+                auto const scale = [&](u32x8 component) {
+                    // (v + 1 + (v >> 8)) >> 8 is v / 255 for all the products of two bytes.
+                    auto const product = (255 - (component & 0xFF)) * k;
+                    return (product + 1 + (product >> 8)) >> 8;
+                };
+                AK::SIMD::store_unaligned(rgb_scanline + x, 0xFF000000 | scale(pixels) << 16 | scale(pixels >> 8) << 8 | scale(pixels >> 16));
+            }
+
+            for (; x < m_size.width(); ++x) {
+                auto const& cmyk = cmyk_scanline[x];
                 u8 k = 255 - cmyk.k;
-                m_rgb_bitmap->scanline(y)[x] = Color((255 - cmyk.c) * k / 255, (255 - cmyk.m) * k / 255, (255 - cmyk.y) * k / 255).value();
+                rgb_scanline[x] = Color((255 - cmyk.c) * k / 255, (255 - cmyk.m) * k / 255, (255 - cmyk.y) * k / 255).value();
             }
         }
     }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/ByteBuffer.h>
+#include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
@@ -53,6 +54,10 @@ protected:
     mutable HashMap<StringView, String> m_main_tags;
 };
 
+// Invoked while a frame is being decoded, once the pixels in the given rect of the frame's bitmap are final.
+// The rest of the bitmap is undefined until frame() returns.
+using PartialFrameCallback = Function<void(Bitmap const&, IntRect const&)>;
+
 enum class NaturalFrameFormat {
     RGB,
     Grayscale,
@@ -92,6 +97,9 @@ public:
     virtual ErrorOr<NonnullRefPtr<CMYKBitmap>> cmyk_frame() { VERIFY_NOT_REACHED(); }
     virtual ErrorOr<VectorImageFrameDescriptor> vector_frame(size_t) { VERIFY_NOT_REACHED(); }
 
+    // Override this if the format can make parts of a frame available before all of it has been decoded.
+    virtual void set_partial_frame_callback(PartialFrameCallback) { }
+
 protected:
     ImageDecoderPlugin() = default;
 };
@@ -122,6 +130,8 @@ public:
     // Call only if natural_frame_format() == NaturalFrameFormat::Vector.
     ErrorOr<VectorImageFrameDescriptor> vector_frame(size_t index) { return m_plugin->vector_frame(index); }
 
+    void set_partial_frame_callback(PartialFrameCallback callback) { m_plugin->set_partial_frame_callback(move(callback)); }
+
 private:
     explicit ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin>);
 
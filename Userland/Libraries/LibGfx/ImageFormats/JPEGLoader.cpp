@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/CPUFeatures.h>
 #include <AK/Debug.h>
 #include <AK/Endian.h>
 #include <AK/Error.h>
@@ -14,6 +15,8 @@
 #include <AK/Math/Trigonometry.h>
 #include <AK/MemoryStream.h>
 #include <AK/NumericLimits.h>
+#include <AK/SIMDExtras.h>
+#include <AK/SIMDMath.h>
 #include <AK/String.h>
 #include <AK/Try.h>
 #include <AK/Vector.h>
@@ -21,9 +24,12 @@
 #include <LibGfx/ImageFormats/JPEGShared.h>
 #include <LibGfx/ImageFormats/TIFFLoader.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibThreading/WorkStealingThreadPool.h>
 
 namespace Gfx {
 
+using AK::SIMD::f32x8, AK::SIMD::i16x8, AK::SIMD::i32x8, AK::SIMD::u16x8, AK::SIMD::u32x8;
+
 struct MacroblockMeta {
     u32 total { 0 };
     u32 padded_total { 0 };
@@ -233,6 +239,39 @@ public:
         return m_saved_marker;
     }
 
+    // Copies the entropy-coded data of a scan to `data`, up to the first marker that isn't a restart marker.
+    // That marker is then saved, like HuffmanStream does when running into it. The offsets of the RSTn
+    // markers that were found in `data` are stored in `restart_marker_offsets`.
+    ErrorOr<void> read_entropy_coded_data(Vector<u8>& data, Vector<size_t>& restart_marker_offsets)
+    {
+        VERIFY(!m_saved_marker.has_value());
+
+        for (;;) {
+            u8 const byte = TRY(read_u8());
+            if (byte != 0xFF) {
+                TRY(data.try_append(byte));
+                continue;
+            }
+
+            // B.1.1.2 - Markers: Any marker may optionally be preceded by any number of fill bytes.
+            u8 next_byte = TRY(read_u8());
+            while (next_byte == 0xFF)
+                next_byte = TRY(read_u8());
+
+            Marker const marker = 0xFF00 | next_byte;
+            if (next_byte != 0x00 && (marker < JPEG_RST0 || marker > JPEG_RST7)) {
+                m_saved_marker = marker;
+                return {};
+            }
+
+            if (next_byte != 0x00)
+                TRY(restart_marker_offsets.try_append(data.size()));
+
+            TRY(data.try_append(0xFF));
+            TRY(data.try_append(next_byte));
+        }
+    }
+
     u64 byte_offset() const
     {
         return m_offset_from_start + m_byte_offset;
@@ -405,6 +444,17 @@ struct Scan {
     {
     }
 
+    // Creates a decoder for the same scan that reads its entropy-coded data from another stream.
+    Scan(Scan const& other, HuffmanStream stream)
+        : components(other.components)
+        , spectral_selection_start(other.spectral_selection_start)
+        , spectral_selection_end(other.spectral_selection_end)
+        , successive_approximation_high(other.successive_approximation_high)
+        , successive_approximation_low(other.successive_approximation_low)
+        , huffman_stream(stream)
+    {
+    }
+
     // B.2.3 - Scan header syntax
     Vector<ScanComponent, 4> components;
 
@@ -519,10 +569,9 @@ enum class JPEGDecodingMode {
 };
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_dc(JPEGLoadingContext const& context, Scan& scan, Array<i16, 4>& previous_dc_values, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto& dc_table = context.dc_tables[scan_component.dc_destination_id];
-    auto& scan = *context.current_scan;
 
     auto* select_component = get_component(macroblock, scan_component.component.index);
     auto& coefficient = select_component[0];
@@ -550,7 +599,7 @@ static ErrorOr<void> add_dc(JPEGLoadingContext& context, Macroblock& macroblock,
     if (dc_length != 0 && dc_diff < (1 << (dc_length - 1)))
         dc_diff -= (1 << dc_length) - 1;
 
-    auto& previous_dc = context.previous_dc_values[scan_component.component.index];
+    auto& previous_dc = previous_dc_values[scan_component.component.index];
     previous_dc += dc_diff;
     coefficient = previous_dc << scan.successive_approximation_low;
 
@@ -594,13 +643,11 @@ static bool is_progressive(StartOfFrame::FrameType frame_type)
 }
 
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock, ScanComponent const& scan_component)
+static ErrorOr<void> add_ac(JPEGLoadingContext const& context, Scan& scan, Macroblock& macroblock, ScanComponent const& scan_component)
 {
     auto& ac_table = context.ac_tables[scan_component.ac_destination_id];
     auto* select_component = get_component(macroblock, scan_component.component.index);
 
-    auto& scan = *context.current_scan;
-
     // Compute the AC coefficients.
 
     // 0th coefficient is the dc, which is already handled
@@ -722,14 +769,14 @@ static ErrorOr<void> add_ac(JPEGLoadingContext& context, Macroblock& macroblock,
  * we are dealing with three components) will fill up the blocks with chroma data.
  */
 template<JPEGDecodingMode DecodingMode>
-static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
+static ErrorOr<void> build_macroblocks(JPEGLoadingContext const& context, Scan& scan, Array<i16, 4>& previous_dc_values, Vector<Macroblock>& macroblocks, u32 hcursor, u32 vcursor)
 {
-    for (auto const& scan_component : context.current_scan->components) {
+    for (auto const& scan_component : scan.components) {
         for (u8 vfactor_i = 0; vfactor_i < scan_component.component.sampling_factors.vertical; vfactor_i++) {
             for (u8 hfactor_i = 0; hfactor_i < scan_component.component.sampling_factors.horizontal; hfactor_i++) {
                 // A.2.3 - Interleaved order
                 u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
-                if (!context.current_scan->are_components_interleaved()) {
+                if (!scan.are_components_interleaved()) {
                     macroblock_index = vcursor * context.mblock_meta.hpadded_count + (hfactor_i + (hcursor * scan_component.component.sampling_factors.vertical) + (vfactor_i * scan_component.component.sampling_factors.horizontal));
 
                     // A.2.4 Completion of partial MCU
@@ -747,17 +794,17 @@ static ErrorOr<void> build_macroblocks(JPEGLoadingContext& context, Vector<Macro
                 Macroblock& block = macroblocks[macroblock_index];
 
                 if constexpr (DecodingMode == JPEGDecodingMode::Sequential) {
-                    TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    TRY(add_dc<DecodingMode>(context, scan, previous_dc_values, block, scan_component));
+                    TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
                 } else {
-                    if (context.current_scan->spectral_selection_start == 0)
-                        TRY(add_dc<DecodingMode>(context, block, scan_component));
-                    if (context.current_scan->spectral_selection_end != 0)
-                        TRY(add_ac<DecodingMode>(context, block, scan_component));
+                    if (scan.spectral_selection_start == 0)
+                        TRY(add_dc<DecodingMode>(context, scan, previous_dc_values, block, scan_component));
+                    if (scan.spectral_selection_end != 0)
+                        TRY(add_ac<DecodingMode>(context, scan, block, scan_component));
 
                     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-                    if (context.current_scan->end_of_bands_run_count > 0) {
-                        --context.current_scan->end_of_bands_run_count;
+                    if (scan.end_of_bands_run_count > 0) {
+                        --scan.end_of_bands_run_count;
                         continue;
                     }
                 }
@@ -780,61 +827,154 @@ static bool is_dct_based(StartOfFrame::FrameType frame_type)
         || frame_type == StartOfFrame::FrameType::Differential_Progressive_DCT_Arithmetic;
 }
 
-static void reset_decoder(JPEGLoadingContext& context)
+static void reset_decoder(JPEGLoadingContext const& context, Scan& scan, Array<i16, 4>& previous_dc_values)
 {
     // G.1.2.2 - Progressive encoding of AC coefficients with Huffman coding
-    context.current_scan->end_of_bands_run_count = 0;
+    scan.end_of_bands_run_count = 0;
 
     // E.2.4 Control procedure for decoding a restart interval
     if (is_dct_based(context.frame.type)) {
-        context.previous_dc_values = {};
+        previous_dc_values = {};
         return;
     }
 
     VERIFY_NOT_REACHED();
 }
 
-static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+static u32 mcus_per_row(JPEGLoadingContext const& context)
 {
-    for (u32 vcursor = 0; vcursor < context.mblock_meta.vcount; vcursor += context.sampling_factors.vertical) {
-        for (u32 hcursor = 0; hcursor < context.mblock_meta.hcount; hcursor += context.sampling_factors.horizontal) {
-            // FIXME: This is likely wrong for non-interleaved scans.
-            VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
-            u32 number_of_mcus_decoded_so_far = ((vcursor / context.sampling_factors.vertical) * context.mblock_meta.hpadded_count + hcursor) / context.sampling_factors.horizontal;
+    // FIXME: This is likely wrong for non-interleaved scans.
+    VERIFY(context.mblock_meta.hpadded_count % context.sampling_factors.horizontal == 0);
+    return context.mblock_meta.hpadded_count / context.sampling_factors.horizontal;
+}
+
+static u32 mcu_count(JPEGLoadingContext const& context)
+{
+    return ceil_div<u32>(context.mblock_meta.vcount, context.sampling_factors.vertical) * mcus_per_row(context);
+}
 
-            auto& huffman_stream = context.current_scan->huffman_stream;
+static ErrorOr<void> decode_mcus(JPEGLoadingContext const& context, Scan& scan, Array<i16, 4>& previous_dc_values, Vector<Macroblock>& macroblocks, u32 first_mcu, u32 end_mcu)
+{
+    auto const mcus_in_a_row = mcus_per_row(context);
 
-            if (context.dc_restart_interval > 0) {
-                if (number_of_mcus_decoded_so_far != 0 && number_of_mcus_decoded_so_far % context.dc_restart_interval == 0) {
-                    reset_decoder(context);
+    for (u32 mcu = first_mcu; mcu < end_mcu; ++mcu) {
+        u32 const vcursor = (mcu / mcus_in_a_row) * context.sampling_factors.vertical;
+        u32 const hcursor = (mcu % mcus_in_a_row) * context.sampling_factors.horizontal;
 
-                    // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
-                    //  the 0th bit of the next byte.
-                    TRY(huffman_stream.advance_to_byte_boundary());
+        if (context.dc_restart_interval > 0) {
+            if (mcu != first_mcu && mcu % context.dc_restart_interval == 0) {
+                reset_decoder(context, scan, previous_dc_values);
 
-                    // Skip the restart marker (RSTn).
-                    TRY(huffman_stream.discard_bits(8));
-                }
+                // Restart markers are stored in byte boundaries. Advance the huffman stream cursor to
+                //  the 0th bit of the next byte.
+                TRY(scan.huffman_stream.advance_to_byte_boundary());
+
+                // Skip the restart marker (RSTn).
+                TRY(scan.huffman_stream.discard_bits(8));
             }
+        }
 
-            auto result = [&]() {
-                if (is_progressive(context.frame.type))
-                    return build_macroblocks<JPEGDecodingMode::Progressive>(context, macroblocks, hcursor, vcursor);
-                return build_macroblocks<JPEGDecodingMode::Sequential>(context, macroblocks, hcursor, vcursor);
-            }();
+        auto result = [&]() {
+            if (is_progressive(context.frame.type))
+                return build_macroblocks<JPEGDecodingMode::Progressive>(context, scan, previous_dc_values, macroblocks, hcursor, vcursor);
+            return build_macroblocks<JPEGDecodingMode::Sequential>(context, scan, previous_dc_values, macroblocks, hcursor, vcursor);
+        }();
 
-            if (result.is_error()) {
-                if constexpr (JPEG_DEBUG) {
-                    dbgln("Failed to build Macroblock {}: {}", number_of_mcus_decoded_so_far, result.error());
-                    dbgln("Huffman stream byte offset {:#x}", context.stream.byte_offset());
-                }
-                return result.release_error();
+        if (result.is_error()) {
+            if constexpr (JPEG_DEBUG) {
+                dbgln("Failed to build Macroblock {}: {}", mcu, result.error());
+                dbgln("Huffman stream byte offset {:#x}", context.stream.byte_offset());
             }
+            return result.release_error();
         }
     }
     return {};
 }
 
+static bool can_decode_restart_intervals_in_parallel(JPEGLoadingContext const& context)
+{
+    if (context.dc_restart_interval == 0)
+        return false;
+
+    // FIXME: Non-interleaved scans of subsampled images don't visit their blocks in MCU order, so we can't
+    //        tell which blocks a restart interval covers.
+    if (!context.current_scan->are_components_interleaved() && context.sampling_factors != SamplingFactors { 1, 1 })
+        return false;
+
+    return mcu_count(context) > context.dc_restart_interval;
+}
+
+static ErrorOr<void> decode_restart_intervals_in_parallel(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    // E.2.4 Control procedure for decoding a restart interval
+    // Every restart interval starts on a byte boundary behind a RSTn marker and with a freshly reset decoder,
+    // so once we know where the markers are, each interval can be decoded on its own.
+    Vector<u8> entropy_coded_data;
+    Vector<size_t> restart_marker_offsets;
+    TRY(context.stream.read_entropy_coded_data(entropy_coded_data, restart_marker_offsets));
+
+    // Make the HuffmanStream of the last interval run into a marker, it will then feed zeroes as it
+    // would when reaching the next segment of the file.
+    TRY(entropy_coded_data.try_append(0xFF));
+    TRY(entropy_coded_data.try_append(JPEG_EOI & 0xFF));
+
+    auto const total_mcu_count = mcu_count(context);
+    auto const restart_interval = context.dc_restart_interval;
+    auto const interval_count = ceil_div<u32>(total_mcu_count, restart_interval);
+
+    auto decode_mcus_from = [&](size_t data_offset, Array<i16, 4>& previous_dc_values, u32 first_mcu, u32 end_mcu) -> ErrorOr<void> {
+        auto stream = TRY(JPEGStream::create(TRY(try_make<FixedMemoryStream>(entropy_coded_data.span().slice(data_offset)))));
+        Scan scan { *context.current_scan, HuffmanStream { stream } };
+        return decode_mcus(context, scan, previous_dc_values, macroblocks, first_mcu, end_mcu);
+    };
+
+    // A stream with missing or extra markers can't be split, decode it in one go so it fails exactly
+    // like it would have without this.
+    if (restart_marker_offsets.size() + 1 != interval_count)
+        return decode_mcus_from(0, context.previous_dc_values, 0, total_mcu_count);
+
+    Vector<Optional<Error>> errors;
+    TRY(errors.try_resize(interval_count));
+    Array<i16, 4> dc_values_after_last_interval {};
+
+    // Keep tasks big enough for the thread pool overhead not to eat the gains on images with tiny intervals.
+    static constexpr u32 minimum_mcus_per_task = 256;
+    auto const intervals_per_task = ceil_div<u32>(minimum_mcus_per_task, restart_interval);
+
+    Threading::WorkStealingThreadPool::the().parallel_for_range(
+        interval_count, [&](size_t begin, size_t end) {
+            for (size_t interval = begin; interval < end; ++interval) {
+                auto previous_dc_values = interval == 0 ? context.previous_dc_values : Array<i16, 4> {};
+                auto const data_offset = interval == 0 ? 0 : restart_marker_offsets[interval - 1] + 2;
+                auto const first_mcu = static_cast<u32>(interval) * restart_interval;
+                auto const end_mcu = min(first_mcu + restart_interval, total_mcu_count);
+
+                if (auto result = decode_mcus_from(data_offset, previous_dc_values, first_mcu, end_mcu); result.is_error())
+                    errors[interval] = result.release_error();
+
+                if (interval == interval_count - 1)
+                    dc_values_after_last_interval = previous_dc_values;
+            }
+        },
+        intervals_per_task);
+
+    for (auto& error : errors) {
+        if (error.has_value())
+            return error.release_value();
+    }
+
+    context.previous_dc_values = dc_values_after_last_interval;
+    return {};
+}
+
+static ErrorOr<void> decode_huffman_stream(JPEGLoadingContext& context, Vector<Macroblock>& macroblocks)
+{
+    if (can_decode_restart_intervals_in_parallel(context))
+        return decode_restart_intervals_in_parallel(context, macroblocks);
+
+    return decode_mcus(context, *context.current_scan, context.previous_dc_values, macroblocks, 0, mcu_count(context));
+}
+
 static bool is_frame_marker(Marker const marker)
 {
     // B.1.1.3 - Marker assignments
@@ -1426,182 +1566,209 @@ static void dequantize(JPEGLoadingContext const& context, Component const& compo
 {
     auto const& quantization_table = context.quantization_tables[component.quantization_table_id];
 
-    for (u32 k = 0; k < 64; k++)
-        block_component[k] *= quantization_table[k];
+    for (u32 k = 0; k < 64; k += 8) {
+        auto const coefficients = AK::SIMD::load_unaligned<i16x8>(block_component + k);
+        auto const quantizers = AK::SIMD::simd_cast<i16x8>(AK::SIMD::load_unaligned<u16x8>(quantization_table.data() + k));
+        AK::SIMD::store_unaligned(block_component + k, coefficients * quantizers);
+    }
 }
 
-static void inverse_dct_8x8(i16* block_component)
+struct IDCTConstants {
+    float m0 { 2.0f * AK::cos(1.0f / 16.0f * 2.0f * AK::Pi<float>) };
+    float m1 { 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>) };
+    float m3 { 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>) };
+    float m5 { 2.0f * AK::cos(3.0f / 16.0f * 2.0f * AK::Pi<float>) };
+    float m2 { m0 - m5 };
+    float m4 { m0 + m5 };
+    float s0 { AK::cos(0.0f / 16.0f * AK::Pi<float>) / AK::sqrt(8.0f) };
+    float s1 { AK::cos(1.0f / 16.0f * AK::Pi<float>) / 2.0f };
+    float s2 { AK::cos(2.0f / 16.0f * AK::Pi<float>) / 2.0f };
+    float s3 { AK::cos(3.0f / 16.0f * AK::Pi<float>) / 2.0f };
+    float s4 { AK::cos(4.0f / 16.0f * AK::Pi<float>) / 2.0f };
+    float s5 { AK::cos(5.0f / 16.0f * AK::Pi<float>) / 2.0f };
+    float s6 { AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f };
+    float s7 { AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f };
+};
+
+static IDCTConstants const& idct_constants()
+{
+    static IDCTConstants const s_constants;
+    return s_constants;
+}
+
+// Note: The helpers of inverse_dct_8x8() are always inlined, so that they get compiled for the target of each
+//       specialization. This also keeps 256-bit vectors from being passed between code using different ABIs.
+ALWAYS_INLINE static i16x8 truncate_to_i16(f32x8 value)
+{
+    // The results are truncated back to 16 bits after each pass, like storing them to the block would.
+    return AK::SIMD::simd_cast<i16x8>(AK::SIMD::simd_cast<i32x8>(value));
+}
+
+// Does 8 1-D IDCTs at once, on the columns of the 8x8 block whose rows are in `rows`.
+ALWAYS_INLINE static void inverse_dct_8_columns(i16x8 (&rows)[8], IDCTConstants const& constants)
 {
-    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
     // The 1-D DCT idea is described at https://unix4lyfe.org/dct-1d/, read aan.cc from bottom to top.
-    static float const m0 = 2.0f * AK::cos(1.0f / 16.0f * 2.0f * AK::Pi<float>);
-    static float const m1 = 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>);
-    static float const m3 = 2.0f * AK::cos(2.0f / 16.0f * 2.0f * AK::Pi<float>);
-    static float const m5 = 2.0f * AK::cos(3.0f / 16.0f * 2.0f * AK::Pi<float>);
-    static float const m2 = m0 - m5;
-    static float const m4 = m0 + m5;
-    static float const s0 = AK::cos(0.0f / 16.0f * AK::Pi<float>) / AK::sqrt(8.0f);
-    static float const s1 = AK::cos(1.0f / 16.0f * AK::Pi<float>) / 2.0f;
-    static float const s2 = AK::cos(2.0f / 16.0f * AK::Pi<float>) / 2.0f;
-    static float const s3 = AK::cos(3.0f / 16.0f * AK::Pi<float>) / 2.0f;
-    static float const s4 = AK::cos(4.0f / 16.0f * AK::Pi<float>) / 2.0f;
-    static float const s5 = AK::cos(5.0f / 16.0f * AK::Pi<float>) / 2.0f;
-    static float const s6 = AK::cos(6.0f / 16.0f * AK::Pi<float>) / 2.0f;
-    static float const s7 = AK::cos(7.0f / 16.0f * AK::Pi<float>) / 2.0f;
-
-    for (u32 k = 0; k < 8; ++k) {
-        float const g0 = block_component[0 * 8 + k] * s0;
-        float const g1 = block_component[4 * 8 + k] * s4;
-        float const g2 = block_component[2 * 8 + k] * s2;
-        float const g3 = block_component[6 * 8 + k] * s6;
-        float const g4 = block_component[5 * 8 + k] * s5;
-        float const g5 = block_component[1 * 8 + k] * s1;
-        float const g6 = block_component[7 * 8 + k] * s7;
-        float const g7 = block_component[3 * 8 + k] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[0 * 8 + k] = b0 + b7;
-        block_component[1 * 8 + k] = b1 + b6;
-        block_component[2 * 8 + k] = b2 + b5;
-        block_component[3 * 8 + k] = b3 + b4;
-        block_component[4 * 8 + k] = b3 - b4;
-        block_component[5 * 8 + k] = b2 - b5;
-        block_component[6 * 8 + k] = b1 - b6;
-        block_component[7 * 8 + k] = b0 - b7;
-    }
-    for (u32 l = 0; l < 8; ++l) {
-        float const g0 = block_component[l * 8 + 0] * s0;
-        float const g1 = block_component[l * 8 + 4] * s4;
-        float const g2 = block_component[l * 8 + 2] * s2;
-        float const g3 = block_component[l * 8 + 6] * s6;
-        float const g4 = block_component[l * 8 + 5] * s5;
-        float const g5 = block_component[l * 8 + 1] * s1;
-        float const g6 = block_component[l * 8 + 7] * s7;
-        float const g7 = block_component[l * 8 + 3] * s3;
-
-        float const f0 = g0;
-        float const f1 = g1;
-        float const f2 = g2;
-        float const f3 = g3;
-        float const f4 = g4 - g7;
-        float const f5 = g5 + g6;
-        float const f6 = g5 - g6;
-        float const f7 = g4 + g7;
-
-        float const e0 = f0;
-        float const e1 = f1;
-        float const e2 = f2 - f3;
-        float const e3 = f2 + f3;
-        float const e4 = f4;
-        float const e5 = f5 - f7;
-        float const e6 = f6;
-        float const e7 = f5 + f7;
-        float const e8 = f4 + f6;
-
-        float const d0 = e0;
-        float const d1 = e1;
-        float const d2 = e2 * m1;
-        float const d3 = e3;
-        float const d4 = e4 * m2;
-        float const d5 = e5 * m3;
-        float const d6 = e6 * m4;
-        float const d7 = e7;
-        float const d8 = e8 * m5;
-
-        float const c0 = d0 + d1;
-        float const c1 = d0 - d1;
-        float const c2 = d2 - d3;
-        float const c3 = d3;
-        float const c4 = d4 + d8;
-        float const c5 = d5 + d7;
-        float const c6 = d6 - d8;
-        float const c7 = d7;
-        float const c8 = c5 - c6;
-
-        float const b0 = c0 + c3;
-        float const b1 = c1 + c2;
-        float const b2 = c1 - c2;
-        float const b3 = c0 - c3;
-        float const b4 = c4 - c8;
-        float const b5 = c8;
-        float const b6 = c6 - c7;
-        float const b7 = c7;
-
-        block_component[l * 8 + 0] = b0 + b7;
-        block_component[l * 8 + 1] = b1 + b6;
-        block_component[l * 8 + 2] = b2 + b5;
-        block_component[l * 8 + 3] = b3 + b4;
-        block_component[l * 8 + 4] = b3 - b4;
-        block_component[l * 8 + 5] = b2 - b5;
-        block_component[l * 8 + 6] = b1 - b6;
-        block_component[l * 8 + 7] = b0 - b7;
-    }
+    f32x8 const g0 = AK::SIMD::simd_cast<f32x8>(rows[0]) * constants.s0;
+    f32x8 const g1 = AK::SIMD::simd_cast<f32x8>(rows[4]) * constants.s4;
+    f32x8 const g2 = AK::SIMD::simd_cast<f32x8>(rows[2]) * constants.s2;
+    f32x8 const g3 = AK::SIMD::simd_cast<f32x8>(rows[6]) * constants.s6;
+    f32x8 const g4 = AK::SIMD::simd_cast<f32x8>(rows[5]) * constants.s5;
+    f32x8 const g5 = AK::SIMD::simd_cast<f32x8>(rows[1]) * constants.s1;
+    f32x8 const g6 = AK::SIMD::simd_cast<f32x8>(rows[7]) * constants.s7;
+    f32x8 const g7 = AK::SIMD::simd_cast<f32x8>(rows[3]) * constants.s3;
+
+    f32x8 const f0 = g0;
+    f32x8 const f1 = g1;
+    f32x8 const f2 = g2;
+    f32x8 const f3 = g3;
+    f32x8 const f4 = g4 - g7;
+    f32x8 const f5 = g5 + g6;
+    f32x8 const f6 = g5 - g6;
+    f32x8 const f7 = g4 + g7;
+
+    f32x8 const e0 = f0;
+    f32x8 const e1 = f1;
+    f32x8 const e2 = f2 - f3;
+    f32x8 const e3 = f2 + f3;
+    f32x8 const e4 = f4;
+    f32x8 const e5 = f5 - f7;
+    f32x8 const e6 = f6;
+    f32x8 const e7 = f5 + f7;
+    f32x8 const e8 = f4 + f6;
+
+    f32x8 const d0 = e0;
+    f32x8 const d1 = e1;
+    f32x8 const d2 = e2 * constants.m1;
+    f32x8 const d3 = e3;
+    f32x8 const d4 = e4 * constants.m2;
+    f32x8 const d5 = e5 * constants.m3;
+    f32x8 const d6 = e6 * constants.m4;
+    f32x8 const d7 = e7;
+    f32x8 const d8 = e8 * constants.m5;
+
+    f32x8 const c0 = d0 + d1;
+    f32x8 const c1 = d0 - d1;
+    f32x8 const c2 = d2 - d3;
+    f32x8 const c3 = d3;
+    f32x8 const c4 = d4 + d8;
+    f32x8 const c5 = d5 + d7;
+    f32x8 const c6 = d6 - d8;
+    f32x8 const c7 = d7;
+    f32x8 const c8 = c5 - c6;
+
+    f32x8 const b0 = c0 + c3;
+    f32x8 const b1 = c1 + c2;
+    f32x8 const b2 = c1 - c2;
+    f32x8 const b3 = c0 - c3;
+    f32x8 const b4 = c4 - c8;
+    f32x8 const b5 = c8;
+    f32x8 const b6 = c6 - c7;
+    f32x8 const b7 = c7;
+
+    rows[0] = truncate_to_i16(b0 + b7);
+    rows[1] = truncate_to_i16(b1 + b6);
+    rows[2] = truncate_to_i16(b2 + b5);
+    rows[3] = truncate_to_i16(b3 + b4);
+    rows[4] = truncate_to_i16(b3 - b4);
+    rows[5] = truncate_to_i16(b2 - b5);
+    rows[6] = truncate_to_i16(b1 - b6);
+    rows[7] = truncate_to_i16(b0 - b7);
+}
+
+ALWAYS_INLINE static void transpose_8x8(i16x8 (&rows)[8])
+{
+    i16x8 const a0 = __builtin_shufflevector(rows[0], rows[1], 0, 8, 1, 9, 2, 10, 3, 11);
+    i16x8 const a1 = __builtin_shufflevector(rows[0], rows[1], 4, 12, 5, 13, 6, 14, 7, 15);
+    i16x8 const a2 = __builtin_shufflevector(rows[2], rows[3], 0, 8, 1, 9, 2, 10, 3, 11);
+    i16x8 const a3 = __builtin_shufflevector(rows[2], rows[3], 4, 12, 5, 13, 6, 14, 7, 15);
+    i16x8 const a4 = __builtin_shufflevector(rows[4], rows[5], 0, 8, 1, 9, 2, 10, 3, 11);
+    i16x8 const a5 = __builtin_shufflevector(rows[4], rows[5], 4, 12, 5, 13, 6, 14, 7, 15);
+    i16x8 const a6 = __builtin_shufflevector(rows[6], rows[7], 0, 8, 1, 9, 2, 10, 3, 11);
+    i16x8 const a7 = __builtin_shufflevector(rows[6], rows[7], 4, 12, 5, 13, 6, 14, 7, 15);
+
+    i16x8 const b0 = __builtin_shufflevector(a0, a2, 0, 1, 8, 9, 2, 3, 10, 11);
+    i16x8 const b1 = __builtin_shufflevector(a0, a2, 4, 5, 12, 13, 6, 7, 14, 15);
+    i16x8 const b2 = __builtin_shufflevector(a1, a3, 0, 1, 8, 9, 2, 3, 10, 11);
+    i16x8 const b3 = __builtin_shufflevector(a1, a3, 4, 5, 12, 13, 6, 7, 14, 15);
+    i16x8 const b4 = __builtin_shufflevector(a4, a6, 0, 1, 8, 9, 2, 3, 10, 11);
+    i16x8 const b5 = __builtin_shufflevector(a4, a6, 4, 5, 12, 13, 6, 7, 14, 15);
+    i16x8 const b6 = __builtin_shufflevector(a5, a7, 0, 1, 8, 9, 2, 3, 10, 11);
+    i16x8 const b7 = __builtin_shufflevector(a5, a7, 4, 5, 12, 13, 6, 7, 14, 15);
+
+    rows[0] = __builtin_shufflevector(b0, b4, 0, 1, 2, 3, 8, 9, 10, 11);
+    rows[1] = __builtin_shufflevector(b0, b4, 4, 5, 6, 7, 12, 13, 14, 15);
+    rows[2] = __builtin_shufflevector(b1, b5, 0, 1, 2, 3, 8, 9, 10, 11);
+    rows[3] = __builtin_shufflevector(b1, b5, 4, 5, 6, 7, 12, 13, 14, 15);
+    rows[4] = __builtin_shufflevector(b2, b6, 0, 1, 2, 3, 8, 9, 10, 11);
+    rows[5] = __builtin_shufflevector(b2, b6, 4, 5, 6, 7, 12, 13, 14, 15);
+    rows[6] = __builtin_shufflevector(b3, b7, 0, 1, 2, 3, 8, 9, 10, 11);
+    rows[7] = __builtin_shufflevector(b3, b7, 4, 5, 6, 7, 12, 13, 14, 15);
 }
 
+ALWAYS_INLINE static void inverse_dct_8x8_impl(i16* block_component)
+{
+    // Does a 2-D IDCT by doing two 1-D IDCTs as described in https://unix4lyfe.org/dct/
+    // The columns are transformed first, then the block is transposed so that the rows can be transformed the same way.
+    auto const& constants = idct_constants();
+
+    i16x8 rows[8];
+    for (size_t i = 0; i < 8; ++i)
+        rows[i] = AK::SIMD::load_unaligned<i16x8>(block_component + i * 8);
+
+    inverse_dct_8_columns(rows, constants);
+    transpose_8x8(rows);
+    inverse_dct_8_columns(rows, constants);
+    transpose_8x8(rows);
+
+    for (size_t i = 0; i < 8; ++i)
+        AK::SIMD::store_unaligned(block_component + i * 8, rows[i]);
+}
+
+template<CPUFeatures>
+static void inverse_dct_8x8(i16* block_component);
+
+template<>
+void inverse_dct_8x8<CPUFeatures::None>(i16* block_component)
+{
+    inverse_dct_8x8_impl(block_component);
+}
+
+#if AK_CAN_CODEGEN_FOR_X86_AVX2
+// With AVX2, a whole row of 8 floats fits in a single register.
+template<>
+[[gnu::target("avx2")]] void inverse_dct_8x8<CPUFeatures::X86_AVX2>(i16* block_component)
+{
+    inverse_dct_8x8_impl(block_component);
+}
+#endif
+
+static void (*const inverse_dct_8x8_dispatched)(i16*) = [] {
+    CPUFeatures features = detect_cpu_features();
+
+    if constexpr (is_valid_feature(CPUFeatures::X86_AVX2)) {
+        if (has_flag(features, CPUFeatures::X86_AVX2))
+            return &inverse_dct_8x8<CPUFeatures::X86_AVX2>;
+    }
+
+    return &inverse_dct_8x8<CPUFeatures::None>;
+}();
+
 static void inverse_dct(JPEGLoadingContext const& context, i16* block_component)
 {
-    inverse_dct_8x8(block_component);
+    inverse_dct_8x8_dispatched(block_component);
 
     // F.2.1.5 - Inverse DCT (IDCT)
     auto const level_shift = 1 << (context.frame.precision - 1);
     auto const max_value = (1 << context.frame.precision) - 1;
     // FIXME: This just truncate all coefficients, it's an easy way to support (read hack)
     //        12 bits JPEGs without rewriting all color transformations.
-    auto const clamp_to_8_bits = [&](u16 color) -> u8 {
-        if (context.frame.precision == 8)
-            return static_cast<u8>(color);
-        return static_cast<u8>(color >> 4);
-    };
+    auto const shift_to_8_bits = context.frame.precision == 8 ? 0 : 4;
 
-    for (u8 i = 0; i < 64; ++i)
-        block_component[i] = clamp_to_8_bits(clamp(block_component[i] + level_shift, 0, max_value));
+    for (u8 i = 0; i < 64; i += 8) {
+        auto samples = AK::SIMD::simd_cast<i32x8>(AK::SIMD::load_unaligned<i16x8>(block_component + i));
+        samples = AK::SIMD::clamp(samples + level_shift, 0, max_value) >> shift_to_8_bits;
+        AK::SIMD::store_unaligned(block_component + i, AK::SIMD::simd_cast<i16x8>(samples));
+    }
 }
 
 static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
@@ -1631,15 +1798,19 @@ static void undo_subsampling(JPEGLoadingContext const& context, Vector<Macrobloc
                         u32 macroblock_index = (vcursor + vfactor_i) * context.mblock_meta.hpadded_count + (hfactor_i + hcursor);
                         Macroblock& block = macroblocks[macroblock_index];
                         auto* block_component_destination = get_component(block, component_i);
+                        // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
+                        // Rows are written bottom to top, as the last destination is also the source.
                         for (u8 i = 7; i < 8; --i) {
-                            for (u8 j = 7; j < 8; --j) {
-                                u8 const pixel = i * 8 + j;
-                                // The component is 8x8 subsampled 2x2. Upsample its 2x2 4x4 tiles.
-                                u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
-                                u32 const component_pxcol = (j / context.sampling_factors.horizontal) + 4 * hfactor_i;
-                                u32 const component_pixel = component_pxrow * 8 + component_pxcol;
-                                block_component_destination[pixel] = block_component_source[component_pixel];
+                            u32 const component_pxrow = (i / context.sampling_factors.vertical) + 4 * vfactor_i;
+                            auto const source_row = AK::SIMD::load_unaligned<i16x8>(block_component_source + component_pxrow * 8);
+                            i16x8 destination_row = source_row;
+                            if (context.sampling_factors.horizontal == 2) {
+                                if (hfactor_i == 0)
+                                    destination_row = __builtin_shufflevector(source_row, source_row, 0, 0, 1, 1, 2, 2, 3, 3);
+                                else
+                                    destination_row = __builtin_shufflevector(source_row, source_row, 4, 4, 5, 5, 6, 6, 7, 7);
                             }
+                            AK::SIMD::store_unaligned(block_component_destination + i * 8, destination_row);
                         }
                     }
                 }
@@ -1657,17 +1828,28 @@ static void ycbcr_to_rgb(Vector<Macroblock>& macroblocks)
         auto* y = macroblock.y;
         auto* cb = macroblock.cb;
         auto* cr = macroblock.cr;
-        for (u8 i = 0; i < 64; ++i) {
-            int r = y[i] + 1.402f * (cr[i] - 128);
-            int g = y[i] - 0.3441f * (cb[i] - 128) - 0.7141f * (cr[i] - 128);
-            int b = y[i] + 1.772f * (cb[i] - 128);
-            y[i] = clamp(r, 0, 255);
-            cb[i] = clamp(g, 0, 255);
-            cr[i] = clamp(b, 0, 255);
+        for (u8 i = 0; i < 64; i += 8) {
+            auto const load = [&](i16 const* samples) { return AK::SIMD::simd_cast<i32x8>(AK::SIMD::load_unaligned<i16x8>(samples + i)); };
+            auto const luma = AK::SIMD::simd_cast<f32x8>(load(y));
+            auto const blue_difference = AK::SIMD::simd_cast<f32x8>(load(cb) - 128);
+            auto const red_difference = AK::SIMD::simd_cast<f32x8>(load(cr) - 128);
+
+            auto const r = AK::SIMD::simd_cast<i32x8>(luma + 1.402f * red_difference);
+            auto const g = AK::SIMD::simd_cast<i32x8>(luma - 0.3441f * blue_difference - 0.7141f * red_difference);
+            auto const b = AK::SIMD::simd_cast<i32x8>(luma + 1.772f * blue_difference);
+            AK::SIMD::store_unaligned(y + i, AK::SIMD::simd_cast<i16x8>(AK::SIMD::clamp(r, 0, 255)));
+            AK::SIMD::store_unaligned(cb + i, AK::SIMD::simd_cast<i16x8>(AK::SIMD::clamp(g, 0, 255)));
+            AK::SIMD::store_unaligned(cr + i, AK::SIMD::simd_cast<i16x8>(AK::SIMD::clamp(b, 0, 255)));
         }
     }
 }
 
+static void invert_samples(i16* samples)
+{
+    for (u8 i = 0; i < 64; i += 8)
+        AK::SIMD::store_unaligned(samples + i, 255 - AK::SIMD::load_unaligned<i16x8>(samples + i));
+}
+
 static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Vector<Macroblock>& macroblocks)
 {
     if (!context.color_transform.has_value())
@@ -1680,12 +1862,10 @@ static void invert_colors_for_adobe_images(JPEGLoadingContext const& context, Ve
     // This is arguably a bug in Photoshop, but if you need to work with Photoshop
     // CMYK files, you will have to deal with it in your application.
     for (auto& macroblock : macroblocks) {
-        for (u8 i = 0; i < 64; ++i) {
-            macroblock.r[i] = 255 - macroblock.r[i];
-            macroblock.g[i] = 255 - macroblock.g[i];
-            macroblock.b[i] = 255 - macroblock.b[i];
-            macroblock.k[i] = 255 - macroblock.k[i];
-        }
+        invert_samples(macroblock.r);
+        invert_samples(macroblock.g);
+        invert_samples(macroblock.b);
+        invert_samples(macroblock.k);
     }
 }
 
@@ -1699,11 +1879,9 @@ static void ycck_to_cmyk(Vector<Macroblock>& macroblocks)
 
     // RGB to CMY, as mentioned in https://www.smcm.iqfr.csic.es/docs/intel/ipp/ipp_manual/IPPI/ippi_ch15/functn_YCCKToCMYK_JPEG.htm#functn_YCCKToCMYK_JPEG
     for (auto& macroblock : macroblocks) {
-        for (u8 i = 0; i < 64; ++i) {
-            macroblock.r[i] = 255 - macroblock.r[i];
-            macroblock.g[i] = 255 - macroblock.g[i];
-            macroblock.b[i] = 255 - macroblock.b[i];
-        }
+        invert_samples(macroblock.r);
+        invert_samples(macroblock.g);
+        invert_samples(macroblock.b);
     }
 }
 
@@ -1762,16 +1940,24 @@ static ErrorOr<void> compose_bitmap(JPEGLoadingContext& context, Vector<Macroblo
 {
     context.bitmap = TRY(Bitmap::create(BitmapFormat::BGRx8888, { context.frame.width, context.frame.height }));
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
+    for (u32 y = 0; y < context.frame.height; y++) {
         u32 const block_row = y / 8;
         u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
-            auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
-            Color const color { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index] };
-            context.bitmap->set_pixel(x, y, color);
+        auto* scanline = context.bitmap->scanline(y);
+        for (u32 x = 0; x < context.frame.width; x += 8) {
+            auto const& block = macroblocks[block_row * context.mblock_meta.hpadded_count + x / 8];
+            auto const* r = block.r + pixel_row * 8;
+            auto const* g = block.g + pixel_row * 8;
+            auto const* b = block.b + pixel_row * 8;
+
+            if (x + 8 > context.frame.width) {
+                for (u32 pixel_column = 0; x + pixel_column < context.frame.width; pixel_column++)
+                    scanline[x + pixel_column] = Color((u8)r[pixel_column], (u8)g[pixel_column], (u8)b[pixel_column]).value();
+                break;
+            }
+
+            auto const channel = [](i16 const* samples) { return AK::SIMD::simd_cast<u32x8>(AK::SIMD::load_unaligned<i16x8>(samples)) & 0xFF; };
+            AK::SIMD::store_unaligned(scanline + x, 0xFF000000 | channel(r) << 16 | channel(g) << 8 | channel(b));
         }
     }
 
@@ -1785,15 +1971,25 @@ static ErrorOr<void> compose_cmyk_bitmap(JPEGLoadingContext& context, Vector<Mac
 
     context.cmyk_bitmap = TRY(Gfx::CMYKBitmap::create_with_size({ context.frame.width, context.frame.height }));
 
-    for (u32 y = context.frame.height - 1; y < context.frame.height; y--) {
+    for (u32 y = 0; y < context.frame.height; y++) {
         u32 const block_row = y / 8;
         u32 const pixel_row = y % 8;
-        for (u32 x = 0; x < context.frame.width; x++) {
-            u32 const block_column = x / 8;
-            auto& block = macroblocks[block_row * context.mblock_meta.hpadded_count + block_column];
-            u32 const pixel_column = x % 8;
-            u32 const pixel_index = pixel_row * 8 + pixel_column;
-            context.cmyk_bitmap->scanline(y)[x] = { (u8)block.y[pixel_index], (u8)block.cb[pixel_index], (u8)block.cr[pixel_index], (u8)block.k[pixel_index] };
+        auto* scanline = context.cmyk_bitmap->scanline(y);
+        for (u32 x = 0; x < context.frame.width; x += 8) {
+            auto const& block = macroblocks[block_row * context.mblock_meta.hpadded_count + x / 8];
+            auto const* cyan = block.y + pixel_row * 8;
+            auto const* magenta = block.cb + pixel_row * 8;
+            auto const* yellow = block.cr + pixel_row * 8;
+            auto const* black = block.k + pixel_row * 8;
+
+            if (x + 8 > context.frame.width) {
+                for (u32 pixel_column = 0; x + pixel_column < context.frame.width; pixel_column++)
+                    scanline[x + pixel_column] = { (u8)cyan[pixel_column], (u8)magenta[pixel_column], (u8)yellow[pixel_column], (u8)black[pixel_column] };
+                break;
+            }
+
+            auto const channel = [](i16 const* samples) { return AK::SIMD::simd_cast<u32x8>(AK::SIMD::load_unaligned<i16x8>(samples)) & 0xFF; };
+            AK::SIMD::store_unaligned(scanline + x, channel(cyan) | channel(magenta) << 8 | channel(yellow) << 16 | channel(black) << 24);
         }
     }
 
@@ -7,6 +7,7 @@
 
 #include <AK/Debug.h>
 #include <AK/Endian.h>
+#include <AK/FixedArray.h>
 #include <AK/MemoryStream.h>
 #include <AK/Vector.h>
 #include <LibCompress/Zlib.h>
@@ -17,6 +18,13 @@
 
 namespace Gfx {
 
+using AK::SIMD::u8x16;
+using AK::SIMD::u8x4;
+using AK::SIMD::u8x8;
+
+// How many scanlines are decoded between two invocations of the partial frame callback.
+static constexpr int scanlines_per_partial_frame_report = 32;
+
 struct PNG_IHDR {
     NetworkOrdered<u32> width;
     NetworkOrdered<u32> height;
@@ -82,11 +90,6 @@ struct EmbeddedICCProfile {
     ReadonlyBytes compressed_data;
 };
 
-struct Scanline {
-    PNG::FilterType filter;
-    ReadonlyBytes data {};
-};
-
 struct [[gnu::packed]] PaletteEntry {
     u8 r;
     u8 g;
@@ -185,9 +188,8 @@ struct PNGLoadingContext {
     bool has_seen_idat_chunk { false };
     bool has_seen_actl_chunk_before_idat { false };
     bool has_alpha() const { return to_underlying(color_type) & 4 || palette_transparency_data.size() > 0; }
-    Vector<Scanline> scanlines;
-    ByteBuffer unfiltered_data;
     RefPtr<Gfx::Bitmap> bitmap;
+    PartialFrameCallback partial_frame_callback;
     ByteBuffer compressed_data;
     Vector<PaletteEntry> palette_data;
     ByteBuffer palette_transparency_data;
@@ -293,6 +295,67 @@ union [[gnu::packed]] Pixel {
 };
 static_assert(AssertSize<Pixel, 4>());
 
+template<size_t bytes_per_complete_pixel, AK::SIMD::SIMDVector V>
+ALWAYS_INLINE static V load_complete_pixel(u8 const* data)
+{
+    static_assert(bytes_per_complete_pixel <= sizeof(V));
+    V pixel {};
+    __builtin_memcpy(&pixel, data, bytes_per_complete_pixel);
+    return pixel;
+}
+
+template<size_t bytes_per_complete_pixel, AK::SIMD::SIMDVector V>
+ALWAYS_INLINE static void store_complete_pixel(u8* data, V pixel)
+{
+    __builtin_memcpy(data, &pixel, bytes_per_complete_pixel);
+}
+
+// Sub, Average and Paeth depend on the already unfiltered pixel to the left, so they can't be vectorized across a scanline.
+// They can still process all bytes of one pixel at once though, which is what this does for 8-bit and 16-bit RGB(A).
+template<PNG::FilterType filter, size_t bytes_per_complete_pixel, AK::SIMD::SIMDVector V>
+static void unfilter_complete_pixels(Bytes scanline_data, ReadonlyBytes previous_scanlines_data)
+{
+    V left {};
+    V upper_left {};
+    for (size_t i = 0; i + bytes_per_complete_pixel <= scanline_data.size(); i += bytes_per_complete_pixel) {
+        auto current = load_complete_pixel<bytes_per_complete_pixel, V>(&scanline_data[i]);
+        auto above = load_complete_pixel<bytes_per_complete_pixel, V>(&previous_scanlines_data[i]);
+        if constexpr (filter == PNG::FilterType::Sub) {
+            current += left;
+        } else if constexpr (filter == PNG::FilterType::Average) {
+            // This is floor((left + above) / 2), without the sum overflowing a byte.
+            current += (left & above) + ((left ^ above) >> 1);
+        } else {
+            static_assert(filter == PNG::FilterType::Paeth);
+            current += PNG::paeth_predictor(left, above, upper_left);
+        }
+        store_complete_pixel<bytes_per_complete_pixel>(&scanline_data[i], current);
+        left = current;
+        upper_left = above;
+    }
+}
+
+template<PNG::FilterType filter>
+static bool unfilter_complete_pixels(Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
+{
+    switch (bytes_per_complete_pixel) {
+    case 3:
+        unfilter_complete_pixels<filter, 3, u8x4>(scanline_data, previous_scanlines_data);
+        return true;
+    case 4:
+        unfilter_complete_pixels<filter, 4, u8x4>(scanline_data, previous_scanlines_data);
+        return true;
+    case 6:
+        unfilter_complete_pixels<filter, 6, u8x8>(scanline_data, previous_scanlines_data);
+        return true;
+    case 8:
+        unfilter_complete_pixels<filter, 8, u8x8>(scanline_data, previous_scanlines_data);
+        return true;
+    default:
+        return false;
+    }
+}
+
 void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scanline_data, ReadonlyBytes previous_scanlines_data, u8 bytes_per_complete_pixel)
 {
     // https://www.w3.org/TR/png-3/#9Filter-types
@@ -301,6 +364,8 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
     case PNG::FilterType::None:
         break;
     case PNG::FilterType::Sub:
+        if (unfilter_complete_pixels<PNG::FilterType::Sub>(scanline_data, previous_scanlines_data, bytes_per_complete_pixel))
+            break;
         // This loop starts at bytes_per_complete_pixel because all bytes before that are
         // guaranteed to have no valid byte at index (i - bytes_per_complete pixel).
         // All such invalid byte indexes should be treated as 0, and adding 0 to the current
@@ -311,13 +376,22 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
             scanline_data[i] += left;
         }
         break;
-    case PNG::FilterType::Up:
-        for (size_t i = 0; i < scanline_data.size(); ++i) {
+    case PNG::FilterType::Up: {
+        size_t i = 0;
+        for (; i + sizeof(u8x16) <= scanline_data.size(); i += sizeof(u8x16)) {
+            auto current = AK::SIMD::load_unaligned<u8x16>(&scanline_data[i]);
+            auto above = AK::SIMD::load_unaligned<u8x16>(&previous_scanlines_data[i]);
+            AK::SIMD::store_unaligned(&scanline_data[i], current + above);
+        }
+        for (; i < scanline_data.size(); ++i) {
             u8 above = previous_scanlines_data[i];
             scanline_data[i] += above;
         }
         break;
+    }
     case PNG::FilterType::Average:
+        if (unfilter_complete_pixels<PNG::FilterType::Average>(scanline_data, previous_scanlines_data, bytes_per_complete_pixel))
+            break;
         for (size_t i = 0; i < scanline_data.size(); ++i) {
             u32 left = (i < bytes_per_complete_pixel) ? 0 : scanline_data[i - bytes_per_complete_pixel];
             u32 above = previous_scanlines_data[i];
@@ -326,6 +400,8 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
         }
         break;
     case PNG::FilterType::Paeth:
+        if (unfilter_complete_pixels<PNG::FilterType::Paeth>(scanline_data, previous_scanlines_data, bytes_per_complete_pixel))
+            break;
         for (size_t i = 0; i < scanline_data.size(); ++i) {
             u8 left = (i < bytes_per_complete_pixel) ? 0 : scanline_data[i - bytes_per_complete_pixel];
             u8 above = previous_scanlines_data[i];
@@ -337,132 +413,82 @@ void PNGImageDecoderPlugin::unfilter_scanline(PNG::FilterType filter, Bytes scan
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_without_alpha(ReadonlyBytes scanline_data, Span<Pixel> pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* gray_values = reinterpret_cast<T const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = gray_values[i];
-            pixel.g = gray_values[i];
-            pixel.b = gray_values[i];
-            pixel.a = 0xff;
-        }
+    auto* gray_values = reinterpret_cast<T const*>(scanline_data.data());
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = gray_values[i];
+        pixel.g = gray_values[i];
+        pixel.b = gray_values[i];
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_grayscale_with_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_grayscale_with_alpha(ReadonlyBytes scanline_data, Span<Pixel> pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* tuples = reinterpret_cast<Tuple<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = tuples[i].gray;
-            pixel.g = tuples[i].gray;
-            pixel.b = tuples[i].gray;
-            pixel.a = tuples[i].a;
-        }
+    auto* tuples = reinterpret_cast<Tuple<T> const*>(scanline_data.data());
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = tuples[i].gray;
+        pixel.g = tuples[i].gray;
+        pixel.b = tuples[i].gray;
+        pixel.a = tuples[i].a;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_without_alpha(PNGLoadingContext& context)
+ALWAYS_INLINE static void unpack_triplets_without_alpha(ReadonlyBytes scanline_data, Span<Pixel> pixels)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline_data.data());
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        pixel.a = 0xff;
     }
 }
 
 template<typename T>
-ALWAYS_INLINE static void unpack_triplets_with_transparency_value(PNGLoadingContext& context, Triplet<T> transparency_value)
+ALWAYS_INLINE static void unpack_triplets_with_transparency_value(ReadonlyBytes scanline_data, Span<Pixel> pixels, Triplet<T> transparency_value)
 {
-    for (int y = 0; y < context.height; ++y) {
-        auto* triplets = reinterpret_cast<Triplet<T> const*>(context.scanlines[y].data.data());
-        for (int i = 0; i < context.width; ++i) {
-            auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-            pixel.r = triplets[i].r;
-            pixel.g = triplets[i].g;
-            pixel.b = triplets[i].b;
-            if (triplets[i] == transparency_value)
-                pixel.a = 0x00;
-            else
-                pixel.a = 0xff;
-        }
+    auto* triplets = reinterpret_cast<Triplet<T> const*>(scanline_data.data());
+    for (size_t i = 0; i < pixels.size(); ++i) {
+        auto& pixel = pixels[i];
+        pixel.r = triplets[i].r;
+        pixel.g = triplets[i].g;
+        pixel.b = triplets[i].b;
+        if (triplets[i] == transparency_value)
+            pixel.a = 0x00;
+        else
+            pixel.a = 0xff;
     }
 }
 
-NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
+// Unpacks one unfiltered scanline to BGRA8888, which is what both bitmap formats we decode into use in memory.
+NEVER_INLINE FLATTEN static ErrorOr<void> unpack_scanline(PNGLoadingContext const& context, ReadonlyBytes scanline_data, Span<Pixel> pixels)
 {
-    // First unfilter the scanlines:
-
-    // FIXME: Instead of creating a separate buffer for the scanlines that need to be
-    //        mutated, the mutation could be done in place (if the data was non-const).
-    size_t bytes_per_scanline = context.scanlines[0].data.size();
-    size_t bytes_needed_for_all_unfiltered_scanlines = 0;
-    for (int y = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            bytes_needed_for_all_unfiltered_scanlines += bytes_per_scanline;
-        }
-    }
-    context.unfiltered_data = TRY(ByteBuffer::create_uninitialized(bytes_needed_for_all_unfiltered_scanlines));
-
-    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
-    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
-    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
-    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
-    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
-    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
-    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
-
-    u8 dummy_scanline_bytes[bytes_per_scanline];
-    memset(dummy_scanline_bytes, 0, sizeof(dummy_scanline_bytes));
-    auto previous_scanlines_data = ReadonlyBytes { dummy_scanline_bytes, sizeof(dummy_scanline_bytes) };
-
-    for (int y = 0, data_start = 0; y < context.height; ++y) {
-        if (context.scanlines[y].filter != PNG::FilterType::None) {
-            auto scanline_data_slice = context.unfiltered_data.bytes().slice(data_start, bytes_per_scanline);
-
-            // Copy the current values over and set the scanline's data to the to-be-mutated slice
-            context.scanlines[y].data.copy_to(scanline_data_slice);
-            context.scanlines[y].data = scanline_data_slice;
-
-            PNGImageDecoderPlugin::unfilter_scanline(context.scanlines[y].filter, scanline_data_slice, previous_scanlines_data, bytes_per_complete_pixel);
-
-            data_start += bytes_per_scanline;
-        }
-        previous_scanlines_data = context.scanlines[y].data;
-    }
-
-    // Now unpack the scanlines to RGBA:
     switch (context.color_type) {
     case PNG::ColorType::Greyscale:
         if (context.bit_depth == 8) {
-            unpack_grayscale_without_alpha<u8>(context);
+            unpack_grayscale_without_alpha<u8>(scanline_data, pixels);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_without_alpha<u16>(context);
+            unpack_grayscale_without_alpha<u16>(scanline_data, pixels);
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto bit_depth_squared = context.bit_depth * context.bit_depth;
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* gray_values = context.scanlines[y].data.data();
-                for (int x = 0; x < context.width; ++x) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
-                    auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[x];
-                    pixel.r = value * (0xff / bit_depth_squared);
-                    pixel.g = value * (0xff / bit_depth_squared);
-                    pixel.b = value * (0xff / bit_depth_squared);
-                    pixel.a = 0xff;
-                }
+            auto* gray_values = scanline_data.data();
+            for (size_t x = 0; x < pixels.size(); ++x) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (x % pixels_per_byte));
+                auto value = (gray_values[x / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[x];
+                pixel.r = value * (0xff / bit_depth_squared);
+                pixel.g = value * (0xff / bit_depth_squared);
+                pixel.b = value * (0xff / bit_depth_squared);
+                pixel.a = 0xff;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -470,9 +496,9 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::GreyscaleWithAlpha:
         if (context.bit_depth == 8) {
-            unpack_grayscale_with_alpha<u8>(context);
+            unpack_grayscale_with_alpha<u8>(scanline_data, pixels);
         } else if (context.bit_depth == 16) {
-            unpack_grayscale_with_alpha<u16>(context);
+            unpack_grayscale_with_alpha<u16>(scanline_data, pixels);
         } else {
             VERIFY_NOT_REACHED();
         }
@@ -480,39 +506,35 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     case PNG::ColorType::Truecolor:
         if (context.palette_transparency_data.size() == 6) {
             if (context.bit_depth == 8) {
-                unpack_triplets_with_transparency_value<u8>(context, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
+                unpack_triplets_with_transparency_value<u8>(scanline_data, pixels, Triplet<u8> { context.palette_transparency_data[0], context.palette_transparency_data[2], context.palette_transparency_data[4] });
             } else if (context.bit_depth == 16) {
                 u16 tr = context.palette_transparency_data[0] | context.palette_transparency_data[1] << 8;
                 u16 tg = context.palette_transparency_data[2] | context.palette_transparency_data[3] << 8;
                 u16 tb = context.palette_transparency_data[4] | context.palette_transparency_data[5] << 8;
-                unpack_triplets_with_transparency_value<u16>(context, Triplet<u16> { tr, tg, tb });
+                unpack_triplets_with_transparency_value<u16>(scanline_data, pixels, Triplet<u16> { tr, tg, tb });
             } else {
                 VERIFY_NOT_REACHED();
             }
         } else {
             if (context.bit_depth == 8)
-                unpack_triplets_without_alpha<u8>(context);
+                unpack_triplets_without_alpha<u8>(scanline_data, pixels);
             else if (context.bit_depth == 16)
-                unpack_triplets_without_alpha<u16>(context);
+                unpack_triplets_without_alpha<u16>(scanline_data, pixels);
             else
                 VERIFY_NOT_REACHED();
         }
         break;
     case PNG::ColorType::TruecolorWithAlpha:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                memcpy(context.bitmap->scanline(y), context.scanlines[y].data.data(), context.scanlines[y].data.size());
-            }
+            memcpy(pixels.data(), scanline_data.data(), pixels.size() * sizeof(Pixel));
         } else if (context.bit_depth == 16) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* quartets = reinterpret_cast<Quartet<u16> const*>(context.scanlines[y].data.data());
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    pixel.r = quartets[i].r & 0xFF;
-                    pixel.g = quartets[i].g & 0xFF;
-                    pixel.b = quartets[i].b & 0xFF;
-                    pixel.a = quartets[i].a & 0xFF;
-                }
+            auto* quartets = reinterpret_cast<Quartet<u16> const*>(scanline_data.data());
+            for (size_t i = 0; i < pixels.size(); ++i) {
+                auto& pixel = pixels[i];
+                pixel.r = quartets[i].r & 0xFF;
+                pixel.g = quartets[i].g & 0xFF;
+                pixel.b = quartets[i].b & 0xFF;
+                pixel.a = quartets[i].a & 0xFF;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -520,42 +542,38 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
         break;
     case PNG::ColorType::IndexedColor:
         if (context.bit_depth == 8) {
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_index = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if (palette_index[i] >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at((int)palette_index[i]);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
-                        ? context.palette_transparency_data[palette_index[i]]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_index = scanline_data.data();
+            for (size_t i = 0; i < pixels.size(); ++i) {
+                auto& pixel = pixels[i];
+                if (palette_index[i] >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at((int)palette_index[i]);
+                auto transparency = context.palette_transparency_data.size() >= palette_index[i] + 1u
+                    ? context.palette_transparency_data[palette_index[i]]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else if (context.bit_depth == 1 || context.bit_depth == 2 || context.bit_depth == 4) {
             auto pixels_per_byte = 8 / context.bit_depth;
             auto mask = (1 << context.bit_depth) - 1;
-            for (int y = 0; y < context.height; ++y) {
-                auto* palette_indices = context.scanlines[y].data.data();
-                for (int i = 0; i < context.width; ++i) {
-                    auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
-                    auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
-                    auto& pixel = (Pixel&)context.bitmap->scanline(y)[i];
-                    if ((size_t)palette_index >= context.palette_data.size())
-                        return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
-                    auto& color = context.palette_data.at(palette_index);
-                    auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
-                        ? context.palette_transparency_data[palette_index]
-                        : 0xff;
-                    pixel.r = color.r;
-                    pixel.g = color.g;
-                    pixel.b = color.b;
-                    pixel.a = transparency;
-                }
+            auto* palette_indices = scanline_data.data();
+            for (size_t i = 0; i < pixels.size(); ++i) {
+                auto bit_offset = (8 - context.bit_depth) - (context.bit_depth * (i % pixels_per_byte));
+                auto palette_index = (palette_indices[i / pixels_per_byte] >> bit_offset) & mask;
+                auto& pixel = pixels[i];
+                if ((size_t)palette_index >= context.palette_data.size())
+                    return Error::from_string_literal("PNGImageDecoderPlugin: Palette index out of range");
+                auto& color = context.palette_data.at(palette_index);
+                auto transparency = context.palette_transparency_data.size() >= palette_index + 1u
+                    ? context.palette_transparency_data[palette_index]
+                    : 0xff;
+                pixel.r = color.r;
+                pixel.g = color.g;
+                pixel.b = color.b;
+                pixel.a = transparency;
             }
         } else {
             VERIFY_NOT_REACHED();
@@ -567,12 +585,54 @@ NEVER_INLINE FLATTEN static ErrorOr<void> unfilter(PNGLoadingContext& context)
     }
 
     // Swap r and b values:
-    for (int y = 0; y < context.height; ++y) {
-        auto* pixels = (Pixel*)context.bitmap->scanline(y);
-        for (int i = 0; i < context.bitmap->width(); ++i) {
-            auto& x = pixels[i];
-            swap(x.r, x.b);
+    for (auto& pixel : pixels) {
+        ARGB32 rgba = pixel.rgba;
+        pixel.rgba = (rgba & 0xff00ff00) | (rgba & 0xff) << 16 | (rgba >> 16 & 0xff);
+    }
+
+    return {};
+}
+
+// Inflates and unfilters the image data one scanline at a time and hands each unfiltered scanline to the callback,
+// so that only the current and the previous scanline are ever held in memory.
+template<typename Callback>
+static ErrorOr<void> decode_scanlines(PNGLoadingContext& context, Stream& image_data, int width, int height, Callback on_scanline_unfiltered)
+{
+    auto row_size = context.compute_row_size_for_width(width);
+    if (row_size.has_overflow())
+        return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+
+    // From section 6.3 of http://www.libpng.org/pub/png/spec/1.2/PNG-Filters.html
+    // "bpp is defined as the number of bytes per complete pixel, rounding up to one.
+    // For example, for color type 2 with a bit depth of 16, bpp is equal to 6
+    // (three samples, two bytes per sample); for color type 0 with a bit depth of 2,
+    // bpp is equal to 1 (rounding up); for color type 4 with a bit depth of 16, bpp
+    // is equal to 4 (two-byte grayscale sample, plus two-byte alpha sample)."
+    u8 bytes_per_complete_pixel = ceil_div(context.bit_depth, (u8)8) * context.channels;
+
+    // Each scanline is preceded by its filter type byte. The previous scanline starts out as all zeroes.
+    size_t filtered_row_size = 1 + row_size.value();
+    auto scanline_buffers = TRY(ByteBuffer::create_zeroed(2 * filtered_row_size));
+    auto current_scanline = scanline_buffers.bytes().slice(0, filtered_row_size);
+    auto previous_scanline = scanline_buffers.bytes().slice(filtered_row_size, filtered_row_size);
+
+    for (int y = 0; y < height; ++y) {
+        if (image_data.read_until_filled(current_scanline).is_error()) {
+            context.state = PNGLoadingContext::State::Error;
+            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
         }
+
+        auto filter_or_error = PNG::filter_type(current_scanline[0]);
+        if (filter_or_error.is_error()) {
+            context.state = PNGLoadingContext::State::Error;
+            return filter_or_error.release_error();
+        }
+
+        auto scanline_data = current_scanline.slice(1);
+        PNGImageDecoderPlugin::unfilter_scanline(filter_or_error.value(), scanline_data, previous_scanline.slice(1), bytes_per_complete_pixel);
+        TRY(on_scanline_unfiltered(y, scanline_data));
+
+        swap(current_scanline, previous_scanline);
     }
 
     return {};
@@ -700,36 +760,19 @@ static bool decode_png_chunks(PNGLoadingContext& context)
     return true;
 }
 
-static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_bitmap_simple(PNGLoadingContext& context, Stream& image_data)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
-
-    for (int y = 0; y < context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
+    context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
 
-        context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = context.scanlines.last().data;
-        auto row_size = context.compute_row_size_for_width(context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
+    return decode_scanlines(context, image_data, context.width, context.height, [&](int y, ReadonlyBytes scanline_data) -> ErrorOr<void> {
+        TRY(unpack_scanline(context, scanline_data, { reinterpret_cast<Pixel*>(context.bitmap->scanline(y)), static_cast<size_t>(context.width) }));
 
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+        if (context.partial_frame_callback && ((y + 1) % scanlines_per_partial_frame_report == 0 || y + 1 == context.height)) {
+            int first_reported_y = y - y % scanlines_per_partial_frame_report;
+            context.partial_frame_callback(*context.bitmap, { 0, first_reported_y, context.width, y + 1 - first_reported_y });
         }
-    }
-
-    context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
-    return unfilter(context);
+        return {};
+    });
 }
 
 static int adam7_height(PNGLoadingContext& context, int pass)
@@ -782,56 +825,58 @@ static int adam7_startx[8] = { 0, 0, 4, 0, 2, 0, 1, 0 };
 static int adam7_stepy[8] = { 1, 8, 8, 8, 4, 4, 2, 2 };
 static int adam7_stepx[8] = { 1, 8, 8, 4, 4, 2, 2, 1 };
 
-static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Streamer& streamer, int pass)
+static ErrorOr<void> decode_adam7_pass(PNGLoadingContext& context, Stream& image_data, int pass, int& reported_height)
 {
-    auto subimage_context = context.create_subimage_context(adam7_width(context, pass), adam7_height(context, pass));
+    auto pass_width = adam7_width(context, pass);
+    auto pass_height = adam7_height(context, pass);
 
     // For small images, some passes might be empty
-    if (!subimage_context.width || !subimage_context.height)
+    if (!pass_width || !pass_height)
         return {};
 
-    for (int y = 0; y < subimage_context.height; ++y) {
-        u8 filter_byte;
-        if (!streamer.read(filter_byte)) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
+    auto pixels = TRY(FixedArray<Pixel>::create(pass_width));
+    TRY(decode_scanlines(context, image_data, pass_width, pass_height, [&](int y, ReadonlyBytes scanline_data) -> ErrorOr<void> {
+        TRY(unpack_scanline(context, scanline_data, pixels.span()));
+
+        // Copy the subimage scanline into the main image according to the pass pattern
+        int dy = adam7_starty[pass] + y * adam7_stepy[pass];
+        if (dy >= context.height)
+            return {};
+        auto* destination = context.bitmap->scanline(dy);
+        for (int x = 0, dx = adam7_startx[pass]; x < pass_width && dx < context.width; ++x, dx += adam7_stepx[pass])
+            destination[dx] = pixels[x].rgba;
+
+        // The earlier passes spread their pixels over the whole image, so nothing is final before the last one. That
+        // fills in the odd rows, and the even rows in between were already completed by the pass before it.
+        if (pass == 7 && context.partial_frame_callback && dy + 1 - reported_height >= scanlines_per_partial_frame_report) {
+            context.partial_frame_callback(*context.bitmap, { 0, reported_height, context.width, dy + 1 - reported_height });
+            reported_height = dy + 1;
         }
-
-        if (filter_byte > 4) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Invalid PNG filter");
-        }
-
-        subimage_context.scanlines.append({ MUST(PNG::filter_type(filter_byte)) });
-        auto& scanline_buffer = subimage_context.scanlines.last().data;
-
-        auto row_size = context.compute_row_size_for_width(subimage_context.width);
-        if (row_size.has_overflow())
-            return Error::from_string_literal("PNGImageDecoderPlugin: Row size overflow");
-        if (!streamer.wrap_bytes(scanline_buffer, row_size.value())) {
-            context.state = PNGLoadingContext::State::Error;
-            return Error::from_string_literal("PNGImageDecoderPlugin: Decoding failed");
-        }
-    }
-
-    subimage_context.bitmap = TRY(Bitmap::create(context.bitmap->format(), { subimage_context.width, subimage_context.height }));
-    TRY(unfilter(subimage_context));
-
-    // Copy the subimage data into the main image according to the pass pattern
-    for (int y = 0, dy = adam7_starty[pass]; y < subimage_context.height && dy < context.height; ++y, dy += adam7_stepy[pass]) {
-        for (int x = 0, dx = adam7_startx[pass]; x < subimage_context.width && dx < context.width; ++x, dx += adam7_stepx[pass]) {
-            context.bitmap->set_pixel(dx, dy, subimage_context.bitmap->get_pixel(x, y));
-        }
-    }
+        return {};
+    }));
     return {};
 }
 
-static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, ByteBuffer& decompression_buffer)
+static ErrorOr<void> decode_png_adam7(PNGLoadingContext& context, Stream& image_data)
 {
-    Streamer streamer(decompression_buffer.data(), decompression_buffer.size());
     context.bitmap = TRY(Bitmap::create(context.has_alpha() ? BitmapFormat::BGRA8888 : BitmapFormat::BGRx8888, { context.width, context.height }));
+    int reported_height = 0;
     for (int pass = 1; pass <= 7; ++pass)
-        TRY(decode_adam7_pass(context, streamer, pass));
+        TRY(decode_adam7_pass(context, image_data, pass, reported_height));
+    if (context.partial_frame_callback && reported_height < context.height)
+        context.partial_frame_callback(*context.bitmap, { 0, reported_height, context.width, context.height - reported_height });
+    return {};
+}
+
+// Scanlines are only inflated as far as they are needed, so this makes sure that whatever
+// follows them in the image data is still a valid zlib stream, like a full decompression would.
+static ErrorOr<void> decompress_remaining_image_data(Stream& image_data)
+{
+    Array<u8, 256> buffer;
+    while (!image_data.is_eof()) {
+        if (TRY(image_data.read_some(buffer)).is_empty())
+            break;
+    }
     return {};
 }
 
@@ -855,27 +900,25 @@ static ErrorOr<void> decode_png_bitmap(PNGLoadingContext& context)
         return decompressor_or_error.release_error();
     }
     auto decompressor = decompressor_or_error.release_value();
-    auto result_or_error = decompressor->read_until_eof();
-    if (result_or_error.is_error()) {
-        context.state = PNGLoadingContext::State::Error;
-        return result_or_error.release_error();
-    }
-    auto decompression_buffer = result_or_error.release_value();
-    context.compressed_data.clear();
 
-    context.scanlines.ensure_capacity(context.height);
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(context, decompression_buffer));
+        TRY(decode_png_bitmap_simple(context, *decompressor));
         break;
     case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(context, decompression_buffer));
+        TRY(decode_png_adam7(context, *decompressor));
         break;
     default:
         context.state = PNGLoadingContext::State::Error;
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
     }
 
+    if (auto result = decompress_remaining_image_data(*decompressor); result.is_error()) {
+        context.state = PNGLoadingContext::State::Error;
+        return result.release_error();
+    }
+    context.compressed_data.clear();
+
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return {};
 }
@@ -892,20 +935,18 @@ static ErrorOr<RefPtr<Bitmap>> decode_png_animation_frame_bitmap(PNGLoadingConte
 
     auto compressed_data_stream = make<FixedMemoryStream>(animation_frame.compressed_data.span());
     auto decompressor = TRY(Compress::ZlibDecompressor::create(move(compressed_data_stream)));
-    auto decompression_buffer = TRY(decompressor->read_until_eof());
-    frame_context.compressed_data.clear();
 
-    frame_context.scanlines.ensure_capacity(frame_context.height);
     switch (context.interlace_method) {
     case PngInterlaceMethod::Null:
-        TRY(decode_png_bitmap_simple(frame_context, decompression_buffer));
+        TRY(decode_png_bitmap_simple(frame_context, *decompressor));
         break;
     case PngInterlaceMethod::Adam7:
-        TRY(decode_png_adam7(frame_context, decompression_buffer));
+        TRY(decode_png_adam7(frame_context, *decompressor));
         break;
     default:
         return Error::from_string_literal("PNGImageDecoderPlugin: Invalid interlace method");
     }
+    TRY(decompress_remaining_image_data(*decompressor));
 
     context.state = PNGLoadingContext::State::BitmapDecoded;
     return move(frame_context.bitmap);
@@ -1465,6 +1506,11 @@ Optional<Metadata const&> PNGImageDecoderPlugin::metadata()
     return OptionalNone {};
 }
 
+void PNGImageDecoderPlugin::set_partial_frame_callback(PartialFrameCallback callback)
+{
+    m_context->partial_frame_callback = move(callback);
+}
+
 ErrorOr<Optional<ReadonlyBytes>> PNGImageDecoderPlugin::icc_data()
 {
     if (!decode_png_chunks(*m_context))
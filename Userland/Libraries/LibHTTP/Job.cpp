@@ -200,6 +200,8 @@ Coroutine<void> Job::flush_received_buffers()
             auto result = co_await do_write(payload);
             if (!result.is_error()) {
                 auto written = result.release_value();
+                if (on_body_data_written)
+                    on_body_data_written(payload.slice(0, written));
                 m_buffered_size -= written;
                 if (written == payload.size()) {
                     // FIXME: Make this a take-first-friendly object?
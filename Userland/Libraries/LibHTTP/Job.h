@@ -31,6 +31,9 @@ public:
     HttpResponse* response() { return static_cast<HttpResponse*>(Core::NetworkJob::response()); }
     HttpResponse const* response() const { return static_cast<HttpResponse const*>(Core::NetworkJob::response()); }
 
+    // Called with every part of the response body that was written to the output stream.
+    Function<void(ReadonlyBytes)> on_body_data_written;
+
 private:
     auto parse_status(auto& stream) -> Coroutine<ErrorOr<void>>;
     auto parse_headers(auto& stream, bool in_trailers) -> Coroutine<ErrorOr<void>>;
@@ -7,7 +7,10 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Op.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/Heap/HeapBlock.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/SourceCode.h>
 
 namespace JS::Bytecode {
@@ -83,6 +86,78 @@ void Executable::dump() const
     warnln("");
 }
 
+static Optional<u32> property_lookup_cache_index_of(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+    case Instruction::Type::GetById:
+        return static_cast<Op::GetById const&>(instruction).cache_index();
+    case Instruction::Type::GetByIdWithThis:
+        return static_cast<Op::GetByIdWithThis const&>(instruction).cache_index();
+    case Instruction::Type::GetLength:
+        return static_cast<Op::GetLength const&>(instruction).cache_index();
+    case Instruction::Type::GetLengthWithThis:
+        return static_cast<Op::GetLengthWithThis const&>(instruction).cache_index();
+    case Instruction::Type::PutById:
+        return static_cast<Op::PutById const&>(instruction).cache_index();
+    case Instruction::Type::PutByIdWithThis:
+        return static_cast<Op::PutByIdWithThis const&>(instruction).cache_index();
+    default:
+        return {};
+    }
+}
+
+void Executable::dump_property_lookup_cache_statistics() const
+{
+    u64 total_hits = 0;
+    u64 total_misses = 0;
+    for (auto const& cache : property_lookup_caches) {
+        total_hits += cache.hit_count;
+        total_misses += cache.miss_count;
+    }
+    if (total_hits == 0 && total_misses == 0)
+        return;
+
+    warnln("\033[37;1mProperty lookup caches\033[0m for \"{}\" ({} hits, {} misses)", name, total_hits, total_misses);
+
+    for (InstructionStreamIterator it(bytecode, this); !it.at_end(); ++it) {
+        auto cache_index = property_lookup_cache_index_of(*it);
+        if (!cache_index.has_value())
+            continue;
+        auto const& cache = property_lookup_caches[*cache_index];
+        if (cache.hit_count == 0 && cache.miss_count == 0)
+            continue;
+
+        size_t shapes_in_use = 0;
+        for (auto const& entry : cache.entries) {
+            if (entry.shape)
+                ++shapes_in_use;
+        }
+
+        StringBuilder builder;
+        builder.appendff("[{:4x}] ", it.offset());
+        if (auto source_range = source_range_at(it.offset()); source_range.source_code) {
+            auto realized_range = source_range.realize();
+            builder.appendff("{}:{}:{} ", source_code->filename(), realized_range.start.line, realized_range.start.column);
+        }
+        builder.appendff("hits: {}, misses: {}, shapes: {}/{}, ", cache.hit_count, cache.miss_count, shapes_in_use, cache.entries.size());
+        builder.append((*it).to_byte_string(*this));
+        warnln("{}", builder.string_view());
+    }
+
+    warnln("");
+}
+
+void Executable::dump_property_lookup_cache_statistics_for_all_executables()
+{
+    // NOTE: Executables have a cell allocator of their own, so we can find all of them without keeping a list around.
+    cell_allocator.allocator.get().for_each_block([](HeapBlock& block) {
+        block.for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            static_cast<Executable*>(cell)->dump_property_lookup_cache_statistics();
+        });
+        return IterationDecision::Continue;
+    });
+}
+
 void Executable::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
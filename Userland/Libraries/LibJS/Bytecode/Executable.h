@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -23,13 +24,44 @@
 namespace JS::Bytecode {
 
 struct PropertyLookupCache {
-    WeakPtr<Shape> shape;
-    Optional<u32> property_offset;
-    WeakPtr<Object> prototype;
-    WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+        WeakPtr<Object> prototype;
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity;
+
+        // Property additions transition objects from `shape` to `new_shape`, with the new property at `property_offset`.
+        bool is_property_addition { false };
+        WeakPtr<Shape> new_shape;
+    };
+
+    // Returns the entry that should be (re)filled for objects of the given shape. That's the entry already
+    // caching that shape if there is one, otherwise an unused entry, otherwise entries are evicted round-robin.
+    Entry& entry_to_fill_for(Shape const& shape)
+    {
+        for (auto& entry : entries) {
+            if (&shape == entry.shape)
+                return entry;
+        }
+        for (auto& entry : entries) {
+            if (!entry.shape)
+                return entry;
+        }
+        auto& entry = entries[next_entry_to_evict];
+        next_entry_to_evict = (next_entry_to_evict + 1) % max_number_of_shapes_to_remember;
+        return entry;
+    }
+
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+    u8 next_entry_to_evict { 0 };
+
+    u64 hit_count { 0 };
+    u64 miss_count { 0 };
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
+struct GlobalVariableCache : public PropertyLookupCache::Entry {
     u64 environment_serial_number { 0 };
     Optional<u32> environment_binding_index;
 };
@@ -88,6 +120,11 @@ public:
 
     Optional<IdentifierTableIndex> length_identifier;
 
+    // Calls and backward jumps make an executable hotter, until the baseline JIT compiles it to native code.
+    u32 hotness_counter { 0 };
+    bool did_try_to_compile_native_code { false };
+    OwnPtr<JIT::NativeExecutable> native_executable;
+
     ByteString const& get_string(StringTableIndex index) const { return string_table->get(index); }
     DeprecatedFlyString const& get_identifier(IdentifierTableIndex index) const { return identifier_table->get(index); }
 
@@ -104,6 +141,9 @@ public:
 
     void dump() const;
 
+    void dump_property_lookup_cache_statistics() const;
+    static void dump_property_lookup_cache_statistics_for_all_executables();
+
 private:
     virtual void visit_edges(Visitor&) override;
 };
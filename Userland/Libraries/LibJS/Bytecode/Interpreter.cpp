@@ -14,6 +14,8 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Accessor.h>
 #include <LibJS/Runtime/Array.h>
@@ -155,16 +157,6 @@ Interpreter::~Interpreter()
 {
 }
 
-ALWAYS_INLINE Value Interpreter::get(Operand op) const
-{
-    return m_registers_and_constants_and_locals.data()[op.index()];
-}
-
-ALWAYS_INLINE void Interpreter::set(Operand op, Value value)
-{
-    m_registers_and_constants_and_locals.data()[op.index()] = value;
-}
-
 ALWAYS_INLINE Value Interpreter::do_yield(Value value, Optional<Label> continuation)
 {
     auto object = Object::create(realm(), nullptr);
@@ -332,6 +324,32 @@ Interpreter::HandleExceptionResponse Interpreter::handle_exception(size_t& progr
     VERIFY_NOT_REACHED();
 }
 
+bool Interpreter::run_native_code(size_t& program_counter)
+{
+    auto& executable = current_executable();
+    if (!executable.native_executable) {
+        if (executable.did_try_to_compile_native_code || ++executable.hotness_counter < JIT::Compiler::hotness_threshold)
+            return false;
+        executable.did_try_to_compile_native_code = true;
+        executable.native_executable = JIT::Compiler::compile(executable);
+        if (!executable.native_executable)
+            return false;
+    }
+
+    for (;;) {
+        switch (executable.native_executable->run(*this, m_registers_and_constants_and_locals, program_counter)) {
+        case JIT::NativeExecutable::Result::Finished:
+            return true;
+        case JIT::NativeExecutable::Result::ExitToInterpreter:
+            return false;
+        case JIT::NativeExecutable::Result::Exception:
+            if (handle_exception(program_counter, reg(Register::exception())) == HandleExceptionResponse::ExitFromExecutable)
+                return true;
+            break;
+        }
+    }
+}
+
 // FIXME: GCC takes a *long* time to compile with flattening, and it will time out our CI. :|
 #if defined(AK_COMPILER_CLANG)
 #    define FLATTEN_ON_CLANG FLATTEN
@@ -356,6 +374,9 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
     TemporaryChange change(m_program_counter, Optional<size_t&>(program_counter));
 
+    if (JIT::Compiler::is_enabled() && run_native_code(program_counter))
+        return;
+
     // Declare a lookup table for computed goto with each of the `handle_*` labels
     // to avoid the overhead of a switch statement.
     // This is a GCC extension, but it's also supported by Clang.
@@ -407,7 +428,12 @@ FLATTEN_ON_CLANG void Interpreter::run_bytecode(size_t entry_point)
 
         handle_Jump: {
             auto& instruction = *reinterpret_cast<Op::Jump const*>(&bytecode[program_counter]);
-            program_counter = instruction.target().address();
+            auto target = instruction.target().address();
+            bool is_backward_jump = target <= program_counter;
+            program_counter = target;
+            // Loops are what make an executable hot, and also where we can switch over to native code.
+            if (is_backward_jump && JIT::Compiler::is_enabled() && run_native_code(program_counter))
+                return;
             goto start;
         }
 
@@ -981,44 +1007,43 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<IdentifierTableIndex>
 
     auto& shape = base_obj->shape();
 
-    if (cache.prototype) {
-        // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
-        bool can_use_cache = [&]() -> bool {
-            if (&shape != cache.shape)
-                return false;
-            if (!cache.prototype_chain_validity)
-                return false;
-            if (!cache.prototype_chain_validity->is_valid())
-                return false;
-            return true;
-        }();
-        if (can_use_cache) {
-            auto value = cache.prototype->get_direct(cache.property_offset.value());
+    for (auto& cache_entry : cache.entries) {
+        if (&shape != cache_entry.shape)
+            continue;
+        if (cache_entry.prototype) {
+            // OPTIMIZATION: If the prototype chain hasn't been mutated in a way that would invalidate the cache, we can use it.
+            if (!cache_entry.prototype_chain_validity || !cache_entry.prototype_chain_validity->is_valid())
+                break;
+            ++cache.hit_count;
+            auto value = cache_entry.prototype->get_direct(cache_entry.property_offset.value());
             if (value.is_accessor())
                 return TRY(call(vm, value.as_accessor().getter(), this_value));
             return value;
         }
-    } else if (&shape == cache.shape) {
         // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
-        auto value = base_obj->get_direct(cache.property_offset.value());
+        ++cache.hit_count;
+        auto value = base_obj->get_direct(cache_entry.property_offset.value());
         if (value.is_accessor())
             return TRY(call(vm, value.as_accessor().getter(), this_value));
         return value;
     }
+    ++cache.miss_count;
 
     CacheablePropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(executable.get_identifier(property), this_value, &cacheable_metadata));
 
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache = {};
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        auto& cache_entry = cache.entry_to_fill_for(shape);
+        cache_entry = {};
+        cache_entry.shape = shape;
+        cache_entry.property_offset = cacheable_metadata.property_offset.value();
     } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain) {
-        cache = {};
-        cache.shape = &base_obj->shape();
-        cache.property_offset = cacheable_metadata.property_offset.value();
-        cache.prototype = *cacheable_metadata.prototype;
-        cache.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
+        auto& cache_entry = cache.entry_to_fill_for(base_obj->shape());
+        cache_entry = {};
+        cache_entry.shape = &base_obj->shape();
+        cache_entry.property_offset = cacheable_metadata.property_offset.value();
+        cache_entry.prototype = *cacheable_metadata.prototype;
+        cache_entry.prototype_chain_validity = *cacheable_metadata.prototype->shape().prototype_chain_validity();
     }
 
     return value;
@@ -1156,6 +1181,59 @@ inline ThrowCompletionOr<Value> get_global(Interpreter& interpreter, IdentifierT
     return vm.throw_completion<ReferenceError>(ErrorType::UnknownIdentifier, identifier);
 }
 
+static bool can_use_cached_property_addition(Object const& object, PropertyLookupCache::Entry const& cache_entry)
+{
+    if (!cache_entry.new_shape || !object.can_add_properties_via_cached_transition())
+        return false;
+
+    // NOTE: The object's prototype is part of its shape, so it's the same one we saw when filling the cache.
+    //       Anything that could make the prototype chain intercept the addition would have invalidated it.
+    if (!object.prototype())
+        return true;
+    return cache_entry.prototype_chain_validity && cache_entry.prototype_chain_validity->is_valid();
+}
+
+static void cache_property_addition(PropertyLookupCache& cache, Object& object, Shape& old_shape, PropertyKey const& property_key)
+{
+    if (!property_key.is_string() || !object.can_add_properties_via_cached_transition())
+        return;
+
+    if (old_shape.is_dictionary() || !old_shape.is_cacheable() || old_shape.is_prototype_shape())
+        return;
+
+    auto& new_shape = object.shape();
+    if (new_shape.is_dictionary() || new_shape.prototype() != old_shape.prototype() || new_shape.property_count() != old_shape.property_count() + 1)
+        return;
+
+    auto metadata = new_shape.lookup(property_key.to_string_or_symbol());
+    if (!metadata.has_value() || metadata->offset != old_shape.property_count() || metadata->attributes != default_attributes)
+        return;
+
+    // NOTE: Nothing in the prototype chain may have had a say in the [[Set]], and all of it must be covered by the
+    //       prototype chain validity. Dictionaries aren't, since they can change without transitioning to a new shape.
+    GCPtr<PrototypeChainValidity> prototype_chain_validity;
+    if (auto* prototype = new_shape.prototype()) {
+        prototype_chain_validity = prototype->shape().prototype_chain_validity();
+        if (!prototype_chain_validity || !prototype_chain_validity->is_valid())
+            return;
+        for (Object const* current = prototype; current; current = current->prototype()) {
+            if (current->may_interfere_with_indexed_property_access() || current->may_interfere_with_property_additions() || current->has_magical_length_property())
+                return;
+            if (current->shape().is_dictionary() || current->storage_has(property_key))
+                return;
+        }
+    }
+
+    auto& cache_entry = cache.entry_to_fill_for(old_shape);
+    cache_entry = {};
+    cache_entry.shape = old_shape;
+    cache_entry.property_offset = metadata->offset;
+    cache_entry.is_property_addition = true;
+    cache_entry.new_shape = new_shape;
+    if (prototype_chain_validity)
+        cache_entry.prototype_chain_validity = *prototype_chain_validity;
+}
+
 inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value this_value, Value value, Optional<DeprecatedFlyString const&> const& base_identifier, PropertyKey name, Op::PropertyKind kind, PropertyLookupCache* cache = nullptr)
 {
     // Better error message than to_object would give
@@ -1188,17 +1266,44 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        bool receiver_is_base = this_value.is_object() && &this_value.as_object() == object.ptr();
+
+        if (cache) {
+            auto& shape = object->shape();
+            for (auto& cache_entry : cache->entries) {
+                if (&shape != cache_entry.shape)
+                    continue;
+                if (!cache_entry.is_property_addition) {
+                    // OPTIMIZATION: If the shape of the object hasn't changed, we can write to the cached property offset.
+                    ++cache->hit_count;
+                    object->put_direct(*cache_entry.property_offset, value);
+                    return {};
+                }
+                // OPTIMIZATION: If objects of this shape have had this property added before, and nothing could intercept
+                //               the addition this time around, we can take the cached shape transition.
+                if (receiver_is_base && can_use_cached_property_addition(*object, cache_entry)) {
+                    ++cache->hit_count;
+                    object->add_property_via_cached_transition(*cache_entry.new_shape, value);
+                    return {};
+                }
+                break;
+            }
+            ++cache->miss_count;
         }
 
         CacheablePropertyMetadata cacheable_metadata;
+        NonnullGCPtr<Shape> shape_before_set = object->shape();
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
-        if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+        if (succeeded && cache) {
+            if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
+                auto& cache_entry = cache->entry_to_fill_for(object->shape());
+                cache_entry = {};
+                cache_entry.shape = object->shape();
+                cache_entry.property_offset = cacheable_metadata.property_offset.value();
+            } else if (receiver_is_base && &object->shape() != shape_before_set.ptr()) {
+                cache_property_addition(*cache, *object, *shape_before_set, name);
+            }
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -1300,7 +1405,7 @@ inline ThrowCompletionOr<void> put_by_value(VM& vm, Value base, Optional<Depreca
             if (maybe_value.has_value()) {
                 auto existing_value = maybe_value->value;
                 if (!existing_value.is_accessor()) {
-                    storage->put(index, value);
+                    object.indexed_properties().put(index, value);
                     return {};
                 }
             }
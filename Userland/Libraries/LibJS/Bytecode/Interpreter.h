@@ -8,6 +8,7 @@
 
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Label.h>
+#include <LibJS/Bytecode/Operand.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
@@ -56,8 +57,8 @@ public:
         return m_registers_and_constants_and_locals.data()[r.index()];
     }
 
-    [[nodiscard]] Value get(Operand) const;
-    void set(Operand, Value);
+    [[nodiscard]] ALWAYS_INLINE Value get(Operand op) const { return m_registers_and_constants_and_locals.data()[op.index()]; }
+    ALWAYS_INLINE void set(Operand op, Value value) { m_registers_and_constants_and_locals.data()[op.index()] = value; }
 
     Value do_yield(Value value, Optional<Label> continuation);
     void do_return(Value value)
@@ -83,6 +84,10 @@ public:
 private:
     void run_bytecode(size_t entry_point);
 
+    // Counts towards tiering up the current executable, and runs its native code from the program counter
+    // if it has any. Returns true if the executable is done, false if the interpreter should continue.
+    bool run_native_code(size_t& program_counter);
+
     enum class HandleExceptionResponse {
         ExitFromExecutable,
         ContinueInThisExecutable,
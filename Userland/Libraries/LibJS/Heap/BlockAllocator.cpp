@@ -25,6 +25,7 @@ namespace JS {
 
 BlockAllocator::~BlockAllocator()
 {
+    m_blocks.extend(move(m_blocks_pending_release));
     for (auto* block : m_blocks) {
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
         if (munmap(block, HeapBlock::block_size) < 0) {
@@ -36,10 +37,12 @@ BlockAllocator::~BlockAllocator()
 
 void* BlockAllocator::allocate_block([[maybe_unused]] char const* name)
 {
-    if (!m_blocks.is_empty()) {
+    // NOTE: Blocks that are pending release still have physical memory attached, so we prefer those.
+    auto& cached_blocks = m_blocks_pending_release.is_empty() ? m_blocks : m_blocks_pending_release;
+    if (!cached_blocks.is_empty()) {
         // To reduce predictability, take a random block from the cache.
-        size_t random_index = get_random_uniform(m_blocks.size());
-        auto* block = m_blocks.unstable_take(random_index);
+        size_t random_index = get_random_uniform(cached_blocks.size());
+        auto* block = cached_blocks.unstable_take(random_index);
         ASAN_UNPOISON_MEMORY_REGION(block, HeapBlock::block_size);
         LSAN_REGISTER_ROOT_REGION(block, HeapBlock::block_size);
 #ifdef AK_OS_SERENITY
@@ -65,6 +68,20 @@ void BlockAllocator::deallocate_block(void* block)
 {
     VERIFY(block);
 
+    ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
+    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
+    m_blocks_pending_release.append(block);
+}
+
+void BlockAllocator::release_unused_blocks()
+{
+    for (auto* block : m_blocks_pending_release)
+        release_block_memory(block);
+    m_blocks.extend(move(m_blocks_pending_release));
+}
+
+void BlockAllocator::release_block_memory(void* block)
+{
 #if defined(USE_FALLBACK_BLOCK_DEALLOCATION)
     // If we can't use any of the nicer techniques, unmap and remap the block to return the physical pages while keeping the VM.
     if (munmap(block, HeapBlock::block_size) < 0) {
@@ -88,8 +105,6 @@ void BlockAllocator::deallocate_block(void* block)
 #endif
 
     ASAN_POISON_MEMORY_REGION(block, HeapBlock::block_size);
-    LSAN_UNREGISTER_ROOT_REGION(block, HeapBlock::block_size);
-    m_blocks.append(block);
 }
 
 }
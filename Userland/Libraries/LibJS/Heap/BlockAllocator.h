@@ -19,8 +19,17 @@ public:
     void* allocate_block(char const* name);
     void deallocate_block(void*);
 
+    // Returns the memory of blocks that were deallocated and haven't been reused since the last call to the system.
+    void release_unused_blocks();
+
 private:
+    static void release_block_memory(void*);
+
     Vector<void*> m_blocks;
+
+    // Deallocated blocks keep their physical memory until the next call to release_unused_blocks(), so blocks that are
+    // needed again right away don't cost a syscall (and page faults) on both ends, and don't add to the GC pause.
+    Vector<void*> m_blocks_pending_release;
 };
 
 }
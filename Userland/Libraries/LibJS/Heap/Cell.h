@@ -27,15 +27,32 @@ namespace JS {
 #    define IGNORE_GC
 #endif
 
-#define JS_CELL(class_, base_class)                \
-public:                                            \
-    using Base = base_class;                       \
-    virtual StringView class_name() const override \
-    {                                              \
-        return #class_##sv;                        \
-    }                                              \
+#define JS_CELL(class_, base_class)                         \
+public:                                                     \
+    using Base = base_class;                                \
+    virtual StringView class_name() const override          \
+    {                                                       \
+        return #class_##sv;                                 \
+    }                                                       \
+    virtual bool has_write_barriers() const override        \
+    {                                                       \
+        return JS::cell_class_has_write_barriers<class_>(); \
+    }                                                       \
     friend class JS::Heap;
 
+// Opts the class (but not its subclasses) into write barriers, see Cell::write_barrier().
+// This must directly follow the JS_CELL() line of the class.
+#define JS_CELL_HAS_WRITE_BARRIERS(class_) \
+    using WriteBarrieredCell = class_;
+
+template<typename T>
+constexpr bool cell_class_has_write_barriers()
+{
+    if constexpr (requires { typename T::WriteBarrieredCell; })
+        return IsSame<typename T::WriteBarrieredCell, T>;
+    return false;
+}
+
 class Cell : public Weakable<Cell> {
     AK_MAKE_NONCOPYABLE(Cell);
     AK_MAKE_NONMOVABLE(Cell);
@@ -47,6 +64,10 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    // Cells are young until they survive their first garbage collection.
+    bool is_young() const { return m_young; }
+    void set_young(bool b) { m_young = b; }
+
     enum class State : bool {
         Live,
         Dead,
@@ -57,6 +78,21 @@ public:
 
     virtual StringView class_name() const = 0;
 
+    // Whether every store of a GC pointer into this cell after its construction is followed by a write_barrier() call.
+    // The garbage collector has to rescan cells without write barriers whenever it needs to know their current edges.
+    virtual bool has_write_barriers() const { return false; }
+
+    // Cells with write barriers have to call this after storing a GC pointer into themselves, so the garbage collector
+    // can find edges from old to young cells, and from marked to unmarked cells during incremental marking.
+    ALWAYS_INLINE void write_barrier()
+    {
+        if ((!m_young || m_mark) && !m_remembered)
+            remember();
+    }
+
+    bool is_remembered() const { return m_remembered; }
+    void set_remembered(Badge<Heap>, bool b) { m_remembered = b; }
+
     class Visitor {
     public:
         void visit(Cell* cell)
@@ -177,9 +213,13 @@ protected:
     void set_overrides_must_survive_garbage_collection(bool b) { m_overrides_must_survive_garbage_collection = b; }
 
 private:
+    void remember();
+
     bool m_mark : 1 { false };
     bool m_overrides_must_survive_garbage_collection : 1 { false };
     State m_state : 1 { State::Live };
+    bool m_young : 1 { true };
+    bool m_remembered : 1 { false };
 };
 
 }
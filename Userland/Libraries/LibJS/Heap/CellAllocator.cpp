@@ -30,12 +30,15 @@ Cell* CellAllocator::allocate_cell(Heap& heap)
             m_min_block_address = block_ptr;
         if (m_max_block_address < block_ptr)
             m_max_block_address = block_ptr;
+        heap.did_create_heap_block({}, *block);
         m_usable_blocks.append(*block.leak_ptr());
     }
 
     auto& block = *m_usable_blocks.last();
     auto* cell = block.allocate();
     VERIFY(cell);
+    if (!block.is_in_nursery())
+        heap.did_allocate_in_block({}, block);
     if (block.is_full())
         m_full_blocks.append(*m_usable_blocks.last());
     return cell;
@@ -74,36 +74,45 @@ void Heap::will_allocate(size_t size)
         collect_garbage();
     } else if (m_allocated_bytes_since_last_gc + size > m_gc_bytes_threshold) {
         m_allocated_bytes_since_last_gc = 0;
-        collect_garbage();
+        collect_garbage(CollectionType::CollectYoungGeneration);
+    } else if (m_incremental_marking_in_progress) {
+        // NOTE: Marking is paced by allocation, so it is done by the time the next collection would have been due.
+        m_allocated_bytes_since_last_mark_slice += size;
+        if (m_allocated_bytes_since_last_mark_slice > m_gc_bytes_threshold / INCREMENTAL_MARK_SLICES_PER_THRESHOLD) {
+            m_allocated_bytes_since_last_mark_slice = 0;
+            if (perform_incremental_mark_slice())
+                collect_garbage(CollectionType::CollectGarbage);
+        }
     }
 
     m_allocated_bytes_since_last_gc += size;
 }
 
-static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
+static FlatPtr possible_pointer_from_value(FlatPtr data)
 {
     if constexpr (sizeof(FlatPtr*) == sizeof(Value)) {
         // Because Value stores pointers in non-canonical form we have to check if the top bytes
         // match any pointer-backed tag, in that case we have to extract the pointer to its
         // canonical form and add that as a possible pointer.
-        FlatPtr possible_pointer;
         if ((data & SHIFTED_IS_CELL_PATTERN) == SHIFTED_IS_CELL_PATTERN)
-            possible_pointer = Value::extract_pointer_bits(data);
-        else
-            possible_pointer = data;
-        if (possible_pointer < min_block_address || possible_pointer > max_block_address)
-            return;
-        possible_pointers.set(possible_pointer, move(origin));
+            return Value::extract_pointer_bits(data);
+        return data;
     } else {
         static_assert((sizeof(Value) % sizeof(FlatPtr*)) == 0);
-        if (data < min_block_address || data > max_block_address)
-            return;
         // In the 32-bit case we will look at the top and bottom part of Value separately we just
         // add both the upper and lower bytes as possible pointers.
-        possible_pointers.set(data, move(origin));
+        return data;
     }
 }
 
+static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, FlatPtr data, HeapRoot origin, FlatPtr min_block_address, FlatPtr max_block_address)
+{
+    auto possible_pointer = possible_pointer_from_value(data);
+    if (possible_pointer < min_block_address || possible_pointer > max_block_address)
+        return;
+    possible_pointers.set(possible_pointer, move(origin));
+}
+
 void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address)
 {
     min_address = explode_byte(0xff);
@@ -135,10 +144,6 @@ public:
         : m_heap(heap)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
         m_work_queue.ensure_capacity(roots.size());
 
         for (auto& [root, root_origin] : roots) {
@@ -169,7 +174,7 @@ public:
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
             add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        for_each_cell_among_possible_pointers(m_heap.m_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
             if (m_node_being_visited)
                 m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(cell));
 
@@ -246,7 +251,6 @@ private:
     HashMap<FlatPtr, GraphNode> m_graph;
 
     Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
@@ -270,21 +274,48 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     perf_event(PERF_EVENT_SIGNPOST, gc_perf_string_id, global_gc_counter++);
 #endif
 
-    Core::ElapsedTimer collection_measurement_timer;
-    if (print_report)
-        collection_measurement_timer.start();
+    auto collection_measurement_timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
 
-    if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
+    if (collection_type != CollectionType::CollectEverything && m_gc_deferrals) {
+        if (!m_should_gc_when_deferral_ends || collection_type == CollectionType::CollectGarbage)
+            m_collection_type_when_deferral_ends = collection_type;
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        if (m_incremental_marking_in_progress) {
+            // NOTE: A minor collection would promote young cells that marking hasn't gotten to yet, so we finish the
+            //       full collection in progress instead.
+            collection_type = CollectionType::CollectGarbage;
+        } else if (m_old_generation_bytes > m_full_gc_bytes_threshold) {
+            // The old generation has grown enough for a full collection. Nobody is waiting for this one though, so
+            // we mark the heap a slice at a time while the mutator keeps running.
+            if (m_incremental_marking_enabled) {
+                start_incremental_marking();
+                m_incremental_mark_pause_histogram.record(collection_measurement_timer.elapsed_time());
+                return;
+            }
+            collection_type = CollectionType::CollectGarbage;
         }
+    }
+
+    if (collection_type == CollectionType::CollectEverything) {
+        if (m_incremental_marking_in_progress)
+            abandon_incremental_marking();
+    } else {
         HashMap<Cell*, HeapRoot> roots;
         gather_roots(roots);
-        mark_live_cells(roots);
+        mark_live_cells(roots, collection_type);
     }
-    finalize_unmarked_cells();
-    sweep_dead_cells(print_report, collection_measurement_timer);
+    forget_remembered_cells();
+    finalize_unmarked_cells(collection_type);
+    sweep_dead_cells(collection_type, print_report, collection_measurement_timer);
+
+    if (collection_type == CollectionType::CollectYoungGeneration)
+        m_minor_pause_histogram.record(collection_measurement_timer.elapsed_time());
+    else
+        m_major_pause_histogram.record(collection_measurement_timer.elapsed_time());
 }
 
 void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
@@ -372,13 +403,7 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
-    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
+    for_each_cell_among_possible_pointers(m_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
             roots.set(cell, *possible_pointers.get(possible_pointer));
@@ -388,17 +413,20 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
     });
 }
 
+// NOTE: Marked cells whose edges haven't been visited yet (the gray cells) are kept in the heap, so that incremental
+//       marking can pick up where the previous slice left off.
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
+    explicit MarkingVisitor(Heap& heap, bool only_young_cells)
         : m_heap(heap)
+        , m_work_queue(heap.m_gray_cells)
+        , m_only_young_cells(only_young_cells)
     {
         m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
+    }
 
+    void mark_roots(HashMap<Cell*, HeapRoot> const& roots)
+    {
         for (auto* root : roots.keys()) {
             visit(root);
         }
@@ -408,6 +436,8 @@ public:
     {
         if (cell.is_marked())
             return;
+        if (m_only_young_cells && !cell.is_young())
+            return;
         dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
 
         cell.set_marked(true);
@@ -416,20 +446,26 @@ public:
 
     virtual void visit_possible_values(ReadonlyBytes bytes) override
     {
-        HashMap<FlatPtr, HeapRoot> possible_pointers;
-
+        // NOTE: This runs for every HeapFunction, so unlike when gathering roots, we don't collect the possible
+        //       pointers into a HashMap first. Visiting a cell more than once is harmless here.
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
-        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
-
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
-            if (cell->is_marked())
-                return;
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i) {
+            auto possible_pointer = possible_pointer_from_value(raw_pointer_sized_values[i]);
+            if (!possible_pointer || possible_pointer < m_min_block_address || possible_pointer > m_max_block_address)
+                continue;
+            auto* possible_heap_block = HeapBlock::from_cell(reinterpret_cast<Cell const*>(possible_pointer));
+            if (!m_heap.m_live_heap_blocks.contains(possible_heap_block))
+                continue;
+            auto* cell = possible_heap_block->cell_from_possible_pointer(possible_pointer);
+            if (!cell || cell->is_marked())
+                continue;
             if (cell->state() != Cell::State::Live)
-                return;
+                continue;
+            if (m_only_young_cells && !cell->is_young())
+                continue;
             cell->set_marked(true);
             m_work_queue.append(*cell);
-        });
+        }
     }
 
     void mark_all_live_cells()
@@ -439,26 +475,153 @@ public:
         }
     }
 
+    // Returns true once there are no gray cells left.
+    bool mark_live_cells_until(Core::ElapsedTimer const& timer, Duration budget)
+    {
+        // NOTE: Reading the clock is not free, so we only check it every so often.
+        static constexpr size_t cells_between_clock_checks = 64;
+
+        size_t visited_cells = 0;
+        while (!m_work_queue.is_empty()) {
+            m_work_queue.take_last()->visit_edges(*this);
+            if (++visited_cells % cells_between_clock_checks == 0 && timer.elapsed_time() >= budget)
+                return m_work_queue.is_empty();
+        }
+        return true;
+    }
+
 private:
     Heap& m_heap;
-    Vector<NonnullGCPtr<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
+    Vector<NonnullGCPtr<Cell>>& m_work_queue;
+    bool m_only_young_cells { false };
     FlatPtr m_min_block_address;
     FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, CollectionType collection_type)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    bool only_young_cells = collection_type == CollectionType::CollectYoungGeneration;
+    MarkingVisitor visitor(*this, only_young_cells);
+
+    if (m_incremental_marking_in_progress) {
+        // NOTE: This is the final pause of incremental marking. Everything marked so far stays marked, but the roots
+        //       may have changed since marking started, and so may the marked cells that were stored into since.
+        VERIFY(!only_young_cells);
+        visit_marked_cells_that_may_have_changed(visitor, IncludeCellsWithoutWriteBarriers::Yes);
+        m_incremental_marking_in_progress = false;
+    }
+
+    visitor.mark_roots(roots);
+
+    if (only_young_cells) {
+        // NOTE: The old generation is assumed to be alive, but anything young it points to has to survive as well.
+        //       Only the old cells that were stored into since the last collection (as told by their write barriers)
+        //       and the old cells without write barriers can point to young cells, so their direct edges are roots.
+        for (auto* cell : m_remembered_cells)
+            cell->visit_edges(visitor);
+        for (auto* cell : m_old_cells_without_write_barriers)
+            cell->visit_edges(visitor);
+    }
 
     visitor.mark_all_live_cells();
 
-    for (auto& inverse_root : m_uprooted_cells)
+    // NOTE: Old cells can only die in a full collection, so uprooted old cells have to wait for the next one.
+    m_uprooted_cells.remove_all_matching([&](auto& inverse_root) {
+        if (only_young_cells && !inverse_root->is_young())
+            return false;
         inverse_root->set_marked(false);
+        return true;
+    });
+}
+
+void Heap::start_incremental_marking()
+{
+    dbgln_if(HEAP_DEBUG, "start_incremental_marking:");
+    VERIFY(!m_incremental_marking_in_progress);
+    VERIFY(m_gray_cells.is_empty());
+
+    // NOTE: No minor collection happens until marking is done, so we don't need to know about old-to-young edges
+    //       until then. From here on, the remembered cells are the marked cells that were stored into.
+    forget_remembered_cells();
+
+    HashMap<Cell*, HeapRoot> roots;
+    gather_roots(roots);
+    MarkingVisitor visitor(*this, false);
+    visitor.mark_roots(roots);
+
+    m_incremental_marking_in_progress = true;
+    m_allocated_bytes_since_last_mark_slice = 0;
+}
+
+bool Heap::perform_incremental_mark_slice()
+{
+    VERIFY(m_incremental_marking_in_progress);
+    if (m_gc_deferrals || m_collecting_garbage)
+        return false;
+    TemporaryChange change(m_collecting_garbage, true);
 
-    m_uprooted_cells.clear();
+    auto timer = Core::ElapsedTimer::start_new(Core::TimerType::Precise);
+    MarkingVisitor visitor(*this, false);
+    visit_marked_cells_that_may_have_changed(visitor, IncludeCellsWithoutWriteBarriers::No);
+    auto is_done = visitor.mark_live_cells_until(timer, INCREMENTAL_MARK_SLICE_BUDGET);
+    m_incremental_mark_pause_histogram.record(timer.elapsed_time());
+    return is_done;
+}
+
+void Heap::visit_marked_cells_that_may_have_changed(MarkingVisitor& visitor, IncludeCellsWithoutWriteBarriers include_cells_without_write_barriers)
+{
+    // Cells that were stored into after we visited their edges may point to unmarked cells now, so we gray them again.
+    // Any remembered cells that haven't been marked yet will have all of their edges visited once they are.
+    m_remembered_cells.remove_all_matching([&](Cell* cell) {
+        if (!cell->is_marked())
+            return false;
+        cell->set_remembered({}, false);
+        cell->visit_edges(visitor);
+        return true;
+    });
+
+    if (include_cells_without_write_barriers == IncludeCellsWithoutWriteBarriers::No)
+        return;
+
+    // Without write barriers, we can't tell whether a cell changed, so every marked one has to be visited again.
+    for (auto* cell : m_old_cells_without_write_barriers) {
+        if (cell->is_marked())
+            cell->visit_edges(visitor);
+    }
+    for (auto* block : m_nursery_blocks) {
+        block->for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (cell->is_young() && cell->is_marked() && !cell->has_write_barriers())
+                cell->visit_edges(visitor);
+        });
+    }
+}
+
+void Heap::abandon_incremental_marking()
+{
+    m_gray_cells.clear();
+    for_each_block([&](auto& block) {
+        block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+            cell->set_marked(false);
+        });
+        return IterationDecision::Continue;
+    });
+    m_incremental_marking_in_progress = false;
+}
+
+void Heap::remember_cell(Badge<Cell>, Cell& cell)
+{
+    cell.set_remembered({}, true);
+    m_remembered_cells.append(&cell);
+}
+
+void Heap::forget_remembered_cells()
+{
+    // NOTE: Every collection promotes all young survivors, so afterwards there are no edges from old to young cells left.
+    for (auto* cell : m_remembered_cells)
+        cell->set_remembered({}, false);
+    m_remembered_cells.clear_with_capacity();
 }
 
 bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
@@ -468,8 +631,18 @@ bool Heap::cell_must_survive_garbage_collection(Cell const& cell)
     return cell.must_survive_garbage_collection();
 }
 
-void Heap::finalize_unmarked_cells()
+void Heap::finalize_unmarked_cells(CollectionType collection_type)
 {
+    if (collection_type == CollectionType::CollectYoungGeneration) {
+        for (auto* block : m_nursery_blocks) {
+            block->for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
+                if (cell->is_young() && !cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
+                    cell->finalize();
+            });
+        }
+        return;
+    }
+
     for_each_block([&](auto& block) {
         block.template for_each_cell_in_state<Cell::State::Live>([](Cell* cell) {
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell))
@@ -479,21 +652,38 @@ void Heap::finalize_unmarked_cells()
     });
 }
 
-void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measurement_timer)
+void Heap::sweep_dead_cells(CollectionType collection_type, bool print_report, Core::ElapsedTimer const& measurement_timer)
 {
     dbgln_if(HEAP_DEBUG, "sweep_dead_cells:");
     Vector<HeapBlock*, 32> empty_blocks;
     Vector<HeapBlock*, 32> full_blocks_that_became_usable;
 
+    bool is_minor_collection = collection_type == CollectionType::CollectYoungGeneration;
+
     size_t collected_cells = 0;
     size_t live_cells = 0;
+    size_t promoted_cells = 0;
     size_t collected_cell_bytes = 0;
     size_t live_cell_bytes = 0;
+    size_t promoted_cell_bytes = 0;
 
-    for_each_block([&](auto& block) {
+    // NOTE: Every survivor is promoted to the old generation, so the nursery starts out empty again.
+    auto nursery_blocks = move(m_nursery_blocks);
+    for (auto* block : nursery_blocks)
+        block->set_in_nursery({}, false);
+
+    // NOTE: A full collection may free any old cell, so we find the survivors without write barriers from scratch.
+    if (!is_minor_collection)
+        m_old_cells_without_write_barriers.clear_with_capacity();
+
+    auto sweep_block = [&](HeapBlock& block) {
         bool block_has_live_cells = false;
         bool block_was_full = block.is_full();
-        block.template for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+        block.for_each_cell_in_state<Cell::State::Live>([&](Cell* cell) {
+            if (is_minor_collection && !cell->is_young()) {
+                block_has_live_cells = true;
+                return;
+            }
             if (!cell->is_marked() && !cell_must_survive_garbage_collection(*cell)) {
                 dbgln_if(HEAP_DEBUG, "  ~ {}", cell);
                 block.deallocate(cell);
@@ -501,6 +691,14 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
                 collected_cell_bytes += block.cell_size();
             } else {
                 cell->set_marked(false);
+                if (cell->is_young()) {
+                    cell->set_young(false);
+                    ++promoted_cells;
+                    promoted_cell_bytes += block.cell_size();
+                }
+                // NOTE: Minor collections only get here for the cells they promote.
+                if (!cell->has_write_barriers())
+                    m_old_cells_without_write_barriers.append(cell);
                 block_has_live_cells = true;
                 ++live_cells;
                 live_cell_bytes += block.cell_size();
@@ -510,14 +708,28 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
             empty_blocks.append(&block);
         else if (block_was_full != block.is_full())
             full_blocks_that_became_usable.append(&block);
-        return IterationDecision::Continue;
-    });
+    };
+
+    if (is_minor_collection) {
+        for (auto* block : nursery_blocks)
+            sweep_block(*block);
+    } else {
+        for_each_block([&](auto& block) {
+            sweep_block(block);
+            return IterationDecision::Continue;
+        });
+    }
 
     for (auto& weak_container : m_weak_containers)
         weak_container.remove_dead_cells({});
 
+    // NOTE: Blocks that weren't needed again since the previous collection are given back to the system now.
+    for (auto& allocator : m_all_cell_allocators)
+        allocator.block_allocator().release_unused_blocks();
+
     for (auto* block : empty_blocks) {
         dbgln_if(HEAP_DEBUG, " - HeapBlock empty @ {}: cell_size={}", block, block->cell_size());
+        m_live_heap_blocks.remove(block);
         block->cell_allocator().block_did_become_empty({}, *block);
     }
 
@@ -533,7 +745,14 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
         });
     }
 
-    m_gc_bytes_threshold = live_cell_bytes > GC_MIN_BYTES_THRESHOLD ? live_cell_bytes : GC_MIN_BYTES_THRESHOLD;
+    if (is_minor_collection) {
+        m_old_generation_bytes += promoted_cell_bytes;
+    } else {
+        m_old_generation_bytes = live_cell_bytes;
+        m_full_gc_bytes_threshold = max(2 * live_cell_bytes, 2 * GC_MIN_BYTES_THRESHOLD);
+    }
+
+    m_gc_bytes_threshold = m_old_generation_bytes > GC_MIN_BYTES_THRESHOLD ? m_old_generation_bytes : GC_MIN_BYTES_THRESHOLD;
 
     if (print_report) {
         Duration const time_spent = measurement_timer.elapsed_time();
@@ -545,15 +764,52 @@ void Heap::sweep_dead_cells(bool print_report, Core::ElapsedTimer const& measure
 
         dbgln("Garbage collection report");
         dbgln("=============================================");
+        dbgln("     Collection: {}", is_minor_collection ? "Minor"sv : "Major"sv);
         dbgln("     Time spent: {} ms", time_spent.to_milliseconds());
-        dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
+        if (is_minor_collection)
+            dbgln(" Old generation: {} bytes", m_old_generation_bytes);
+        else
+            dbgln("     Live cells: {} ({} bytes)", live_cells, live_cell_bytes);
+        dbgln(" Promoted cells: {} ({} bytes)", promoted_cells, promoted_cell_bytes);
         dbgln("Collected cells: {} ({} bytes)", collected_cells, collected_cell_bytes);
         dbgln("    Live blocks: {} ({} bytes)", live_block_count, live_block_count * HeapBlock::block_size);
         dbgln("   Freed blocks: {} ({} bytes)", empty_blocks.size(), empty_blocks.size() * HeapBlock::block_size);
         dbgln("=============================================");
+        dump_pause_histograms();
+    }
+}
+
+void GCPauseHistogram::record(Duration pause)
+{
+    size_t bucket = 0;
+    while (bucket < bucket_count - 1 && pause >= bucket_upper_bound(bucket))
+        ++bucket;
+    ++m_buckets[bucket];
+    ++m_count;
+    m_total += pause;
+    m_longest = max(m_longest, pause);
+}
+
+void GCPauseHistogram::dump(StringView name) const
+{
+    dbgln("{} pauses: {} (total {} us, longest {} us)", name, m_count, m_total.to_microseconds(), m_longest.to_microseconds());
+    for (size_t i = 0; i < bucket_count; ++i) {
+        if (!m_buckets[i])
+            continue;
+        if (i == bucket_count - 1)
+            dbgln("  >= {:>6} us: {}", bucket_upper_bound(i - 1).to_microseconds(), m_buckets[i]);
+        else
+            dbgln("  <  {:>6} us: {}", bucket_upper_bound(i).to_microseconds(), m_buckets[i]);
     }
 }
 
+void Heap::dump_pause_histograms() const
+{
+    m_minor_pause_histogram.dump("Minor GC"sv);
+    m_major_pause_histogram.dump("Major GC"sv);
+    m_incremental_mark_pause_histogram.dump("Incremental marking"sv);
+}
+
 void Heap::defer_gc()
 {
     ++m_gc_deferrals;
@@ -566,7 +822,7 @@ void Heap::undefer_gc()
 
     if (!m_gc_deferrals) {
         if (m_should_gc_when_deferral_ends)
-            collect_garbage();
+            collect_garbage(m_collection_type_when_deferral_ends);
         m_should_gc_when_deferral_ends = false;
     }
 }
@@ -6,11 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -28,6 +30,31 @@
 
 namespace JS {
 
+class MarkingVisitor;
+
+class GCPauseHistogram {
+public:
+    // Bucket N counts pauses shorter than 2^N * 100 microseconds, the last bucket counts all longer pauses.
+    static constexpr size_t bucket_count = 12;
+
+    void record(Duration);
+
+    size_t count() const { return m_count; }
+    Duration total() const { return m_total; }
+    Duration longest() const { return m_longest; }
+    size_t count_in_bucket(size_t index) const { return m_buckets[index]; }
+
+    static Duration bucket_upper_bound(size_t index) { return Duration::from_microseconds(100ll << index); }
+
+    void dump(StringView name) const;
+
+private:
+    AK::Array<size_t, bucket_count> m_buckets {};
+    size_t m_count { 0 };
+    Duration m_total;
+    Duration m_longest;
+};
+
 class Heap : public HeapBase {
     AK_MAKE_NONCOPYABLE(Heap);
     AK_MAKE_NONMOVABLE(Heap);
@@ -61,6 +88,10 @@ public:
     enum class CollectionType {
         CollectGarbage,
         CollectEverything,
+        // Only traces and sweeps cells allocated since the last collection, promoting the survivors to the old generation.
+        // Once the old generation has grown enough since the last full collection, this starts marking the whole heap
+        // incrementally instead, and finishes that full collection the next time around.
+        CollectYoungGeneration,
     };
 
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
@@ -69,6 +100,10 @@ public:
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
+    bool is_incremental_marking_enabled() const { return m_incremental_marking_enabled; }
+    void set_incremental_marking_enabled(bool b) { m_incremental_marking_enabled = b; }
+    bool is_incremental_marking_in_progress() const { return m_incremental_marking_in_progress; }
+
     void did_create_handle(Badge<HandleImpl>, HandleImpl&);
     void did_destroy_handle(Badge<HandleImpl>, HandleImpl&);
 
@@ -85,9 +120,18 @@ public:
     void did_destroy_execution_context(Badge<ExecutionContext>, ExecutionContext&);
 
     void register_cell_allocator(Badge<CellAllocator>, CellAllocator&);
+    void did_create_heap_block(Badge<CellAllocator>, HeapBlock&);
+    void did_allocate_in_block(Badge<CellAllocator>, HeapBlock&);
 
     void uproot_cell(Cell* cell);
 
+    void remember_cell(Badge<Cell>, Cell&);
+
+    GCPauseHistogram const& minor_pause_histogram() const { return m_minor_pause_histogram; }
+    GCPauseHistogram const& major_pause_histogram() const { return m_major_pause_histogram; }
+    GCPauseHistogram const& incremental_mark_pause_histogram() const { return m_incremental_mark_pause_histogram; }
+    void dump_pause_histograms() const;
+
 private:
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
@@ -116,9 +160,20 @@ private:
     void gather_roots(HashMap<Cell*, HeapRoot>&);
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
-    void finalize_unmarked_cells();
-    void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, CollectionType);
+    void forget_remembered_cells();
+
+    void start_incremental_marking();
+    bool perform_incremental_mark_slice();
+    void abandon_incremental_marking();
+
+    enum class IncludeCellsWithoutWriteBarriers {
+        No,
+        Yes,
+    };
+    void visit_marked_cells_that_may_have_changed(MarkingVisitor&, IncludeCellsWithoutWriteBarriers);
+    void finalize_unmarked_cells(CollectionType);
+    void sweep_dead_cells(CollectionType, bool print_report, Core::ElapsedTimer const&);
 
     ALWAYS_INLINE CellAllocator& allocator_for_size(size_t cell_size)
     {
@@ -144,6 +199,35 @@ private:
     size_t m_gc_bytes_threshold { GC_MIN_BYTES_THRESHOLD };
     size_t m_allocated_bytes_since_last_gc { 0 };
 
+    // The old generation only shrinks during full collections, so we do one once it has doubled since the last one.
+    size_t m_old_generation_bytes { 0 };
+    size_t m_full_gc_bytes_threshold { 2 * GC_MIN_BYTES_THRESHOLD };
+
+    // While marking incrementally, each time this fraction of the GC threshold has been allocated, marking continues
+    // for a slice of at most this long.
+    static constexpr size_t INCREMENTAL_MARK_SLICES_PER_THRESHOLD { 64 };
+    static constexpr Duration INCREMENTAL_MARK_SLICE_BUDGET { Duration::from_milliseconds(1) };
+
+    bool m_incremental_marking_enabled { true };
+    bool m_incremental_marking_in_progress { false };
+    size_t m_allocated_bytes_since_last_mark_slice { 0 };
+
+    // Cells that have been marked, but whose edges haven't been visited yet.
+    Vector<NonnullGCPtr<Cell>> m_gray_cells;
+
+    HashTable<HeapBlock*> m_live_heap_blocks;
+    Vector<HeapBlock*> m_nursery_blocks;
+
+    // Cells with write barriers that have been stored into since the last collection, and all old cells without write
+    // barriers. Together, they are the only old cells that may point to young cells.
+    // NOTE: While marking incrementally, cells are only remembered until marking visits them again.
+    Vector<Cell*> m_remembered_cells;
+    Vector<Cell*> m_old_cells_without_write_barriers;
+
+    GCPauseHistogram m_minor_pause_histogram;
+    GCPauseHistogram m_major_pause_histogram;
+    GCPauseHistogram m_incremental_mark_pause_histogram;
+
     bool m_should_collect_on_every_allocation { false };
 
     Vector<NonnullOwnPtr<CellAllocator>> m_size_based_cell_allocators;
@@ -158,6 +242,7 @@ private:
 
     size_t m_gc_deferrals { 0 };
     bool m_should_gc_when_deferral_ends { false };
+    CollectionType m_collection_type_when_deferral_ends { CollectionType::CollectYoungGeneration };
 
     bool m_collecting_garbage { false };
 };
@@ -215,4 +300,15 @@ inline void Heap::register_cell_allocator(Badge<CellAllocator>, CellAllocator& a
     m_all_cell_allocators.append(allocator);
 }
 
+inline void Heap::did_create_heap_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    m_live_heap_blocks.set(&block);
+}
+
+inline void Heap::did_allocate_in_block(Badge<CellAllocator>, HeapBlock& block)
+{
+    block.set_in_nursery({}, true);
+    m_nursery_blocks.append(&block);
+}
+
 }
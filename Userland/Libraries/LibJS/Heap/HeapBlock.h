@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Badge.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Platform.h>
 #include <AK/StringView.h>
@@ -50,6 +51,10 @@ public:
 
     void deallocate(Cell*);
 
+    // A block is in the nursery if cells have been allocated in it since the last garbage collection.
+    bool is_in_nursery() const { return m_in_nursery; }
+    void set_in_nursery(Badge<Heap>, bool b) { m_in_nursery = b; }
+
     template<typename Callback>
     void for_each_cell(Callback callback)
     {
@@ -111,6 +116,7 @@ private:
     CellAllocator& m_cell_allocator;
     size_t m_cell_size { 0 };
     size_t m_next_lazy_freelist_index { 0 };
+    bool m_in_nursery { false };
     GCPtr<FreelistEntry> m_freelist;
     alignas(__BIGGEST_ALIGNMENT__) u8 m_storage[];
 
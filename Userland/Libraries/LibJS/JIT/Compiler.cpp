@@ -0,0 +1,686 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/AbstractOperations.h>
+#include <LibJS/Runtime/ValueInlines.h>
+#include <stdlib.h>
+
+namespace JS::JIT {
+
+#ifdef JIT_ARCH_SUPPORTED
+bool Compiler::s_enabled = getenv("LIBJS_JIT") != nullptr;
+#else
+bool Compiler::s_enabled = false;
+#endif
+
+void Compiler::set_enabled(bool enabled)
+{
+#ifdef JIT_ARCH_SUPPORTED
+    s_enabled = enabled;
+#else
+    (void)enabled;
+#endif
+}
+
+#ifdef JIT_ARCH_SUPPORTED
+
+using Assembler = ::JIT::Assembler;
+
+// Native code keeps these in callee-saved registers for its whole lifetime.
+static constexpr auto INTERPRETER = Assembler::Reg::RBX;
+static constexpr auto REGISTERS_AND_CONSTANTS_AND_LOCALS = Assembler::Reg::R14;
+static constexpr auto PROGRAM_COUNTER = Assembler::Reg::R15;
+
+// NOTE: RCX is used as a scratch register by the tag checks below.
+static constexpr auto SCRATCH = Assembler::Reg::RCX;
+
+template<typename OpType>
+static u64 cxx_execute(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    if constexpr (IsSame<decltype(instruction.execute_impl(interpreter)), void>) {
+        instruction.execute_impl(interpreter);
+    } else {
+        auto result = instruction.execute_impl(interpreter);
+        if (result.is_error()) {
+            interpreter.reg(Bytecode::Register::exception()) = result.error_value();
+            return 1;
+        }
+    }
+    return 0;
+}
+
+template<typename OpType>
+static u64 cxx_to_boolean(Bytecode::Interpreter& interpreter, OpType const& instruction)
+{
+    return interpreter.get(instruction.condition()).to_boolean();
+}
+
+static u64 cxx_get_argument(Bytecode::Interpreter& interpreter, Bytecode::Op::GetArgument const& instruction)
+{
+    interpreter.set(instruction.dst(), interpreter.running_execution_context().arguments.data()[instruction.index()]);
+    return 0;
+}
+
+static u64 cxx_set_argument(Bytecode::Interpreter& interpreter, Bytecode::Op::SetArgument const& instruction)
+{
+    interpreter.running_execution_context().arguments.data()[instruction.index()] = interpreter.get(instruction.src());
+    return 0;
+}
+
+static ThrowCompletionOr<Value> loosely_equals(VM& vm, Value lhs, Value rhs)
+{
+    return Value(TRY(is_loosely_equal(vm, lhs, rhs)));
+}
+
+static ThrowCompletionOr<Value> loosely_inequals(VM& vm, Value lhs, Value rhs)
+{
+    return Value(!TRY(is_loosely_equal(vm, lhs, rhs)));
+}
+
+static ThrowCompletionOr<Value> strict_equals(VM&, Value lhs, Value rhs)
+{
+    return Value(is_strictly_equal(lhs, rhs));
+}
+
+static ThrowCompletionOr<Value> strict_inequals(VM&, Value lhs, Value rhs)
+{
+    return Value(!is_strictly_equal(lhs, rhs));
+}
+
+// Slow paths of the fused compare-and-jump instructions. These return 0 or 1 for the outcome of
+// the comparison, or 2 if it threw.
+#    define JS_DEFINE_JUMP_COMPARISON_SLOW_PATH(op_TitleCase, op_snake_case, numeric_operator)                                    \
+        static u64 cxx_jump_comparison(Bytecode::Interpreter& interpreter, Bytecode::Op::Jump##op_TitleCase const& instruction) \
+        {                                                                                                                      \
+            auto lhs = interpreter.get(instruction.lhs());                                                                     \
+            auto rhs = interpreter.get(instruction.rhs());                                                                     \
+            if (lhs.is_number() && rhs.is_number())                                                                            \
+                return lhs.as_double() numeric_operator rhs.as_double();                                                       \
+            auto result = op_snake_case(interpreter.vm(), lhs, rhs);                                                           \
+            if (result.is_error()) {                                                                                           \
+                interpreter.reg(Bytecode::Register::exception()) = result.error_value();                                       \
+                return 2;                                                                                                      \
+            }                                                                                                                  \
+            return result.value().to_boolean();                                                                                \
+        }
+
+JS_ENUMERATE_COMPARISON_OPS(JS_DEFINE_JUMP_COMPARISON_SLOW_PATH)
+#    undef JS_DEFINE_JUMP_COMPARISON_SLOW_PATH
+
+void Compiler::load_operand(Assembler::Reg dst, Bytecode::Operand operand)
+{
+    m_assembler.mov(
+        Assembler::Operand::Register(dst),
+        Assembler::Operand::Mem64BaseAndOffset(REGISTERS_AND_CONSTANTS_AND_LOCALS, operand.index() * sizeof(Value)));
+}
+
+void Compiler::store_operand(Bytecode::Operand operand, Assembler::Reg src)
+{
+    m_assembler.mov(
+        Assembler::Operand::Mem64BaseAndOffset(REGISTERS_AND_CONSTANTS_AND_LOCALS, operand.index() * sizeof(Value)),
+        Assembler::Operand::Register(src));
+}
+
+void Compiler::branch_if_not_int32(Assembler::Reg reg, Assembler::Label& label)
+{
+    VERIFY(reg != SCRATCH);
+    m_assembler.mov(Assembler::Operand::Register(SCRATCH), Assembler::Operand::Register(reg));
+    m_assembler.shift_right(Assembler::Operand::Register(SCRATCH), Assembler::Operand::Imm(TAG_SHIFT));
+    m_assembler.jump_if(
+        Assembler::Operand::Register(SCRATCH),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(INT32_TAG),
+        label);
+}
+
+void Compiler::branch_if_either_not_int32(Assembler::Reg lhs, Assembler::Reg rhs, Assembler::Label& label)
+{
+    branch_if_not_int32(lhs, label);
+    branch_if_not_int32(rhs, label);
+}
+
+void Compiler::box_int32(Assembler::Reg reg)
+{
+    // NOTE: 32-bit operations already cleared the upper half of the register, so we only have to add the tag.
+    m_assembler.mov(Assembler::Operand::Register(SCRATCH), Assembler::Operand::Imm(SHIFTED_INT32_TAG));
+    m_assembler.bitwise_or(Assembler::Operand::Register(reg), Assembler::Operand::Register(SCRATCH));
+}
+
+void Compiler::box_boolean(Assembler::Reg reg)
+{
+    VERIFY(reg != Assembler::Reg::RAX);
+    m_assembler.mov(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Imm(SHIFTED_BOOLEAN_TAG));
+    m_assembler.bitwise_or(Assembler::Operand::Register(reg), Assembler::Operand::Register(Assembler::Reg::RAX));
+}
+
+void Compiler::set_program_counter(size_t program_counter)
+{
+    m_assembler.mov(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Imm(program_counter));
+    m_assembler.mov(Assembler::Operand::Mem64BaseAndOffset(PROGRAM_COUNTER, 0), Assembler::Operand::Register(Assembler::Reg::RAX));
+}
+
+Assembler::Label& Compiler::label_for(Bytecode::Label label)
+{
+    return m_block_labels[m_block_index_for_offset.get(label.address()).value()];
+}
+
+void Compiler::call_into_interpreter(void* callee, Bytecode::Instruction const& instruction)
+{
+    set_program_counter(m_current_offset);
+    m_assembler.mov(Assembler::Operand::Register(Assembler::Reg::RDI), Assembler::Operand::Register(INTERPRETER));
+    m_assembler.mov(Assembler::Operand::Register(Assembler::Reg::RSI), Assembler::Operand::Imm(bit_cast<u64>(&instruction)));
+    m_assembler.native_call(bit_cast<u64>(callee));
+}
+
+void Compiler::jump_to_exception_exit_if_nonzero()
+{
+    m_assembler.jump_if(
+        Assembler::Operand::Register(Assembler::Reg::RAX),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(0),
+        m_exception_label);
+}
+
+void Compiler::exit_with_result(NativeExecutable::Result result)
+{
+    if (result == NativeExecutable::Result::ExitToInterpreter)
+        set_program_counter(m_current_offset);
+    m_assembler.mov(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Imm(to_underlying(result)));
+    m_assembler.jump(m_exit_label);
+}
+
+template<typename OpType>
+void Compiler::compile_generic(OpType const& instruction)
+{
+    if constexpr (requires(OpType const& op, Bytecode::Interpreter& interpreter) { op.execute_impl(interpreter); }) {
+        call_into_interpreter((void*)&cxx_execute<OpType>, instruction);
+        if constexpr (!IsSame<decltype(declval<OpType const&>().execute_impl(declval<Bytecode::Interpreter&>())), void>)
+            jump_to_exception_exit_if_nonzero();
+    } else {
+        // Instructions that manipulate the unwind state directly are left to the interpreter.
+        exit_with_result(NativeExecutable::Result::ExitToInterpreter);
+    }
+}
+
+void Compiler::compile_mov(Bytecode::Op::Mov const& op)
+{
+    load_operand(Assembler::Reg::RAX, op.src());
+    store_operand(op.dst(), Assembler::Reg::RAX);
+}
+
+void Compiler::compile_get_argument(Bytecode::Op::GetArgument const& op)
+{
+    call_into_interpreter((void*)&cxx_get_argument, op);
+}
+
+void Compiler::compile_set_argument(Bytecode::Op::SetArgument const& op)
+{
+    call_into_interpreter((void*)&cxx_set_argument, op);
+}
+
+void Compiler::compile_end(Bytecode::Op::End const& op)
+{
+    load_operand(Assembler::Reg::RAX, op.value());
+    store_operand(Bytecode::Operand(Bytecode::Register::accumulator()), Assembler::Reg::RAX);
+    exit_with_result(NativeExecutable::Result::Finished);
+}
+
+void Compiler::compile_jump(Bytecode::Op::Jump const& op)
+{
+    m_assembler.jump(label_for(op.target()));
+}
+
+void Compiler::branch_on_truthiness(Bytecode::Operand condition, Assembler::Label& if_true, Assembler::Label& if_false, void* to_boolean_slow_path, Bytecode::Instruction const& instruction)
+{
+    load_operand(Assembler::Reg::RAX, condition);
+    m_assembler.mov(Assembler::Operand::Register(SCRATCH), Assembler::Operand::Register(Assembler::Reg::RAX));
+    m_assembler.shift_right(Assembler::Operand::Register(SCRATCH), Assembler::Operand::Imm(TAG_SHIFT));
+
+    // Booleans are truthy if their lowest bit is set.
+    auto not_boolean = Assembler::Label {};
+    m_assembler.jump_if(
+        Assembler::Operand::Register(SCRATCH),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(BOOLEAN_TAG),
+        not_boolean);
+    m_assembler.test(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Imm(1));
+    m_assembler.jump_if(Assembler::Condition::NotEqualTo, if_true);
+    m_assembler.jump(if_false);
+
+    // Int32s are truthy if they are non-zero.
+    not_boolean.link(m_assembler);
+    auto slow_case = Assembler::Label {};
+    m_assembler.jump_if(
+        Assembler::Operand::Register(SCRATCH),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(INT32_TAG),
+        slow_case);
+    m_assembler.mov32(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Register(Assembler::Reg::RAX));
+    m_assembler.jump_if(
+        Assembler::Operand::Register(Assembler::Reg::RAX),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(0),
+        if_true);
+    m_assembler.jump(if_false);
+
+    slow_case.link(m_assembler);
+    call_into_interpreter(to_boolean_slow_path, instruction);
+    m_assembler.jump_if(
+        Assembler::Operand::Register(Assembler::Reg::RAX),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(0),
+        if_true);
+    m_assembler.jump(if_false);
+}
+
+void Compiler::compile_jump_if(Bytecode::Op::JumpIf const& op)
+{
+    branch_on_truthiness(op.condition(), label_for(op.true_target()), label_for(op.false_target()), (void*)&cxx_to_boolean<Bytecode::Op::JumpIf>, op);
+}
+
+void Compiler::compile_jump_true(Bytecode::Op::JumpTrue const& op)
+{
+    auto fall_through = Assembler::Label {};
+    branch_on_truthiness(op.condition(), label_for(op.target()), fall_through, (void*)&cxx_to_boolean<Bytecode::Op::JumpTrue>, op);
+    fall_through.link(m_assembler);
+}
+
+void Compiler::compile_jump_false(Bytecode::Op::JumpFalse const& op)
+{
+    auto fall_through = Assembler::Label {};
+    branch_on_truthiness(op.condition(), fall_through, label_for(op.target()), (void*)&cxx_to_boolean<Bytecode::Op::JumpFalse>, op);
+    fall_through.link(m_assembler);
+}
+
+void Compiler::compile_jump_nullish(Bytecode::Op::JumpNullish const& op)
+{
+    load_operand(Assembler::Reg::RAX, op.condition());
+    m_assembler.shift_right(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Imm(TAG_SHIFT));
+    m_assembler.bitwise_and(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Imm(IS_NULLISH_EXTRACT_PATTERN));
+    m_assembler.jump_if(
+        Assembler::Operand::Register(Assembler::Reg::RAX),
+        Assembler::Condition::EqualTo,
+        Assembler::Operand::Imm(IS_NULLISH_PATTERN),
+        label_for(op.true_target()));
+    m_assembler.jump(label_for(op.false_target()));
+}
+
+void Compiler::compile_jump_undefined(Bytecode::Op::JumpUndefined const& op)
+{
+    load_operand(Assembler::Reg::RAX, op.condition());
+    m_assembler.shift_right(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Imm(TAG_SHIFT));
+    m_assembler.jump_if(
+        Assembler::Operand::Register(Assembler::Reg::RAX),
+        Assembler::Condition::EqualTo,
+        Assembler::Operand::Imm(UNDEFINED_TAG),
+        label_for(op.true_target()));
+    m_assembler.jump(label_for(op.false_target()));
+}
+
+template<typename OpType>
+void Compiler::compile_jump_comparison(OpType const& op, Assembler::Condition condition)
+{
+    auto slow_case = Assembler::Label {};
+
+    load_operand(Assembler::Reg::RAX, op.lhs());
+    load_operand(Assembler::Reg::RDX, op.rhs());
+    branch_if_either_not_int32(Assembler::Reg::RAX, Assembler::Reg::RDX, slow_case);
+    m_assembler.sign_extend_32_to_64_bits(Assembler::Reg::RAX);
+    m_assembler.sign_extend_32_to_64_bits(Assembler::Reg::RDX);
+    m_assembler.jump_if(
+        Assembler::Operand::Register(Assembler::Reg::RAX),
+        condition,
+        Assembler::Operand::Register(Assembler::Reg::RDX),
+        label_for(op.true_target()));
+    m_assembler.jump(label_for(op.false_target()));
+
+    slow_case.link(m_assembler);
+    call_into_interpreter((void*)static_cast<u64 (*)(Bytecode::Interpreter&, OpType const&)>(&cxx_jump_comparison), op);
+    m_assembler.jump_if(
+        Assembler::Operand::Register(Assembler::Reg::RAX),
+        Assembler::Condition::EqualTo,
+        Assembler::Operand::Imm(2),
+        m_exception_label);
+    m_assembler.jump_if(
+        Assembler::Operand::Register(Assembler::Reg::RAX),
+        Assembler::Condition::NotEqualTo,
+        Assembler::Operand::Imm(0),
+        label_for(op.true_target()));
+    m_assembler.jump(label_for(op.false_target()));
+}
+
+template<typename OpType>
+void Compiler::compile_comparison(OpType const& op, Assembler::Condition condition)
+{
+    auto slow_case = Assembler::Label {};
+    auto done = Assembler::Label {};
+
+    load_operand(Assembler::Reg::RAX, op.lhs());
+    load_operand(Assembler::Reg::RDX, op.rhs());
+    branch_if_either_not_int32(Assembler::Reg::RAX, Assembler::Reg::RDX, slow_case);
+    m_assembler.sign_extend_32_to_64_bits(Assembler::Reg::RAX);
+    m_assembler.sign_extend_32_to_64_bits(Assembler::Reg::RDX);
+
+    // NOTE: This has to be cleared before the comparison, as clearing it clobbers the flags.
+    m_assembler.mov(Assembler::Operand::Register(SCRATCH), Assembler::Operand::Imm(0));
+    m_assembler.cmp(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Register(Assembler::Reg::RDX));
+    m_assembler.set_if(condition, Assembler::Operand::Register(SCRATCH));
+    box_boolean(SCRATCH);
+    store_operand(op.dst(), SCRATCH);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_add(Bytecode::Op::Add const& op)
+{
+    auto slow_case = Assembler::Label {};
+    auto done = Assembler::Label {};
+
+    load_operand(Assembler::Reg::RAX, op.lhs());
+    load_operand(Assembler::Reg::RDX, op.rhs());
+    branch_if_either_not_int32(Assembler::Reg::RAX, Assembler::Reg::RDX, slow_case);
+    m_assembler.add32(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Register(Assembler::Reg::RDX), slow_case);
+    box_int32(Assembler::Reg::RAX);
+    store_operand(op.dst(), Assembler::Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_sub(Bytecode::Op::Sub const& op)
+{
+    auto slow_case = Assembler::Label {};
+    auto done = Assembler::Label {};
+
+    load_operand(Assembler::Reg::RAX, op.lhs());
+    load_operand(Assembler::Reg::RDX, op.rhs());
+    branch_if_either_not_int32(Assembler::Reg::RAX, Assembler::Reg::RDX, slow_case);
+    m_assembler.sub32(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Register(Assembler::Reg::RDX), slow_case);
+    box_int32(Assembler::Reg::RAX);
+    store_operand(op.dst(), Assembler::Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_increment(Bytecode::Op::Increment const& op)
+{
+    auto slow_case = Assembler::Label {};
+    auto done = Assembler::Label {};
+
+    load_operand(Assembler::Reg::RAX, op.dst());
+    branch_if_not_int32(Assembler::Reg::RAX, slow_case);
+    m_assembler.inc32(Assembler::Operand::Register(Assembler::Reg::RAX), slow_case);
+    box_int32(Assembler::Reg::RAX);
+    store_operand(op.dst(), Assembler::Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_decrement(Bytecode::Op::Decrement const& op)
+{
+    auto slow_case = Assembler::Label {};
+    auto done = Assembler::Label {};
+
+    load_operand(Assembler::Reg::RAX, op.dst());
+    branch_if_not_int32(Assembler::Reg::RAX, slow_case);
+    m_assembler.dec32(Assembler::Operand::Register(Assembler::Reg::RAX), slow_case);
+    box_int32(Assembler::Reg::RAX);
+    store_operand(op.dst(), Assembler::Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_bitwise_and(Bytecode::Op::BitwiseAnd const& op)
+{
+    auto slow_case = Assembler::Label {};
+    auto done = Assembler::Label {};
+
+    // NOTE: Combining two int32s bit by bit leaves the shared tag intact, so we don't have to unbox them.
+    load_operand(Assembler::Reg::RAX, op.lhs());
+    load_operand(Assembler::Reg::RDX, op.rhs());
+    branch_if_either_not_int32(Assembler::Reg::RAX, Assembler::Reg::RDX, slow_case);
+    m_assembler.bitwise_and(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Register(Assembler::Reg::RDX));
+    store_operand(op.dst(), Assembler::Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_bitwise_or(Bytecode::Op::BitwiseOr const& op)
+{
+    auto slow_case = Assembler::Label {};
+    auto done = Assembler::Label {};
+
+    load_operand(Assembler::Reg::RAX, op.lhs());
+    load_operand(Assembler::Reg::RDX, op.rhs());
+    branch_if_either_not_int32(Assembler::Reg::RAX, Assembler::Reg::RDX, slow_case);
+    m_assembler.bitwise_or(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Register(Assembler::Reg::RDX));
+    store_operand(op.dst(), Assembler::Reg::RAX);
+    m_assembler.jump(done);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+
+    done.link(m_assembler);
+}
+
+void Compiler::compile_instruction(Bytecode::Instruction const& instruction)
+{
+    using Type = Bytecode::Instruction::Type;
+    using Condition = Assembler::Condition;
+
+    switch (instruction.type()) {
+    case Type::Mov:
+        compile_mov(static_cast<Bytecode::Op::Mov const&>(instruction));
+        return;
+    case Type::GetArgument:
+        compile_get_argument(static_cast<Bytecode::Op::GetArgument const&>(instruction));
+        return;
+    case Type::SetArgument:
+        compile_set_argument(static_cast<Bytecode::Op::SetArgument const&>(instruction));
+        return;
+    case Type::End:
+        compile_end(static_cast<Bytecode::Op::End const&>(instruction));
+        return;
+    case Type::Jump:
+        compile_jump(static_cast<Bytecode::Op::Jump const&>(instruction));
+        return;
+    case Type::JumpIf:
+        compile_jump_if(static_cast<Bytecode::Op::JumpIf const&>(instruction));
+        return;
+    case Type::JumpTrue:
+        compile_jump_true(static_cast<Bytecode::Op::JumpTrue const&>(instruction));
+        return;
+    case Type::JumpFalse:
+        compile_jump_false(static_cast<Bytecode::Op::JumpFalse const&>(instruction));
+        return;
+    case Type::JumpNullish:
+        compile_jump_nullish(static_cast<Bytecode::Op::JumpNullish const&>(instruction));
+        return;
+    case Type::JumpUndefined:
+        compile_jump_undefined(static_cast<Bytecode::Op::JumpUndefined const&>(instruction));
+        return;
+    case Type::JumpLessThan:
+        compile_jump_comparison(static_cast<Bytecode::Op::JumpLessThan const&>(instruction), Condition::SignedLessThan);
+        return;
+    case Type::JumpLessThanEquals:
+        compile_jump_comparison(static_cast<Bytecode::Op::JumpLessThanEquals const&>(instruction), Condition::SignedLessThanOrEqualTo);
+        return;
+    case Type::JumpGreaterThan:
+        compile_jump_comparison(static_cast<Bytecode::Op::JumpGreaterThan const&>(instruction), Condition::SignedGreaterThan);
+        return;
+    case Type::JumpGreaterThanEquals:
+        compile_jump_comparison(static_cast<Bytecode::Op::JumpGreaterThanEquals const&>(instruction), Condition::SignedGreaterThanOrEqualTo);
+        return;
+    case Type::JumpLooselyEquals:
+        compile_jump_comparison(static_cast<Bytecode::Op::JumpLooselyEquals const&>(instruction), Condition::EqualTo);
+        return;
+    case Type::JumpLooselyInequals:
+        compile_jump_comparison(static_cast<Bytecode::Op::JumpLooselyInequals const&>(instruction), Condition::NotEqualTo);
+        return;
+    case Type::JumpStrictlyEquals:
+        compile_jump_comparison(static_cast<Bytecode::Op::JumpStrictlyEquals const&>(instruction), Condition::EqualTo);
+        return;
+    case Type::JumpStrictlyInequals:
+        compile_jump_comparison(static_cast<Bytecode::Op::JumpStrictlyInequals const&>(instruction), Condition::NotEqualTo);
+        return;
+    case Type::LessThan:
+        compile_comparison(static_cast<Bytecode::Op::LessThan const&>(instruction), Condition::SignedLessThan);
+        return;
+    case Type::LessThanEquals:
+        compile_comparison(static_cast<Bytecode::Op::LessThanEquals const&>(instruction), Condition::SignedLessThanOrEqualTo);
+        return;
+    case Type::GreaterThan:
+        compile_comparison(static_cast<Bytecode::Op::GreaterThan const&>(instruction), Condition::SignedGreaterThan);
+        return;
+    case Type::GreaterThanEquals:
+        compile_comparison(static_cast<Bytecode::Op::GreaterThanEquals const&>(instruction), Condition::SignedGreaterThanOrEqualTo);
+        return;
+    case Type::LooselyEquals:
+        compile_comparison(static_cast<Bytecode::Op::LooselyEquals const&>(instruction), Condition::EqualTo);
+        return;
+    case Type::LooselyInequals:
+        compile_comparison(static_cast<Bytecode::Op::LooselyInequals const&>(instruction), Condition::NotEqualTo);
+        return;
+    case Type::StrictlyEquals:
+        compile_comparison(static_cast<Bytecode::Op::StrictlyEquals const&>(instruction), Condition::EqualTo);
+        return;
+    case Type::StrictlyInequals:
+        compile_comparison(static_cast<Bytecode::Op::StrictlyInequals const&>(instruction), Condition::NotEqualTo);
+        return;
+    case Type::Add:
+        compile_add(static_cast<Bytecode::Op::Add const&>(instruction));
+        return;
+    case Type::Sub:
+        compile_sub(static_cast<Bytecode::Op::Sub const&>(instruction));
+        return;
+    case Type::Increment:
+        compile_increment(static_cast<Bytecode::Op::Increment const&>(instruction));
+        return;
+    case Type::Decrement:
+        compile_decrement(static_cast<Bytecode::Op::Decrement const&>(instruction));
+        return;
+    case Type::BitwiseAnd:
+        compile_bitwise_and(static_cast<Bytecode::Op::BitwiseAnd const&>(instruction));
+        return;
+    case Type::BitwiseOr:
+        compile_bitwise_or(static_cast<Bytecode::Op::BitwiseOr const&>(instruction));
+        return;
+    case Type::Await:
+    case Type::Return:
+    case Type::Yield:
+        // These hand control back to our caller once the interpreter is done with them.
+        if (instruction.type() == Type::Await)
+            compile_generic(static_cast<Bytecode::Op::Await const&>(instruction));
+        else if (instruction.type() == Type::Return)
+            compile_generic(static_cast<Bytecode::Op::Return const&>(instruction));
+        else
+            compile_generic(static_cast<Bytecode::Op::Yield const&>(instruction));
+        exit_with_result(NativeExecutable::Result::Finished);
+        return;
+    case Type::EnterUnwindContext:
+    case Type::ContinuePendingUnwind:
+    case Type::ScheduleJump:
+        exit_with_result(NativeExecutable::Result::ExitToInterpreter);
+        return;
+    default:
+        break;
+    }
+
+    // FIXME: Property accesses (GetById, PutById, ...) end up here too, so they still go through the interpreter's
+    //        polymorphic inline caches instead of checking the shape inline in machine code.
+    switch (instruction.type()) {
+#    define COMPILE_GENERIC(OpTitleCase)                                                  \
+    case Type::OpTitleCase:                                                               \
+        compile_generic(static_cast<Bytecode::Op::OpTitleCase const&>(instruction));      \
+        return;
+        ENUMERATE_BYTECODE_OPS(COMPILE_GENERIC)
+#    undef COMPILE_GENERIC
+    }
+    VERIFY_NOT_REACHED();
+}
+
+OwnPtr<NativeExecutable> Compiler::compile_executable()
+{
+    for (auto offset : m_bytecode_executable.basic_block_start_offsets) {
+        m_block_index_for_offset.set(offset, m_block_labels.size());
+        m_block_labels.append({});
+    }
+
+    // Entry point: u64 (Interpreter&, Value* registers_and_constants_and_locals, size_t* program_counter, u8 const* native_entry_point)
+    m_assembler.enter();
+    m_assembler.mov(Assembler::Operand::Register(INTERPRETER), Assembler::Operand::Register(Assembler::Reg::RDI));
+    m_assembler.mov(Assembler::Operand::Register(REGISTERS_AND_CONSTANTS_AND_LOCALS), Assembler::Operand::Register(Assembler::Reg::RSI));
+    m_assembler.mov(Assembler::Operand::Register(PROGRAM_COUNTER), Assembler::Operand::Register(Assembler::Reg::RDX));
+    m_assembler.jump(Assembler::Operand::Register(Assembler::Reg::RCX));
+
+    HashMap<size_t, size_t> native_offsets_of_basic_blocks;
+
+    auto it = Bytecode::InstructionStreamIterator(m_bytecode_executable.bytecode, &m_bytecode_executable);
+    while (!it.at_end()) {
+        m_current_offset = it.offset();
+        if (auto block_index = m_block_index_for_offset.get(m_current_offset); block_index.has_value()) {
+            m_block_labels[*block_index].link(m_assembler);
+            native_offsets_of_basic_blocks.set(m_current_offset, m_output.size());
+        }
+        compile_instruction(*it);
+        ++it;
+    }
+
+    // Falling off the end of the bytecode is a bug, don't let it go unnoticed.
+    m_assembler.verify_not_reached();
+
+    m_exception_label.link(m_assembler);
+    m_assembler.mov(Assembler::Operand::Register(Assembler::Reg::RAX), Assembler::Operand::Imm(to_underlying(NativeExecutable::Result::Exception)));
+
+    m_exit_label.link(m_assembler);
+    m_assembler.exit();
+
+    dbgln_if(JS_JIT_DEBUG, "LibJS JIT: Compiled {} ({} bytes of bytecode) into {} bytes of native code", m_bytecode_executable.name, m_bytecode_executable.bytecode.size(), m_output.size());
+
+    return NativeExecutable::create(m_output, move(native_offsets_of_basic_blocks), m_bytecode_executable.name);
+}
+
+#endif
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& bytecode_executable)
+{
+#ifdef JIT_ARCH_SUPPORTED
+    Compiler compiler { bytecode_executable };
+    return compiler.compile_executable();
+#else
+    (void)bytecode_executable;
+    return nullptr;
+#endif
+}
+
+}
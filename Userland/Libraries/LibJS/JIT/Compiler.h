@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJIT/Assembler.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+// A baseline compiler that translates every basic block of a hot executable into native code.
+// Simple instructions get inline int32/boolean fast paths, everything else calls back into the
+// interpreter's implementation of the instruction. Native code works on the interpreter's own
+// registers and keeps its program counter up to date, so either side can take over at any
+// basic block boundary.
+class Compiler {
+public:
+    static bool is_enabled() { return s_enabled; }
+    static void set_enabled(bool);
+
+    // How many calls and backward jumps an executable goes through before we try to compile it.
+    static constexpr u32 hotness_threshold = 100;
+
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+private:
+    static bool s_enabled;
+
+#ifdef JIT_ARCH_SUPPORTED
+    using Assembler = ::JIT::Assembler;
+
+    explicit Compiler(Bytecode::Executable& bytecode_executable)
+        : m_bytecode_executable(bytecode_executable)
+    {
+    }
+
+    OwnPtr<NativeExecutable> compile_executable();
+    void compile_instruction(Bytecode::Instruction const&);
+
+    void compile_mov(Bytecode::Op::Mov const&);
+    void compile_get_argument(Bytecode::Op::GetArgument const&);
+    void compile_set_argument(Bytecode::Op::SetArgument const&);
+    void compile_end(Bytecode::Op::End const&);
+    void compile_jump(Bytecode::Op::Jump const&);
+    void compile_jump_if(Bytecode::Op::JumpIf const&);
+    void compile_jump_true(Bytecode::Op::JumpTrue const&);
+    void compile_jump_false(Bytecode::Op::JumpFalse const&);
+    void compile_jump_nullish(Bytecode::Op::JumpNullish const&);
+    void compile_jump_undefined(Bytecode::Op::JumpUndefined const&);
+    void compile_add(Bytecode::Op::Add const&);
+    void compile_sub(Bytecode::Op::Sub const&);
+    void compile_increment(Bytecode::Op::Increment const&);
+    void compile_decrement(Bytecode::Op::Decrement const&);
+    void compile_bitwise_and(Bytecode::Op::BitwiseAnd const&);
+    void compile_bitwise_or(Bytecode::Op::BitwiseOr const&);
+
+    template<typename OpType>
+    void compile_jump_comparison(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_comparison(OpType const&, Assembler::Condition);
+    template<typename OpType>
+    void compile_generic(OpType const&);
+
+    // Calls `callee(interpreter, instruction)` with the program counter pointing at the instruction.
+    void call_into_interpreter(void* callee, Bytecode::Instruction const&);
+    void jump_to_exception_exit_if_nonzero();
+    void exit_with_result(NativeExecutable::Result);
+
+    void branch_on_truthiness(Bytecode::Operand, Assembler::Label& if_true, Assembler::Label& if_false, void* to_boolean_slow_path, Bytecode::Instruction const&);
+
+    void load_operand(Assembler::Reg, Bytecode::Operand);
+    void store_operand(Bytecode::Operand, Assembler::Reg);
+    void branch_if_not_int32(Assembler::Reg, Assembler::Label&);
+    void branch_if_either_not_int32(Assembler::Reg, Assembler::Reg, Assembler::Label&);
+    void box_int32(Assembler::Reg);
+    void box_boolean(Assembler::Reg);
+    void set_program_counter(size_t);
+    Assembler::Label& label_for(Bytecode::Label);
+
+    Bytecode::Executable& m_bytecode_executable;
+    size_t m_current_offset { 0 };
+
+    Vector<u8> m_output;
+    Assembler m_assembler { m_output };
+    HashMap<size_t, size_t> m_block_index_for_offset;
+    Vector<Assembler::Label> m_block_labels;
+    Assembler::Label m_exit_label;
+    Assembler::Label m_exception_label;
+#endif
+};
+
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteString.h>
+#include <LibJIT/GDB.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+using EntryPoint = u64 (*)(Bytecode::Interpreter&, Value* registers_and_constants_and_locals, size_t* program_counter, u8 const* native_entry_point);
+
+OwnPtr<NativeExecutable> NativeExecutable::create(ReadonlyBytes code, HashMap<size_t, size_t> native_offsets_of_basic_blocks, StringView name)
+{
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        dbgln("LibJS JIT: Failed to allocate memory for native code: {}", strerror(errno));
+        return nullptr;
+    }
+
+    memcpy(memory, code.data(), code.size());
+
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("LibJS JIT: Failed to make native code executable: {}", strerror(errno));
+        munmap(memory, code.size());
+        return nullptr;
+    }
+
+    auto native_executable = adopt_own(*new NativeExecutable(static_cast<u8*>(memory), code.size(), move(native_offsets_of_basic_blocks)));
+
+    native_executable->m_gdb_object = ::JIT::GDB::build_gdb_image({ native_executable->m_code, native_executable->m_size }, "LibJS JIT"sv, name.is_empty() ? "(anonymous)"sv : name);
+    if (native_executable->m_gdb_object.has_value())
+        ::JIT::GDB::register_into_gdb(native_executable->m_gdb_object->span());
+
+    return native_executable;
+}
+
+NativeExecutable::NativeExecutable(u8* code, size_t size, HashMap<size_t, size_t> native_offsets_of_basic_blocks)
+    : m_code(code)
+    , m_size(size)
+    , m_native_offsets_of_basic_blocks(move(native_offsets_of_basic_blocks))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::unregister_from_gdb(m_gdb_object->span());
+    munmap(m_code, m_size);
+}
+
+NativeExecutable::Result NativeExecutable::run(Bytecode::Interpreter& interpreter, Span<Value> registers_and_constants_and_locals, size_t& program_counter) const
+{
+    auto native_offset = m_native_offsets_of_basic_blocks.get(program_counter);
+    if (!native_offset.has_value())
+        return Result::ExitToInterpreter;
+
+    auto entry_point = reinterpret_cast<EntryPoint>(m_code);
+    return static_cast<Result>(entry_point(interpreter, registers_and_constants_and_locals.data(), &program_counter, m_code + *native_offset));
+}
+
+}
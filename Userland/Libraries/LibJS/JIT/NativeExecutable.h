@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FixedArray.h>
+#include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Span.h>
+#include <LibJS/Forward.h>
+#include <LibJS/Runtime/Value.h>
+
+namespace JS::JIT {
+
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    enum class Result : u64 {
+        // The executable returned, yielded, awaited or reached its end.
+        Finished = 0,
+        // The interpreter should take over at the program counter, which native code doesn't handle.
+        ExitToInterpreter = 1,
+        // The instruction at the program counter threw the value in the exception register.
+        Exception = 2,
+    };
+
+    // Copies `code` into executable memory. `native_offsets_of_basic_blocks` maps the bytecode offset of every
+    // basic block to where its native code starts.
+    static OwnPtr<NativeExecutable> create(ReadonlyBytes code, HashMap<size_t, size_t> native_offsets_of_basic_blocks, StringView name);
+
+    ~NativeExecutable();
+
+    // Runs native code starting at the basic block at `program_counter`, which is kept up to date while running.
+    // If that isn't the start of a basic block, this returns ExitToInterpreter without doing anything.
+    Result run(Bytecode::Interpreter&, Span<Value> registers_and_constants_and_locals, size_t& program_counter) const;
+
+private:
+    NativeExecutable(u8* code, size_t size, HashMap<size_t, size_t> native_offsets_of_basic_blocks);
+
+    u8* m_code { nullptr };
+    size_t m_size { 0 };
+    HashMap<size_t, size_t> m_native_offsets_of_basic_blocks;
+    Optional<FixedArray<u8>> m_gdb_object;
+};
+
+}
@@ -21,6 +21,7 @@ namespace JS {
 
 class Array : public Object {
     JS_OBJECT(Array, Object);
+    JS_CELL_HAS_WRITE_BARRIERS(Array);
     JS_DECLARE_ALLOCATOR(Array);
 
 public:
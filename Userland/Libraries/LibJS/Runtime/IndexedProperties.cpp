@@ -236,6 +236,7 @@ void IndexedProperties::put(u32 index, Value value, PropertyAttributes attribute
     }
 
     m_storage->put(index, value, attributes);
+    m_owner->write_barrier();
 }
 
 void IndexedProperties::remove(u32 index)
@@ -148,12 +148,19 @@ private:
 
 class IndexedProperties {
 public:
-    IndexedProperties() = default;
+    // The owner's write barrier is fired whenever a value is stored, see Cell::write_barrier().
+    explicit IndexedProperties(Cell& owner)
+        : m_owner(&owner)
+    {
+    }
 
-    explicit IndexedProperties(Vector<Value> values)
+    IndexedProperties(Cell& owner, Vector<Value> values)
+        : m_owner(&owner)
     {
-        if (!values.is_empty())
+        if (!values.is_empty()) {
             m_storage = make<SimpleIndexedPropertyStorage>(move(values));
+            m_owner->write_barrier();
+        }
     }
 
     bool has_index(u32 index) const { return m_storage ? m_storage->has_index(index) : false; }
@@ -170,6 +177,7 @@ public:
     size_t array_like_size() const { return m_storage ? m_storage->array_like_size() : 0; }
     bool set_array_like_size(size_t);
 
+    // NOTE: Values must be stored through put(), so the owner's write barrier fires.
     IndexedPropertyStorage* storage() { return m_storage; }
     IndexedPropertyStorage const* storage() const { return m_storage; }
 
@@ -195,6 +203,7 @@ private:
     void switch_to_generic_storage();
     void ensure_storage();
 
+    Cell* m_owner { nullptr };
     OwnPtr<IndexedPropertyStorage> m_storage;
 };
 
@@ -552,6 +552,7 @@ ThrowCompletionOr<void> Object::private_field_add(PrivateName const& name, Value
 
     // 4. Append PrivateElement { [[Key]]: P, [[Kind]]: field, [[Value]]: value } to O.[[PrivateElements]].
     m_private_elements->empend(name, PrivateElement::Kind::Field, value);
+    write_barrier();
 
     // 5. Return unused.
     return {};
@@ -580,6 +581,7 @@ ThrowCompletionOr<void> Object::private_method_or_accessor_add(PrivateElement el
 
     // 5. Append method to O.[[PrivateElements]].
     m_private_elements->append(move(element));
+    write_barrier();
 
     // 6. Return unused.
     return {};
@@ -635,6 +637,7 @@ ThrowCompletionOr<void> Object::private_set(PrivateName const& name, Value value
     if (entry->kind == PrivateElement::Kind::Field) {
         // a. Set entry.[[Value]] to value.
         entry->value = value;
+        write_barrier();
         return {};
     }
     // 4. Else if entry.[[Kind]] is method, then
@@ -1176,8 +1179,10 @@ Optional<ValueAndAttributes> Object::storage_get(PropertyKey const& property_key
             return {};
 
         if (m_has_intrinsic_accessors) {
-            if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value())
+            if (auto accessor = find_intrinsic_accessor(this, property_key); accessor.has_value()) {
                 const_cast<Object&>(*this).m_storage[metadata->offset] = (*accessor)(shape().realm());
+                const_cast<Object&>(*this).write_barrier();
+            }
         }
 
         value = m_storage[metadata->offset];
@@ -1196,6 +1201,24 @@ bool Object::storage_has(PropertyKey const& property_key) const
     return shape().lookup(property_key.to_string_or_symbol()).has_value();
 }
 
+bool Object::can_add_properties_via_cached_transition() const
+{
+    return m_is_extensible
+        && !m_may_interfere_with_indexed_property_access
+        && !m_may_interfere_with_property_additions
+        && !m_has_magical_length_property
+        && !m_has_intrinsic_accessors;
+}
+
+void Object::add_property_via_cached_transition(Shape& new_shape, Value value)
+{
+    VERIFY(!m_shape->is_dictionary());
+    VERIFY(new_shape.property_count() == m_shape->property_count() + 1);
+    set_shape(new_shape);
+    m_storage.append(value);
+    write_barrier();
+}
+
 void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes const& value_and_attributes)
 {
     VERIFY(property_key.is_valid());
@@ -1226,6 +1249,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
         else
             set_shape(*m_shape->create_put_transition(property_key_string_or_symbol, attributes));
         m_storage.append(value);
+        write_barrier();
         return;
     }
 
@@ -1237,6 +1261,7 @@ void Object::storage_set(PropertyKey const& property_key, ValueAndAttributes con
     }
 
     m_storage[metadata->offset] = value;
+    write_barrier();
 }
 
 void Object::storage_delete(PropertyKey const& property_key)
@@ -1256,14 +1281,14 @@ void Object::storage_delete(PropertyKey const& property_key)
     VERIFY(metadata.has_value());
 
     if (m_shape->is_cacheable_dictionary()) {
-        m_shape = m_shape->create_uncacheable_dictionary_transition();
+        set_shape(*m_shape->create_uncacheable_dictionary_transition());
     }
     if (m_shape->is_uncacheable_dictionary()) {
         m_shape->remove_property_without_transition(property_key.to_string_or_symbol(), metadata->offset);
         m_storage.remove(metadata->offset);
         return;
     }
-    m_shape = m_shape->create_delete_transition(property_key.to_string_or_symbol());
+    set_shape(*m_shape->create_delete_transition(property_key.to_string_or_symbol()));
     m_storage.remove(metadata->offset);
 }
 
@@ -1271,7 +1296,7 @@ void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
         return;
-    m_shape = shape().create_prototype_transition(new_prototype);
+    set_shape(*shape().create_prototype_transition(new_prototype));
 }
 
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
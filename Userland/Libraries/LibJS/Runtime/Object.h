@@ -55,6 +55,7 @@ struct CacheablePropertyMetadata {
 
 class Object : public Cell {
     JS_CELL(Object, Cell);
+    JS_CELL_HAS_WRITE_BARRIERS(Object);
     JS_DECLARE_ALLOCATOR(Object);
 
 public:
@@ -156,6 +157,10 @@ public:
     //       might not hold when property access behaves differently.
     bool may_interfere_with_indexed_property_access() const { return m_may_interfere_with_indexed_property_access; }
 
+    // NOTE: Any subclass of Object that may add (or refuse to add) properties differently from OrdinarySet followed by
+    //       OrdinaryDefineOwnProperty must return true for this, to opt out of cached shape transitions for property additions.
+    bool may_interfere_with_property_additions() const { return m_may_interfere_with_property_additions; }
+
     ThrowCompletionOr<bool> ordinary_set_with_own_descriptor(PropertyKey const&, Value, Value, Optional<PropertyDescriptor>, CacheablePropertyMetadata* = nullptr);
 
     // 10.4.7 Immutable Prototype Exotic Objects, https://tc39.es/ecma262/#sec-immutable-prototype-exotic-objects
@@ -209,11 +214,20 @@ public:
     virtual void visit_edges(Cell::Visitor&) override;
 
     Value get_direct(size_t index) const { return m_storage[index]; }
-    void put_direct(size_t index, Value value) { m_storage[index] = value; }
+    void put_direct(size_t index, Value value)
+    {
+        m_storage[index] = value;
+        write_barrier();
+    }
+
+    // Returns true if adding a new property to this object is guaranteed to take the same shape transition
+    // as it did for any other object of the same shape, provided its prototype chain doesn't interfere.
+    bool can_add_properties_via_cached_transition() const;
+    void add_property_via_cached_transition(Shape& new_shape, Value);
 
     IndexedProperties const& indexed_properties() const { return m_indexed_properties; }
     IndexedProperties& indexed_properties() { return m_indexed_properties; }
-    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(move(values)); }
+    void set_indexed_property_elements(Vector<Value>&& values) { m_indexed_properties = IndexedProperties(*this, move(values)); }
 
     Shape& shape() { return *m_shape; }
     Shape const& shape() const { return *m_shape; }
@@ -253,8 +267,14 @@ protected:
 
     bool m_is_typed_array { false };
 
+    bool m_may_interfere_with_property_additions { false };
+
 private:
-    void set_shape(Shape& shape) { m_shape = &shape; }
+    void set_shape(Shape& shape)
+    {
+        m_shape = &shape;
+        write_barrier();
+    }
 
     Object* prototype() { return shape().prototype(); }
 
@@ -265,7 +285,7 @@ private:
 
     GCPtr<Shape> m_shape;
     Vector<Value> m_storage;
-    IndexedProperties m_indexed_properties;
+    IndexedProperties m_indexed_properties { *this };
     OwnPtr<Vector<PrivateElement>> m_private_elements; // [[PrivateElements]]
 };
 
@@ -22,6 +22,7 @@ namespace JS {
 
 class PrimitiveString final : public Cell {
     JS_CELL(PrimitiveString, Cell);
+    JS_CELL_HAS_WRITE_BARRIERS(PrimitiveString);
     JS_DECLARE_ALLOCATOR(PrimitiveString);
 
 public:
@@ -0,0 +1,28 @@
+test("cells stored into already marked cells survive incremental marking", () => {
+    // Promote enough cells for allocation to start marking the whole heap incrementally, while we keep
+    // storing new cells into old ones, which marking may or may not have visited already.
+    const old = [];
+    for (let i = 0; i < 50_000; ++i) old.push({ i, young: null });
+    gc();
+
+    let captured = null;
+    const capture = value => {
+        captured = value;
+    };
+
+    for (let round = 0; round < 10; ++round) {
+        for (let i = 0; i < old.length; ++i) {
+            const young = { round, values: [round, i] };
+            old[i].young = young;
+            old[(i * 7919) % old.length][`round${round}`] = young.values;
+            if (i % 1000 === 0) capture(young);
+        }
+    }
+
+    for (let i = 0; i < old.length; ++i) {
+        expect(old[i].young.round).toBe(9);
+        expect(old[i].young.values).toEqual([9, i]);
+        expect(old[(i * 7919) % old.length].round9).toEqual([9, i]);
+    }
+    expect(captured.values).toEqual([9, 49_000]);
+});
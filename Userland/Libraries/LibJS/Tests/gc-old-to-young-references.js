@@ -0,0 +1,52 @@
+test("young cells only referenced by old cells survive minor collections", () => {
+    const old = { values: [], map: new Map() };
+    gc();
+
+    for (let i = 0; i < 100_000; ++i) {
+        const young = { i };
+        if (i % 100 === 0) {
+            old.values.push(young);
+            old.map.set(i, [young]);
+            old[`property${i}`] = young;
+        }
+    }
+
+    expect(old.values).toHaveLength(1000);
+    for (let i = 0; i < 1000; ++i) {
+        expect(old.values[i].i).toBe(i * 100);
+        expect(old.map.get(i * 100)[0]).toBe(old.values[i]);
+        expect(old[`property${i * 100}`]).toBe(old.values[i]);
+    }
+});
+
+test("young cells only referenced by old environments and private fields survive minor collections", () => {
+    let captured = null;
+    const setCaptured = value => {
+        captured = value;
+    };
+    class Holder {
+        #value = null;
+        set(value) {
+            this.#value = value;
+        }
+        get() {
+            return this.#value;
+        }
+    }
+    const holder = new Holder();
+    const prototypeHolder = Object.create(null);
+    gc();
+
+    for (let i = 0; i < 100_000; ++i) {
+        const young = { i };
+        if (i === 50_000) {
+            setCaptured(young);
+            holder.set([young]);
+            Object.setPrototypeOf(prototypeHolder, { young });
+        }
+    }
+
+    expect(captured.i).toBe(50_000);
+    expect(holder.get()[0]).toBe(captured);
+    expect(Object.getPrototypeOf(prototypeHolder).young).toBe(captured);
+});
@@ -16,3 +16,124 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic get sites return the right property for every shape", () => {
+    function ic(o) {
+        return o.x;
+    }
+
+    const objects = [
+        { x: 1 },
+        { a: 0, x: 2 },
+        { a: 0, b: 0, x: 3 },
+        { a: 0, b: 0, c: 0, x: 4 },
+        { a: 0, b: 0, c: 0, d: 0, x: 5 },
+        Object.create({ x: 6 }),
+    ];
+
+    for (let i = 0; i < 10; ++i) {
+        for (let j = 0; j < objects.length; ++j) expect(ic(objects[j])).toBe(j + 1);
+    }
+});
+
+test("Cached property additions take the same transition as uncached ones", () => {
+    function add(o, value) {
+        o.y = value;
+        return o;
+    }
+
+    for (let i = 0; i < 10; ++i) {
+        const o = add({ x: i }, i * 2);
+        expect(o.y).toBe(i * 2);
+        expect(Object.keys(o)).toEqual(["x", "y"]);
+        const descriptor = Object.getOwnPropertyDescriptor(o, "y");
+        expect(descriptor.writable).toBeTrue();
+        expect(descriptor.enumerable).toBeTrue();
+        expect(descriptor.configurable).toBeTrue();
+    }
+});
+
+test("Cached property additions respect non-extensible and frozen objects", () => {
+    function add(o) {
+        o.y = 1;
+        return o;
+    }
+
+    add({ x: 0 });
+    add({ x: 0 });
+
+    const nonExtensible = Object.preventExtensions({ x: 0 });
+    expect(add(nonExtensible).y).toBeUndefined();
+
+    const frozen = Object.freeze({ x: 0 });
+    expect(add(frozen).y).toBeUndefined();
+
+    expect(() => {
+        "use strict";
+        const o = Object.preventExtensions({ x: 0 });
+        o.y = 1;
+    }).toThrow(TypeError);
+});
+
+test("Cached property additions respect setters and read-only properties added to the prototype chain", () => {
+    const prototype = {};
+    function add(o) {
+        o.y = 1;
+        return o;
+    }
+
+    add(Object.create(prototype));
+    add(Object.create(prototype));
+
+    let setterValue;
+    Object.defineProperty(prototype, "y", {
+        set(value) {
+            setterValue = value;
+        },
+        configurable: true,
+    });
+    const withSetter = add(Object.create(prototype));
+    expect(setterValue).toBe(1);
+    expect(Object.hasOwn(withSetter, "y")).toBeFalse();
+
+    delete prototype.y;
+    add(Object.create(prototype));
+
+    Object.defineProperty(prototype, "y", {
+        value: 42,
+        writable: false,
+        configurable: true,
+    });
+    const withReadOnly = add(Object.create(prototype));
+    expect(withReadOnly.y).toBe(42);
+    expect(Object.hasOwn(withReadOnly, "y")).toBeFalse();
+});
+
+test("Cached property additions respect exotic prototypes", () => {
+    function add(o) {
+        o.length = 5;
+        return o;
+    }
+
+    add({});
+    add({});
+
+    // String.prototype has a non-writable "length" property, while Array.prototype's is writable.
+    const inheritsFromString = add(Object.create(String.prototype));
+    expect(Object.hasOwn(inheritsFromString, "length")).toBeFalse();
+
+    const inheritsFromArray = add(Object.create(Array.prototype));
+    expect(Object.hasOwn(inheritsFromArray, "length")).toBeTrue();
+    expect(inheritsFromArray.length).toBe(5);
+
+    const proxy = new Proxy(
+        {},
+        {
+            set() {
+                return true;
+            },
+        }
+    );
+    const inheritsFromProxy = add(Object.create(proxy));
+    expect(Object.hasOwn(inheritsFromProxy, "length")).toBeFalse();
+});
@@ -0,0 +1,491 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CharacterTypes.h>
+#include <AK/HashTable.h>
+#include <AK/StringHash.h>
+#include <AK/Utf16View.h>
+#include <AK/Utf32View.h>
+#include <LibRegex/RegexDFA.h>
+
+namespace regex {
+
+static constexpr u64 make_thread(size_t instruction_position, size_t string_index)
+{
+    return (static_cast<u64>(string_index) << 32) | instruction_position;
+}
+
+static constexpr size_t instruction_position_of(u64 thread)
+{
+    return thread & 0xffffffff;
+}
+
+static constexpr size_t string_index_of(u64 thread)
+{
+    return thread >> 32;
+}
+
+static bool is_word_character(u32 code_point)
+{
+    return is_ascii_alphanumeric(code_point) || code_point == '_';
+}
+
+unsigned LazyDFA::StateKeyTraits::hash(Vector<u64> const& key)
+{
+    return string_hash(reinterpret_cast<char const*>(key.data()), key.size() * sizeof(u64));
+}
+
+OwnPtr<LazyDFA> LazyDFA::try_create(ByteCode const& bytecode, AllOptions options)
+{
+    // In unicode mode positions are counted in code points, which the DFA doesn't keep track of.
+    if (options.has_flag_set(AllFlags::Unicode))
+        return nullptr;
+
+    // The DFA only keeps instruction positions in its threads.
+    if (bytecode.size() > NumericLimits<u32>::max())
+        return nullptr;
+
+    bool has_line_assertions = false;
+    bool has_word_boundaries = false;
+
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare:
+            for (auto& compare : static_cast<OpCode_Compare const&>(opcode).flat_compares()) {
+                if (compare.type == CharacterCompareType::Reference)
+                    return nullptr;
+            }
+            break;
+        case OpCodeId::CheckBegin:
+        case OpCodeId::CheckEnd:
+            has_line_assertions = true;
+            break;
+        case OpCodeId::CheckBoundary:
+            has_word_boundaries = true;
+            break;
+        case OpCodeId::Jump:
+        case OpCodeId::JumpNonEmpty:
+        case OpCodeId::ForkJump:
+        case OpCodeId::ForkStay:
+        case OpCodeId::ForkReplaceJump:
+        case OpCodeId::ForkReplaceStay:
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+        case OpCodeId::Exit:
+            break;
+        case OpCodeId::FailForks:
+        case OpCodeId::Save:
+        case OpCodeId::Restore:
+        case OpCodeId::GoBack:
+        case OpCodeId::Repeat:
+        case OpCodeId::ResetRepeat:
+            // Lookaround and counted repetition need the VM.
+            return nullptr;
+        }
+        state.instruction_position += opcode.size();
+    }
+
+    // Line assertions in multiline mode look at the neighbouring characters, which aren't part of a state.
+    if (has_line_assertions && options.has_flag_set(AllFlags::Multiline) && options.has_flag_set(AllFlags::Internal_ConsiderNewline))
+        return nullptr;
+
+    return adopt_own(*new LazyDFA(bytecode, options, has_word_boundaries));
+}
+
+LazyDFA::LazyDFA(ByteCode const& bytecode, AllOptions options, bool tracks_word_boundaries)
+    : m_bytecode(bytecode)
+    , m_options(options)
+    , m_tracks_word_boundaries(tracks_word_boundaries)
+{
+    reset_cache();
+}
+
+void LazyDFA::reset_cache()
+{
+    m_states.clear();
+    m_state_indices.clear();
+    m_start_states.fill({});
+    ++m_cache_generation;
+
+    auto dead = make<State>();
+    dead->matches_at_end = false;
+    dead->transitions.fill(dead_state << 1);
+    m_states.append(move(dead));
+}
+
+u32 LazyDFA::intern_state(Vector<Thread>&& threads, bool at_begin, bool after_word_character, bool unanchored)
+{
+    if (threads.is_empty())
+        return dead_state;
+
+    Vector<u64> key;
+    key.ensure_capacity(threads.size() + 1);
+    key.unchecked_append((at_begin ? 1 : 0) | (after_word_character ? 2 : 0) | (unanchored ? 4 : 0));
+    key.extend(threads);
+
+    if (auto index = m_state_indices.get(key); index.has_value())
+        return *index;
+
+    // Start over instead of growing without bounds, worst case this degrades to simulating the NFA.
+    if (m_states.size() >= max_cached_states)
+        reset_cache();
+
+    auto state = make<State>();
+    state->threads = move(threads);
+    state->at_begin = at_begin;
+    state->after_word_character = after_word_character;
+    state->unanchored = unanchored;
+    state->transitions.fill(unknown_transition);
+
+    u32 index = m_states.size();
+    m_states.append(move(state));
+    m_state_indices.set(move(key), index);
+    return index;
+}
+
+u32 LazyDFA::start_state(bool unanchored, bool at_begin, bool after_word_character)
+{
+    auto slot = (unanchored ? 4 : 0) | (at_begin ? 2 : 0) | (after_word_character ? 1 : 0);
+    if (auto index = m_start_states[slot]; index.has_value())
+        return *index;
+
+    Vector<Thread> threads;
+    threads.append(make_thread(0, 0));
+    auto index = intern_state(move(threads), at_begin, after_word_character, unanchored);
+    m_start_states[slot] = index;
+    return index;
+}
+
+Optional<size_t> LazyDFA::single_string_length(size_t instruction_position) const
+{
+    // Strings only ever appear as the sole argument of a compare, see ByteCode::insert_bytecode_compare_string().
+    if (m_bytecode.at(instruction_position + 1) != 1 || m_bytecode.at(instruction_position + 3) != to_underlying(CharacterCompareType::String))
+        return {};
+    return m_bytecode.at(instruction_position + 4);
+}
+
+bool LazyDFA::compare_accepts(size_t instruction_position, size_t string_index, u32 character) const
+{
+    if (auto length = single_string_length(instruction_position); length.has_value()) {
+        u32 expected = m_bytecode.at(instruction_position + 5 + string_index);
+        if (m_options.has_flag_set(AllFlags::Insensitive))
+            return to_ascii_lowercase(expected) == to_ascii_lowercase(character);
+        return expected == character;
+    }
+
+    // Let the VM decide on a one-character input, the compare has to consume exactly that character.
+    MatchInput input;
+    input.view = Utf32View { &character, 1 };
+    input.regex_options = m_options;
+    MatchState state;
+    state.instruction_position = instruction_position;
+    auto& opcode = m_bytecode.get_opcode(state);
+    return opcode.execute(input, state) == ExecutionResult::Continue && state.string_position == 1;
+}
+
+bool LazyDFA::assertion_holds(size_t instruction_position, Context const& context) const
+{
+    MatchState state;
+    state.instruction_position = instruction_position;
+    auto& opcode = m_bytecode.get_opcode(state);
+
+    if (opcode.opcode_id() == OpCodeId::CheckBoundary) {
+        auto before_next_word_character = context.next_character.has_value() && is_word_character(*context.next_character);
+        auto at_boundary = context.after_word_character != before_next_word_character;
+        if (static_cast<OpCode_CheckBoundary const&>(opcode).type() == BoundaryCheckType::Word)
+            return at_boundary;
+        return !at_boundary;
+    }
+
+    // Outside of multiline mode, line assertions only care whether they're at the edge of the input.
+    u32 placeholder = ' ';
+    MatchInput input;
+    input.view = Utf32View { &placeholder, 1 };
+    input.regex_options = m_options;
+    if (opcode.opcode_id() == OpCodeId::CheckBegin)
+        state.string_position = context.at_begin ? 0 : 1;
+    else
+        state.string_position = context.next_character.has_value() ? 0 : 1;
+    state.string_position_in_code_units = state.string_position;
+    return opcode.execute(input, state) == ExecutionResult::Continue;
+}
+
+bool LazyDFA::compute_closure(State const& state, Context const& context, Vector<Thread>& consumers) const
+{
+    struct PendingThread {
+        size_t instruction_position { 0 };
+        Vector<u64, 2> checkpoints_at_this_position;
+    };
+
+    // Threads that reach an instruction already reached by a higher priority thread can't find anything new,
+    // unless they differ in which loop checkpoints were passed without consuming anything since.
+    HashMap<size_t, Vector<Vector<u64, 2>>> visited;
+    HashTable<Thread> seen_consumers;
+    Vector<PendingThread> stack;
+    MatchState vm_state;
+
+    auto add_consumer = [&](Thread thread) {
+        if (seen_consumers.set(thread) == HashSetResult::InsertedNewEntry)
+            consumers.append(thread);
+    };
+
+    for (auto thread : state.threads) {
+        if (string_index_of(thread) != 0) {
+            add_consumer(thread);
+            continue;
+        }
+
+        stack.append({ instruction_position_of(thread), {} });
+        while (!stack.is_empty()) {
+            auto pending = stack.take_last();
+            auto instruction_position = pending.instruction_position;
+
+            // Running off the end of the bytecode is a match, all threads not explored yet have a lower priority.
+            if (instruction_position >= m_bytecode.size())
+                return true;
+
+            auto& seen_checkpoints = visited.ensure(instruction_position);
+            if (seen_checkpoints.contains_slow(pending.checkpoints_at_this_position))
+                continue;
+            seen_checkpoints.append(pending.checkpoints_at_this_position);
+
+            vm_state.instruction_position = instruction_position;
+            auto& opcode = m_bytecode.get_opcode(vm_state);
+            auto next = instruction_position + opcode.size();
+
+            // Alternatives are pushed lowest priority first.
+            auto push = [&](size_t target) {
+                stack.append({ target, pending.checkpoints_at_this_position });
+            };
+            auto push_fork = [&](size_t preferred, size_t other) {
+                push(other);
+                push(preferred);
+            };
+
+            switch (opcode.opcode_id()) {
+            case OpCodeId::Compare:
+                if (single_string_length(instruction_position).value_or(1) == 0)
+                    push(next);
+                else
+                    add_consumer(make_thread(instruction_position, 0));
+                break;
+            case OpCodeId::Jump:
+                push(next + static_cast<OpCode_Jump const&>(opcode).offset());
+                break;
+            case OpCodeId::ForkJump:
+            case OpCodeId::ForkReplaceJump:
+                push_fork(next + static_cast<OpCode_ForkJump const&>(opcode).offset(), next);
+                break;
+            case OpCodeId::ForkStay:
+            case OpCodeId::ForkReplaceStay:
+                push_fork(next, next + static_cast<OpCode_ForkStay const&>(opcode).offset());
+                break;
+            case OpCodeId::Checkpoint: {
+                auto id = static_cast<OpCode_Checkpoint const&>(opcode).id();
+                if (!pending.checkpoints_at_this_position.contains_slow(id))
+                    pending.checkpoints_at_this_position.append(id);
+                push(next);
+                break;
+            }
+            case OpCodeId::JumpNonEmpty: {
+                auto& jump = static_cast<OpCode_JumpNonEmpty const&>(opcode);
+                // Every path to this instruction passes the checkpoint, so it's empty exactly if it was passed at this position.
+                if (pending.checkpoints_at_this_position.contains_slow(jump.checkpoint())) {
+                    push(next);
+                    break;
+                }
+                auto target = next + jump.offset();
+                switch (jump.form()) {
+                case OpCodeId::Jump:
+                    push(target);
+                    break;
+                case OpCodeId::ForkJump:
+                case OpCodeId::ForkReplaceJump:
+                    push_fork(target, next);
+                    break;
+                case OpCodeId::ForkStay:
+                case OpCodeId::ForkReplaceStay:
+                    push_fork(next, target);
+                    break;
+                default:
+                    push(next);
+                    break;
+                }
+                break;
+            }
+            case OpCodeId::SaveLeftCaptureGroup:
+            case OpCodeId::SaveRightCaptureGroup:
+            case OpCodeId::SaveRightNamedCaptureGroup:
+            case OpCodeId::ClearCaptureGroup:
+                push(next);
+                break;
+            case OpCodeId::CheckBegin:
+            case OpCodeId::CheckEnd:
+            case OpCodeId::CheckBoundary:
+                if (assertion_holds(instruction_position, context))
+                    push(next);
+                break;
+            case OpCodeId::Exit:
+                // An explicit exit before the end of the bytecode always fails.
+                break;
+            default:
+                VERIFY_NOT_REACHED();
+            }
+        }
+    }
+
+    return false;
+}
+
+u32 LazyDFA::transition(u32 state_index, u32 character)
+{
+    auto& state = *m_states[state_index];
+    auto cached = character < state.transitions.size() ? state.transitions[character] : state.wide_transitions.get(character).value_or(unknown_transition);
+    if (cached != unknown_transition)
+        return cached;
+
+    Vector<Thread> consumers;
+    auto matched = compute_closure(state, { state.at_begin, state.after_word_character, character }, consumers);
+
+    Vector<Thread> next_threads;
+    HashTable<Thread> seen;
+    MatchState vm_state;
+    for (auto thread : consumers) {
+        auto instruction_position = instruction_position_of(thread);
+        auto string_index = string_index_of(thread);
+        if (!compare_accepts(instruction_position, string_index, character))
+            continue;
+
+        Thread next_thread;
+        auto string_length = single_string_length(instruction_position);
+        if (string_length.has_value() && string_index + 1 < *string_length) {
+            next_thread = make_thread(instruction_position, string_index + 1);
+        } else {
+            vm_state.instruction_position = instruction_position;
+            next_thread = make_thread(instruction_position + m_bytecode.get_opcode(vm_state).size(), 0);
+        }
+        if (seen.set(next_thread) == HashSetResult::InsertedNewEntry)
+            next_threads.append(next_thread);
+    }
+
+    // Unanchored searches start a new attempt at every position, with the lowest priority.
+    if (state.unanchored && !seen.contains(make_thread(0, 0)))
+        next_threads.append(make_thread(0, 0));
+
+    auto generation = m_cache_generation;
+    auto next_index = intern_state(move(next_threads), false, m_tracks_word_boundaries && is_word_character(character), state.unanchored);
+    u32 encoded = (next_index << 1) | (matched ? 1 : 0);
+
+    // Interning may have thrown away the cache, including the state we're coming from.
+    if (generation == m_cache_generation) {
+        if (character < state.transitions.size())
+            state.transitions[character] = encoded;
+        else
+            state.wide_transitions.set(character, encoded);
+    }
+    return encoded;
+}
+
+bool LazyDFA::matches_at_end(u32 state_index)
+{
+    auto& state = *m_states[state_index];
+    if (!state.matches_at_end.has_value()) {
+        Vector<Thread> consumers;
+        state.matches_at_end = compute_closure(state, { state.at_begin, state.after_word_character, {} }, consumers);
+    }
+    return *state.matches_at_end;
+}
+
+template<typename CharacterAt>
+LazyDFA::Result LazyDFA::run(size_t length, size_t start, bool unanchored, size_t& match_end, CharacterAt character_at)
+{
+    bool after_word_character = false;
+    if (m_tracks_word_boundaries && start > 0) {
+        auto previous = character_at(start - 1);
+        after_word_character = previous.has_value() && is_word_character(*previous);
+    }
+
+    auto state = start_state(unanchored, start == 0, after_word_character);
+    Optional<size_t> last_match_end;
+    for (size_t position = start;; ++position) {
+        if (position == length) {
+            if (matches_at_end(state))
+                last_match_end = position;
+            break;
+        }
+
+        auto character = character_at(position);
+        if (!character.has_value())
+            return Result::Unsupported;
+
+        auto next = transition(state, *character);
+        if (next & 1) {
+            // Higher priority threads may still find a longer match, but any match is enough for an unanchored search.
+            last_match_end = position;
+            if (unanchored)
+                break;
+        }
+
+        state = next >> 1;
+        if (state == dead_state)
+            break;
+    }
+
+    if (!last_match_end.has_value())
+        return Result::NoMatch;
+
+    match_end = *last_match_end;
+    return Result::Match;
+}
+
+template<typename Callback>
+static LazyDFA::Result visit_code_units(RegexStringView const& view, Callback callback)
+{
+    if (view.is_string_view()) {
+        auto bytes = view.string_view().bytes();
+        return callback(bytes.size(), [&](size_t index) -> Optional<u32> { return bytes[index]; });
+    }
+
+    if (view.is_u16_view()) {
+        auto const& utf16 = view.u16_view();
+        auto length = utf16.length_in_code_units();
+        return callback(length, [&](size_t index) -> Optional<u32> {
+            u16 code_unit = utf16.code_unit_at(index);
+            // Some compares look at the whole surrogate pair instead, leave those to the VM.
+            if (Utf16View::is_high_surrogate(code_unit) && index + 1 < length && Utf16View::is_low_surrogate(utf16.code_unit_at(index + 1)))
+                return {};
+            return code_unit;
+        });
+    }
+
+    if (view.is_u32_view()) {
+        auto const& utf32 = view.u32_view();
+        return callback(utf32.length(), [&](size_t index) -> Optional<u32> { return utf32[index]; });
+    }
+
+    return LazyDFA::Result::Unsupported;
+}
+
+LazyDFA::Result LazyDFA::match_at(RegexStringView const& view, size_t start, size_t& match_end)
+{
+    return visit_code_units(view, [&](size_t length, auto character_at) {
+        return run(length, start, false, match_end, character_at);
+    });
+}
+
+LazyDFA::Result LazyDFA::find_earliest_match_end(RegexStringView const& view, size_t start, size_t& match_end)
+{
+    return visit_code_units(view, [&](size_t length, auto character_at) {
+        return run(length, start, true, match_end, character_at);
+    });
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "RegexByteCode.h"
+#include "RegexMatch.h"
+#include "RegexOptions.h"
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+
+namespace regex {
+
+// A DFA that is built lazily from the bytecode of patterns without backreferences or lookaround.
+// Each state is the ordered list of VM threads a backtracking search would still explore, so the
+// match end it reports is the one Matcher::execute() would find; capture groups are left to the VM.
+class LazyDFA {
+    AK_MAKE_NONCOPYABLE(LazyDFA);
+    AK_MAKE_NONMOVABLE(LazyDFA);
+
+public:
+    enum class Result {
+        NoMatch,
+        Match,
+        Unsupported, // The input can't be handled by the DFA, use the VM instead.
+    };
+
+    // Returns null if the pattern needs something only the VM can do.
+    static OwnPtr<LazyDFA> try_create(ByteCode const&, AllOptions);
+
+    AllOptions options() const { return m_options; }
+
+    // Finds the end of the match that the VM would find starting exactly at `start`.
+    Result match_at(RegexStringView const&, size_t start, size_t& match_end);
+
+    // Finds the smallest position at which some match starting at or after `start` ends, so match_at()
+    // succeeds somewhere between `start` and that position. NoMatch means nothing matches from `start` on.
+    Result find_earliest_match_end(RegexStringView const&, size_t start, size_t& match_end);
+
+private:
+    LazyDFA(ByteCode const&, AllOptions, bool tracks_word_boundaries);
+
+    static constexpr size_t max_cached_states = 2048;
+    static constexpr u32 unknown_transition = NumericLimits<u32>::max();
+    static constexpr u32 dead_state = 0;
+
+    // A thread is an instruction position, plus the index into the string of a String compare it's in the middle of.
+    using Thread = u64;
+
+    struct State {
+        Vector<Thread> threads;
+        bool at_begin { false };
+        bool after_word_character { false };
+        bool unanchored { false };
+        Optional<bool> matches_at_end;
+
+        // Transitions are encoded as (next state << 1) | (whether a match ended before the character).
+        Array<u32, 256> transitions;
+        HashMap<u32, u32> wide_transitions;
+    };
+
+    struct StateKeyTraits : public DefaultTraits<Vector<u64>> {
+        static unsigned hash(Vector<u64> const&);
+    };
+
+    struct Context {
+        bool at_begin { false };
+        bool after_word_character { false };
+        Optional<u32> next_character;
+    };
+
+    template<typename CharacterAt>
+    Result run(size_t length, size_t start, bool unanchored, size_t& match_end, CharacterAt);
+
+    u32 start_state(bool unanchored, bool at_begin, bool after_word_character);
+    u32 transition(u32 state_index, u32 character);
+    bool matches_at_end(u32 state_index);
+
+    bool compute_closure(State const&, Context const&, Vector<Thread>& consumers) const;
+    bool assertion_holds(size_t instruction_position, Context const&) const;
+    bool compare_accepts(size_t instruction_position, size_t string_index, u32 character) const;
+    Optional<size_t> single_string_length(size_t instruction_position) const;
+
+    u32 intern_state(Vector<Thread>&& threads, bool at_begin, bool after_word_character, bool unanchored);
+    void reset_cache();
+
+    ByteCode const& m_bytecode;
+    AllOptions m_options;
+    bool m_tracks_word_boundaries { false };
+
+    Vector<NonnullOwnPtr<State>> m_states;
+    HashMap<Vector<u64>, u32, StateKeyTraits> m_state_indices;
+    Array<Optional<u32>, 8> m_start_states;
+    size_t m_cache_generation { 0 };
+};
+
+}
@@ -72,6 +72,21 @@ public:
         return m_view.get<StringView>();
     }
 
+    bool is_u32_view() const
+    {
+        return m_view.has<Utf32View>();
+    }
+
+    bool is_u16_view() const
+    {
+        return m_view.has<Utf16View>();
+    }
+
+    bool is_u8_view() const
+    {
+        return m_view.has<Utf8View>();
+    }
+
     Utf32View const& u32_view() const
     {
         return m_view.get<Utf32View>();
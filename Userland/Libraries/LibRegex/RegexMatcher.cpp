@@ -7,6 +7,7 @@
 #include <AK/BumpAllocator.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
+#include <AK/MemMem.h>
 #include <AK/StringBuilder.h>
 #include <LibRegex/RegexMatcher.h>
 #include <LibRegex/RegexParser.h>
@@ -185,6 +186,53 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
 
     auto single_match_only = input.regex_options.has_flag_set(AllFlags::SingleMatch);
 
+    // Without captures to fill in, the DFA alone can tell where a match ends.
+    auto* dfa = lazy_dfa(input.regex_options);
+    bool needs_vm_for_captures = m_pattern->parser_result.capture_groups_count != 0 && !input.regex_options.has_flag_set(AllFlags::SkipSubExprResults);
+
+    auto const& literal_prefix = m_pattern->parser_result.optimization_data.literal_prefix;
+    bool can_skip_to_literal_prefix = continue_search && !literal_prefix.is_empty()
+        && !input.regex_options.has_flag_set(AllFlags::Insensitive) && !input.regex_options.has_flag_set(AllFlags::Unicode);
+    Vector<u8, 32> literal_prefix_bytes;
+    if (can_skip_to_literal_prefix) {
+        for (auto code_unit : literal_prefix) {
+            if (code_unit > 0xff)
+                break;
+            literal_prefix_bytes.append(code_unit);
+        }
+    }
+
+    auto find_literal_prefix = [&](RegexStringView const& view, size_t start) -> Optional<size_t> {
+        // Positions in UTF-8 views are byte offsets of code points, don't bother.
+        if (view.is_u8_view())
+            return start;
+
+        if (view.is_string_view()) {
+            // Bytes can't match a prefix that doesn't fit in them.
+            if (literal_prefix_bytes.size() != literal_prefix.size())
+                return {};
+            auto string = view.string_view();
+            if (start > string.length())
+                return {};
+            auto offset = AK::memmem_optional(string.characters_without_null_termination() + start, string.length() - start, literal_prefix_bytes.data(), literal_prefix_bytes.size());
+            if (!offset.has_value())
+                return {};
+            return start + *offset;
+        }
+
+        auto length = view.length();
+        for (auto position = start; position + literal_prefix.size() <= length; ++position) {
+            if (view.code_unit_at(position) != literal_prefix.first())
+                continue;
+            bool matches = true;
+            for (size_t i = 1; i < literal_prefix.size() && matches; ++i)
+                matches = view.code_unit_at(position + i) == literal_prefix[i];
+            if (matches)
+                return position;
+        }
+        return {};
+    };
+
     for (auto const& view : views) {
         if (lines_to_skip != 0) {
             ++input.line;
@@ -200,6 +248,9 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
         state.string_position_in_code_units = view_index;
         bool succeeded = false;
 
+        bool use_dfa = dfa != nullptr && !view.is_u8_view();
+        Optional<size_t> earliest_match_end;
+
         if (view_index == view_length && m_pattern->parser_result.match_length_minimum == 0) {
             // Run the code until it tries to consume something.
             // This allows non-consuming code to run on empty strings, for instance
@@ -245,6 +296,25 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             if (match_length_minimum && match_length_minimum > view_length - view_index)
                 break;
 
+            if (can_skip_to_literal_prefix) {
+                auto candidate = find_literal_prefix(view, view_index);
+                if (!candidate.has_value())
+                    break;
+                view_index = *candidate;
+            }
+
+            // Once the DFA finds no match ending anywhere after this point, there's nothing left to try.
+            if (use_dfa && continue_search && (!earliest_match_end.has_value() || view_index > *earliest_match_end)) {
+                size_t match_end = 0;
+                auto result = dfa->find_earliest_match_end(view, view_index, match_end);
+                if (result == LazyDFA::Result::NoMatch)
+                    break;
+                if (result == LazyDFA::Result::Unsupported)
+                    use_dfa = false;
+                else
+                    earliest_match_end = match_end;
+            }
+
             input.column = match_count;
             input.match_index = match_count;
 
@@ -253,7 +323,22 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
             state.instruction_position = 0;
             state.repetition_marks.clear();
 
-            auto success = execute(input, state, operations);
+            bool success = false;
+            size_t match_end = 0;
+            auto dfa_result = use_dfa ? dfa->match_at(view, view_index, match_end) : LazyDFA::Result::Unsupported;
+            if (dfa_result == LazyDFA::Result::Unsupported) {
+                use_dfa = false;
+                success = execute(input, state, operations);
+            } else if (dfa_result == LazyDFA::Result::Match) {
+                if (needs_vm_for_captures) {
+                    success = execute(input, state, operations);
+                } else {
+                    state.string_position = match_end;
+                    state.string_position_in_code_units = match_end;
+                    success = true;
+                }
+            }
+
             if (success) {
                 succeeded = true;
 
@@ -335,6 +420,20 @@ RegexResult Matcher<Parser>::match(Vector<RegexStringView> const& views, Optiona
     return result;
 }
 
+template<class Parser>
+LazyDFA* Matcher<Parser>::lazy_dfa(AllOptions options) const
+{
+    // A plain substring search is already as fast as it gets.
+    if (m_pattern->parser_result.optimization_data.pure_substring_search.has_value())
+        return nullptr;
+
+    if (!m_lazy_dfa_options.has_value() || m_lazy_dfa_options->value() != options.value()) {
+        m_lazy_dfa = LazyDFA::try_create(m_pattern->parser_result.bytecode, options);
+        m_lazy_dfa_options = options;
+    }
+    return m_lazy_dfa.ptr();
+}
+
 template<typename T>
 class BumpAllocatedLinkedList {
 public:
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "RegexByteCode.h"
+#include "RegexDFA.h"
 #include "RegexMatch.h"
 #include "RegexOptions.h"
 #include "RegexParser.h"
@@ -71,13 +72,20 @@ public:
     void reset_pattern(Badge<Regex<Parser>>, Regex<Parser> const* pattern)
     {
         m_pattern = pattern;
+        // The DFA refers to the bytecode of the previous pattern object.
+        m_lazy_dfa = nullptr;
+        m_lazy_dfa_options.clear();
     }
 
 private:
     bool execute(MatchInput const& input, MatchState& state, size_t& operations) const;
+    LazyDFA* lazy_dfa(AllOptions) const;
 
     Regex<Parser> const* m_pattern;
     typename ParserTraits<Parser>::OptionsType const m_regex_options;
+
+    mutable OwnPtr<LazyDFA> m_lazy_dfa;
+    mutable Optional<AllOptions> m_lazy_dfa_options;
 };
 
 template<class Parser>
@@ -238,6 +246,7 @@ private:
     void run_optimization_passes();
     void attempt_rewrite_loops_as_atomic_groups(BasicBlockList const&);
     bool attempt_rewrite_entire_match_as_substring_search(BasicBlockList const&);
+    void compute_required_literal_prefix();
 };
 
 // free standing functions for match, search and has_match
@@ -28,6 +28,9 @@ void Regex<Parser>::run_optimization_passes()
 {
     parser_result.bytecode.flatten();
 
+    // The passes below keep the meaning of the bytecode intact, so the prefix stays valid.
+    compute_required_literal_prefix();
+
     auto blocks = split_basic_blocks(parser_result.bytecode);
     if (attempt_rewrite_entire_match_as_substring_search(blocks))
         return;
@@ -651,6 +654,43 @@ bool Regex<Parser>::attempt_rewrite_entire_match_as_substring_search(BasicBlockL
     return true;
 }
 
+template<typename Parser>
+void Regex<Parser>::compute_required_literal_prefix()
+{
+    // Every match has to start with the characters of the compares that run before anything can branch,
+    // which lets the matcher skip ahead to the places where they occur.
+    auto& bytecode = parser_result.bytecode;
+    auto& prefix = parser_result.optimization_data.literal_prefix;
+
+    MatchState state;
+    while (state.instruction_position < bytecode.size()) {
+        auto& opcode = bytecode.get_opcode(state);
+        switch (opcode.opcode_id()) {
+        case OpCodeId::Compare: {
+            auto& compare = static_cast<OpCode_Compare const&>(opcode);
+            // A compare with several arguments is a character class, even if each of them is a Char.
+            if (compare.arguments_count() != 1)
+                return;
+            for (auto& flat_compare : compare.flat_compares()) {
+                if (flat_compare.type != CharacterCompareType::Char)
+                    return;
+                prefix.append(flat_compare.value);
+            }
+            break;
+        }
+        case OpCodeId::SaveLeftCaptureGroup:
+        case OpCodeId::SaveRightCaptureGroup:
+        case OpCodeId::SaveRightNamedCaptureGroup:
+        case OpCodeId::ClearCaptureGroup:
+        case OpCodeId::Checkpoint:
+            break;
+        default:
+            return;
+        }
+        state.instruction_position += opcode.size();
+    }
+}
+
 template<typename Parser>
 void Regex<Parser>::attempt_rewrite_loops_as_atomic_groups(BasicBlockList const& basic_blocks)
 {
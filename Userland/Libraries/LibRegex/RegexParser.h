@@ -58,6 +58,8 @@ public:
 
         struct {
             Optional<ByteString> pure_substring_search;
+            // Characters every match starts with.
+            Vector<u32> literal_prefix;
         } optimization_data {};
     };
 
@@ -1082,6 +1082,9 @@ public:
     RefPtr<LimitClause> const& limit_clause() const { return m_limit_clause; }
     ResultOr<ResultSet> execute(ExecutionContext&) const override;
 
+    // Returns a human-readable description of the plan execute() would use, one step per line.
+    ResultOr<Vector<ByteString>> describe_query_plan(ExecutionContext&) const;
+
 private:
     RefPtr<CommonTableExpressionList> m_common_table_expression_list;
     bool m_select_all;
@@ -1107,4 +1110,18 @@ private:
     NonnullRefPtr<QualifiedTableName> m_qualified_table_name;
 };
 
+class Explain : public Statement {
+public:
+    explicit Explain(NonnullRefPtr<Select> select_statement)
+        : m_select_statement(move(select_statement))
+    {
+    }
+
+    NonnullRefPtr<Select> const& select_statement() const { return m_select_statement; }
+    ResultOr<ResultSet> execute(ExecutionContext&) const override;
+
+private:
+    NonnullRefPtr<Select> m_select_statement;
+};
+
 }
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibSQL/AST/AST.h>
+#include <LibSQL/ResultSet.h>
+#include <LibSQL/Tuple.h>
+
+namespace SQL::AST {
+
+ResultOr<ResultSet> Explain::execute(ExecutionContext& context) const
+{
+    auto plan = TRY(m_select_statement->describe_query_plan(context));
+
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->empend(""sv, ""sv, "Plan"sv, SQLType::Text);
+
+    ResultSet result { SQLCommand::Explain, { "Plan" } };
+    TRY(result.try_ensure_capacity(plan.size()));
+
+    for (auto& step : plan) {
+        Tuple tuple(descriptor);
+        tuple[0] = move(step);
+
+        result.insert_row(tuple, Tuple {});
+    }
+
+    return result;
+}
+
+}
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/GenericShorthands.h>
+#include <AK/HashMap.h>
 #include <AK/NumericLimits.h>
 #include <LibSQL/AST/AST.h>
 #include <LibSQL/Database.h>
@@ -37,6 +39,346 @@ static ByteString result_column_name(ResultColumn const& column, size_t column_i
     return fallback_column_name();
 }
 
+namespace {
+
+// One step of a query plan: the rows of `table` that pass `pushed_down_predicates` are joined to the rows
+// produced by the steps before it, either through a hash table keyed on `build_key`, or by pairing every
+// row with every other row. The joined rows are then filtered with `join_predicates`.
+struct PlannedTable {
+    NonnullRefPtr<TableDef> table;
+    Vector<NonnullRefPtr<Expression>> pushed_down_predicates {};
+    Vector<NonnullRefPtr<Expression>> join_predicates {};
+
+    RefPtr<ColumnNameExpression> build_key {};
+    RefPtr<ColumnNameExpression> probe_key {};
+};
+
+struct QueryPlan {
+    Vector<PlannedTable> tables;
+
+    // Predicates that can only be evaluated against the fully joined rows.
+    Vector<NonnullRefPtr<Expression>> residual_predicates {};
+};
+
+struct ResolvedColumn {
+    size_t table_index { 0 };
+    SQLType type { SQLType::Null };
+};
+
+}
+
+static Optional<ResolvedColumn> resolve_column(Vector<PlannedTable> const& tables, ColumnNameExpression const& column)
+{
+    Optional<ResolvedColumn> resolved_column;
+
+    for (size_t table_index = 0; table_index < tables.size(); ++table_index) {
+        auto const& table = *tables[table_index].table;
+        if (!column.table_name().is_empty() && table.name() != column.table_name())
+            continue;
+
+        for (auto const& column_def : table.columns()) {
+            if (column_def->name() != column.column_name())
+                continue;
+
+            // Leave ambiguous columns to ColumnNameExpression::evaluate, so they are reported the same way as before.
+            if (resolved_column.has_value())
+                return {};
+            resolved_column = ResolvedColumn { table_index, column_def->type() };
+        }
+    }
+
+    return resolved_column;
+}
+
+// Marks the tables an expression reads from. Returns false for expressions the planner does not know how to
+// attribute to a set of tables, which then have to be evaluated against the fully joined rows.
+static bool collect_referenced_tables(Vector<PlannedTable> const& tables, Expression const& expression, Vector<bool>& referenced_tables)
+{
+    auto collect = [&](Expression const& nested_expression) {
+        return collect_referenced_tables(tables, nested_expression, referenced_tables);
+    };
+
+    if (is<NumericLiteral>(expression) || is<StringLiteral>(expression) || is<BlobLiteral>(expression) || is<BooleanLiteral>(expression) || is<NullLiteral>(expression) || is<Placeholder>(expression))
+        return true;
+
+    if (is<ColumnNameExpression>(expression)) {
+        auto column = resolve_column(tables, verify_cast<ColumnNameExpression>(expression));
+        if (!column.has_value())
+            return false;
+
+        referenced_tables[column->table_index] = true;
+        return true;
+    }
+
+    if (is<UnaryOperatorExpression>(expression) || is<CastExpression>(expression) || is<CollateExpression>(expression) || is<NullExpression>(expression))
+        return collect(*verify_cast<NestedExpression>(expression).expression());
+
+    if (is<BinaryOperatorExpression>(expression) || is<IsExpression>(expression)) {
+        auto const& nested_expression = verify_cast<NestedDoubleExpression>(expression);
+        return collect(*nested_expression.lhs()) && collect(*nested_expression.rhs());
+    }
+
+    if (is<MatchExpression>(expression)) {
+        auto const& match_expression = verify_cast<MatchExpression>(expression);
+        if (match_expression.escape() && !collect(*match_expression.escape()))
+            return false;
+        return collect(*match_expression.lhs()) && collect(*match_expression.rhs());
+    }
+
+    if (is<BetweenExpression>(expression)) {
+        auto const& between_expression = verify_cast<BetweenExpression>(expression);
+        return collect(*between_expression.expression()) && collect(*between_expression.lhs()) && collect(*between_expression.rhs());
+    }
+
+    if (is<ChainedExpression>(expression)) {
+        for (auto const& chained_expression : verify_cast<ChainedExpression>(expression).expressions()) {
+            if (!collect(*chained_expression))
+                return false;
+        }
+        return true;
+    }
+
+    if (is<InChainedExpression>(expression)) {
+        auto const& in_chained_expression = verify_cast<InChainedExpression>(expression);
+        return collect(*in_chained_expression.expression()) && collect(*in_chained_expression.expression_chain());
+    }
+
+    return false;
+}
+
+// Splits a WHERE clause into predicates that all have to hold. Both `a AND b` and a parenthesized list `(a, b)`
+// are only true if each of their parts is true.
+static void collect_conjuncts(NonnullRefPtr<Expression> const& expression, Vector<NonnullRefPtr<Expression>>& conjuncts)
+{
+    if (is<BinaryOperatorExpression>(*expression)) {
+        auto const& binary_expression = verify_cast<BinaryOperatorExpression>(*expression);
+        if (binary_expression.type() == BinaryOperator::And) {
+            collect_conjuncts(binary_expression.lhs(), conjuncts);
+            collect_conjuncts(binary_expression.rhs(), conjuncts);
+            return;
+        }
+    }
+
+    if (is<ChainedExpression>(*expression)) {
+        for (auto const& chained_expression : verify_cast<ChainedExpression>(*expression).expressions())
+            collect_conjuncts(chained_expression, conjuncts);
+        return;
+    }
+
+    conjuncts.append(expression);
+}
+
+// Tries to use `predicate` as the key of a hash join. This works for `a = b` where `a` and `b` are columns of the
+// same hashable type, and one of them belongs to the table being joined while the other one was joined before.
+static void try_use_as_hash_join_key(Vector<PlannedTable>& tables, NonnullRefPtr<Expression> const& predicate)
+{
+    if (!is<BinaryOperatorExpression>(*predicate))
+        return;
+
+    auto const& equality = verify_cast<BinaryOperatorExpression>(*predicate);
+    if (equality.type() != BinaryOperator::Equals || !is<ColumnNameExpression>(*equality.lhs()) || !is<ColumnNameExpression>(*equality.rhs()))
+        return;
+
+    auto lhs = static_ptr_cast<ColumnNameExpression>(equality.lhs());
+    auto rhs = static_ptr_cast<ColumnNameExpression>(equality.rhs());
+
+    auto lhs_column = resolve_column(tables, *lhs);
+    auto rhs_column = resolve_column(tables, *rhs);
+    if (!lhs_column.has_value() || !rhs_column.has_value() || lhs_column->table_index == rhs_column->table_index)
+        return;
+
+    // NOTE: Values of different types may compare equal without hashing to the same value, and floating point
+    //       values can't be hashed at all.
+    if (lhs_column->type != rhs_column->type || !first_is_one_of(lhs_column->type, SQLType::Text, SQLType::Integer, SQLType::Boolean))
+        return;
+
+    if (lhs_column->table_index < rhs_column->table_index) {
+        swap(lhs, rhs);
+        swap(lhs_column, rhs_column);
+    }
+
+    auto& planned_table = tables[lhs_column->table_index];
+    if (planned_table.build_key)
+        return;
+
+    planned_table.build_key = move(lhs);
+    planned_table.probe_key = move(rhs);
+}
+
+static ResultOr<QueryPlan> build_query_plan(Select const& select, ExecutionContext& context)
+{
+    QueryPlan plan;
+
+    for (auto& table_descriptor : select.table_or_subquery_list()) {
+        if (!table_descriptor->is_table())
+            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
+
+        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
+        if (table_def->num_columns() == 0)
+            continue;
+
+        TRY(plan.tables.try_append(PlannedTable { .table = move(table_def) }));
+    }
+
+    if (!select.where_clause())
+        return plan;
+
+    Vector<NonnullRefPtr<Expression>> conjuncts;
+    collect_conjuncts(*select.where_clause(), conjuncts);
+
+    for (auto& predicate : conjuncts) {
+        Vector<bool> referenced_tables;
+        referenced_tables.resize(plan.tables.size());
+
+        if (!collect_referenced_tables(plan.tables, *predicate, referenced_tables)) {
+            TRY(plan.residual_predicates.try_append(move(predicate)));
+            continue;
+        }
+
+        Optional<size_t> first_table;
+        Optional<size_t> last_table;
+        for (size_t table_index = 0; table_index < referenced_tables.size(); ++table_index) {
+            if (!referenced_tables[table_index])
+                continue;
+            if (!first_table.has_value())
+                first_table = table_index;
+            last_table = table_index;
+        }
+
+        // Constant predicates are left to the end, so their errors are only reported if there are rows to filter.
+        if (!last_table.has_value()) {
+            TRY(plan.residual_predicates.try_append(move(predicate)));
+            continue;
+        }
+
+        auto& planned_table = plan.tables[*last_table];
+
+        if (*first_table == *last_table) {
+            TRY(planned_table.pushed_down_predicates.try_append(move(predicate)));
+            continue;
+        }
+
+        // The hash join key predicate is checked again after joining, as rows that share a bucket aren't
+        // necessarily equal.
+        try_use_as_hash_join_key(plan.tables, predicate);
+        TRY(planned_table.join_predicates.try_append(move(predicate)));
+    }
+
+    return plan;
+}
+
+static ResultOr<bool> passes_predicates(ExecutionContext& context, Tuple& row, Vector<NonnullRefPtr<Expression>> const& predicates)
+{
+    context.current_row = &row;
+
+    for (auto const& predicate : predicates) {
+        auto result = TRY(predicate->evaluate(context)).to_bool();
+        if (!result.has_value() || !result.value())
+            return false;
+    }
+
+    return true;
+}
+
+static Tuple join_rows(NonnullRefPtr<TupleDescriptor> const& descriptor, Tuple const& left, Tuple const& right)
+{
+    Tuple joined_row(descriptor);
+
+    for (size_t i = 0; i < left.size(); ++i)
+        joined_row[i] = left[i];
+    for (size_t i = 0; i < right.size(); ++i)
+        joined_row[left.size() + i] = right[i];
+
+    return joined_row;
+}
+
+static ResultOr<Vector<Tuple>> execute_query_plan(ExecutionContext& context, QueryPlan const& plan)
+{
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    descriptor->empend("__unity__"sv);
+
+    Vector<Tuple> rows;
+    TRY(rows.try_append(Tuple { descriptor }));
+    rows.first()[0] = Value { true };
+
+    for (auto const& planned_table : plan.tables) {
+        auto table_descriptor = planned_table.table->to_tuple_descriptor();
+
+        // NOTE: Each table is only read once, and rows that don't pass the predicates pushed down to this table
+        //       are dropped before they are joined with anything.
+        auto stored_rows = TRY(context.database->select_all(*planned_table.table));
+        Vector<Tuple> table_rows;
+        for (auto const& stored_row : stored_rows) {
+            Tuple table_row(table_descriptor);
+            for (size_t i = 0; i < table_row.size(); ++i)
+                table_row[i] = stored_row[i];
+
+            if (TRY(passes_predicates(context, table_row, planned_table.pushed_down_predicates)))
+                TRY(table_rows.try_append(move(table_row)));
+        }
+
+        auto joined_descriptor = adopt_ref(*new TupleDescriptor);
+        joined_descriptor->extend(*descriptor);
+        joined_descriptor->extend(*table_descriptor);
+
+        Vector<Tuple> joined_rows;
+        auto join = [&](Tuple const& left, Tuple const& right) -> ResultOr<void> {
+            auto joined_row = join_rows(joined_descriptor, left, right);
+            if (TRY(passes_predicates(context, joined_row, planned_table.join_predicates)))
+                TRY(joined_rows.try_append(move(joined_row)));
+            return {};
+        };
+
+        if (planned_table.build_key) {
+            HashMap<u32, Vector<size_t>> hash_table;
+
+            for (size_t i = 0; i < table_rows.size(); ++i) {
+                context.current_row = &table_rows[i];
+                auto key = TRY(planned_table.build_key->evaluate(context));
+
+                // NULL is not equal to anything, not even NULL.
+                if (!key.is_null())
+                    TRY(hash_table.ensure(key.hash()).try_append(i));
+            }
+
+            for (auto& row : rows) {
+                context.current_row = &row;
+                auto key = TRY(planned_table.probe_key->evaluate(context));
+                if (key.is_null())
+                    continue;
+
+                auto bucket = hash_table.find(key.hash());
+                if (bucket == hash_table.end())
+                    continue;
+
+                for (auto table_row_index : bucket->value)
+                    TRY(join(row, table_rows[table_row_index]));
+            }
+        } else {
+            for (auto const& row : rows) {
+                for (auto const& table_row : table_rows)
+                    TRY(join(row, table_row));
+            }
+        }
+
+        rows = move(joined_rows);
+        descriptor = move(joined_descriptor);
+
+        if (rows.is_empty())
+            break;
+    }
+
+    return rows;
+}
+
+static ByteString qualified_column_name(Vector<PlannedTable> const& tables, ColumnNameExpression const& column)
+{
+    auto resolved_column = resolve_column(tables, column);
+    VERIFY(resolved_column.has_value());
+
+    return ByteString::formatted("{}.{}", tables[resolved_column->table_index].table->name(), column.column_name());
+}
+
 ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 {
     Vector<NonnullRefPtr<ResultColumn const>> columns;
@@ -85,35 +427,8 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
 
     ResultSet result { SQLCommand::Select, move(column_names) };
 
-    auto descriptor = adopt_ref(*new TupleDescriptor);
-    Tuple tuple(descriptor);
-    Vector<Tuple> rows;
-    descriptor->empend("__unity__"sv);
-    tuple.append(Value { true });
-    rows.append(tuple);
-
-    for (auto& table_descriptor : table_or_subquery_list()) {
-        if (!table_descriptor->is_table())
-            return Result { SQLCommand::Select, SQLErrorCode::NotYetImplemented, "Sub-selects are not yet implemented"sv };
-
-        auto table_def = TRY(context.database->get_table(table_descriptor->schema_name(), table_descriptor->table_name()));
-        if (table_def->num_columns() == 0)
-            continue;
-
-        auto old_descriptor_size = descriptor->size();
-        descriptor->extend(table_def->to_tuple_descriptor());
-
-        while (!rows.is_empty() && (rows.first().size() == old_descriptor_size)) {
-            auto cartesian_row = rows.take_first();
-            auto table_rows = TRY(context.database->select_all(*table_def));
-
-            for (auto& table_row : table_rows) {
-                auto new_row = cartesian_row;
-                new_row.extend(table_row);
-                rows.append(new_row);
-            }
-        }
-    }
+    auto plan = TRY(build_query_plan(*this, context));
+    auto rows = TRY(execute_query_plan(context, plan));
 
     bool has_ordering { false };
     auto sort_descriptor = adopt_ref(*new TupleDescriptor);
@@ -123,14 +438,12 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     }
     Tuple sort_key(sort_descriptor);
 
-    for (auto& row : rows) {
-        context.current_row = &row;
+    auto descriptor = adopt_ref(*new TupleDescriptor);
+    Tuple tuple(descriptor);
 
-        if (where_clause()) {
-            auto where_result = TRY(where_clause()->evaluate(context)).to_bool();
-            if (!where_result.has_value() || !where_result.value())
-                continue;
-        }
+    for (auto& row : rows) {
+        if (!TRY(passes_predicates(context, row, plan.residual_predicates)))
+            continue;
 
         tuple.clear();
 
@@ -180,4 +493,35 @@ ResultOr<ResultSet> Select::execute(ExecutionContext& context) const
     return result;
 }
 
+ResultOr<Vector<ByteString>> Select::describe_query_plan(ExecutionContext& context) const
+{
+    auto plan = TRY(build_query_plan(*this, context));
+    Vector<ByteString> steps;
+
+    for (size_t i = 0; i < plan.tables.size(); ++i) {
+        auto const& planned_table = plan.tables[i];
+        auto table_name = ByteString::formatted("{}.{}", planned_table.table->parent()->name(), planned_table.table->name());
+
+        if (i == 0)
+            TRY(steps.try_append(ByteString::formatted("SCAN {}", table_name)));
+        else if (planned_table.build_key)
+            TRY(steps.try_append(ByteString::formatted("HASH JOIN {} ON {} = {}", table_name, qualified_column_name(plan.tables, *planned_table.probe_key), qualified_column_name(plan.tables, *planned_table.build_key))));
+        else
+            TRY(steps.try_append(ByteString::formatted("NESTED LOOP JOIN {}", table_name)));
+
+        if (!planned_table.pushed_down_predicates.is_empty())
+            TRY(steps.try_append(ByteString::formatted("  PUSHED-DOWN PREDICATES: {}", planned_table.pushed_down_predicates.size())));
+
+        // The hash join key is counted as a join predicate too, as it is checked again after joining.
+        auto join_predicate_count = planned_table.join_predicates.size() - (planned_table.build_key ? 1 : 0);
+        if (join_predicate_count != 0)
+            TRY(steps.try_append(ByteString::formatted("  JOIN PREDICATES: {}", join_predicate_count)));
+    }
+
+    if (!plan.residual_predicates.is_empty())
+        TRY(steps.try_append(ByteString::formatted("RESIDUAL PREDICATES: {}", plan.residual_predicates.size())));
+
+    return steps;
+}
+
 }
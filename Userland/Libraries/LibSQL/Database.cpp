@@ -81,6 +81,13 @@ ResultOr<void> Database::open()
 Database::~Database() = default;
 
 ErrorOr<void> Database::commit()
+{
+    VERIFY(is_open());
+    TRY(m_heap->commit());
+    return {};
+}
+
+ErrorOr<void> Database::flush()
 {
     VERIFY(is_open());
     TRY(m_heap->flush());
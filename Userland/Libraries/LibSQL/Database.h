@@ -31,8 +31,15 @@ public:
     ResultOr<void> open();
     bool is_open() const { return m_open; }
     ErrorOr<void> commit();
+    ErrorOr<void> flush();
+    [[nodiscard]] bool has_pending_commits() const { return m_heap->has_pending_commits(); }
+    void when_written_back(Function<void(ErrorOr<void>)> callback) { m_heap->when_written_back(move(callback)); }
     ErrorOr<size_t> file_size_in_bytes() const { return m_heap->file_size_in_bytes(); }
 
+    void set_group_commit_size(size_t size) { m_heap->set_group_commit_size(size); }
+    void set_sync_policy(Heap::SyncPolicy policy) { m_heap->set_sync_policy(policy); }
+    void set_page_cache_capacity(size_t capacity) { m_heap->set_page_cache_capacity(capacity); }
+
     ResultOr<void> add_schema(SchemaDef const&);
     static Key get_schema_key(ByteString const&);
     ResultOr<NonnullRefPtr<SchemaDef>> get_schema(ByteString const&);
@@ -56,6 +56,7 @@ ErrorOr<void> Heap::open()
     }
 
     auto file = TRY(Core::File::open(name(), Core::File::OpenMode::ReadWrite));
+    m_file_descriptor = file->fd();
     m_file = TRY(Core::InputBufferedFile::create(move(file)));
 
     if (file_size > 0) {
@@ -71,6 +72,7 @@ ErrorOr<void> Heap::open()
     if (m_version != VERSION) {
         dbgln_if(SQL_DEBUG, "Heap file {} opened has incompatible version {}. Deleting for version {}.", name(), m_version, VERSION);
         m_file = nullptr;
+        evict_cached_blocks(0);
 
         TRY(Core::System::unlink(name()));
         return open();
@@ -78,8 +80,9 @@ ErrorOr<void> Heap::open()
 
     // Perform a heap scan to find all free blocks
     // FIXME: this is very inefficient; store free blocks in a persistent heap structure
+    // NOTE: This reads from the file directly, so the scan doesn't push the blocks we actually need out of the page cache.
     for (Block::Index index = 1; index <= m_highest_block_written; ++index) {
-        auto block_data = TRY(read_raw_block(index));
+        auto block_data = TRY(read_raw_block_from_file(index));
         auto size_in_bytes = *reinterpret_cast<u32*>(block_data.data());
         if (size_in_bytes == 0)
             TRY(m_free_block_indices.try_append(index));
@@ -180,6 +183,19 @@ ErrorOr<ByteBuffer> Heap::read_raw_block(Block::Index index)
     if (auto wal_entry = m_write_ahead_log.get(index); wal_entry.has_value())
         return wal_entry.value();
 
+    if (auto cached_data = cached_block(index); cached_data.has_value()) {
+        ++m_page_cache_hits;
+        return ByteBuffer::copy(cached_data->bytes());
+    }
+
+    ++m_page_cache_misses;
+    auto buffer = TRY(read_raw_block_from_file(index));
+    TRY(cache_block(index, buffer));
+    return buffer;
+}
+
+ErrorOr<ByteBuffer> Heap::read_raw_block_from_file(Block::Index index)
+{
     TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
     auto buffer = TRY(ByteBuffer::create_uninitialized(Block::SIZE));
     TRY(m_file->read_until_filled(buffer));
@@ -198,18 +214,19 @@ ErrorOr<Block> Heap::read_block(Block::Index index)
     return Block { index, size_in_bytes, next_block, move(data) };
 }
 
-ErrorOr<void> Heap::write_raw_block(Block::Index index, ReadonlyBytes data)
+ErrorOr<void> Heap::write_raw_blocks(Block::Index first_index, ReadonlyBytes data)
 {
-    dbgln_if(SQL_DEBUG, "Write raw block {}", index);
-
     VERIFY(m_file);
-    VERIFY(data.size() == Block::SIZE);
+    VERIFY(!data.is_empty() && data.size() % Block::SIZE == 0);
 
-    TRY(m_file->seek(index * Block::SIZE, SeekMode::SetPosition));
+    auto last_index = first_index + data.size() / Block::SIZE - 1;
+    dbgln_if(SQL_DEBUG, "Write raw blocks {}-{}", first_index, last_index);
+
+    TRY(m_file->seek(first_index * Block::SIZE, SeekMode::SetPosition));
     TRY(m_file->write_until_depleted(data));
 
-    if (index > m_highest_block_written)
-        m_highest_block_written = index;
+    if (last_index > m_highest_block_written)
+        m_highest_block_written = last_index;
 
     return {};
 }
@@ -273,21 +290,130 @@ ErrorOr<void> Heap::free_block(Block const& block)
     return m_free_block_indices.try_append(index);
 }
 
+ErrorOr<void> Heap::commit()
+{
+    if (m_write_ahead_log.is_empty())
+        return {};
+
+    if (++m_pending_commits < m_group_commit_size)
+        return {};
+
+    return flush();
+}
+
+void Heap::when_written_back(Function<void(ErrorOr<void>)> callback)
+{
+    if (!has_pending_commits()) {
+        callback({});
+        return;
+    }
+    m_write_back_callbacks.append(move(callback));
+}
+
 ErrorOr<void> Heap::flush()
+{
+    auto result = write_back();
+
+    // Let everyone waiting for their transactions to hit the disk know how it went, even if it didn't.
+    auto callbacks = move(m_write_back_callbacks);
+    for (auto& callback : callbacks) {
+        if (result.is_error())
+            callback(Error::copy(result.error()));
+        else
+            callback({});
+    }
+
+    return result;
+}
+
+ErrorOr<void> Heap::write_back()
 {
     VERIFY(m_file);
     auto indices = m_write_ahead_log.keys();
     quick_sort(indices);
+
+    // Write back each run of consecutive blocks with a single write.
+    ByteBuffer run;
+    Block::Index run_first_index = 0;
+    auto write_run = [&]() -> ErrorOr<void> {
+        if (run.is_empty())
+            return {};
+        TRY(write_raw_blocks(run_first_index, run));
+        run.clear();
+        return {};
+    };
+
     for (auto index : indices) {
         dbgln_if(SQL_DEBUG, "Flushing block {}", index);
-        auto& data = m_write_ahead_log.get(index).value();
-        TRY(write_raw_block(index, data));
+        if (!run.is_empty() && index != run_first_index + run.size() / Block::SIZE)
+            TRY(write_run());
+        if (run.is_empty())
+            run_first_index = index;
+        TRY(run.try_append(m_write_ahead_log.get(index)->bytes()));
     }
+    TRY(write_run());
+
+    if (m_sync_policy == SyncPolicy::OnWriteBack && !indices.is_empty())
+        TRY(Core::System::fsync(m_file_descriptor));
+
+    // The blocks we just wrote back are likely to be read again soon, so keep them around as clean blocks.
+    for (auto index : indices)
+        TRY(cache_block(index, m_write_ahead_log.take(index).release_value()));
+
     m_write_ahead_log.clear();
+    m_pending_commits = 0;
     dbgln_if(SQL_DEBUG, "WAL flushed; new number of blocks = {}", m_highest_block_written);
     return {};
 }
 
+Optional<ByteBuffer const&> Heap::cached_block(Block::Index index)
+{
+    auto it = m_page_cache.find(index);
+    if (it == m_page_cache.end())
+        return {};
+
+    auto& block = *it->value;
+    m_page_cache_lru.remove(block);
+    m_page_cache_lru.prepend(block);
+    return block.data;
+}
+
+ErrorOr<void> Heap::cache_block(Block::Index index, ByteBuffer data)
+{
+    if (m_page_cache_capacity == 0)
+        return {};
+
+    if (auto it = m_page_cache.find(index); it != m_page_cache.end()) {
+        auto& block = *it->value;
+        block.data = move(data);
+        m_page_cache_lru.remove(block);
+        m_page_cache_lru.prepend(block);
+        return {};
+    }
+
+    evict_cached_blocks(m_page_cache_capacity - 1);
+
+    auto block = TRY(adopt_nonnull_own_or_enomem(new (nothrow) CachedBlock { .index = index, .data = move(data) }));
+    auto& block_reference = *block;
+    TRY(m_page_cache.try_set(index, move(block)));
+    m_page_cache_lru.prepend(block_reference);
+    return {};
+}
+
+void Heap::evict_cached_blocks(size_t capacity)
+{
+    while (m_page_cache.size() > capacity) {
+        auto* block = m_page_cache_lru.take_last();
+        m_page_cache.remove(block->index);
+    }
+}
+
+void Heap::set_page_cache_capacity(size_t capacity)
+{
+    m_page_cache_capacity = capacity;
+    evict_cached_blocks(capacity);
+}
+
 constexpr static auto FILE_ID = "SerenitySQL "sv;
 constexpr static auto VERSION_OFFSET = FILE_ID.length();
 constexpr static auto SCHEMAS_ROOT_OFFSET = VERSION_OFFSET + sizeof(u32);
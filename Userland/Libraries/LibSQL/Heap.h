@@ -10,7 +10,10 @@
 #include <AK/Array.h>
 #include <AK/ByteString.h>
 #include <AK/Debug.h>
+#include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Vector.h>
 #include <LibCore/File.h>
@@ -67,6 +70,14 @@ private:
 class Heap : public RefCounted<Heap> {
 public:
     static constexpr u32 VERSION = 5;
+    static constexpr size_t DEFAULT_PAGE_CACHE_CAPACITY = 1024;
+
+    enum class SyncPolicy {
+        // Leave it up to the operating system when written back blocks reach the disk.
+        Never,
+        // fsync() the heap file every time blocks are written back, so committed data survives a system crash.
+        OnWriteBack,
+    };
 
     static ErrorOr<NonnullRefPtr<Heap>> create(ByteString);
     virtual ~Heap();
@@ -119,14 +130,50 @@ public:
     ErrorOr<void> write_storage(Block::Index, ReadonlyBytes);
     ErrorOr<void> free_storage(Block::Index);
 
+    // Marks the end of a transaction. Its changes are only written back once `group_commit_size` transactions
+    // have been committed, or when the heap is flushed explicitly.
+    ErrorOr<void> commit();
+    [[nodiscard]] bool has_pending_commits() const { return m_pending_commits > 0; }
     ErrorOr<void> flush();
 
+    // Calls `callback` once all transactions committed so far have been written back (and synced to disk, depending
+    // on the sync policy), or with the error that prevented it. This happens right away if nothing is pending.
+    void when_written_back(Function<void(ErrorOr<void>)> callback);
+
+    size_t group_commit_size() const { return m_group_commit_size; }
+    void set_group_commit_size(size_t size) { m_group_commit_size = max(size, 1uz); }
+
+    SyncPolicy sync_policy() const { return m_sync_policy; }
+    void set_sync_policy(SyncPolicy policy) { m_sync_policy = policy; }
+
+    size_t page_cache_capacity() const { return m_page_cache_capacity; }
+    void set_page_cache_capacity(size_t);
+    size_t page_cache_size() const { return m_page_cache.size(); }
+    u64 page_cache_hits() const { return m_page_cache_hits; }
+    u64 page_cache_misses() const { return m_page_cache_misses; }
+
 private:
+    // A clean copy of a block as it is stored in the heap file. Blocks that have been changed since are pinned
+    // in the write-ahead log instead, until they are written back.
+    struct CachedBlock {
+        Block::Index index { 0 };
+        ByteBuffer data;
+        IntrusiveListNode<CachedBlock> list_node;
+
+        using List = IntrusiveList<&CachedBlock::list_node>;
+    };
+
     explicit Heap(ByteString);
 
     ErrorOr<ByteBuffer> read_raw_block(Block::Index);
-    ErrorOr<void> write_raw_block(Block::Index, ReadonlyBytes);
+    ErrorOr<ByteBuffer> read_raw_block_from_file(Block::Index);
+    ErrorOr<void> write_raw_blocks(Block::Index first_index, ReadonlyBytes);
     ErrorOr<void> write_raw_block_to_wal(Block::Index, ByteBuffer&&);
+    ErrorOr<void> write_back();
+
+    Optional<ByteBuffer const&> cached_block(Block::Index);
+    ErrorOr<void> cache_block(Block::Index, ByteBuffer);
+    void evict_cached_blocks(size_t capacity);
 
     ErrorOr<Block> read_block(Block::Index);
     ErrorOr<void> write_block(Block const&);
@@ -139,6 +186,7 @@ private:
     ByteString m_name;
 
     OwnPtr<Core::InputBufferedFile> m_file;
+    int m_file_descriptor { -1 };
     Block::Index m_highest_block_written { 0 };
     Block::Index m_next_block { 1 };
     Block::Index m_schemas_root { 0 };
@@ -148,6 +196,17 @@ private:
     Array<u32, 16> m_user_values { 0 };
     HashMap<Block::Index, ByteBuffer> m_write_ahead_log;
     Vector<Block::Index> m_free_block_indices;
+
+    size_t m_pending_commits { 0 };
+    size_t m_group_commit_size { 1 };
+    Vector<Function<void(ErrorOr<void>)>> m_write_back_callbacks;
+    SyncPolicy m_sync_policy { SyncPolicy::Never };
+
+    HashMap<Block::Index, NonnullOwnPtr<CachedBlock>> m_page_cache;
+    CachedBlock::List m_page_cache_lru;
+    size_t m_page_cache_capacity { DEFAULT_PAGE_CACHE_CAPACITY };
+    u64 m_page_cache_hits { 0 };
+    u64 m_page_cache_misses { 0 };
 };
 
 }
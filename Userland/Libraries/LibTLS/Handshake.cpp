@@ -19,6 +19,23 @@ ByteBuffer TLSv12::build_hello()
 {
     fill_with_random(m_context.local_random);
 
+    // Offer to resume an earlier session by its ID, or with its ticket. A server that accepts the ticket echoes
+    // the session ID we send along, so make one up if the session doesn't have one (RFC 5077 section 3.4).
+    auto const& session = m_context.options.session_to_resume;
+    bool use_session_tickets = m_context.options.use_session_tickets;
+    ReadonlyBytes session_ticket;
+    if (session.has_value() && !session->has_expired()) {
+        if (!session->session_id.is_empty() && session->session_id.size() <= sizeof(m_context.session_id)) {
+            memcpy(m_context.session_id, session->session_id.data(), session->session_id.size());
+            m_context.session_id_size = session->session_id.size();
+        } else if (use_session_tickets && !session->ticket.is_empty()) {
+            fill_with_random(m_context.session_id);
+            m_context.session_id_size = sizeof(m_context.session_id);
+        }
+        if (use_session_tickets)
+            session_ticket = session->ticket;
+    }
+
     auto packet_version = (u16)m_context.options.version;
     auto version = (u16)m_context.options.version;
     PacketBuilder builder { ContentType::HANDSHAKE, packet_version };
@@ -89,6 +106,9 @@ ByteBuffer TLSv12::build_hello()
     if (enable_extended_master_secret)
         extension_length += 4;
 
+    if (use_session_tickets)
+        extension_length += 4 + session_ticket.size();
+
     builder.append((u16)extension_length);
 
     if (sni_length) {
@@ -139,6 +159,13 @@ ByteBuffer TLSv12::build_hello()
         builder.append((u16)0);
     }
 
+    if (use_session_tickets) {
+        // session_ticket extension, empty unless we have a ticket to present
+        builder.append((u16)ExtensionType::SESSION_TICKET);
+        builder.append((u16)session_ticket.size());
+        builder.append(session_ticket);
+    }
+
     if (alpn_length) {
         // TODO
         VERIFY_NOT_REACHED();
@@ -227,6 +254,20 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
 
     // TODO: Compare Hashes
     dbgln_if(TLS_DEBUG, "FIXME: handle_handshake_finished :: Check message validity");
+
+    // In an abbreviated handshake, the server finishes first and we still have to send our Finished message.
+    if (m_context.is_resumed_session) {
+        write_packets = WritePacketStage::Finished;
+        return index + size;
+    }
+
+    did_establish_connection();
+
+    return index + size;
+}
+
+void TLSv12::did_establish_connection()
+{
     m_context.connection_status = ConnectionStatus::Established;
 
     if (m_handshake_timeout_timer) {
@@ -236,10 +277,68 @@ ssize_t TLSv12::handle_handshake_finished(ReadonlyBytes buffer, WritePacketStage
         m_handshake_timeout_timer = nullptr;
     }
 
+    // Hand the session over to whoever wants to resume it later, if the server made it resumable.
+    if (m_context.session_id_size || !m_context.session_ticket.is_empty()) {
+        Session session;
+        session.cipher = m_context.cipher;
+        session.extended_master_secret = m_context.extensions.extended_master_secret;
+        if (m_context.is_resumed_session && !m_context.received_session_ticket) {
+            // Resuming a session doesn't make the server remember it for any longer.
+            session.expiry = m_context.options.session_to_resume->expiry;
+        } else if (m_context.received_session_ticket && m_context.session_ticket_lifetime_hint != 0) {
+            session.expiry = UnixDateTime::now() + Duration::from_seconds(m_context.session_ticket_lifetime_hint);
+        } else {
+            // A lifetime hint of zero means the server didn't specify one.
+            session.expiry = UnixDateTime::now() + Session::default_lifetime;
+        }
+        auto copied = [&]() -> ErrorOr<void> {
+            session.master_key = TRY(ByteBuffer::copy(m_context.master_key));
+            session.session_id = TRY(ByteBuffer::copy(m_context.session_id, m_context.session_id_size));
+            session.ticket = TRY(ByteBuffer::copy(m_context.session_ticket));
+            return {};
+        }();
+        if (copied.is_error())
+            dbgln("Failed to save the TLS session: {}", copied.error());
+        else
+            m_context.options.new_session_handler(session);
+    }
+
     if (on_connected)
         on_connected();
+}
 
-    return index + size;
+ssize_t TLSv12::handle_new_session_ticket(ReadonlyBytes buffer)
+{
+    if (buffer.size() < 3)
+        return (i8)Error::NeedMoreData;
+
+    size_t size = buffer[0] * 0x10000 + buffer[1] * 0x100 + buffer[2];
+
+    if (buffer.size() - 3 < size)
+        return (i8)Error::NeedMoreData;
+
+    // RFC 5077 section 3.3:
+    // struct {
+    //     uint32 ticket_lifetime_hint;
+    //     opaque ticket<0..2^16-1>;
+    // } NewSessionTicket;
+    if (size < 6)
+        return (i8)Error::BrokenPacket;
+
+    auto ticket_length = AK::convert_between_host_and_network_endian(ByteReader::load16(buffer.offset_pointer(3 + 4)));
+    if (size - 6 < ticket_length)
+        return (i8)Error::BrokenPacket;
+
+    m_context.session_ticket_lifetime_hint = AK::convert_between_host_and_network_endian(ByteReader::load32(buffer.offset_pointer(3)));
+
+    // An empty ticket means the server won't let us resume this session with a ticket.
+    auto ticket_result = ByteBuffer::copy(buffer.slice(3 + 6, ticket_length));
+    if (ticket_result.is_error())
+        return (i8)Error::OutOfMemory;
+    m_context.session_ticket = ticket_result.release_value();
+    m_context.received_session_ticket = true;
+
+    return size + 3;
 }
 
 ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
@@ -406,6 +505,20 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 payload_res = (i8)Error::UnexpectedMessage;
             }
             break;
+        case HandshakeType::NEW_SESSION_TICKET:
+            if (m_context.handshake_messages[11] >= 1 || !m_context.extensions.session_ticket) {
+                dbgln("unexpected new session ticket message");
+                payload_res = (i8)Error::UnexpectedMessage;
+                break;
+            }
+            ++m_context.handshake_messages[11];
+            dbgln_if(TLS_DEBUG, "new session ticket");
+            if (m_context.connection_status == ConnectionStatus::KeyExchange) {
+                payload_res = handle_new_session_ticket(buffer.slice(1, payload_size));
+            } else {
+                payload_res = (i8)Error::UnexpectedMessage;
+            }
+            break;
         case HandshakeType::FINISHED:
             m_context.cached_handshake.clear();
             if (m_context.handshake_messages[10] >= 1) {
@@ -547,7 +660,7 @@ ssize_t TLSv12::handle_handshake_payload(ReadonlyBytes vbuffer)
                 auto packet = build_handshake_finished();
                 write_packet(packet);
             }
-            m_context.connection_status = ConnectionStatus::Established;
+            did_establish_connection();
             break;
         }
         payload_size++;
@@ -61,6 +61,12 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         return (i8)Error::NeedMoreData;
     }
 
+    // RFC 5246 section 7.4.1.3: A server that resumes the session we offered echoes its session ID.
+    bool is_resuming_offered_session = m_context.options.session_to_resume.has_value()
+        && m_context.session_id_size != 0
+        && session_length == m_context.session_id_size
+        && memcmp(m_context.session_id, buffer.offset_pointer(res), session_length) == 0;
+
     if (session_length && session_length <= 32) {
         memcpy(m_context.session_id, buffer.offset_pointer(res), session_length);
         m_context.session_id_size = session_length;
@@ -190,15 +196,55 @@ ssize_t TLSv12::handle_server_hello(ReadonlyBytes buffer, WritePacketStage& writ
         } else if (extension_type == ExtensionType::EXTENDED_MASTER_SECRET) {
             m_context.extensions.extended_master_secret = true;
             res += extension_length;
+        } else if (extension_type == ExtensionType::SESSION_TICKET) {
+            // RFC 5077 section 3.2: The server will send a NewSessionTicket message before its ChangeCipherSpec.
+            m_context.extensions.session_ticket = true;
+            res += extension_length;
         } else {
             dbgln("Encountered unknown extension {} with length {}", enum_to_string(extension_type), extension_length);
             res += extension_length;
         }
     }
 
+    if (is_resuming_offered_session && !resume_session(*m_context.options.session_to_resume))
+        return (i8)Error::NotSafe;
+
     return res;
 }
 
+bool TLSv12::resume_session(Session const& session)
+{
+    // RFC 5246 section 7.4.1.3: A resumed session must keep its cipher suite.
+    if (m_context.cipher != session.cipher) {
+        dbgln("Server resumed a session with a different cipher suite");
+        return false;
+    }
+
+    // RFC 7627 section 5.3: A session resumes with the extended master secret if and only if it was created with it.
+    if (m_context.extensions.extended_master_secret != session.extended_master_secret) {
+        dbgln("Server resumed a session with a different extended master secret setting");
+        return false;
+    }
+
+    auto master_key_result = ByteBuffer::copy(session.master_key);
+    auto ticket_result = ByteBuffer::copy(session.ticket);
+    if (master_key_result.is_error() || ticket_result.is_error()) {
+        dbgln("Failed to resume the session: not enough memory");
+        return false;
+    }
+    m_context.master_key = master_key_result.release_value();
+    // Keep presenting the same ticket, unless the server gives us a new one.
+    m_context.session_ticket = ticket_result.release_value();
+
+    // The abbreviated handshake skips the certificates and the key exchange, and goes straight to
+    // the server's ChangeCipherSpec and Finished messages.
+    m_context.is_resumed_session = true;
+    m_context.connection_status = ConnectionStatus::KeyExchange;
+    dbgln_if(TLS_DEBUG, "Resuming session");
+
+    return expand_key();
+}
+
 ssize_t TLSv12::handle_server_hello_done(ReadonlyBytes buffer)
 {
     if (buffer.size() < 3)
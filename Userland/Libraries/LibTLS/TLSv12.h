@@ -139,6 +139,23 @@ constexpr CipherAlgorithm get_cipher_algorithm(CipherSuite suite)
     }
 }
 
+// Everything a client needs to resume a session with an abbreviated handshake, either by
+// its session ID (RFC 5246 section 7.4.1.2) or with a session ticket (RFC 5077).
+struct Session {
+    // RFC 5246 section F.1.4 suggests an upper limit of 24 hours for session lifetimes, we use that
+    // unless the server gave us a ticket with a lifetime hint (RFC 5077 section 3.3).
+    static constexpr Duration default_lifetime = Duration::from_seconds(24 * 60 * 60);
+
+    bool has_expired() const { return UnixDateTime::now() >= expiry; }
+
+    CipherSuite cipher { CipherSuite::TLS_NULL_WITH_NULL_NULL };
+    ByteBuffer master_key;
+    ByteBuffer session_id;
+    ByteBuffer ticket;
+    bool extended_master_secret { false };
+    UnixDateTime expiry;
+};
+
 struct Options {
     static Vector<CipherSuite> default_usable_cipher_suites()
     {
@@ -194,6 +211,9 @@ struct Options {
     OPTION_WITH_DEFAULTS(Function<void()>, finish_callback, [] { })
     OPTION_WITH_DEFAULTS(Function<Vector<Certificate>()>, certificate_provider, [] { return Vector<Certificate> {}; })
     OPTION_WITH_DEFAULTS(bool, enable_extended_master_secret, true)
+    OPTION_WITH_DEFAULTS(bool, use_session_tickets, true)
+    OPTION_WITH_DEFAULTS(Optional<Session>, session_to_resume, )
+    OPTION_WITH_DEFAULTS(Function<void(Session const&)>, new_session_handler, [](auto&) { })
 
 #undef OPTION_WITH_DEFAULTS
 };
@@ -246,6 +266,11 @@ struct Context {
     u8 local_random[32];
     u8 session_id[32];
     u8 session_id_size { 0 };
+    ByteBuffer session_ticket;
+    u32 session_ticket_lifetime_hint { 0 };
+    // NOTE: Unlike handshake_messages, this isn't reset once the handshake is finished.
+    bool received_session_ticket { false };
+    bool is_resumed_session { false };
     CipherSuite cipher;
     bool is_server { false };
     Vector<Certificate> certificates;
@@ -285,6 +310,7 @@ struct Context {
         // Server Name Indicator
         ByteString SNI; // I hate your existence
         bool extended_master_secret { false };
+        bool session_ticket { false };
     } extensions;
 
     u8 request_client_certificate { 0 };
@@ -298,7 +324,7 @@ struct Context {
     bool has_invoked_finish_or_error_callback { false };
 
     // message flags
-    u8 handshake_messages[11] { 0 };
+    u8 handshake_messages[12] { 0 };
     ByteBuffer user_data;
     HashMap<ByteString, Certificate> root_certificates;
 
@@ -367,6 +393,7 @@ public:
     explicit TLSv12(StreamVariantType, Options);
 
     bool is_established() const { return m_context.connection_status == ConnectionStatus::Established; }
+    bool is_resumed_session() const { return m_context.is_resumed_session; }
 
     void set_sni(StringView sni)
     {
@@ -450,6 +477,7 @@ private:
     ssize_t handle_ecdhe_ecdsa_server_key_exchange(ReadonlyBytes);
     ssize_t handle_server_hello_done(ReadonlyBytes);
     ssize_t handle_certificate_verify(ReadonlyBytes);
+    ssize_t handle_new_session_ticket(ReadonlyBytes);
     ssize_t handle_handshake_payload(ReadonlyBytes);
     ssize_t handle_message(ReadonlyBytes);
 
@@ -527,6 +555,8 @@ private:
     bool expand_key();
 
     bool compute_master_secret_from_pre_master_secret(size_t length);
+    bool resume_session(Session const&);
+    void did_establish_connection();
 
     void try_disambiguate_error() const;
 
@@ -12,4 +12,6 @@ namespace Threading {
 template<typename ErrorType>
 class WorkerThread;
 
+class WorkStealingThreadPool;
+
 }
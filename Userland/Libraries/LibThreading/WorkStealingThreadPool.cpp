@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/System.h>
+#include <LibThreading/WorkStealingThreadPool.h>
+
+#ifdef AK_OS_SERENITY
+#    include <sys/prctl.h>
+#endif
+
+namespace Threading {
+
+static thread_local WorkStealingThreadPool* s_current_pool { nullptr };
+static thread_local size_t s_current_worker_index { 0 };
+
+void WorkStealingThreadPool::TaskDeque::push_back(Task task)
+{
+    MutexLocker locker(m_mutex);
+    m_tasks.append(move(task));
+}
+
+Optional<WorkStealingThreadPool::Task> WorkStealingThreadPool::TaskDeque::pop_back()
+{
+    MutexLocker locker(m_mutex);
+    if (m_tasks.size() == m_head)
+        return {};
+    auto task = m_tasks.take_last();
+    if (m_tasks.size() == m_head) {
+        m_tasks.clear_with_capacity();
+        m_head = 0;
+    }
+    return task;
+}
+
+Optional<WorkStealingThreadPool::Task> WorkStealingThreadPool::TaskDeque::steal_front()
+{
+    MutexLocker locker(m_mutex);
+    if (m_tasks.size() == m_head)
+        return {};
+    auto task = move(m_tasks[m_head++]);
+    if (m_tasks.size() == m_head) {
+        m_tasks.clear_with_capacity();
+        m_head = 0;
+    }
+    return task;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(Optional<size_t> concurrency)
+    : m_work_available(m_mutex)
+    , m_progress_made(m_mutex)
+{
+    auto worker_count = max(concurrency.value_or(Core::System::hardware_concurrency()), 1uz);
+
+    for (size_t i = 0; i < worker_count; ++i)
+        m_deques.append(make<TaskDeque>());
+
+    for (size_t i = 0; i < worker_count; ++i) {
+        m_workers.append(Thread::construct([this, i]() -> intptr_t {
+            worker_loop(i);
+            return 0;
+        },
+            "WorkStealingThreadPool worker"sv));
+    }
+
+    for (auto& worker : m_workers)
+        worker->start();
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    {
+        MutexLocker locker(m_mutex);
+        m_should_exit.store(true);
+        m_work_available.broadcast();
+    }
+    for (auto& worker : m_workers)
+        (void)worker->join();
+}
+
+WorkStealingThreadPool& WorkStealingThreadPool::the()
+{
+    // NOTE: This is intentionally leaked, so that tasks still running at exit don't race with its destruction.
+    static auto* s_the = new WorkStealingThreadPool;
+    return *s_the;
+}
+
+size_t WorkStealingThreadPool::chunk_size_for(size_t count, size_t grain_size) const
+{
+    if (count == 0)
+        return 0;
+
+    // Aim for a few chunks per worker, so stealing can even out chunks that take longer than others.
+    auto maximum_chunk_count = worker_count() * 4;
+    auto chunk_size = ceil_div(count, maximum_chunk_count);
+    return max(chunk_size, max(grain_size, 1uz));
+}
+
+void WorkStealingThreadPool::submit(Task task)
+{
+    m_unfinished_tasks.fetch_add(1);
+
+    // NOTE: The task has to be counted before it's pushed. Otherwise another thread could take it and decrement
+    //       the count first, which would wrap it around. Until the push is done, others may see one task too
+    //       many and look for it a few times, but they never fall asleep while a task is queued.
+    m_queued_tasks.fetch_add(1);
+
+    // Workers keep their own work close, everyone else spreads it out over all deques.
+    if (s_current_pool == this)
+        m_deques[s_current_worker_index]->push_back(move(task));
+    else
+        m_deques[m_next_deque.fetch_add(1, AK::MemoryOrder::memory_order_relaxed) % m_deques.size()]->push_back(move(task));
+
+    // NOTE: Both this and the sleeping worker use sequentially consistent accesses to the two counters,
+    //       so either we see the sleeping worker here, or it sees the task we just queued.
+    if (m_sleeping_workers.load() > 0 || m_waiting_helpers.load() > 0) {
+        MutexLocker locker(m_mutex);
+        m_work_available.signal();
+        m_progress_made.broadcast();
+    }
+}
+
+Optional<WorkStealingThreadPool::Task> WorkStealingThreadPool::find_task()
+{
+    if (m_queued_tasks.load(AK::MemoryOrder::memory_order_relaxed) == 0)
+        return {};
+
+    bool is_worker = s_current_pool == this;
+    size_t first_victim = 0;
+    if (is_worker) {
+        if (auto task = m_deques[s_current_worker_index]->pop_back(); task.has_value())
+            return task;
+        first_victim = s_current_worker_index + 1;
+    } else {
+        first_victim = m_next_deque.load(AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < m_deques.size(); ++i) {
+        auto victim = (first_victim + i) % m_deques.size();
+        if (is_worker && victim == s_current_worker_index)
+            continue;
+        if (auto task = m_deques[victim]->steal_front(); task.has_value()) {
+            m_steal_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    return {};
+}
+
+bool WorkStealingThreadPool::run_one_task()
+{
+    auto task = find_task();
+    if (!task.has_value())
+        return false;
+
+    m_queued_tasks.fetch_sub(1);
+    (*task)();
+    m_unfinished_tasks.fetch_sub(1);
+
+    // Anyone blocked in help_until() may be waiting for exactly this task to finish.
+    if (m_waiting_helpers.load() > 0) {
+        MutexLocker locker(m_mutex);
+        m_progress_made.broadcast();
+    }
+    return true;
+}
+
+void WorkStealingThreadPool::help_until(Function<bool()> is_done)
+{
+    while (!is_done()) {
+        if (run_one_task())
+            continue;
+
+        // Nothing to steal, so sleep until a task is queued or finishes, either of which may get us closer to done.
+        // NOTE: As in submit(), the counter and the state checked here are accessed with sequentially consistent
+        //       operations, so either the thread making progress sees us waiting, or we see its progress.
+        MutexLocker locker(m_mutex);
+        m_waiting_helpers.fetch_add(1);
+        while (m_queued_tasks.load() == 0 && !is_done())
+            m_progress_made.wait();
+        m_waiting_helpers.fetch_sub(1);
+    }
+}
+
+void WorkStealingThreadPool::wait_for_all()
+{
+    VERIFY(s_current_pool != this);
+    help_until([this] { return m_unfinished_tasks.load() == 0; });
+}
+
+void WorkStealingThreadPool::worker_loop(size_t worker_index)
+{
+    s_current_pool = this;
+    s_current_worker_index = worker_index;
+
+#ifdef AK_OS_SERENITY
+    // Ask for a processor of our own, so the tasks we push and pop stay in its caches.
+    // This is only a hint, the kernel still moves us elsewhere when this processor is busy.
+    (void)prctl(PR_SET_THREAD_PREFERRED_CPU, gettid(), worker_index % Core::System::hardware_concurrency(), 0);
+#endif
+
+    while (true) {
+        if (run_one_task())
+            continue;
+
+        MutexLocker locker(m_mutex);
+        m_sleeping_workers.fetch_add(1);
+        while (m_queued_tasks.load() == 0 && !m_should_exit.load())
+            m_work_available.wait();
+        m_sleeping_workers.fetch_sub(1);
+
+        if (m_should_exit.load() && m_queued_tasks.load() == 0)
+            return;
+    }
+}
+
+}
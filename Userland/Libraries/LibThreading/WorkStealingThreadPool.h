@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Function.h>
+#include <AK/IntegralMath.h>
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Vector.h>
+#include <LibThreading/ConditionVariable.h>
+#include <LibThreading/Mutex.h>
+#include <LibThreading/Thread.h>
+
+namespace Threading {
+
+// A pool of worker threads that each own a deque of tasks. Workers push and pop tasks at the back of
+// their own deque, and steal from the front of other workers' deques once they run out of work, so
+// fine-grained tasks don't all contend on a single queue.
+class WorkStealingThreadPool {
+    AK_MAKE_NONCOPYABLE(WorkStealingThreadPool);
+    AK_MAKE_NONMOVABLE(WorkStealingThreadPool);
+
+public:
+    using Task = Function<void()>;
+
+    explicit WorkStealingThreadPool(Optional<size_t> concurrency = {});
+    ~WorkStealingThreadPool();
+
+    // A lazily created pool with one worker per hardware thread.
+    static WorkStealingThreadPool& the();
+
+    size_t worker_count() const { return m_workers.size(); }
+    u64 steal_count() const { return m_steal_count.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    void submit(Task);
+
+    // Blocks until every submitted task has finished, running tasks on the calling thread while waiting.
+    // NOTE: This must not be called from within a task, use the fork/join helpers below instead.
+    void wait_for_all();
+
+    // Splits [0, count) into chunks of at least `grain_size` indices, and calls `callback(begin, end)` for each
+    // of them in parallel. The calling thread runs chunks itself until all of them are done, so this may be
+    // nested inside tasks running on the pool.
+    template<typename Callback>
+    void parallel_for_range(size_t count, Callback callback, size_t grain_size = 1)
+    {
+        auto chunk_size = chunk_size_for(count, grain_size);
+        if (chunk_size == 0)
+            return;
+
+        auto chunk_count = ceil_div(count, chunk_size);
+        if (chunk_count == 1) {
+            callback(0, count);
+            return;
+        }
+
+        Atomic<size_t> remaining_chunks { chunk_count };
+        for (size_t chunk = 1; chunk < chunk_count; ++chunk) {
+            auto begin = chunk * chunk_size;
+            auto end = min(begin + chunk_size, count);
+            submit([&callback, &remaining_chunks, begin, end] {
+                callback(begin, end);
+                remaining_chunks.fetch_sub(1);
+            });
+        }
+
+        callback(0, chunk_size);
+        remaining_chunks.fetch_sub(1);
+
+        help_until([&] { return remaining_chunks.load() == 0; });
+    }
+
+    // Calls `callback(item)` for every item, in parallel.
+    template<typename T, typename Callback>
+    void parallel_for(Span<T> items, Callback callback, size_t grain_size = 1)
+    {
+        parallel_for_range(
+            items.size(), [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                    callback(items[i]);
+            },
+            grain_size);
+    }
+
+    // Folds each chunk of `items` with `fold(accumulator, item)` starting from `identity`, then combines the
+    // per-chunk results from left to right with `combine(left, right)`. As long as `combine` is associative,
+    // the result doesn't depend on how the items were split up.
+    template<typename T, typename R, typename Fold, typename Combine>
+    R parallel_reduce(Span<T> items, R identity, Fold fold, Combine combine, size_t grain_size = 1)
+    {
+        auto chunk_size = chunk_size_for(items.size(), grain_size);
+        if (chunk_size == 0)
+            return identity;
+
+        auto chunk_count = ceil_div(items.size(), chunk_size);
+        Vector<R> partial_results;
+        partial_results.ensure_capacity(chunk_count);
+        for (size_t i = 0; i < chunk_count; ++i)
+            partial_results.unchecked_append(identity);
+
+        parallel_for_range(chunk_count, [&](size_t first_chunk, size_t end_chunk) {
+            for (size_t chunk = first_chunk; chunk < end_chunk; ++chunk) {
+                auto& accumulator = partial_results[chunk];
+                auto end = min((chunk + 1) * chunk_size, items.size());
+                for (size_t i = chunk * chunk_size; i < end; ++i)
+                    accumulator = fold(move(accumulator), items[i]);
+            }
+        });
+
+        R result = move(identity);
+        for (auto& partial_result : partial_results)
+            result = combine(move(result), move(partial_result));
+        return result;
+    }
+
+private:
+    // NOTE: Each deque is protected by its own mutex rather than being a lock-free Chase-Lev deque, since any thread
+    //       may submit() into any of them. Contention stays low because every worker mostly touches its own deque.
+    class TaskDeque {
+    public:
+        void push_back(Task);
+        Optional<Task> pop_back();
+        Optional<Task> steal_front();
+
+    private:
+        Mutex m_mutex;
+        Vector<Task> m_tasks;
+        size_t m_head { 0 };
+    };
+
+    size_t chunk_size_for(size_t count, size_t grain_size) const;
+
+    void worker_loop(size_t worker_index);
+    bool run_one_task();
+    Optional<Task> find_task();
+    void help_until(Function<bool()> is_done);
+
+    Vector<NonnullRefPtr<Thread>> m_workers;
+    Vector<NonnullOwnPtr<TaskDeque>> m_deques;
+
+    // Tasks that are sitting in a deque, and tasks that have been submitted but haven't finished yet.
+    Atomic<size_t> m_queued_tasks { 0 };
+    Atomic<size_t> m_unfinished_tasks { 0 };
+
+    Atomic<size_t> m_next_deque { 0 };
+    Atomic<u64> m_steal_count { 0 };
+
+    Mutex m_mutex;
+    ConditionVariable m_work_available;
+    Atomic<size_t> m_sleeping_workers { 0 };
+
+    // Signaled whenever a task is queued or finishes, for threads blocked in help_until().
+    ConditionVariable m_progress_made;
+    Atomic<size_t> m_waiting_helpers { 0 };
+    Atomic<bool> m_should_exit { false };
+};
+
+}
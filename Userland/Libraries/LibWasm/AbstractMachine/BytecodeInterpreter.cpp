@@ -15,6 +15,7 @@
 #include <LibWasm/AbstractMachine/BytecodeInterpreter.h>
 #include <LibWasm/AbstractMachine/Configuration.h>
 #include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/AbstractMachine/SIMDKernels.h>
 #include <LibWasm/Opcode.h>
 #include <LibWasm/Printer/Printer.h>
 
@@ -30,6 +31,295 @@ namespace Wasm {
         }                                                                                      \
     } while (false)
 
+#define ENUMERATE_I32_COMPARISONS(M) \
+    M(i32_eq, ==, i32)               \
+    M(i32_ne, !=, i32)               \
+    M(i32_lts, <, i32)               \
+    M(i32_ltu, <, u32)               \
+    M(i32_gts, >, i32)               \
+    M(i32_gtu, >, u32)               \
+    M(i32_les, <=, i32)              \
+    M(i32_leu, <=, u32)              \
+    M(i32_ges, >=, i32)              \
+    M(i32_geu, >=, u32)
+
+// Everything not listed here goes through interpret_instruction().
+#define ENUMERATE_THREADED_HANDLERS(M)       \
+    M(generic)                               \
+    M(finished)                              \
+    M(nop)                                   \
+    M(local_get)                             \
+    M(local_set)                             \
+    M(local_tee)                             \
+    M(i32_const)                             \
+    M(i64_const)                             \
+    M(i32_add)                               \
+    M(i32_sub)                               \
+    M(i32_and)                               \
+    M(i32_or)                                \
+    M(i32_xor)                               \
+    M(i32_eqz)                               \
+    M(br)                                    \
+    M(br_if)                                 \
+    M(br_table)                              \
+    M(structured_end)                        \
+    M(local_get_local_set)                   \
+    M(i32_const_local_set)                   \
+    M(local_get_local_get_i32_add)           \
+    M(local_get_local_get_i32_add_local_set) \
+    M(local_get_i32_const_i32_add)           \
+    M(local_get_i32_const_i32_add_local_set) \
+    M(i32_eqz_br_if)                         \
+    M(simd_binary_kernel)                    \
+    M(simd_unary_kernel)                     \
+    M(simd_mask_kernel)
+
+enum class ThreadedHandler : u8 {
+#define M(name) name,
+    ENUMERATE_THREADED_HANDLERS(M)
+#undef M
+#define M(name, ...) name, name##_br_if,
+    ENUMERATE_I32_COMPARISONS(M)
+#undef M
+    Count,
+};
+
+static void compile_instructions(Expression const& expression, ReadonlySpan<void*> handlers, Vector<FunctionType> const& types, size_t frame_arity)
+{
+    auto& instructions = expression.instructions();
+    auto& compiled = expression.compiled_instructions();
+    compiled.ensure_capacity(instructions.size() + 1);
+
+    // Superinstructions must not swallow an instruction that something can branch to.
+    Vector<bool> is_branch_target;
+    is_branch_target.resize(instructions.size() + 2);
+    for (size_t ip = 0; ip < instructions.size(); ++ip) {
+        auto* args = instructions[ip].arguments().get_pointer<Instruction::StructuredInstructionArgs>();
+        if (!args)
+            continue;
+        if (instructions[ip].opcode() == Instructions::loop)
+            is_branch_target[ip + 1] = true;
+        is_branch_target[args->end_ip.value()] = true;
+        is_branch_target[args->end_ip.value() + 1] = true;
+        if (args->else_ip.has_value())
+            is_branch_target[args->else_ip->value()] = true;
+    }
+
+    auto matches = [&](size_t ip, auto... sequence) {
+        OpCode const opcodes[] { sequence... };
+        if (ip + array_size(opcodes) > instructions.size())
+            return false;
+        for (size_t i = 0; i < array_size(opcodes); ++i) {
+            if (i != 0 && is_branch_target[ip + i])
+                return false;
+            if (instructions[ip + i].opcode() != opcodes[i])
+                return false;
+        }
+        return true;
+    };
+    auto local_index = [&](size_t ip) { return static_cast<u32>(instructions[ip].arguments().get<LocalIndex>().value()); };
+    auto i32_immediate = [&](size_t ip) { return static_cast<i64>(instructions[ip].arguments().get<i32>()); };
+
+    // Resolve the continuation and arity of every branch up front, so taking it doesn't have to look at its label.
+    // NOTE: The stack height still comes from the label at run time, since it depends on how deep the value stack
+    //       was when the block was entered.
+    auto& branch_targets = expression.compiled_branch_targets();
+    Vector<size_t> enclosing_blocks;
+    auto result_arity = [&](BlockType const& block_type) -> u32 {
+        switch (block_type.kind()) {
+        case BlockType::Empty:
+            return 0;
+        case BlockType::Type:
+            return 1;
+        case BlockType::Index:
+            return types[block_type.type_index().value()].results().size();
+        }
+        VERIFY_NOT_REACHED();
+    };
+    auto parameter_arity = [&](BlockType const& block_type) -> u32 {
+        if (block_type.kind() != BlockType::Index)
+            return 0;
+        return types[block_type.type_index().value()].parameters().size();
+    };
+    auto add_branch_target = [&](LabelIndex label) {
+        auto index = static_cast<u32>(branch_targets.size());
+        CompiledBranchTarget target { .labels_to_drop = static_cast<u32>(label.value()) };
+        if (label.value() >= enclosing_blocks.size()) {
+            // This leaves the function.
+            target.arity = frame_arity;
+            target.continuation = instructions.size();
+        } else {
+            auto block_ip = enclosing_blocks[enclosing_blocks.size() - label.value() - 1];
+            auto& args = instructions[block_ip].arguments().get<Instruction::StructuredInstructionArgs>();
+            if (instructions[block_ip].opcode() == Instructions::loop) {
+                target.arity = parameter_arity(args.block_type);
+                target.continuation = block_ip + 1;
+            } else {
+                target.arity = result_arity(args.block_type);
+                target.continuation = args.end_ip.value();
+            }
+        }
+        branch_targets.append(target);
+        return index;
+    };
+
+    for (size_t ip = 0; ip < instructions.size(); ++ip) {
+        auto& instruction = instructions[ip];
+        CompiledInstruction entry;
+        auto handler = ThreadedHandler::generic;
+
+        switch (instruction.opcode().value()) {
+        case Instructions::nop.value():
+            handler = ThreadedHandler::nop;
+            break;
+        case Instructions::local_get.value():
+            entry.operands[0] = local_index(ip);
+            if (matches(ip, Instructions::local_get, Instructions::local_get, Instructions::i32_add, Instructions::local_set)) {
+                handler = ThreadedHandler::local_get_local_get_i32_add_local_set;
+                entry.operands[1] = local_index(ip + 1);
+                entry.operands[2] = local_index(ip + 3);
+                entry.length = 4;
+            } else if (matches(ip, Instructions::local_get, Instructions::local_get, Instructions::i32_add)) {
+                handler = ThreadedHandler::local_get_local_get_i32_add;
+                entry.operands[1] = local_index(ip + 1);
+                entry.length = 3;
+            } else if (matches(ip, Instructions::local_get, Instructions::i32_const, Instructions::i32_add, Instructions::local_set)) {
+                handler = ThreadedHandler::local_get_i32_const_i32_add_local_set;
+                entry.immediate = i32_immediate(ip + 1);
+                entry.operands[2] = local_index(ip + 3);
+                entry.length = 4;
+            } else if (matches(ip, Instructions::local_get, Instructions::i32_const, Instructions::i32_add)) {
+                handler = ThreadedHandler::local_get_i32_const_i32_add;
+                entry.immediate = i32_immediate(ip + 1);
+                entry.length = 3;
+            } else if (matches(ip, Instructions::local_get, Instructions::local_set)) {
+                handler = ThreadedHandler::local_get_local_set;
+                entry.operands[1] = local_index(ip + 1);
+                entry.length = 2;
+            } else {
+                handler = ThreadedHandler::local_get;
+            }
+            break;
+        case Instructions::local_set.value():
+            handler = ThreadedHandler::local_set;
+            entry.operands[0] = local_index(ip);
+            break;
+        case Instructions::local_tee.value():
+            handler = ThreadedHandler::local_tee;
+            entry.operands[0] = local_index(ip);
+            break;
+        case Instructions::i32_const.value():
+            entry.immediate = i32_immediate(ip);
+            if (matches(ip, Instructions::i32_const, Instructions::local_set)) {
+                handler = ThreadedHandler::i32_const_local_set;
+                entry.operands[0] = local_index(ip + 1);
+                entry.length = 2;
+            } else {
+                handler = ThreadedHandler::i32_const;
+            }
+            break;
+        case Instructions::i64_const.value():
+            handler = ThreadedHandler::i64_const;
+            entry.immediate = instruction.arguments().get<i64>();
+            break;
+        case Instructions::i32_add.value():
+            handler = ThreadedHandler::i32_add;
+            break;
+        case Instructions::i32_sub.value():
+            handler = ThreadedHandler::i32_sub;
+            break;
+        case Instructions::i32_and.value():
+            handler = ThreadedHandler::i32_and;
+            break;
+        case Instructions::i32_or.value():
+            handler = ThreadedHandler::i32_or;
+            break;
+        case Instructions::i32_xor.value():
+            handler = ThreadedHandler::i32_xor;
+            break;
+        case Instructions::i32_eqz.value():
+            if (matches(ip, Instructions::i32_eqz, Instructions::br_if)) {
+                handler = ThreadedHandler::i32_eqz_br_if;
+                entry.operands[0] = add_branch_target(instructions[ip + 1].arguments().get<LabelIndex>());
+                entry.length = 2;
+            } else {
+                handler = ThreadedHandler::i32_eqz;
+            }
+            break;
+#define M(name, ...)                                                                                   \
+    case Instructions::name.value():                                                                   \
+        if (matches(ip, Instructions::name, Instructions::br_if)) {                                    \
+            handler = ThreadedHandler::name##_br_if;                                                   \
+            entry.operands[0] = add_branch_target(instructions[ip + 1].arguments().get<LabelIndex>()); \
+            entry.length = 2;                                                                          \
+        } else {                                                                                       \
+            handler = ThreadedHandler::name;                                                           \
+        }                                                                                              \
+        break;
+            ENUMERATE_I32_COMPARISONS(M)
+#undef M
+#define M(name, ...)                                                \
+    case Instructions::name.value():                                \
+        handler = ThreadedHandler::simd_binary_kernel;              \
+        entry.binary_kernel = SIMDKernels::dispatched_kernels.name; \
+        break;
+            ENUMERATE_BINARY_SIMD_KERNELS(M)
+#undef M
+#define M(name, ...)                                               \
+    case Instructions::name.value():                               \
+        handler = ThreadedHandler::simd_unary_kernel;              \
+        entry.unary_kernel = SIMDKernels::dispatched_kernels.name; \
+        break;
+            ENUMERATE_UNARY_SIMD_KERNELS(M)
+#undef M
+#define M(name, ...)                                              \
+    case Instructions::name.value():                              \
+        handler = ThreadedHandler::simd_mask_kernel;              \
+        entry.mask_kernel = SIMDKernels::dispatched_kernels.name; \
+        break;
+            ENUMERATE_MASK_SIMD_KERNELS(M)
+#undef M
+        case Instructions::br.value():
+            handler = ThreadedHandler::br;
+            entry.operands[0] = add_branch_target(instruction.arguments().get<LabelIndex>());
+            break;
+        case Instructions::br_if.value():
+            handler = ThreadedHandler::br_if;
+            entry.operands[0] = add_branch_target(instruction.arguments().get<LabelIndex>());
+            break;
+        case Instructions::br_table.value(): {
+            // The targets are stored next to each other, with the default one last.
+            auto& args = instruction.arguments().get<Instruction::TableBranchArgs>();
+            handler = ThreadedHandler::br_table;
+            entry.operands[0] = static_cast<u32>(branch_targets.size());
+            entry.operands[1] = static_cast<u32>(args.labels.size());
+            for (auto label : args.labels)
+                add_branch_target(label);
+            add_branch_target(args.default_);
+            break;
+        }
+        case Instructions::structured_end.value():
+            handler = ThreadedHandler::structured_end;
+            if (!enclosing_blocks.is_empty())
+                enclosing_blocks.take_last();
+            break;
+        case Instructions::block.value():
+        case Instructions::loop.value():
+        case Instructions::if_.value():
+            enclosing_blocks.append(ip);
+            break;
+        default:
+            break;
+        }
+
+        entry.handler = handlers[to_underlying(handler)];
+        compiled.unchecked_append(entry);
+    }
+
+    // Branching or returning out of the function leaves the instruction pointer at the end, so stop there.
+    compiled.unchecked_append(CompiledInstruction { .handler = handlers[to_underlying(ThreadedHandler::finished)] });
+}
+
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
@@ -39,6 +329,10 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     auto const should_limit_instruction_count = configuration.should_limit_instruction_count();
     u64 executed_instructions = 0;
 
+    // Superinstructions would throw off both the instruction count and the trace, so run those one by one.
+    if (!should_limit_instruction_count && !WASM_TRACE_DEBUG)
+        return interpret_threaded(configuration);
+
     while (current_ip_value < max_ip_value) {
         if (should_limit_instruction_count) {
             if (executed_instructions++ >= Constants::max_allowed_executed_instructions_per_call) [[unlikely]] {
@@ -56,6 +350,191 @@ void BytecodeInterpreter::interpret(Configuration& configuration)
     }
 }
 
+// Runs the pre-decoded form of the current expression, jumping straight from one handler to the next.
+// Handlers for common instructions (and superinstructions fused from common sequences, which work on locals
+// directly instead of going through the value stack) are implemented inline, the rest fall back to interpret_instruction().
+void BytecodeInterpreter::interpret_threaded(Configuration& configuration)
+{
+    static void* const handlers[] = {
+#define M(name) &&handle_##name,
+        ENUMERATE_THREADED_HANDLERS(M)
+#undef M
+#define M(name, ...) &&handle_##name, &&handle_##name##_br_if,
+        ENUMERATE_I32_COMPARISONS(M)
+#undef M
+    };
+    static_assert(array_size(handlers) == to_underlying(ThreadedHandler::Count));
+
+    auto& expression = configuration.frame().expression();
+    if (expression.compiled_instructions().is_empty())
+        compile_instructions(expression, { handlers, array_size(handlers) }, configuration.frame().module().types(), configuration.frame().arity());
+
+    auto& instructions = expression.instructions();
+    auto const* compiled = expression.compiled_instructions().data();
+    auto const* branch_targets = expression.compiled_branch_targets().data();
+    auto& stack = configuration.value_stack();
+    auto* locals = configuration.frame().locals().data();
+    size_t ip = configuration.ip().value();
+
+#define DISPATCH() goto* compiled[ip].handler
+#define DISPATCH_NEXT()            \
+    do {                           \
+        ip += compiled[ip].length; \
+        DISPATCH();                \
+    } while (false)
+#define BRANCH_TO(target_index)                                                 \
+    do {                                                                        \
+        auto& target = branch_targets[(target_index)];                          \
+        auto& labels = configuration.label_stack();                             \
+        labels.shrink(labels.size() - target.labels_to_drop, true);             \
+        auto stack_height = labels.last().stack_height();                       \
+        stack.remove(stack_height, stack.size() - stack_height - target.arity); \
+        ip = target.continuation;                                               \
+        DISPATCH();                                                             \
+    } while (false)
+
+    DISPATCH();
+
+handle_generic: {
+    configuration.ip() = ip;
+    interpret_instruction(configuration, configuration.ip(), instructions[ip]);
+    if (did_trap())
+        return;
+    // Calls may have moved the frame stack around.
+    locals = configuration.frame().locals().data();
+    auto new_ip = configuration.ip().value();
+    ip = new_ip == ip ? ip + 1 : new_ip;
+    DISPATCH();
+}
+handle_finished:
+    configuration.ip() = ip;
+    return;
+handle_nop:
+    DISPATCH_NEXT();
+handle_local_get:
+    stack.append(locals[compiled[ip].operands[0]]);
+    DISPATCH_NEXT();
+handle_local_set:
+    locals[compiled[ip].operands[0]] = stack.take_last();
+    DISPATCH_NEXT();
+handle_local_tee:
+    locals[compiled[ip].operands[0]] = stack.last();
+    DISPATCH_NEXT();
+handle_i32_const:
+    stack.append(Value(static_cast<i32>(compiled[ip].immediate)));
+    DISPATCH_NEXT();
+handle_i64_const:
+    stack.append(Value(compiled[ip].immediate));
+    DISPATCH_NEXT();
+
+#define HANDLE_I32_BINARY_OPERATION(name, operation)                \
+    handle_##name:                                                  \
+    {                                                               \
+        auto rhs = stack.take_last().to<u32>();                     \
+        auto& lhs = stack.last();                                   \
+        lhs = Value(static_cast<i32>(lhs.to<u32>() operation rhs)); \
+        DISPATCH_NEXT();                                            \
+    }
+    HANDLE_I32_BINARY_OPERATION(i32_add, +)
+    HANDLE_I32_BINARY_OPERATION(i32_sub, -)
+    HANDLE_I32_BINARY_OPERATION(i32_and, &)
+    HANDLE_I32_BINARY_OPERATION(i32_or, |)
+    HANDLE_I32_BINARY_OPERATION(i32_xor, ^)
+#undef HANDLE_I32_BINARY_OPERATION
+
+handle_i32_eqz: {
+    auto& value = stack.last();
+    value = Value(static_cast<i32>(value.to<i32>() == 0));
+    DISPATCH_NEXT();
+}
+handle_i32_eqz_br_if:
+    if (stack.take_last().to<i32>() == 0)
+        BRANCH_TO(compiled[ip].operands[0]);
+    DISPATCH_NEXT();
+
+#define M(name, operation, type)                                     \
+    handle_##name:                                                   \
+    {                                                                \
+        auto rhs = stack.take_last().to<type>();                     \
+        auto& lhs = stack.last();                                    \
+        lhs = Value(static_cast<i32>(lhs.to<type>() operation rhs)); \
+        DISPATCH_NEXT();                                             \
+    }                                                                \
+    handle_##name##_br_if:                                           \
+    {                                                                \
+        auto rhs = stack.take_last().to<type>();                     \
+        auto lhs = stack.take_last().to<type>();                     \
+        if (lhs operation rhs)                                       \
+            BRANCH_TO(compiled[ip].operands[0]);                     \
+        DISPATCH_NEXT();                                             \
+    }
+    ENUMERATE_I32_COMPARISONS(M)
+#undef M
+
+handle_br:
+    BRANCH_TO(compiled[ip].operands[0]);
+handle_br_if:
+    if (stack.take_last().to<i32>() != 0)
+        BRANCH_TO(compiled[ip].operands[0]);
+    DISPATCH_NEXT();
+handle_br_table: {
+    auto& entry = compiled[ip];
+    auto index = stack.take_last().to<u32>();
+    BRANCH_TO(entry.operands[0] + min(index, entry.operands[1]));
+}
+handle_structured_end:
+    configuration.label_stack().take_last();
+    DISPATCH_NEXT();
+
+handle_local_get_local_set:
+    locals[compiled[ip].operands[1]] = locals[compiled[ip].operands[0]];
+    DISPATCH_NEXT();
+handle_i32_const_local_set:
+    locals[compiled[ip].operands[0]] = Value(static_cast<i32>(compiled[ip].immediate));
+    DISPATCH_NEXT();
+handle_local_get_local_get_i32_add: {
+    auto& entry = compiled[ip];
+    stack.append(Value(static_cast<i32>(locals[entry.operands[0]].to<u32>() + locals[entry.operands[1]].to<u32>())));
+    DISPATCH_NEXT();
+}
+handle_local_get_local_get_i32_add_local_set: {
+    auto& entry = compiled[ip];
+    locals[entry.operands[2]] = Value(static_cast<i32>(locals[entry.operands[0]].to<u32>() + locals[entry.operands[1]].to<u32>()));
+    DISPATCH_NEXT();
+}
+handle_local_get_i32_const_i32_add: {
+    auto& entry = compiled[ip];
+    stack.append(Value(static_cast<i32>(locals[entry.operands[0]].to<u32>() + static_cast<u32>(entry.immediate))));
+    DISPATCH_NEXT();
+}
+handle_local_get_i32_const_i32_add_local_set: {
+    auto& entry = compiled[ip];
+    locals[entry.operands[2]] = Value(static_cast<i32>(locals[entry.operands[0]].to<u32>() + static_cast<u32>(entry.immediate)));
+    DISPATCH_NEXT();
+}
+
+handle_simd_binary_kernel: {
+    auto rhs = stack.take_last().to<u128>();
+    auto& lhs = stack.last();
+    lhs = Value(compiled[ip].binary_kernel(lhs.to<u128>(), rhs));
+    DISPATCH_NEXT();
+}
+handle_simd_unary_kernel: {
+    auto& value = stack.last();
+    value = Value(compiled[ip].unary_kernel(value.to<u128>()));
+    DISPATCH_NEXT();
+}
+handle_simd_mask_kernel: {
+    auto& value = stack.last();
+    value = Value(compiled[ip].mask_kernel(value.to<u128>()));
+    DISPATCH_NEXT();
+}
+
+#undef BRANCH_TO
+#undef DISPATCH_NEXT
+#undef DISPATCH
+}
+
 void BytecodeInterpreter::branch_to_label(Configuration& configuration, LabelIndex index)
 {
     dbgln_if(WASM_TRACE_DEBUG, "Branch to label with index {}...", index.value());
@@ -1235,7 +1714,7 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     case Instructions::i64x2_shr_s.value():
         return binary_numeric_operation<u128, u128, Operators::VectorShiftRight<2, MakeSigned>, i32>(configuration);
     case Instructions::i8x16_swizzle.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorSwizzle>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_swizzle>>(configuration);
     case Instructions::i8x16_extract_lane_s.value():
         return unary_operation<u128, i8, Operators::VectorExtractLane<16, MakeSigned>>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
     case Instructions::i8x16_extract_lane_u.value():
@@ -1265,217 +1744,217 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     case Instructions::f64x2_replace_lane.value():
         return binary_numeric_operation<u128, u128, Operators::VectorReplaceLane<2, double>, double>(configuration, instruction.arguments().get<Instruction::LaneIndex>().lane);
     case Instructions::i8x16_eq.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::Equals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_eq>>(configuration);
     case Instructions::i8x16_ne.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::NotEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_ne>>(configuration);
     case Instructions::i8x16_lt_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::LessThan, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_lt_s>>(configuration);
     case Instructions::i8x16_lt_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::LessThan, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_lt_u>>(configuration);
     case Instructions::i8x16_gt_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::GreaterThan, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_gt_s>>(configuration);
     case Instructions::i8x16_gt_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::GreaterThan, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_gt_u>>(configuration);
     case Instructions::i8x16_le_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::LessThanOrEquals, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_le_s>>(configuration);
     case Instructions::i8x16_le_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::LessThanOrEquals, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_le_u>>(configuration);
     case Instructions::i8x16_ge_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::GreaterThanOrEquals, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_ge_s>>(configuration);
     case Instructions::i8x16_ge_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<16, Operators::GreaterThanOrEquals, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_ge_u>>(configuration);
     case Instructions::i8x16_abs.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::Absolute>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_abs>>(configuration);
     case Instructions::i8x16_neg.value():
         return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::Negate>>(configuration);
     case Instructions::i8x16_all_true.value():
-        return unary_operation<u128, i32, Operators::VectorAllTrue<16>>(configuration);
+        return unary_operation<u128, i32, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_all_true>>(configuration);
     case Instructions::i8x16_popcnt.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<16, Operators::PopCount>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_popcnt>>(configuration);
     case Instructions::i8x16_add.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Add>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_add>>(configuration);
     case Instructions::i8x16_sub.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Subtract>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_sub>>(configuration);
     case Instructions::i8x16_avgr_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Average, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_avgr_u>>(configuration);
     case Instructions::i8x16_add_sat_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Add>, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_add_sat_s>>(configuration);
     case Instructions::i8x16_add_sat_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Add>, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_add_sat_u>>(configuration);
     case Instructions::i8x16_sub_sat_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Subtract>, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_sub_sat_s>>(configuration);
     case Instructions::i8x16_sub_sat_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Subtract>, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_sub_sat_u>>(configuration);
     case Instructions::i8x16_min_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Minimum, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_min_s>>(configuration);
     case Instructions::i8x16_min_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Minimum, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_min_u>>(configuration);
     case Instructions::i8x16_max_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Maximum, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_max_s>>(configuration);
     case Instructions::i8x16_max_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<16, Operators::Maximum, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_max_u>>(configuration);
     case Instructions::i16x8_eq.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::Equals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_eq>>(configuration);
     case Instructions::i16x8_ne.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::NotEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_ne>>(configuration);
     case Instructions::i16x8_lt_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::LessThan, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_lt_s>>(configuration);
     case Instructions::i16x8_lt_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::LessThan, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_lt_u>>(configuration);
     case Instructions::i16x8_gt_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::GreaterThan, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_gt_s>>(configuration);
     case Instructions::i16x8_gt_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::GreaterThan, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_gt_u>>(configuration);
     case Instructions::i16x8_le_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::LessThanOrEquals, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_le_s>>(configuration);
     case Instructions::i16x8_le_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::LessThanOrEquals, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_le_u>>(configuration);
     case Instructions::i16x8_ge_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::GreaterThanOrEquals, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_ge_s>>(configuration);
     case Instructions::i16x8_ge_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<8, Operators::GreaterThanOrEquals, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_ge_u>>(configuration);
     case Instructions::i16x8_abs.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<8, Operators::Absolute>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_abs>>(configuration);
     case Instructions::i16x8_neg.value():
         return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<8, Operators::Negate>>(configuration);
     case Instructions::i16x8_all_true.value():
-        return unary_operation<u128, i32, Operators::VectorAllTrue<8>>(configuration);
+        return unary_operation<u128, i32, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_all_true>>(configuration);
     case Instructions::i16x8_add.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Add>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_add>>(configuration);
     case Instructions::i16x8_sub.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Subtract>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_sub>>(configuration);
     case Instructions::i16x8_mul.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Multiply>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_mul>>(configuration);
     case Instructions::i16x8_avgr_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Average, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_avgr_u>>(configuration);
     case Instructions::i16x8_add_sat_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Add>, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_add_sat_s>>(configuration);
     case Instructions::i16x8_add_sat_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Add>, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_add_sat_u>>(configuration);
     case Instructions::i16x8_sub_sat_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Subtract>, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_sub_sat_s>>(configuration);
     case Instructions::i16x8_sub_sat_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Subtract>, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_sub_sat_u>>(configuration);
     case Instructions::i16x8_min_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Minimum, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_min_s>>(configuration);
     case Instructions::i16x8_min_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Minimum, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_min_u>>(configuration);
     case Instructions::i16x8_max_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Maximum, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_max_s>>(configuration);
     case Instructions::i16x8_max_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::Maximum, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_max_u>>(configuration);
     case Instructions::i16x8_extend_low_i8x16_s.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<8, Operators::VectorExt::Low, MakeSigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extend_low_i8x16_s>>(configuration);
     case Instructions::i16x8_extend_high_i8x16_s.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<8, Operators::VectorExt::High, MakeSigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extend_high_i8x16_s>>(configuration);
     case Instructions::i16x8_extend_low_i8x16_u.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<8, Operators::VectorExt::Low, MakeUnsigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extend_low_i8x16_u>>(configuration);
     case Instructions::i16x8_extend_high_i8x16_u.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<8, Operators::VectorExt::High, MakeUnsigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extend_high_i8x16_u>>(configuration);
     case Instructions::i16x8_extadd_pairwise_i8x16_s.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeSigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extadd_pairwise_i8x16_s>>(configuration);
     case Instructions::i16x8_extadd_pairwise_i8x16_u.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeUnsigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extadd_pairwise_i8x16_u>>(configuration);
     case Instructions::i16x8_extmul_low_i8x16_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extmul_low_i8x16_s>>(configuration);
     case Instructions::i16x8_extmul_high_i8x16_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::High, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extmul_high_i8x16_s>>(configuration);
     case Instructions::i16x8_extmul_low_i8x16_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::Low, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extmul_low_i8x16_u>>(configuration);
     case Instructions::i16x8_extmul_high_i8x16_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_extmul_high_i8x16_u>>(configuration);
     case Instructions::i32x4_eq.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::Equals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_eq>>(configuration);
     case Instructions::i32x4_ne.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::NotEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_ne>>(configuration);
     case Instructions::i32x4_lt_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::LessThan, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_lt_s>>(configuration);
     case Instructions::i32x4_lt_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::LessThan, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_lt_u>>(configuration);
     case Instructions::i32x4_gt_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::GreaterThan, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_gt_s>>(configuration);
     case Instructions::i32x4_gt_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::GreaterThan, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_gt_u>>(configuration);
     case Instructions::i32x4_le_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::LessThanOrEquals, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_le_s>>(configuration);
     case Instructions::i32x4_le_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::LessThanOrEquals, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_le_u>>(configuration);
     case Instructions::i32x4_ge_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::GreaterThanOrEquals, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_ge_s>>(configuration);
     case Instructions::i32x4_ge_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<4, Operators::GreaterThanOrEquals, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_ge_u>>(configuration);
     case Instructions::i32x4_abs.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<4, Operators::Absolute>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_abs>>(configuration);
     case Instructions::i32x4_neg.value():
         return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<4, Operators::Negate, MakeUnsigned>>(configuration);
     case Instructions::i32x4_all_true.value():
-        return unary_operation<u128, i32, Operators::VectorAllTrue<4>>(configuration);
+        return unary_operation<u128, i32, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_all_true>>(configuration);
     case Instructions::i32x4_add.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Add, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_add>>(configuration);
     case Instructions::i32x4_sub.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Subtract, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_sub>>(configuration);
     case Instructions::i32x4_mul.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Multiply, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_mul>>(configuration);
     case Instructions::i32x4_min_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Minimum, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_min_s>>(configuration);
     case Instructions::i32x4_min_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Minimum, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_min_u>>(configuration);
     case Instructions::i32x4_max_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Maximum, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_max_s>>(configuration);
     case Instructions::i32x4_max_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<4, Operators::Maximum, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_max_u>>(configuration);
     case Instructions::i32x4_extend_low_i16x8_s.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<4, Operators::VectorExt::Low, MakeSigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extend_low_i16x8_s>>(configuration);
     case Instructions::i32x4_extend_high_i16x8_s.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<4, Operators::VectorExt::High, MakeSigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extend_high_i16x8_s>>(configuration);
     case Instructions::i32x4_extend_low_i16x8_u.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<4, Operators::VectorExt::Low, MakeUnsigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extend_low_i16x8_u>>(configuration);
     case Instructions::i32x4_extend_high_i16x8_u.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<4, Operators::VectorExt::High, MakeUnsigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extend_high_i16x8_u>>(configuration);
     case Instructions::i32x4_extadd_pairwise_i16x8_s.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeSigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extadd_pairwise_i16x8_s>>(configuration);
     case Instructions::i32x4_extadd_pairwise_i16x8_u.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeUnsigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extadd_pairwise_i16x8_u>>(configuration);
     case Instructions::i32x4_extmul_low_i16x8_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extmul_low_i16x8_s>>(configuration);
     case Instructions::i32x4_extmul_high_i16x8_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::High, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extmul_high_i16x8_s>>(configuration);
     case Instructions::i32x4_extmul_low_i16x8_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::Low, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extmul_low_i16x8_u>>(configuration);
     case Instructions::i32x4_extmul_high_i16x8_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_extmul_high_i16x8_u>>(configuration);
     case Instructions::i64x2_eq.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::Equals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_eq>>(configuration);
     case Instructions::i64x2_ne.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::NotEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_ne>>(configuration);
     case Instructions::i64x2_lt_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::LessThan, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_lt_s>>(configuration);
     case Instructions::i64x2_gt_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::GreaterThan, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_gt_s>>(configuration);
     case Instructions::i64x2_le_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::LessThanOrEquals, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_le_s>>(configuration);
     case Instructions::i64x2_ge_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorCmpOp<2, Operators::GreaterThanOrEquals, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_ge_s>>(configuration);
     case Instructions::i64x2_abs.value():
         return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<2, Operators::Absolute>>(configuration);
     case Instructions::i64x2_neg.value():
         return unary_operation<u128, u128, Operators::VectorIntegerUnaryOp<2, Operators::Negate, MakeUnsigned>>(configuration);
     case Instructions::i64x2_all_true.value():
-        return unary_operation<u128, i32, Operators::VectorAllTrue<2>>(configuration);
+        return unary_operation<u128, i32, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_all_true>>(configuration);
     case Instructions::i64x2_add.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Add, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_add>>(configuration);
     case Instructions::i64x2_sub.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Subtract, MakeUnsigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_sub>>(configuration);
     case Instructions::i64x2_mul.value():
         return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<2, Operators::Multiply, MakeUnsigned>>(configuration);
     case Instructions::i64x2_extend_low_i32x4_s.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<2, Operators::VectorExt::Low, MakeSigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_extend_low_i32x4_s>>(configuration);
     case Instructions::i64x2_extend_high_i32x4_s.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<2, Operators::VectorExt::High, MakeSigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_extend_high_i32x4_s>>(configuration);
     case Instructions::i64x2_extend_low_i32x4_u.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<2, Operators::VectorExt::Low, MakeUnsigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_extend_low_i32x4_u>>(configuration);
     case Instructions::i64x2_extend_high_i32x4_u.value():
-        return unary_operation<u128, u128, Operators::VectorIntegerExt<2, Operators::VectorExt::High, MakeUnsigned>>(configuration);
+        return unary_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_extend_high_i32x4_u>>(configuration);
     case Instructions::i64x2_extmul_low_i32x4_s.value():
         return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<2, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>>(configuration);
     case Instructions::i64x2_extmul_high_i32x4_s.value():
@@ -1485,33 +1964,33 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     case Instructions::i64x2_extmul_high_i32x4_u.value():
         return binary_numeric_operation<u128, u128, Operators::VectorIntegerExtOp<2, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>>(configuration);
     case Instructions::f32x4_eq.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<4, Operators::Equals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f32x4_eq>>(configuration);
     case Instructions::f32x4_ne.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<4, Operators::NotEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f32x4_ne>>(configuration);
     case Instructions::f32x4_lt.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<4, Operators::LessThan>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f32x4_lt>>(configuration);
     case Instructions::f32x4_gt.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<4, Operators::GreaterThan>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f32x4_gt>>(configuration);
     case Instructions::f32x4_le.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<4, Operators::LessThanOrEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f32x4_le>>(configuration);
     case Instructions::f32x4_ge.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<4, Operators::GreaterThanOrEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f32x4_ge>>(configuration);
     case Instructions::f32x4_min.value():
         return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Minimum>>(configuration);
     case Instructions::f32x4_max.value():
         return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<4, Operators::Maximum>>(configuration);
     case Instructions::f64x2_eq.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<2, Operators::Equals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f64x2_eq>>(configuration);
     case Instructions::f64x2_ne.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<2, Operators::NotEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f64x2_ne>>(configuration);
     case Instructions::f64x2_lt.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<2, Operators::LessThan>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f64x2_lt>>(configuration);
     case Instructions::f64x2_gt.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<2, Operators::GreaterThan>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f64x2_gt>>(configuration);
     case Instructions::f64x2_le.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<2, Operators::LessThanOrEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f64x2_le>>(configuration);
     case Instructions::f64x2_ge.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorFloatCmpOp<2, Operators::GreaterThanOrEquals>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::f64x2_ge>>(configuration);
     case Instructions::f64x2_min.value():
         return binary_numeric_operation<u128, u128, Operators::VectorFloatBinaryOp<2, Operators::Minimum>>(configuration);
     case Instructions::f64x2_max.value():
@@ -1616,25 +2095,25 @@ ALWAYS_INLINE void BytecodeInterpreter::interpret_instruction(Configuration& con
     case Instructions::i32x4_trunc_sat_f32x4_u.value():
         return unary_operation<u128, u128, Operators::VectorConvertOp<4, 4, u32, f32, Operators::SaturatingTruncate<u32>>>(configuration);
     case Instructions::i8x16_bitmask.value():
-        return unary_operation<u128, i32, Operators::VectorBitmask<16>>(configuration);
+        return unary_operation<u128, i32, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_bitmask>>(configuration);
     case Instructions::i16x8_bitmask.value():
-        return unary_operation<u128, i32, Operators::VectorBitmask<8>>(configuration);
+        return unary_operation<u128, i32, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_bitmask>>(configuration);
     case Instructions::i32x4_bitmask.value():
-        return unary_operation<u128, i32, Operators::VectorBitmask<4>>(configuration);
+        return unary_operation<u128, i32, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_bitmask>>(configuration);
     case Instructions::i64x2_bitmask.value():
-        return unary_operation<u128, i32, Operators::VectorBitmask<2>>(configuration);
+        return unary_operation<u128, i32, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i64x2_bitmask>>(configuration);
     case Instructions::i32x4_dot_i16x8_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorDotProduct<4>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i32x4_dot_i16x8_s>>(configuration);
     case Instructions::i8x16_narrow_i16x8_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<16, i8>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_narrow_i16x8_s>>(configuration);
     case Instructions::i8x16_narrow_i16x8_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<16, u8>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i8x16_narrow_i16x8_u>>(configuration);
     case Instructions::i16x8_narrow_i32x4_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<8, i16>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_narrow_i32x4_s>>(configuration);
     case Instructions::i16x8_narrow_i32x4_u.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorNarrow<8, u16>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_narrow_i32x4_u>>(configuration);
     case Instructions::i16x8_q15mulr_sat_s.value():
-        return binary_numeric_operation<u128, u128, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Q15Mul>, MakeSigned>>(configuration);
+        return binary_numeric_operation<u128, u128, SIMDKernels::Dispatched<&SIMDKernels::Kernels::i16x8_q15mulr_sat_s>>(configuration);
     case Instructions::f32x4_convert_i32x4_s.value():
         return unary_operation<u128, u128, Operators::VectorConvertOp<4, 4, u32, i32, Operators::Convert<f32>>>(configuration);
     case Instructions::f32x4_convert_i32x4_u.value():
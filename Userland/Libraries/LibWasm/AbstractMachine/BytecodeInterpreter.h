@@ -45,6 +45,7 @@ struct BytecodeInterpreter : public Interpreter {
     };
 
 protected:
+    void interpret_threaded(Configuration&);
     void interpret_instruction(Configuration&, InstructionPointer&, Instruction const&);
     void branch_to_label(Configuration&, LabelIndex);
     template<typename ReadT, typename PushT>
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/CPUFeatures.h>
+#include <LibWasm/AbstractMachine/Operators.h>
+#include <LibWasm/AbstractMachine/SIMDKernels.h>
+
+#if AK_CAN_CODEGEN_FOR_X86_SSE42
+#    include <nmmintrin.h>
+#endif
+
+namespace Wasm::SIMDKernels {
+
+static constexpr Kernels s_generic_kernels {
+#define M(name, ...) .name = [](u128 lhs, u128 rhs) -> u128 { return __VA_ARGS__ {}(lhs, rhs); },
+    ENUMERATE_BINARY_SIMD_KERNELS(M)
+#undef M
+#define M(name, ...) .name = [](u128 value) -> u128 { return __VA_ARGS__ {}(value); },
+    ENUMERATE_UNARY_SIMD_KERNELS(M)
+#undef M
+#define M(name, ...) .name = [](u128 value) -> i32 { return static_cast<i32>(__VA_ARGS__ {}(value)); },
+    ENUMERATE_MASK_SIMD_KERNELS(M)
+#undef M
+};
+
+#if AK_CAN_CODEGEN_FOR_X86_SSE42
+// NOTE: Everything up to SSE4.1 (and SSSE3's byte shuffles) is implied by SSE4.2, so these can use all of it.
+//       Wider AVX2 registers don't help here, as every operation works on exactly one 128-bit vector.
+namespace SSE42 {
+
+#    define KERNEL_TARGET gnu::target("sse4.2")
+
+// Element-wise operations that the compiler lowers to a single instruction by itself once it may use SSE4.2,
+// such as pcmpgtq for 64-bit comparisons, or the unsigned comparisons that it builds from pminu*/pcmpeq*.
+#    define DEFINE_VECTOR_OPERATION(name, VectorType, operation)                                  \
+        [[KERNEL_TARGET]] static u128 name(u128 lhs, u128 rhs)                                    \
+        {                                                                                         \
+            return bit_cast<u128>(bit_cast<VectorType>(lhs) operation bit_cast<VectorType>(rhs)); \
+        }
+
+#    define DEFINE_INTRINSIC_OPERATION(name, intrinsic)                                       \
+        [[KERNEL_TARGET]] static u128 name(u128 lhs, u128 rhs)                                \
+        {                                                                                     \
+            return bit_cast<u128>(intrinsic(bit_cast<__m128i>(lhs), bit_cast<__m128i>(rhs))); \
+        }
+
+#    define DEFINE_COMPARISONS(prefix, SignedType, UnsignedType) \
+        DEFINE_VECTOR_OPERATION(prefix##_eq, SignedType, ==)     \
+        DEFINE_VECTOR_OPERATION(prefix##_ne, SignedType, !=)     \
+        DEFINE_VECTOR_OPERATION(prefix##_lt_s, SignedType, <)    \
+        DEFINE_VECTOR_OPERATION(prefix##_lt_u, UnsignedType, <)  \
+        DEFINE_VECTOR_OPERATION(prefix##_gt_s, SignedType, >)    \
+        DEFINE_VECTOR_OPERATION(prefix##_gt_u, UnsignedType, >)  \
+        DEFINE_VECTOR_OPERATION(prefix##_le_s, SignedType, <=)   \
+        DEFINE_VECTOR_OPERATION(prefix##_le_u, UnsignedType, <=) \
+        DEFINE_VECTOR_OPERATION(prefix##_ge_s, SignedType, >=)   \
+        DEFINE_VECTOR_OPERATION(prefix##_ge_u, UnsignedType, >=)
+
+DEFINE_COMPARISONS(i8x16, AK::SIMD::i8x16, AK::SIMD::u8x16)
+DEFINE_COMPARISONS(i16x8, AK::SIMD::i16x8, AK::SIMD::u16x8)
+DEFINE_COMPARISONS(i32x4, AK::SIMD::i32x4, AK::SIMD::u32x4)
+DEFINE_VECTOR_OPERATION(i64x2_eq, AK::SIMD::i64x2, ==)
+DEFINE_VECTOR_OPERATION(i64x2_ne, AK::SIMD::i64x2, !=)
+DEFINE_VECTOR_OPERATION(i64x2_lt_s, AK::SIMD::i64x2, <)
+DEFINE_VECTOR_OPERATION(i64x2_gt_s, AK::SIMD::i64x2, >)
+DEFINE_VECTOR_OPERATION(i64x2_le_s, AK::SIMD::i64x2, <=)
+DEFINE_VECTOR_OPERATION(i64x2_ge_s, AK::SIMD::i64x2, >=)
+
+// NOTE: These follow IEEE 754 just like Wasm does, so `ne` is true and everything else is false for NaNs.
+DEFINE_VECTOR_OPERATION(f32x4_eq, AK::SIMD::f32x4, ==)
+DEFINE_VECTOR_OPERATION(f32x4_ne, AK::SIMD::f32x4, !=)
+DEFINE_VECTOR_OPERATION(f32x4_lt, AK::SIMD::f32x4, <)
+DEFINE_VECTOR_OPERATION(f32x4_gt, AK::SIMD::f32x4, >)
+DEFINE_VECTOR_OPERATION(f32x4_le, AK::SIMD::f32x4, <=)
+DEFINE_VECTOR_OPERATION(f32x4_ge, AK::SIMD::f32x4, >=)
+DEFINE_VECTOR_OPERATION(f64x2_eq, AK::SIMD::f64x2, ==)
+DEFINE_VECTOR_OPERATION(f64x2_ne, AK::SIMD::f64x2, !=)
+DEFINE_VECTOR_OPERATION(f64x2_lt, AK::SIMD::f64x2, <)
+DEFINE_VECTOR_OPERATION(f64x2_gt, AK::SIMD::f64x2, >)
+DEFINE_VECTOR_OPERATION(f64x2_le, AK::SIMD::f64x2, <=)
+DEFINE_VECTOR_OPERATION(f64x2_ge, AK::SIMD::f64x2, >=)
+
+DEFINE_VECTOR_OPERATION(i8x16_add, AK::SIMD::u8x16, +)
+DEFINE_VECTOR_OPERATION(i8x16_sub, AK::SIMD::u8x16, -)
+DEFINE_VECTOR_OPERATION(i16x8_add, AK::SIMD::u16x8, +)
+DEFINE_VECTOR_OPERATION(i16x8_sub, AK::SIMD::u16x8, -)
+DEFINE_VECTOR_OPERATION(i32x4_add, AK::SIMD::u32x4, +)
+DEFINE_VECTOR_OPERATION(i32x4_sub, AK::SIMD::u32x4, -)
+DEFINE_VECTOR_OPERATION(i64x2_add, AK::SIMD::u64x2, +)
+DEFINE_VECTOR_OPERATION(i64x2_sub, AK::SIMD::u64x2, -)
+
+DEFINE_INTRINSIC_OPERATION(i8x16_add_sat_s, _mm_adds_epi8)
+DEFINE_INTRINSIC_OPERATION(i8x16_add_sat_u, _mm_adds_epu8)
+DEFINE_INTRINSIC_OPERATION(i8x16_sub_sat_s, _mm_subs_epi8)
+DEFINE_INTRINSIC_OPERATION(i8x16_sub_sat_u, _mm_subs_epu8)
+DEFINE_INTRINSIC_OPERATION(i8x16_avgr_u, _mm_avg_epu8)
+DEFINE_INTRINSIC_OPERATION(i16x8_add_sat_s, _mm_adds_epi16)
+DEFINE_INTRINSIC_OPERATION(i16x8_add_sat_u, _mm_adds_epu16)
+DEFINE_INTRINSIC_OPERATION(i16x8_sub_sat_s, _mm_subs_epi16)
+DEFINE_INTRINSIC_OPERATION(i16x8_sub_sat_u, _mm_subs_epu16)
+DEFINE_INTRINSIC_OPERATION(i16x8_avgr_u, _mm_avg_epu16)
+
+DEFINE_INTRINSIC_OPERATION(i8x16_min_s, _mm_min_epi8)
+DEFINE_INTRINSIC_OPERATION(i8x16_min_u, _mm_min_epu8)
+DEFINE_INTRINSIC_OPERATION(i8x16_max_s, _mm_max_epi8)
+DEFINE_INTRINSIC_OPERATION(i8x16_max_u, _mm_max_epu8)
+DEFINE_INTRINSIC_OPERATION(i16x8_min_s, _mm_min_epi16)
+DEFINE_INTRINSIC_OPERATION(i16x8_min_u, _mm_min_epu16)
+DEFINE_INTRINSIC_OPERATION(i16x8_max_s, _mm_max_epi16)
+DEFINE_INTRINSIC_OPERATION(i16x8_max_u, _mm_max_epu16)
+DEFINE_INTRINSIC_OPERATION(i32x4_min_s, _mm_min_epi32)
+DEFINE_INTRINSIC_OPERATION(i32x4_min_u, _mm_min_epu32)
+DEFINE_INTRINSIC_OPERATION(i32x4_max_s, _mm_max_epi32)
+DEFINE_INTRINSIC_OPERATION(i32x4_max_u, _mm_max_epu32)
+
+DEFINE_INTRINSIC_OPERATION(i16x8_mul, _mm_mullo_epi16)
+DEFINE_INTRINSIC_OPERATION(i32x4_mul, _mm_mullo_epi32)
+DEFINE_INTRINSIC_OPERATION(i32x4_dot_i16x8_s, _mm_madd_epi16)
+
+// NOTE: The pack instructions always treat their inputs as signed, which is exactly what Wasm asks for.
+DEFINE_INTRINSIC_OPERATION(i8x16_narrow_i16x8_s, _mm_packs_epi16)
+DEFINE_INTRINSIC_OPERATION(i8x16_narrow_i16x8_u, _mm_packus_epi16)
+DEFINE_INTRINSIC_OPERATION(i16x8_narrow_i32x4_s, _mm_packs_epi32)
+DEFINE_INTRINSIC_OPERATION(i16x8_narrow_i32x4_u, _mm_packus_epi32)
+
+[[KERNEL_TARGET]] static u128 i16x8_q15mulr_sat_s(u128 lhs, u128 rhs)
+{
+    // pmulhrsw matches q15mulr except for -1 * -1, which wraps around to -1 instead of saturating.
+    auto result = _mm_mulhrs_epi16(bit_cast<__m128i>(lhs), bit_cast<__m128i>(rhs));
+    auto overflowed = _mm_cmpeq_epi16(result, _mm_set1_epi16(NumericLimits<i16>::min()));
+    return bit_cast<u128>(_mm_xor_si128(result, overflowed));
+}
+
+[[KERNEL_TARGET]] static u128 i8x16_swizzle(u128 lhs, u128 rhs)
+{
+    // pshufb zeroes lanes whose index has the top bit set; pushing all indices >= 16 there
+    // (while keeping the low nibble of the others) gives us Wasm's out-of-range behavior.
+    auto indices = _mm_adds_epu8(bit_cast<__m128i>(rhs), _mm_set1_epi8(0x70));
+    return bit_cast<u128>(_mm_shuffle_epi8(bit_cast<__m128i>(lhs), indices));
+}
+
+[[KERNEL_TARGET]] ALWAYS_INLINE static __m128i high_half(__m128i value)
+{
+    return _mm_srli_si128(value, 8);
+}
+
+#    define DEFINE_EXTENDED_MULTIPLY(name, extend, multiply, half)                                                       \
+        [[KERNEL_TARGET]] static u128 name(u128 lhs, u128 rhs)                                                           \
+        {                                                                                                                \
+            return bit_cast<u128>(multiply(extend(half(bit_cast<__m128i>(lhs))), extend(half(bit_cast<__m128i>(rhs))))); \
+        }
+
+#    define LOW_HALF(value) value
+DEFINE_EXTENDED_MULTIPLY(i16x8_extmul_low_i8x16_s, _mm_cvtepi8_epi16, _mm_mullo_epi16, LOW_HALF)
+DEFINE_EXTENDED_MULTIPLY(i16x8_extmul_low_i8x16_u, _mm_cvtepu8_epi16, _mm_mullo_epi16, LOW_HALF)
+DEFINE_EXTENDED_MULTIPLY(i16x8_extmul_high_i8x16_s, _mm_cvtepi8_epi16, _mm_mullo_epi16, high_half)
+DEFINE_EXTENDED_MULTIPLY(i16x8_extmul_high_i8x16_u, _mm_cvtepu8_epi16, _mm_mullo_epi16, high_half)
+DEFINE_EXTENDED_MULTIPLY(i32x4_extmul_low_i16x8_s, _mm_cvtepi16_epi32, _mm_mullo_epi32, LOW_HALF)
+DEFINE_EXTENDED_MULTIPLY(i32x4_extmul_low_i16x8_u, _mm_cvtepu16_epi32, _mm_mullo_epi32, LOW_HALF)
+DEFINE_EXTENDED_MULTIPLY(i32x4_extmul_high_i16x8_s, _mm_cvtepi16_epi32, _mm_mullo_epi32, high_half)
+DEFINE_EXTENDED_MULTIPLY(i32x4_extmul_high_i16x8_u, _mm_cvtepu16_epi32, _mm_mullo_epi32, high_half)
+
+#    define DEFINE_UNARY_INTRINSIC_OPERATION(name, expression) \
+        [[KERNEL_TARGET]] static u128 name(u128 value_bits)    \
+        {                                                      \
+            auto value = bit_cast<__m128i>(value_bits);        \
+            return bit_cast<u128>(expression);                 \
+        }
+
+DEFINE_UNARY_INTRINSIC_OPERATION(i8x16_abs, _mm_abs_epi8(value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i16x8_abs, _mm_abs_epi16(value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i32x4_abs, _mm_abs_epi32(value))
+
+DEFINE_UNARY_INTRINSIC_OPERATION(i16x8_extend_low_i8x16_s, _mm_cvtepi8_epi16(value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i16x8_extend_low_i8x16_u, _mm_cvtepu8_epi16(value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i16x8_extend_high_i8x16_s, _mm_cvtepi8_epi16(high_half(value)))
+DEFINE_UNARY_INTRINSIC_OPERATION(i16x8_extend_high_i8x16_u, _mm_cvtepu8_epi16(high_half(value)))
+DEFINE_UNARY_INTRINSIC_OPERATION(i32x4_extend_low_i16x8_s, _mm_cvtepi16_epi32(value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i32x4_extend_low_i16x8_u, _mm_cvtepu16_epi32(value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i32x4_extend_high_i16x8_s, _mm_cvtepi16_epi32(high_half(value)))
+DEFINE_UNARY_INTRINSIC_OPERATION(i32x4_extend_high_i16x8_u, _mm_cvtepu16_epi32(high_half(value)))
+DEFINE_UNARY_INTRINSIC_OPERATION(i64x2_extend_low_i32x4_s, _mm_cvtepi32_epi64(value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i64x2_extend_low_i32x4_u, _mm_cvtepu32_epi64(value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i64x2_extend_high_i32x4_s, _mm_cvtepi32_epi64(high_half(value)))
+DEFINE_UNARY_INTRINSIC_OPERATION(i64x2_extend_high_i32x4_u, _mm_cvtepu32_epi64(high_half(value)))
+
+// pmaddubsw multiplies unsigned bytes of its first operand with signed bytes of its second one, so multiplying by
+// a vector of ones (on the appropriate side) sums up adjacent pairs without being able to saturate.
+DEFINE_UNARY_INTRINSIC_OPERATION(i16x8_extadd_pairwise_i8x16_s, _mm_maddubs_epi16(_mm_set1_epi8(1), value))
+DEFINE_UNARY_INTRINSIC_OPERATION(i16x8_extadd_pairwise_i8x16_u, _mm_maddubs_epi16(value, _mm_set1_epi8(1)))
+DEFINE_UNARY_INTRINSIC_OPERATION(i32x4_extadd_pairwise_i16x8_s, _mm_madd_epi16(value, _mm_set1_epi16(1)))
+
+[[KERNEL_TARGET]] static u128 i32x4_extadd_pairwise_i16x8_u(u128 value_bits)
+{
+    // pmaddwd is signed only, so bias each lane into signed range and add the bias of both lanes back afterwards.
+    auto biased = _mm_xor_si128(bit_cast<__m128i>(value_bits), _mm_set1_epi16(NumericLimits<i16>::min()));
+    auto sums = _mm_madd_epi16(biased, _mm_set1_epi16(1));
+    return bit_cast<u128>(_mm_add_epi32(sums, _mm_set1_epi32(0x10000)));
+}
+
+[[KERNEL_TARGET]] static u128 i8x16_popcnt(u128 value_bits)
+{
+    // Look up the bit count of each nibble in a 16-entry table.
+    auto value = bit_cast<__m128i>(value_bits);
+    auto nibble_mask = _mm_set1_epi8(0x0f);
+    auto table = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    auto low_nibbles = _mm_and_si128(value, nibble_mask);
+    auto high_nibbles = _mm_and_si128(_mm_srli_epi16(value, 4), nibble_mask);
+    return bit_cast<u128>(_mm_add_epi8(_mm_shuffle_epi8(table, low_nibbles), _mm_shuffle_epi8(table, high_nibbles)));
+}
+
+#    define DEFINE_MASK_OPERATION(name, expression)        \
+        [[KERNEL_TARGET]] static i32 name(u128 value_bits) \
+        {                                                  \
+            auto value = bit_cast<__m128i>(value_bits);    \
+            return (expression);                           \
+        }
+
+DEFINE_MASK_OPERATION(i8x16_all_true, _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) == 0)
+DEFINE_MASK_OPERATION(i16x8_all_true, _mm_movemask_epi8(_mm_cmpeq_epi16(value, _mm_setzero_si128())) == 0)
+DEFINE_MASK_OPERATION(i32x4_all_true, _mm_movemask_epi8(_mm_cmpeq_epi32(value, _mm_setzero_si128())) == 0)
+DEFINE_MASK_OPERATION(i64x2_all_true, _mm_movemask_epi8(_mm_cmpeq_epi64(value, _mm_setzero_si128())) == 0)
+DEFINE_MASK_OPERATION(i8x16_bitmask, _mm_movemask_epi8(value))
+DEFINE_MASK_OPERATION(i16x8_bitmask, _mm_movemask_epi8(_mm_packs_epi16(value, _mm_setzero_si128())))
+DEFINE_MASK_OPERATION(i32x4_bitmask, _mm_movemask_ps(_mm_castsi128_ps(value)))
+DEFINE_MASK_OPERATION(i64x2_bitmask, _mm_movemask_pd(_mm_castsi128_pd(value)))
+
+#    undef DEFINE_MASK_OPERATION
+#    undef DEFINE_UNARY_INTRINSIC_OPERATION
+#    undef LOW_HALF
+#    undef DEFINE_EXTENDED_MULTIPLY
+#    undef DEFINE_COMPARISONS
+#    undef DEFINE_INTRINSIC_OPERATION
+#    undef DEFINE_VECTOR_OPERATION
+#    undef KERNEL_TARGET
+
+}
+
+static constexpr Kernels s_sse42_kernels {
+#    define M(name, ...) .name = SSE42::name,
+    ENUMERATE_BINARY_SIMD_KERNELS(M)
+    ENUMERATE_UNARY_SIMD_KERNELS(M)
+    ENUMERATE_MASK_SIMD_KERNELS(M)
+#    undef M
+};
+#endif
+
+Vector<KernelSet> available_kernel_sets()
+{
+    Vector<KernelSet> sets;
+    sets.append({ "generic"sv, s_generic_kernels });
+
+#if AK_CAN_CODEGEN_FOR_X86_SSE42
+    if (has_flag(detect_cpu_features(), CPUFeatures::X86_SSE42))
+        sets.append({ "sse4.2"sv, s_sse42_kernels });
+#endif
+
+    return sets;
+}
+
+Kernels const& dispatched_kernels = []() -> Kernels const& {
+#if AK_CAN_CODEGEN_FOR_X86_SSE42
+    if (has_flag(detect_cpu_features(), CPUFeatures::X86_SSE42))
+        return s_sse42_kernels;
+#endif
+    return s_generic_kernels;
+}();
+
+}
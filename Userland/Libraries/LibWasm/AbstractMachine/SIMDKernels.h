@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/StringView.h>
+#include <AK/UFixedBigInt.h>
+#include <AK/Vector.h>
+
+namespace Wasm::SIMDKernels {
+
+// v128 operations that have dedicated kernels, along with the generic operator each one falls back to.
+// Binary kernels take two vectors, unary kernels take one, and mask kernels reduce a vector to an i32.
+#define ENUMERATE_BINARY_SIMD_KERNELS(M)                                                                                          \
+    M(i8x16_eq, Operators::VectorCmpOp<16, Operators::Equals>)                                                                    \
+    M(i8x16_ne, Operators::VectorCmpOp<16, Operators::NotEquals>)                                                                 \
+    M(i8x16_lt_s, Operators::VectorCmpOp<16, Operators::LessThan, MakeSigned>)                                                    \
+    M(i8x16_lt_u, Operators::VectorCmpOp<16, Operators::LessThan, MakeUnsigned>)                                                  \
+    M(i8x16_gt_s, Operators::VectorCmpOp<16, Operators::GreaterThan, MakeSigned>)                                                 \
+    M(i8x16_gt_u, Operators::VectorCmpOp<16, Operators::GreaterThan, MakeUnsigned>)                                               \
+    M(i8x16_le_s, Operators::VectorCmpOp<16, Operators::LessThanOrEquals, MakeSigned>)                                            \
+    M(i8x16_le_u, Operators::VectorCmpOp<16, Operators::LessThanOrEquals, MakeUnsigned>)                                          \
+    M(i8x16_ge_s, Operators::VectorCmpOp<16, Operators::GreaterThanOrEquals, MakeSigned>)                                         \
+    M(i8x16_ge_u, Operators::VectorCmpOp<16, Operators::GreaterThanOrEquals, MakeUnsigned>)                                       \
+    M(i16x8_eq, Operators::VectorCmpOp<8, Operators::Equals>)                                                                     \
+    M(i16x8_ne, Operators::VectorCmpOp<8, Operators::NotEquals>)                                                                  \
+    M(i16x8_lt_s, Operators::VectorCmpOp<8, Operators::LessThan, MakeSigned>)                                                     \
+    M(i16x8_lt_u, Operators::VectorCmpOp<8, Operators::LessThan, MakeUnsigned>)                                                   \
+    M(i16x8_gt_s, Operators::VectorCmpOp<8, Operators::GreaterThan, MakeSigned>)                                                  \
+    M(i16x8_gt_u, Operators::VectorCmpOp<8, Operators::GreaterThan, MakeUnsigned>)                                                \
+    M(i16x8_le_s, Operators::VectorCmpOp<8, Operators::LessThanOrEquals, MakeSigned>)                                             \
+    M(i16x8_le_u, Operators::VectorCmpOp<8, Operators::LessThanOrEquals, MakeUnsigned>)                                           \
+    M(i16x8_ge_s, Operators::VectorCmpOp<8, Operators::GreaterThanOrEquals, MakeSigned>)                                          \
+    M(i16x8_ge_u, Operators::VectorCmpOp<8, Operators::GreaterThanOrEquals, MakeUnsigned>)                                        \
+    M(i32x4_eq, Operators::VectorCmpOp<4, Operators::Equals>)                                                                     \
+    M(i32x4_ne, Operators::VectorCmpOp<4, Operators::NotEquals>)                                                                  \
+    M(i32x4_lt_s, Operators::VectorCmpOp<4, Operators::LessThan, MakeSigned>)                                                     \
+    M(i32x4_lt_u, Operators::VectorCmpOp<4, Operators::LessThan, MakeUnsigned>)                                                   \
+    M(i32x4_gt_s, Operators::VectorCmpOp<4, Operators::GreaterThan, MakeSigned>)                                                  \
+    M(i32x4_gt_u, Operators::VectorCmpOp<4, Operators::GreaterThan, MakeUnsigned>)                                                \
+    M(i32x4_le_s, Operators::VectorCmpOp<4, Operators::LessThanOrEquals, MakeSigned>)                                             \
+    M(i32x4_le_u, Operators::VectorCmpOp<4, Operators::LessThanOrEquals, MakeUnsigned>)                                           \
+    M(i32x4_ge_s, Operators::VectorCmpOp<4, Operators::GreaterThanOrEquals, MakeSigned>)                                          \
+    M(i32x4_ge_u, Operators::VectorCmpOp<4, Operators::GreaterThanOrEquals, MakeUnsigned>)                                        \
+    M(i64x2_eq, Operators::VectorCmpOp<2, Operators::Equals>)                                                                     \
+    M(i64x2_ne, Operators::VectorCmpOp<2, Operators::NotEquals>)                                                                  \
+    M(i64x2_lt_s, Operators::VectorCmpOp<2, Operators::LessThan, MakeSigned>)                                                     \
+    M(i64x2_gt_s, Operators::VectorCmpOp<2, Operators::GreaterThan, MakeSigned>)                                                  \
+    M(i64x2_le_s, Operators::VectorCmpOp<2, Operators::LessThanOrEquals, MakeSigned>)                                             \
+    M(i64x2_ge_s, Operators::VectorCmpOp<2, Operators::GreaterThanOrEquals, MakeSigned>)                                          \
+    M(f32x4_eq, Operators::VectorFloatCmpOp<4, Operators::Equals>)                                                                \
+    M(f32x4_ne, Operators::VectorFloatCmpOp<4, Operators::NotEquals>)                                                             \
+    M(f32x4_lt, Operators::VectorFloatCmpOp<4, Operators::LessThan>)                                                              \
+    M(f32x4_gt, Operators::VectorFloatCmpOp<4, Operators::GreaterThan>)                                                           \
+    M(f32x4_le, Operators::VectorFloatCmpOp<4, Operators::LessThanOrEquals>)                                                      \
+    M(f32x4_ge, Operators::VectorFloatCmpOp<4, Operators::GreaterThanOrEquals>)                                                   \
+    M(f64x2_eq, Operators::VectorFloatCmpOp<2, Operators::Equals>)                                                                \
+    M(f64x2_ne, Operators::VectorFloatCmpOp<2, Operators::NotEquals>)                                                             \
+    M(f64x2_lt, Operators::VectorFloatCmpOp<2, Operators::LessThan>)                                                              \
+    M(f64x2_gt, Operators::VectorFloatCmpOp<2, Operators::GreaterThan>)                                                           \
+    M(f64x2_le, Operators::VectorFloatCmpOp<2, Operators::LessThanOrEquals>)                                                      \
+    M(f64x2_ge, Operators::VectorFloatCmpOp<2, Operators::GreaterThanOrEquals>)                                                   \
+    M(i8x16_add, Operators::VectorIntegerBinaryOp<16, Operators::Add>)                                                            \
+    M(i8x16_sub, Operators::VectorIntegerBinaryOp<16, Operators::Subtract>)                                                       \
+    M(i16x8_add, Operators::VectorIntegerBinaryOp<8, Operators::Add>)                                                             \
+    M(i16x8_sub, Operators::VectorIntegerBinaryOp<8, Operators::Subtract>)                                                        \
+    M(i32x4_add, Operators::VectorIntegerBinaryOp<4, Operators::Add, MakeUnsigned>)                                               \
+    M(i32x4_sub, Operators::VectorIntegerBinaryOp<4, Operators::Subtract, MakeUnsigned>)                                          \
+    M(i64x2_add, Operators::VectorIntegerBinaryOp<2, Operators::Add, MakeUnsigned>)                                               \
+    M(i64x2_sub, Operators::VectorIntegerBinaryOp<2, Operators::Subtract, MakeUnsigned>)                                          \
+    M(i8x16_add_sat_s, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Add>, MakeSigned>)             \
+    M(i8x16_add_sat_u, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Add>, MakeUnsigned>)           \
+    M(i8x16_sub_sat_s, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<i8, Operators::Subtract>, MakeSigned>)        \
+    M(i8x16_sub_sat_u, Operators::VectorIntegerBinaryOp<16, Operators::SaturatingOp<u8, Operators::Subtract>, MakeUnsigned>)      \
+    M(i8x16_avgr_u, Operators::VectorIntegerBinaryOp<16, Operators::Average, MakeUnsigned>)                                       \
+    M(i16x8_add_sat_s, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Add>, MakeSigned>)             \
+    M(i16x8_add_sat_u, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Add>, MakeUnsigned>)           \
+    M(i16x8_sub_sat_s, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Subtract>, MakeSigned>)        \
+    M(i16x8_sub_sat_u, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<u16, Operators::Subtract>, MakeUnsigned>)      \
+    M(i16x8_avgr_u, Operators::VectorIntegerBinaryOp<8, Operators::Average, MakeUnsigned>)                                        \
+    M(i8x16_min_s, Operators::VectorIntegerBinaryOp<16, Operators::Minimum, MakeSigned>)                                          \
+    M(i8x16_min_u, Operators::VectorIntegerBinaryOp<16, Operators::Minimum, MakeUnsigned>)                                        \
+    M(i8x16_max_s, Operators::VectorIntegerBinaryOp<16, Operators::Maximum, MakeSigned>)                                          \
+    M(i8x16_max_u, Operators::VectorIntegerBinaryOp<16, Operators::Maximum, MakeUnsigned>)                                        \
+    M(i16x8_min_s, Operators::VectorIntegerBinaryOp<8, Operators::Minimum, MakeSigned>)                                           \
+    M(i16x8_min_u, Operators::VectorIntegerBinaryOp<8, Operators::Minimum, MakeUnsigned>)                                         \
+    M(i16x8_max_s, Operators::VectorIntegerBinaryOp<8, Operators::Maximum, MakeSigned>)                                           \
+    M(i16x8_max_u, Operators::VectorIntegerBinaryOp<8, Operators::Maximum, MakeUnsigned>)                                         \
+    M(i32x4_min_s, Operators::VectorIntegerBinaryOp<4, Operators::Minimum, MakeSigned>)                                           \
+    M(i32x4_min_u, Operators::VectorIntegerBinaryOp<4, Operators::Minimum, MakeUnsigned>)                                         \
+    M(i32x4_max_s, Operators::VectorIntegerBinaryOp<4, Operators::Maximum, MakeSigned>)                                           \
+    M(i32x4_max_u, Operators::VectorIntegerBinaryOp<4, Operators::Maximum, MakeUnsigned>)                                         \
+    M(i16x8_mul, Operators::VectorIntegerBinaryOp<8, Operators::Multiply>)                                                        \
+    M(i32x4_mul, Operators::VectorIntegerBinaryOp<4, Operators::Multiply, MakeUnsigned>)                                          \
+    M(i16x8_q15mulr_sat_s, Operators::VectorIntegerBinaryOp<8, Operators::SaturatingOp<i16, Operators::Q15Mul>, MakeSigned>)      \
+    M(i32x4_dot_i16x8_s, Operators::VectorDotProduct<4>)                                                                          \
+    M(i8x16_narrow_i16x8_s, Operators::VectorNarrow<16, i8>)                                                                      \
+    M(i8x16_narrow_i16x8_u, Operators::VectorNarrow<16, u8>)                                                                      \
+    M(i16x8_narrow_i32x4_s, Operators::VectorNarrow<8, i16>)                                                                      \
+    M(i16x8_narrow_i32x4_u, Operators::VectorNarrow<8, u16>)                                                                      \
+    M(i8x16_swizzle, Operators::VectorSwizzle)                                                                                    \
+    M(i16x8_extmul_low_i8x16_s, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>)     \
+    M(i16x8_extmul_low_i8x16_u, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::Low, MakeUnsigned>)   \
+    M(i16x8_extmul_high_i8x16_s, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::High, MakeSigned>)   \
+    M(i16x8_extmul_high_i8x16_u, Operators::VectorIntegerExtOp<8, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>) \
+    M(i32x4_extmul_low_i16x8_s, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::Low, MakeSigned>)     \
+    M(i32x4_extmul_low_i16x8_u, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::Low, MakeUnsigned>)   \
+    M(i32x4_extmul_high_i16x8_s, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::High, MakeSigned>)   \
+    M(i32x4_extmul_high_i16x8_u, Operators::VectorIntegerExtOp<4, Operators::Multiply, Operators::VectorExt::High, MakeUnsigned>)
+
+#define ENUMERATE_UNARY_SIMD_KERNELS(M)                                                                      \
+    M(i8x16_abs, Operators::VectorIntegerUnaryOp<16, Operators::Absolute>)                                   \
+    M(i16x8_abs, Operators::VectorIntegerUnaryOp<8, Operators::Absolute>)                                    \
+    M(i32x4_abs, Operators::VectorIntegerUnaryOp<4, Operators::Absolute>)                                    \
+    M(i8x16_popcnt, Operators::VectorIntegerUnaryOp<16, Operators::PopCount>)                                \
+    M(i16x8_extend_low_i8x16_s, Operators::VectorIntegerExt<8, Operators::VectorExt::Low, MakeSigned>)       \
+    M(i16x8_extend_low_i8x16_u, Operators::VectorIntegerExt<8, Operators::VectorExt::Low, MakeUnsigned>)     \
+    M(i16x8_extend_high_i8x16_s, Operators::VectorIntegerExt<8, Operators::VectorExt::High, MakeSigned>)     \
+    M(i16x8_extend_high_i8x16_u, Operators::VectorIntegerExt<8, Operators::VectorExt::High, MakeUnsigned>)   \
+    M(i32x4_extend_low_i16x8_s, Operators::VectorIntegerExt<4, Operators::VectorExt::Low, MakeSigned>)       \
+    M(i32x4_extend_low_i16x8_u, Operators::VectorIntegerExt<4, Operators::VectorExt::Low, MakeUnsigned>)     \
+    M(i32x4_extend_high_i16x8_s, Operators::VectorIntegerExt<4, Operators::VectorExt::High, MakeSigned>)     \
+    M(i32x4_extend_high_i16x8_u, Operators::VectorIntegerExt<4, Operators::VectorExt::High, MakeUnsigned>)   \
+    M(i64x2_extend_low_i32x4_s, Operators::VectorIntegerExt<2, Operators::VectorExt::Low, MakeSigned>)       \
+    M(i64x2_extend_low_i32x4_u, Operators::VectorIntegerExt<2, Operators::VectorExt::Low, MakeUnsigned>)     \
+    M(i64x2_extend_high_i32x4_s, Operators::VectorIntegerExt<2, Operators::VectorExt::High, MakeSigned>)     \
+    M(i64x2_extend_high_i32x4_u, Operators::VectorIntegerExt<2, Operators::VectorExt::High, MakeUnsigned>)   \
+    M(i16x8_extadd_pairwise_i8x16_s, Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeSigned>)   \
+    M(i16x8_extadd_pairwise_i8x16_u, Operators::VectorIntegerExtOpPairwise<8, Operators::Add, MakeUnsigned>) \
+    M(i32x4_extadd_pairwise_i16x8_s, Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeSigned>)   \
+    M(i32x4_extadd_pairwise_i16x8_u, Operators::VectorIntegerExtOpPairwise<4, Operators::Add, MakeUnsigned>)
+
+#define ENUMERATE_MASK_SIMD_KERNELS(M)              \
+    M(i8x16_all_true, Operators::VectorAllTrue<16>) \
+    M(i16x8_all_true, Operators::VectorAllTrue<8>)  \
+    M(i32x4_all_true, Operators::VectorAllTrue<4>)  \
+    M(i64x2_all_true, Operators::VectorAllTrue<2>)  \
+    M(i8x16_bitmask, Operators::VectorBitmask<16>)  \
+    M(i16x8_bitmask, Operators::VectorBitmask<8>)   \
+    M(i32x4_bitmask, Operators::VectorBitmask<4>)   \
+    M(i64x2_bitmask, Operators::VectorBitmask<2>)
+
+struct Kernels {
+#define M(name, ...) u128 (*name)(u128, u128);
+    ENUMERATE_BINARY_SIMD_KERNELS(M)
+#undef M
+#define M(name, ...) u128 (*name)(u128);
+    ENUMERATE_UNARY_SIMD_KERNELS(M)
+#undef M
+#define M(name, ...) i32 (*name)(u128);
+    ENUMERATE_MASK_SIMD_KERNELS(M)
+#undef M
+};
+
+// The best set of kernels the current CPU supports, picked once at startup.
+extern Kernels const& dispatched_kernels;
+
+struct KernelSet {
+    StringView name;
+    Kernels const& kernels;
+};
+
+// Every set of kernels the current CPU supports, starting with the portable one.
+Vector<KernelSet> available_kernel_sets();
+
+// Lets a kernel stand in for an operator in BytecodeInterpreter::binary_numeric_operation() and unary_operation(),
+// for when instructions are run one by one. Threaded dispatch looks kernels up once, when it pre-decodes an expression.
+template<auto kernel>
+struct Dispatched {
+    template<typename... Args>
+    auto operator()(Args... args) const
+    {
+        return (dispatched_kernels.*kernel)(args...);
+    }
+
+    static StringView name() { return "simd_kernel"sv; }
+};
+
+}
@@ -697,6 +697,28 @@ private:
     Vector<Memory> m_memories;
 };
 
+// A pre-decoded instruction, as executed by the bytecode interpreter's threaded dispatch loop.
+// Superinstructions live on the first instruction of the sequence they replace, and skip the rest of it.
+struct CompiledInstruction {
+    void const* handler { nullptr };
+    u32 length { 1 };
+    u32 operands[3] { 0, 0, 0 };
+    i64 immediate { 0 };
+    // The v128 kernel to run, picked from the CPU's kernel set once when the expression is pre-decoded.
+    union {
+        u128 (*binary_kernel)(u128, u128) { nullptr };
+        u128 (*unary_kernel)(u128);
+        i32 (*mask_kernel)(u128);
+    };
+};
+
+// Where a branch ends up, resolved once when the bytecode interpreter pre-decodes an expression.
+struct CompiledBranchTarget {
+    u32 labels_to_drop { 0 };
+    u32 arity { 0 };
+    size_t continuation { 0 };
+};
+
 class Expression {
 public:
     explicit Expression(Vector<Instruction> instructions)
@@ -706,10 +728,17 @@ public:
 
     auto& instructions() const { return m_instructions; }
 
+    // Lazily filled in by the bytecode interpreter the first time it runs this expression,
+    // with one entry per instruction (so instruction pointers stay valid), plus one to stop at.
+    auto& compiled_instructions() const { return m_compiled_instructions; }
+    auto& compiled_branch_targets() const { return m_compiled_branch_targets; }
+
     static ParseResult<Expression> parse(Stream& stream, Optional<size_t> size_hint = {});
 
 private:
     Vector<Instruction> m_instructions;
+    mutable Vector<CompiledInstruction> m_compiled_instructions;
+    mutable Vector<CompiledBranchTarget> m_compiled_branch_targets;
 };
 
 class GlobalSection {
@@ -69,11 +69,13 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/HTML/TagNames.h>
 #include <LibWeb/HighResolutionTime/TimeOrigin.h>
 #include <LibWeb/Layout/Node.h>
 #include <LibWeb/Namespace.h>
@@ -1440,11 +1442,8 @@ void StyleComputer::start_needed_transitions(StyleProperties const& previous_sty
     }
 }
 
-// https://www.w3.org/TR/css-cascade/#cascading
-// https://drafts.csswg.org/css-cascade-5/#layering
-void StyleComputer::compute_cascaded_values(StyleProperties& style, DOM::Element& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, bool& did_match_any_pseudo_element_rules, ComputeStyleMode mode) const
+StyleComputer::MatchingRuleSet StyleComputer::build_matching_rule_set(DOM::Element const& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element) const
 {
-    // First, we collect all the CSS rules whose selectors match `element`:
     MatchingRuleSet matching_rule_set;
     matching_rule_set.user_agent_rules = collect_matching_rules(element, CascadeOrigin::UserAgent, pseudo_element);
     sort_matching_rules(matching_rule_set.user_agent_rules);
@@ -1460,6 +1459,14 @@ void StyleComputer::compute_cascaded_values(StyleProperties& style, DOM::Element
     auto unlayered_author_rules = collect_matching_rules(element, CascadeOrigin::Author, pseudo_element);
     sort_matching_rules(unlayered_author_rules);
     matching_rule_set.author_rules.append({ {}, unlayered_author_rules });
+    return matching_rule_set;
+}
+
+// https://www.w3.org/TR/css-cascade/#cascading
+// https://drafts.csswg.org/css-cascade-5/#layering
+void StyleComputer::compute_cascaded_values(StyleProperties& style, DOM::Element& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, MatchingRuleSet const& matching_rule_set, bool& did_match_any_pseudo_element_rules, ComputeStyleMode mode) const
+{
+    // NOTE: The CSS rules whose selectors match `element` have already been collected into `matching_rule_set`.
 
     if (mode == ComputeStyleMode::CreatePseudoElementStyleIfNeeded) {
         VERIFY(pseudo_element.has_value());
@@ -2309,10 +2316,32 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
 
     ScopeGuard guard { [&element]() { element.set_needs_style_update(false); } };
 
+    bool const may_use_style_caches = mode == ComputeStyleMode::Normal && !pseudo_element.has_value() && can_use_style_caches(element);
+
+    // If a sibling with the same tag name, attributes and state already went through steps 1-7, it computed exactly what we would.
+    if (may_use_style_caches) {
+        if (auto shared_style = find_style_shared_by_sibling(element); shared_style.has_value())
+            return reuse_cached_style(element, *shared_style);
+    }
+
+    auto matching_rule_set = build_matching_rule_set(element, pseudo_element);
+
+    // Otherwise, if another element matched the same rules under a parent with the same computed style, steps 1-7 would
+    // compute the same thing again.
+    Optional<MatchedPropertiesCacheKey> matched_properties_cache_key;
+    if (may_use_style_caches) {
+        matched_properties_cache_key = make_matched_properties_cache_key(element, matching_rule_set);
+        if (auto matched_properties = find_matched_properties(*matched_properties_cache_key); matched_properties.has_value()) {
+            auto style = reuse_cached_style(element, *matched_properties);
+            m_style_sharing_candidates.set(&element, *matched_properties);
+            return style;
+        }
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
-    compute_cascaded_values(style, element, pseudo_element, did_match_any_pseudo_element_rules, mode);
+    compute_cascaded_values(style, element, pseudo_element, matching_rule_set, did_match_any_pseudo_element_rules, mode);
 
     if (mode == ComputeStyleMode::CreatePseudoElementStyleIfNeeded) {
         // NOTE: If we're computing style for a pseudo-element, we look for a number of reasons to bail early.
@@ -2361,6 +2390,19 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
     // 7. Resolve effective overflow values
     resolve_effective_overflow_values(style);
 
+    // NOTE: Styles that start CSS animations are not cached, since the cascade has to create an animation for each element.
+    if (matched_properties_cache_key.has_value() && !style->animation_name_source()) {
+        CachedStyle cached_style { style->clone(), element.custom_properties({}) };
+        m_style_sharing_candidates.set(&element, cached_style);
+        m_matched_properties_cache.ensure(matched_properties_cache_key->hash).append({ matched_properties_cache_key.release_value(), move(cached_style) });
+    }
+
+    finish_computing_style(style, element, pseudo_element);
+    return style;
+}
+
+void StyleComputer::finish_computing_style(StyleProperties& style, DOM::Element& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element) const
+{
     // 8. Let the element adjust computed style
     element.adjust_computed_style(style);
 
@@ -2370,10 +2412,223 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
     if (auto const* previous_style = element.computed_css_values()) {
         start_needed_transitions(*previous_style, style, element, pseudo_element);
     }
+}
+
+static bool have_same_attributes(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    for (u32 i = 0; i < a.attribute_list_size(); ++i) {
+        auto const& a_attribute = *a.attributes()->item(i);
+        auto const& b_attribute = *b.attributes()->item(i);
+        if (a_attribute.local_name() != b_attribute.local_name() || a_attribute.namespace_uri() != b_attribute.namespace_uri() || a_attribute.value() != b_attribute.value())
+            return false;
+    }
+    return true;
+}
 
+static bool have_same_property_values(StyleProperties const& a, StyleProperties const& b)
+{
+    for (auto i = to_underlying(CSS::first_property_id); i <= to_underlying(CSS::last_property_id); ++i) {
+        auto a_value = a.maybe_null_property(static_cast<PropertyID>(i));
+        auto b_value = b.maybe_null_property(static_cast<PropertyID>(i));
+        if (a_value == b_value)
+            continue;
+        if (!a_value || !b_value || !a_value->equals(*b_value))
+            return false;
+    }
+    return true;
+}
+
+static bool declaration_has_var_or_attr(PropertyOwningCSSStyleDeclaration const& declaration)
+{
+    auto contains_var_or_attr = [](CSSStyleValue const& value) {
+        return value.is_unresolved() && value.as_unresolved().contains_var_or_attr();
+    };
+    for (auto const& property : declaration.properties()) {
+        if (contains_var_or_attr(property.value))
+            return true;
+    }
+    for (auto const& it : declaration.custom_properties()) {
+        if (contains_var_or_attr(it.value.value))
+            return true;
+    }
+    return false;
+}
+
+// Whether selectors could match this element but not an otherwise identical sibling (or vice versa) because of state that
+// isn't reflected in its attributes.
+static bool has_state_not_reflected_in_attributes(DOM::Element const& element)
+{
+    // :host, :defined and the form, media and open states.
+    if (element.shadow_root() || element.local_name().bytes_as_string_view().contains('-'))
+        return true;
+    if (element.local_name().is_one_of(HTML::TagNames::input, HTML::TagNames::textarea, HTML::TagNames::select, HTML::TagNames::option,
+            HTML::TagNames::optgroup, HTML::TagNames::button, HTML::TagNames::fieldset, HTML::TagNames::progress, HTML::TagNames::meter,
+            HTML::TagNames::details, HTML::TagNames::dialog, HTML::TagNames::audio, HTML::TagNames::video, HTML::TagNames::bdi))
+        return true;
+    if (element.has_attribute(HTML::AttributeNames::popover))
+        return true;
+
+    // :dir() for elements whose directionality comes from their text.
+    if (auto dir = element.attribute(HTML::AttributeNames::dir); dir.has_value() && dir->equals_ignoring_ascii_case("auto"sv))
+        return true;
+
+    // :hover, :focus, :focus-within, :target, :target-within and :active.
+    auto const& document = element.document();
+    auto is_inclusive_ancestor_of = [&](DOM::Node const* node) {
+        return node && element.is_shadow_including_inclusive_ancestor_of(*node);
+    };
+    return is_inclusive_ancestor_of(document.hovered_node())
+        || is_inclusive_ancestor_of(document.focused_element())
+        || is_inclusive_ancestor_of(document.target_element())
+        || element.is_active();
+}
+
+bool StyleComputer::can_use_style_caches(DOM::Element const& element) const
+{
+    if (!m_style_caches_enabled)
+        return false;
+
+    // NOTE: Steps 1-7 only look at the element's parent style, which is part of every cache key. Children of shadow roots
+    //       inherit from their shadow host instead, so we leave those alone.
+    auto const* parent = element.parent_element();
+    if (!parent || !parent->computed_css_values())
+        return false;
+
+    // Inline style, SVG presentation attributes and MathML's display rules feed into steps 1-7 in ways the cache keys don't capture.
+    if (element.inline_style() || element.namespace_uri() != Namespace::HTML)
+        return false;
+
+    // NOTE: <br> is never blockified, see required_box_type_transformation().
+    if (is<HTML::HTMLBRElement>(element))
+        return false;
+
+    // The element's animations (including CSS transitions) are applied as part of the cascade.
+    if (element.has_associated_animations() || element.cached_animation_name_animation({}))
+        return false;
+
+    return true;
+}
+
+bool StyleComputer::can_share_style_with_siblings(DOM::Element const& element) const
+{
+    if (m_has_sibling_dependent_rules_for_any_tag_name || m_tag_names_with_sibling_dependent_rules.contains(element.local_name()))
+        return false;
+    return !has_state_not_reflected_in_attributes(element);
+}
+
+Optional<StyleComputer::CachedStyle const&> StyleComputer::find_style_shared_by_sibling(DOM::Element const& element) const
+{
+    if (!can_share_style_with_siblings(element))
+        return {};
+
+    // NOTE: Siblings share a parent, so they match the same rules if they have the same tag name, attributes and state,
+    //       and no rule looks at their position among their siblings. We only look a few siblings back to keep misses cheap.
+    static constexpr size_t max_siblings_to_look_at = 8;
+    size_t siblings_looked_at = 0;
+    for (auto const* sibling = element.previous_element_sibling(); sibling && siblings_looked_at < max_siblings_to_look_at; sibling = sibling->previous_element_sibling(), ++siblings_looked_at) {
+        auto it = m_style_sharing_candidates.find(sibling);
+        if (it == m_style_sharing_candidates.end())
+            continue;
+        if (sibling->local_name() != element.local_name() || !have_same_attributes(*sibling, element) || has_state_not_reflected_in_attributes(*sibling))
+            continue;
+        return it->value;
+    }
+    return {};
+}
+
+StyleComputer::MatchedPropertiesCacheKey StyleComputer::make_matched_properties_cache_key(DOM::Element const& element, MatchingRuleSet const& matching_rule_set) const
+{
+    auto const& parent_style = *element.parent_element()->computed_css_values();
+    u32 hash = pair_int_hash(element.local_name().hash(), ptr_hash(parent_style.m_data.ptr()));
+
+    Vector<CSSRule const*> matched_rules;
+    bool has_var_or_attr = false;
+    auto append_rules = [&](Vector<MatchingRule> const& rules) {
+        for (auto const& rule : rules) {
+            matched_rules.append(rule.rule.ptr());
+            hash = pair_int_hash(hash, ptr_hash(rule.rule.ptr()));
+            if (!has_var_or_attr)
+                has_var_or_attr = declaration_has_var_or_attr(rule.declaration());
+        }
+        // NOTE: Keep the origins and layers apart, since they cascade differently.
+        matched_rules.append(nullptr);
+    };
+    append_rules(matching_rule_set.user_agent_rules);
+    append_rules(matching_rule_set.user_rules);
+    for (auto const& layer : matching_rule_set.author_rules)
+        append_rules(layer.rules);
+
+    auto presentational_hints = StyleProperties::create();
+    element.apply_presentational_hints(presentational_hints);
+    if (element.supports_dimension_attributes()) {
+        apply_dimension_attribute(presentational_hints, element, HTML::AttributeNames::width, CSS::PropertyID::Width);
+        apply_dimension_attribute(presentational_hints, element, HTML::AttributeNames::height, CSS::PropertyID::Height);
+    }
+    presentational_hints->for_each_property([&](PropertyID property_id, CSSStyleValue const&) {
+        hash = pair_int_hash(hash, to_underlying(property_id));
+    });
+
+    return MatchedPropertiesCacheKey {
+        .local_name = element.local_name(),
+        .matched_rules = move(matched_rules),
+        .parent_style_data = *parent_style.m_data.ptr(),
+        .presentational_hints = move(presentational_hints),
+        .element_whose_attributes_matter = has_var_or_attr ? &element : nullptr,
+        .hash = hash,
+    };
+}
+
+bool StyleComputer::MatchedPropertiesCacheKey::matches(MatchedPropertiesCacheKey const& other) const
+{
+    if (hash != other.hash || local_name != other.local_name || parent_style_data.ptr() != other.parent_style_data.ptr() || matched_rules != other.matched_rules)
+        return false;
+    if (element_whose_attributes_matter || other.element_whose_attributes_matter) {
+        if (!element_whose_attributes_matter || !other.element_whose_attributes_matter || !have_same_attributes(*element_whose_attributes_matter, *other.element_whose_attributes_matter))
+            return false;
+    }
+    return have_same_property_values(presentational_hints, other.presentational_hints);
+}
+
+Optional<StyleComputer::CachedStyle const&> StyleComputer::find_matched_properties(MatchedPropertiesCacheKey const& key) const
+{
+    auto it = m_matched_properties_cache.find(key.hash);
+    if (it == m_matched_properties_cache.end())
+        return {};
+    for (auto const& entry : it->value) {
+        if (entry.key.matches(key))
+            return entry.cached_style;
+    }
+    return {};
+}
+
+NonnullRefPtr<StyleProperties> StyleComputer::reuse_cached_style(DOM::Element& element, CachedStyle const& cached_style) const
+{
+    // NOTE: The clone shares its property values with the cached style until either of them is modified.
+    auto style = cached_style.style->clone();
+    element.set_custom_properties({}, cached_style.custom_properties);
+    finish_computing_style(style, element, {});
     return style;
 }
 
+void StyleComputer::clear_style_caches() const
+{
+    m_style_sharing_candidates.clear();
+    m_matched_properties_cache.clear();
+}
+
+void StyleComputer::begin_style_update()
+{
+    m_style_caches_enabled = true;
+}
+
+void StyleComputer::end_style_update()
+{
+    m_style_caches_enabled = false;
+    clear_style_caches();
+}
+
 void StyleComputer::build_rule_cache_if_needed() const
 {
     if (m_author_rule_cache && m_user_rule_cache && m_user_agent_rule_cache)
@@ -2417,6 +2672,42 @@ static Optional<SimplifiedSelectorForBucketing> is_roundabout_selector_bucketabl
     return {};
 }
 
+static bool compound_selector_depends_on_siblings_or_contents(Selector::CompoundSelector const& compound_selector)
+{
+    if (compound_selector.combinator == Selector::Combinator::NextSibling || compound_selector.combinator == Selector::Combinator::SubsequentSibling)
+        return true;
+
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+            continue;
+        auto const& pseudo_class = simple_selector.pseudo_class();
+        switch (pseudo_class.type) {
+        case PseudoClass::Empty:
+        case PseudoClass::FirstChild:
+        case PseudoClass::FirstOfType:
+        case PseudoClass::Has:
+        case PseudoClass::LastChild:
+        case PseudoClass::LastOfType:
+        case PseudoClass::NthChild:
+        case PseudoClass::NthLastChild:
+        case PseudoClass::NthLastOfType:
+        case PseudoClass::NthOfType:
+        case PseudoClass::OnlyChild:
+        case PseudoClass::OnlyOfType:
+            return true;
+        default:
+            break;
+        }
+        for (auto const& argument_selector : pseudo_class.argument_selector_list) {
+            for (auto const& argument_compound_selector : argument_selector->compound_selectors()) {
+                if (compound_selector_depends_on_siblings_or_contents(argument_compound_selector))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
 NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin)
 {
     auto rule_cache = make<RuleCache>();
@@ -2500,6 +2791,19 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     }
                 }
 
+                // NOTE: Only the subject compound and the compounds it reaches through sibling combinators can tell siblings apart;
+                //       everything further left is matched against ancestors, which siblings have in common.
+                auto const& subject_compound_selector = selector.compound_selectors().last();
+                if (compound_selector_depends_on_siblings_or_contents(subject_compound_selector)) {
+                    auto tag_name_selector = subject_compound_selector.simple_selectors.first_matching([](auto const& simple_selector) {
+                        return simple_selector.type == CSS::Selector::SimpleSelector::Type::TagName;
+                    });
+                    if (tag_name_selector.has_value())
+                        rule_cache->tag_names_with_sibling_dependent_rules.set(tag_name_selector->qualified_name().name.lowercase_name);
+                    else
+                        rule_cache->has_sibling_dependent_rules_for_any_tag_name = true;
+                }
+
                 // NOTE: We traverse the simple selectors in reverse order to make sure that class/ID buckets are preferred over tag buckets
                 //       in the common case of div.foo or div#foo selectors.
                 bool added_to_bucket = false;
@@ -2713,10 +3017,20 @@ void StyleComputer::build_rule_cache()
     m_user_agent_rule_cache = make_rule_cache_for_cascade_origin(CascadeOrigin::UserAgent);
 
     m_has_has_selectors = m_author_rule_cache->has_has_selectors || m_user_rule_cache->has_has_selectors || m_user_agent_rule_cache->has_has_selectors;
+
+    m_has_sibling_dependent_rules_for_any_tag_name = false;
+    m_tag_names_with_sibling_dependent_rules.clear();
+    for (auto const* rule_cache : { m_author_rule_cache.ptr(), m_user_rule_cache.ptr(), m_user_agent_rule_cache.ptr() }) {
+        m_has_sibling_dependent_rules_for_any_tag_name |= rule_cache->has_sibling_dependent_rules_for_any_tag_name;
+        for (auto const& tag_name : rule_cache->tag_names_with_sibling_dependent_rules)
+            m_tag_names_with_sibling_dependent_rules.set(tag_name);
+    }
 }
 
 void StyleComputer::invalidate_rule_cache()
 {
+    clear_style_caches();
+
     m_author_rule_cache = nullptr;
 
     // NOTE: We could be smarter about keeping the user rule cache, and style sheet.
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Font/VectorFont.h>
@@ -134,6 +135,11 @@ public:
     void push_ancestor(DOM::Element const&);
     void pop_ancestor(DOM::Element const&);
 
+    // The style sharing and matched properties caches are only valid while the DOM and the style sheets stay unchanged,
+    // so they are only consulted between these two calls, which bracket a single style update of the document.
+    void begin_style_update();
+    void end_style_update();
+
     NonnullRefPtr<StyleProperties> create_document_style() const;
 
     NonnullRefPtr<StyleProperties> compute_style(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type> = {}) const;
@@ -174,8 +180,12 @@ private:
 
     [[nodiscard]] bool should_reject_with_ancestor_filter(Selector const&) const;
 
+    struct MatchingRuleSet;
+
     RefPtr<StyleProperties> compute_style_impl(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, ComputeStyleMode) const;
-    void compute_cascaded_values(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
+    MatchingRuleSet build_matching_rule_set(DOM::Element const&, Optional<CSS::Selector::PseudoElement::Type>) const;
+    void compute_cascaded_values(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, MatchingRuleSet const&, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
+    void finish_computing_style(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_descending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
     RefPtr<Gfx::FontCascadeList const> font_matching_algorithm(FontFaceKey const& key, float font_size_in_pt) const;
@@ -217,6 +227,37 @@ private:
     void build_rule_cache();
     void build_rule_cache_if_needed() const;
 
+    struct MatchedPropertiesCacheKey {
+        FlyString local_name;
+        Vector<CSSRule const*> matched_rules;
+        NonnullRefPtr<StyleProperties::Data const> parent_style_data;
+        NonnullRefPtr<StyleProperties const> presentational_hints;
+        // If any of the matched declarations still has var() or attr() in it, the result may depend on the attributes of
+        // the element itself, so those have to be equal as well.
+        DOM::Element const* element_whose_attributes_matter { nullptr };
+        u32 hash { 0 };
+
+        bool matches(MatchedPropertiesCacheKey const&) const;
+    };
+
+    struct CachedStyle {
+        NonnullRefPtr<StyleProperties const> style;
+        HashMap<FlyString, StyleProperty> custom_properties;
+    };
+
+    struct MatchedPropertiesCacheEntry {
+        MatchedPropertiesCacheKey key;
+        CachedStyle cached_style;
+    };
+
+    [[nodiscard]] bool can_use_style_caches(DOM::Element const&) const;
+    [[nodiscard]] bool can_share_style_with_siblings(DOM::Element const&) const;
+    [[nodiscard]] Optional<CachedStyle const&> find_style_shared_by_sibling(DOM::Element const&) const;
+    [[nodiscard]] MatchedPropertiesCacheKey make_matched_properties_cache_key(DOM::Element const&, MatchingRuleSet const&) const;
+    [[nodiscard]] Optional<CachedStyle const&> find_matched_properties(MatchedPropertiesCacheKey const&) const;
+    NonnullRefPtr<StyleProperties> reuse_cached_style(DOM::Element&, CachedStyle const&) const;
+    void clear_style_caches() const;
+
     JS::NonnullGCPtr<DOM::Document> m_document;
 
     struct RuleCache {
@@ -231,6 +272,11 @@ private:
         HashMap<FlyString, NonnullRefPtr<Animations::KeyframeEffect::KeyFrameSet>> rules_by_animation_keyframes;
 
         bool has_has_selectors { false };
+
+        // Tag names of rules whose subject depends on the element's position among its siblings or on its contents
+        // (e.g. `li:nth-child(odd)` or `h2 + p`). Rules like that without a tag name set the flag below instead.
+        HashTable<FlyString> tag_names_with_sibling_dependent_rules;
+        bool has_sibling_dependent_rules_for_any_tag_name { false };
     };
 
     NonnullOwnPtr<RuleCache> make_rule_cache_for_cascade_origin(CascadeOrigin);
@@ -238,6 +284,8 @@ private:
     RuleCache const& rule_cache_for_cascade_origin(CascadeOrigin) const;
 
     bool m_has_has_selectors { false };
+    HashTable<FlyString> m_tag_names_with_sibling_dependent_rules;
+    bool m_has_sibling_dependent_rules_for_any_tag_name { false };
     OwnPtr<RuleCache> m_author_rule_cache;
     OwnPtr<RuleCache> m_user_rule_cache;
     OwnPtr<RuleCache> m_user_agent_rule_cache;
@@ -252,6 +300,10 @@ private:
     CSSPixelRect m_viewport_rect;
 
     CountingBloomFilter<u8, 14> m_ancestor_filter;
+
+    bool m_style_caches_enabled { false };
+    mutable HashMap<DOM::Element const*, CachedStyle> m_style_sharing_candidates;
+    mutable HashMap<u32, Vector<MatchedPropertiesCacheEntry>> m_matched_properties_cache;
 };
 
 class FontLoader : public ResourceClient {
@@ -116,6 +116,7 @@
 #include <LibWeb/Infra/Strings.h>
 #include <LibWeb/IntersectionObserver/IntersectionObserver.h>
 #include <LibWeb/Layout/BlockFormattingContext.h>
+#include <LibWeb/Layout/LayoutState.h>
 #include <LibWeb/Layout/TreeBuilder.h>
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Namespace.h>
@@ -974,6 +975,7 @@ WebIDL::ExceptionOr<void> Document::set_title(String const& title)
 
 void Document::tear_down_layout_tree()
 {
+    m_layout_state = nullptr;
     m_layout_root = nullptr;
     m_paintable = nullptr;
 }
@@ -1129,6 +1131,55 @@ static void propagate_overflow_to_viewport(Element& root_element, Layout::Viewpo
     overflow_origin_computed_values.set_overflow_y(CSS::Overflow::Visible);
 }
 
+static void collect_nodes_needing_layout(Layout::Node const& node, Vector<Layout::Node const&>& nodes)
+{
+    if (node.needs_layout())
+        nodes.append(node);
+    if (!node.child_needs_layout())
+        return;
+    for (auto const* child = node.first_child(); child; child = child->next_sibling())
+        collect_nodes_needing_layout(*child, nodes);
+}
+
+// Returns the outermost layout boundaries that contain every node that needs layout,
+// or nothing if some change may affect geometry outside of any layout boundary.
+static Optional<HashTable<Layout::Box const*>> find_relayout_roots(Layout::Viewport const& viewport)
+{
+    Vector<Layout::Node const&> nodes_needing_layout;
+    collect_nodes_needing_layout(viewport, nodes_needing_layout);
+
+    HashMap<Layout::Box const*, bool> is_layout_boundary_cache;
+    auto is_layout_boundary = [&](Layout::Box const& box) {
+        return is_layout_boundary_cache.ensure(&box, [&] { return Layout::FormattingContext::is_layout_boundary(box); });
+    };
+
+    HashTable<Layout::Box const*> boundaries;
+    for (auto const& node : nodes_needing_layout) {
+        // NOTE: A boundary that needs layout itself may have changed size, so we look for the nearest boundary *above* each node.
+        Layout::Box const* boundary = nullptr;
+        for (auto const* ancestor = node.parent(); ancestor; ancestor = ancestor->parent()) {
+            if (ancestor->is_box() && is_layout_boundary(static_cast<Layout::Box const&>(*ancestor))) {
+                boundary = static_cast<Layout::Box const*>(ancestor);
+                break;
+            }
+        }
+        if (!boundary)
+            return {};
+        boundaries.set(boundary);
+    }
+
+    // Boundaries nested inside another one are laid out as part of it.
+    HashTable<Layout::Box const*> relayout_roots;
+    for (auto const* boundary : boundaries) {
+        bool is_nested = false;
+        for (auto const* ancestor = boundary->parent(); ancestor && !is_nested; ancestor = ancestor->parent())
+            is_nested = ancestor->is_box() && boundaries.contains(static_cast<Layout::Box const*>(ancestor));
+        if (!is_nested)
+            relayout_roots.set(boundary);
+    }
+    return relayout_roots;
+}
+
 void Document::update_layout()
 {
     auto navigable = this->navigable();
@@ -1142,7 +1193,7 @@ void Document::update_layout()
 
     update_style();
 
-    if (!m_needs_layout && m_layout_root)
+    if (!m_needs_layout && m_layout_root && !m_layout_root->needs_layout() && !m_layout_root->child_needs_layout())
         return;
 
     // NOTE: If this is a document hosting <template> contents, layout is unnecessary.
@@ -1153,6 +1204,8 @@ void Document::update_layout()
     auto viewport_rect = navigable->viewport_rect();
 
     if (!m_layout_root) {
+        m_layout_state = nullptr;
+
         Layout::TreeBuilder tree_builder;
         m_layout_root = verify_cast<Layout::Viewport>(*tree_builder.build(*this));
 
@@ -1162,28 +1215,59 @@ void Document::update_layout()
         }
     }
 
-    Layout::LayoutState layout_state;
+    // If only parts of the layout tree have changed since the last layout, and all of them are inside layout boundaries,
+    // we carry over the results of the previous layout and only lay out the insides of those boundaries again.
+    Optional<HashTable<Layout::Box const*>> relayout_roots;
+    if (!m_needs_layout && m_layout_state) {
+        relayout_roots = find_relayout_roots(*m_layout_root);
+        if (relayout_roots.has_value()) {
+            for (auto const* relayout_root : *relayout_roots) {
+                if (!m_layout_state->used_values_per_layout_node.contains(*relayout_root)) {
+                    relayout_roots.clear();
+                    break;
+                }
+            }
+        }
+    }
+
+    auto layout_state = make<Layout::LayoutState>();
 
     {
-        Layout::BlockFormattingContext root_formatting_context(layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
+        Layout::BlockFormattingContext root_formatting_context(*layout_state, Layout::LayoutMode::Normal, *m_layout_root, nullptr);
 
-        auto& viewport = static_cast<Layout::Viewport&>(*m_layout_root);
-        auto& viewport_state = layout_state.get_mutable(viewport);
-        viewport_state.set_content_width(viewport_rect.width());
-        viewport_state.set_content_height(viewport_rect.height());
+        if (relayout_roots.has_value()) {
+            layout_state->carry_over_used_values_from(*m_layout_state, *relayout_roots);
+            for (auto const* relayout_root : *relayout_roots)
+                root_formatting_context.layout_inside_layout_boundary(*relayout_root);
+        } else {
+            auto& viewport = static_cast<Layout::Viewport&>(*m_layout_root);
+            auto& viewport_state = layout_state->get_mutable(viewport);
+            viewport_state.set_content_width(viewport_rect.width());
+            viewport_state.set_content_height(viewport_rect.height());
+
+            if (document_element && document_element->layout_node()) {
+                auto& icb_state = layout_state->get_mutable(verify_cast<Layout::NodeWithStyleAndBoxModelMetrics>(*document_element->layout_node()));
+                icb_state.set_content_width(viewport_rect.width());
+            }
 
-        if (document_element && document_element->layout_node()) {
-            auto& icb_state = layout_state.get_mutable(verify_cast<Layout::NodeWithStyleAndBoxModelMetrics>(*document_element->layout_node()));
-            icb_state.set_content_width(viewport_rect.width());
+            root_formatting_context.run(
+                Layout::AvailableSpace(
+                    Layout::AvailableSize::make_definite(viewport_rect.width()),
+                    Layout::AvailableSize::make_definite(viewport_rect.height())));
         }
+    }
+
+    layout_state->commit(*m_layout_root);
 
-        root_formatting_context.run(
-            Layout::AvailableSpace(
-                Layout::AvailableSize::make_definite(viewport_rect.width()),
-                Layout::AvailableSize::make_definite(viewport_rect.height())));
+    size_t laid_out_boxes = 0;
+    for (auto const& it : layout_state->used_values_per_layout_node) {
+        if (it.key->is_box())
+            ++laid_out_boxes;
     }
+    m_boxes_laid_out_in_last_layout = laid_out_boxes - layout_state->boxes_taken_over_from_previous_layout();
 
-    layout_state.commit(*m_layout_root);
+    m_layout_state = move(layout_state);
+    m_layout_root->clear_needs_layout_in_subtree();
 
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
@@ -1285,7 +1369,9 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
+    style_computer().begin_style_update();
     auto invalidation = update_style_recursively(*this, style_computer());
+    style_computer().end_style_update();
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout_tree();
     } else {
@@ -243,6 +243,9 @@ public:
 
     void set_needs_layout();
 
+    // The number of boxes that went through layout in the most recent layout update.
+    size_t boxes_laid_out_in_last_layout() const { return m_boxes_laid_out_in_last_layout; }
+
     void invalidate_layout_tree();
     void invalidate_stacking_context_tree();
 
@@ -768,6 +771,10 @@ private:
 
     JS::GCPtr<Layout::Viewport> m_layout_root;
 
+    // The used values of the most recent layout, kept around so that a relayout can reuse them for unchanged subtrees.
+    OwnPtr<Layout::LayoutState> m_layout_state;
+    size_t m_boxes_laid_out_in_last_layout { 0 };
+
     Optional<Color> m_normal_link_color;
     Optional<Color> m_active_link_color;
     Optional<Color> m_visited_link_color;
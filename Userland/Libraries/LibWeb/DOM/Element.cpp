@@ -587,6 +587,8 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
         layout_node()->apply_style(*m_computed_css_values);
         if (invalidation.repaint && paintable())
             paintable()->set_needs_display();
+        if (invalidation.relayout)
+            layout_node()->set_needs_layout();
 
         // Do the same for pseudo-elements.
         for (auto i = 0; i < to_underlying(CSS::Selector::PseudoElement::Type::KnownPseudoElementCount); i++) {
@@ -603,8 +605,13 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
                 node_with_style->apply_style(*pseudo_element_style);
                 if (invalidation.repaint && node_with_style->paintable())
                     node_with_style->paintable()->set_needs_display();
+                if (invalidation.relayout)
+                    node_with_style->set_needs_layout();
             }
         }
+
+        // The layout nodes that need layout have been marked above, which lets the document skip a full relayout.
+        invalidation.relayout = false;
     }
 
     return invalidation;
@@ -30,6 +30,7 @@ namespace Web::Painting {
 class DisplayList;
 class DisplayListRecorder;
 class SVGGradientPaintStyle;
+class TileCache;
 using PaintStyle = RefPtr<SVGGradientPaintStyle>;
 }
 
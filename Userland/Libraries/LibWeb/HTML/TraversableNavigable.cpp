@@ -1380,8 +1380,12 @@ void TraversableNavigable::paint(DevicePixelRect const& content_rect, Gfx::Bitma
         }
 #endif
     } else {
+        if (!m_tile_cache)
+            m_tile_cache = make<Painting::TileCache>();
         Painting::DisplayListPlayerCPU player(target, display_list_player_type == DisplayListPlayerType::CPUWithExperimentalTransformSupport);
-        player.execute(display_list);
+        // NOTE: The tile grid is anchored to the document rather than the viewport, so tiles that stay on screen while
+        //       scrolling can be reused.
+        player.execute_in_tiles(display_list, m_tile_cache.ptr(), content_rect.location().to_type<int>());
     }
 }
 
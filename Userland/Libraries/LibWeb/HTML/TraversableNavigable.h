@@ -132,6 +132,9 @@ private:
     JS::NonnullGCPtr<SessionHistoryTraversalQueue> m_session_history_traversal_queue;
 
     String m_window_handle;
+
+    // Tiles of the previous frame, for the CPU painter to reuse the ones that didn't change.
+    OwnPtr<Painting::TileCache> m_tile_cache;
 };
 
 struct BrowsingContextAndDocument {
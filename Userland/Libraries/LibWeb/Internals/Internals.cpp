@@ -184,4 +184,9 @@ void Internals::simulate_drop(double x, double y)
     page.handle_drag_and_drop_event(DragEvent::Type::Drop, position, position, UIEvents::MouseButton::Primary, 0, 0, {});
 }
 
+WebIDL::UnsignedLong Internals::boxes_laid_out_in_last_layout()
+{
+    return internals_window().associated_document().boxes_laid_out_in_last_layout();
+}
+
 }
@@ -44,6 +44,8 @@ public:
     void simulate_drag_move(double x, double y);
     void simulate_drop(double x, double y);
 
+    WebIDL::UnsignedLong boxes_laid_out_in_last_layout();
+
 private:
     explicit Internals(JS::Realm&);
     virtual void initialize(JS::Realm&) override;
@@ -698,9 +698,13 @@ void BlockFormattingContext::layout_block_level_box(Box const& box, BlockContain
         left_space_before_children_formatted = space_used_before_children_formatted.left;
     }
 
+    bool did_reuse_previous_layout_inside = false;
     if (independent_formatting_context) {
-        // This box establishes a new formatting context. Pass control to it.
-        independent_formatting_context->run(box_state.available_inner_space_or_constraints_from(available_space));
+        // This box establishes a new formatting context. Pass control to it, unless nothing changed inside it since the previous layout.
+        auto available_inner_space = box_state.available_inner_space_or_constraints_from(available_space);
+        did_reuse_previous_layout_inside = reuse_previous_layout_inside(box, m_layout_mode, available_inner_space);
+        if (!did_reuse_previous_layout_inside)
+            independent_formatting_context->run(available_inner_space);
     } else {
         // This box participates in the current block container's flow.
         if (box.children_are_inline()) {
@@ -748,7 +752,7 @@ void BlockFormattingContext::layout_block_level_box(Box const& box, BlockContain
 
     bottom_of_lowest_margin_box = max(bottom_of_lowest_margin_box, box_state.offset.y() + box_state.content_height() + box_state.margin_box_bottom());
 
-    if (independent_formatting_context)
+    if (independent_formatting_context && !did_reuse_previous_layout_inside)
         independent_formatting_context->parent_context_did_dimension_child_root_box();
 }
 
@@ -113,6 +113,50 @@ bool FormattingContext::creates_block_formatting_context(Box const& box)
     return false;
 }
 
+bool FormattingContext::is_layout_boundary(Box const& box)
+{
+    if (box.is_viewport() || box.is_root_element() || !box.can_have_children())
+        return false;
+
+    // The box must get its size from its own style, without looking at its contents.
+    auto const& computed_values = box.computed_values();
+    if (!computed_values.width().is_length() || !computed_values.height().is_length())
+        return false;
+    auto is_content_independent_limit = [](CSS::Size const& size) {
+        return size.is_auto() || size.is_none() || size.is_length() || size.is_percentage();
+    };
+    if (!is_content_independent_limit(computed_values.min_width())
+        || !is_content_independent_limit(computed_values.max_width())
+        || !is_content_independent_limit(computed_values.min_height())
+        || !is_content_independent_limit(computed_values.max_height()))
+        return false;
+
+    // Flex, grid and table layout look at the contents of their children even when those have a definite size.
+    if (box.is_flex_item() || box.is_grid_item() || box.is_table_wrapper() || box.display().is_internal())
+        return false;
+
+    // Floats and margins must not escape, so the box has to establish an independent formatting context.
+    auto type = formatting_context_type_created_by_box(box);
+    if (!type.has_value() || (type != Type::Block && type != Type::Flex && type != Type::Grid))
+        return false;
+
+    // An inline-level box sits on a line of its parent, aligned by a baseline that box_baseline() derives from its
+    // contents, so relaying out its insides can move the line around it.
+    if (!box.display().is_block_outside())
+        return false;
+
+    // Absolutely positioned descendants that are placed relative to something outside the box would escape it too.
+    bool has_escaping_descendant = false;
+    box.for_each_in_subtree_of_type<Box>([&](Box const& descendant) {
+        if (descendant.is_absolutely_positioned() && !box.is_ancestor_of(*descendant.containing_block())) {
+            has_escaping_descendant = true;
+            return TraversalDecision::Break;
+        }
+        return TraversalDecision::Continue;
+    });
+    return !has_escaping_descendant;
+}
+
 Optional<FormattingContext::Type> FormattingContext::formatting_context_type_created_by_box(Box const& box)
 {
     if (box.is_replaced_box() && !box.can_have_children()) {
@@ -228,6 +272,9 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     if (!child_box.can_have_children())
         return {};
 
+    if (reuse_previous_layout_inside(child_box, layout_mode, available_space))
+        return nullptr;
+
     auto independent_formatting_context = create_independent_formatting_context_if_needed(m_state, layout_mode, child_box);
     if (independent_formatting_context)
         independent_formatting_context->run(available_space);
@@ -237,6 +284,41 @@ OwnPtr<FormattingContext> FormattingContext::layout_inside(Box const& child_box,
     return independent_formatting_context;
 }
 
+void FormattingContext::layout_inside_layout_boundary(Box const& box)
+{
+    VERIFY(is_layout_boundary(box));
+
+    auto& box_state = m_state.get_mutable(box);
+    box_state.clear_results_of_inner_layout();
+
+    AvailableSpace available_space(
+        AvailableSize::make_definite(box_state.content_width()),
+        AvailableSize::make_definite(box_state.content_height()));
+
+    auto independent_formatting_context = create_independent_formatting_context_if_needed(m_state, LayoutMode::Normal, box);
+    VERIFY(independent_formatting_context);
+    independent_formatting_context->run(available_space);
+    independent_formatting_context->parent_context_did_dimension_child_root_box();
+}
+
+bool FormattingContext::reuse_previous_layout_inside(Box const& box, LayoutMode layout_mode, AvailableSpace const& available_space)
+{
+    if (layout_mode != LayoutMode::Normal || !m_state.has_previous_layout())
+        return false;
+    if (box.needs_layout() || box.child_needs_layout())
+        return false;
+
+    // The insides of a layout boundary are laid out in its content box, and don't depend on anything else.
+    auto const& box_state = m_state.get(box);
+    if (available_space.width != AvailableSize::make_definite(box_state.content_width())
+        || available_space.height != AvailableSize::make_definite(box_state.content_height()))
+        return false;
+    if (!is_layout_boundary(box))
+        return false;
+
+    return m_state.take_over_inner_layout_from_previous_layout(box);
+}
+
 CSSPixels FormattingContext::greatest_child_width(Box const& box) const
 {
     CSSPixels max_width = 0;
@@ -58,6 +58,10 @@ public:
 
     static bool creates_block_formatting_context(Box const&);
 
+    // A layout boundary is a box whose geometry can't be affected by anything inside it,
+    // which allows a relayout to start at the box instead of at the viewport.
+    static bool is_layout_boundary(Box const&);
+
     CSSPixels compute_table_box_width_inside_table_wrapper(Box const&, AvailableSpace const&);
     CSSPixels compute_table_box_height_inside_table_wrapper(Box const&, AvailableSpace const&);
 
@@ -68,6 +72,13 @@ public:
 
     virtual void parent_context_did_dimension_child_root_box() { }
 
+    // Lays out the insides of a layout boundary again, keeping the geometry it was given by the previous layout.
+    void layout_inside_layout_boundary(Box const&);
+
+    // Takes over the results of laying out the insides of `box` from the previous layout instead of running its
+    // formatting context, if `box` is a layout boundary with nothing changed inside it that gets the same size as before.
+    bool reuse_previous_layout_inside(Box const&, LayoutMode, AvailableSpace const&);
+
     CSSPixels calculate_min_content_width(Layout::Box const&) const;
     CSSPixels calculate_max_content_width(Layout::Box const&) const;
     CSSPixels calculate_min_content_height(Layout::Box const&, CSSPixels width) const;
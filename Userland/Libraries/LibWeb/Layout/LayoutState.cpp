@@ -71,6 +71,63 @@ LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
     return *new_used_values_ptr;
 }
 
+void LayoutState::carry_over_used_values_from(LayoutState& previous, HashTable<Box const*> const& relayout_roots)
+{
+    VERIFY(!m_parent);
+    VERIFY(!previous.m_parent);
+    VERIFY(used_values_per_layout_node.is_empty());
+
+    HashTable<Node const*> nodes_to_lay_out;
+    for (auto const* relayout_root : relayout_roots) {
+        relayout_root->for_each_in_subtree([&](Node const& node) {
+            nodes_to_lay_out.set(&node);
+            return TraversalDecision::Continue;
+        });
+    }
+
+    // NOTE: The containing block of a carried over node is always one of its ancestors, so it gets carried over too
+    //       and the pointers between used values stay valid.
+    previous.used_values_per_layout_node.remove_all_matching([&](auto const& node, auto& used_values) {
+        if (nodes_to_lay_out.contains(node.ptr()))
+            return false;
+        if (node->is_box() && !relayout_roots.contains(static_cast<Box const*>(node.ptr())))
+            ++m_boxes_taken_over_from_previous_layout;
+        used_values_per_layout_node.set(node, move(used_values));
+        return true;
+    });
+    m_previous_layout = &previous;
+}
+
+bool LayoutState::take_over_inner_layout_from_previous_layout(Box const& box)
+{
+    VERIFY(!m_parent);
+
+    if (!m_previous_layout)
+        return false;
+    auto* previous_box_state = m_previous_layout->used_values_per_layout_node.get(box).value_or(nullptr);
+    if (!previous_box_state)
+        return false;
+    auto& box_state = get_mutable(box);
+    if (previous_box_state->content_width() != box_state.content_width() || previous_box_state->content_height() != box_state.content_height())
+        return false;
+
+    box_state.take_results_of_inner_layout_from(*previous_box_state);
+    box.for_each_in_subtree([&](Node const& node) {
+        auto used_values = m_previous_layout->used_values_per_layout_node.take(node);
+        if (!used_values.has_value())
+            return TraversalDecision::Continue;
+        // NOTE: The containing blocks of nodes inside `box` are `box` itself or inside it, and the latter keep their
+        //       used values at the same address.
+        if ((*used_values)->containing_block_used_values() == previous_box_state)
+            (*used_values)->set_containing_block_used_values(&box_state);
+        if (node.is_box())
+            ++m_boxes_taken_over_from_previous_layout;
+        used_values_per_layout_node.set(node, used_values.release_value());
+        return TraversalDecision::Continue;
+    });
+    return true;
+}
+
 // https://www.w3.org/TR/css-overflow-3/#scrollable-overflow
 static CSSPixelRect measure_scrollable_overflow(Box const& box)
 {
@@ -217,6 +274,9 @@ void LayoutState::commit(Box& root)
     // Only the top-level LayoutState should ever be committed.
     VERIFY(!m_parent);
 
+    // NOTE: The previous layout is about to go away, and nothing can be taken over from it once layout is done.
+    m_previous_layout = nullptr;
+
     // NOTE: In case this is a relayout of an existing tree, we start by detaching the old paint tree
     //       from the layout tree. This is done to ensure that we don't end up with any old-tree pointers
     //       when text paintables shift around in the tree.
@@ -278,7 +338,7 @@ void LayoutState::commit(Box& root)
 
             if (used_values.computed_svg_path().has_value() && is<Painting::SVGPathPaintable>(paintable_box)) {
                 auto& svg_geometry_paintable = static_cast<Painting::SVGPathPaintable&>(paintable_box);
-                svg_geometry_paintable.set_computed_path(move(*used_values.computed_svg_path()));
+                svg_geometry_paintable.set_computed_path(*used_values.computed_svg_path());
             }
         }
     }
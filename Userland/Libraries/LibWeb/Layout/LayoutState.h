@@ -126,6 +126,22 @@ struct LayoutState {
         void add_floating_descendant(Box const& box) { m_floating_descendants.set(&box); }
         auto const& floating_descendants() const { return m_floating_descendants; }
 
+        // Forgets what the box's own formatting context produced, keeping the geometry of the box itself.
+        void clear_results_of_inner_layout()
+        {
+            line_boxes.clear();
+            m_floating_descendants.clear();
+        }
+
+        // Takes over what the box's own formatting context produced from the used values of a previous layout.
+        void take_results_of_inner_layout_from(UsedValues& other)
+        {
+            line_boxes = move(other.line_boxes);
+            m_floating_descendants = move(other.m_floating_descendants);
+        }
+
+        void set_containing_block_used_values(UsedValues const* containing_block_used_values) { m_containing_block_used_values = containing_block_used_values; }
+
         void set_override_borders_data(Painting::PaintableBox::BordersDataWithElementKind const& override_borders_data) { m_override_borders_data = override_borders_data; }
         auto const& override_borders_data() const { return m_override_borders_data; }
 
@@ -168,8 +184,25 @@ struct LayoutState {
     };
 
     // Commits the used values produced by layout and builds a paintable tree.
+    // The used values are left intact, so a later relayout can carry them over.
     void commit(Box& root);
 
+    // Takes over the used values of a previous layout for every node that is not inside one of `relayout_roots`,
+    // so that only the formatting contexts of those boxes have to run again. The used values of the nodes inside them
+    // stay in `previous`, which has to outlive this layout, for take_over_inner_layout_from_previous_layout().
+    void carry_over_used_values_from(LayoutState& previous, HashTable<Box const*> const& relayout_roots);
+
+    bool has_previous_layout() const { return m_previous_layout; }
+
+    // Takes over the used values of everything inside `box` from the previous layout, if `box` had the same content
+    // size back then. The caller has to make sure that nothing inside `box` changed since, and that its insides only
+    // depend on its content size. Returns whether the used values were taken over.
+    bool take_over_inner_layout_from_previous_layout(Box const&);
+
+    // The number of boxes whose used values were taken over from the previous layout instead of being laid out,
+    // not counting the relayout roots themselves.
+    size_t boxes_taken_over_from_previous_layout() const { return m_boxes_taken_over_from_previous_layout; }
+
     // NOTE: get_mutable() will CoW the UsedValues if it's inherited from an ancestor state;
     UsedValues& get_mutable(NodeWithStyle const&);
 
@@ -195,6 +228,9 @@ struct LayoutState {
 
 private:
     void resolve_relative_positions();
+
+    LayoutState* m_previous_layout { nullptr };
+    size_t m_boxes_taken_over_from_previous_layout { 0 };
 };
 
 }
@@ -1061,6 +1061,27 @@ JS::GCPtr<Painting::Paintable> Node::create_paintable() const
     return nullptr;
 }
 
+void Node::set_needs_layout()
+{
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+    for (auto* ancestor = parent(); ancestor && !ancestor->m_child_needs_layout; ancestor = ancestor->parent())
+        ancestor->m_child_needs_layout = true;
+    document().schedule_layout_update();
+}
+
+void Node::clear_needs_layout_in_subtree()
+{
+    bool child_needs_layout = m_child_needs_layout;
+    m_needs_layout = false;
+    m_child_needs_layout = false;
+    if (!child_needs_layout)
+        return;
+    for (auto* child = first_child(); child; child = child->next_sibling())
+        child->clear_needs_layout_in_subtree();
+}
+
 bool Node::is_anonymous() const
 {
     return m_anonymous;
@@ -161,6 +161,13 @@ public:
     bool children_are_inline() const { return m_children_are_inline; }
     void set_children_are_inline(bool value) { m_children_are_inline = value; }
 
+    // A node that needs layout has changed in a way that may affect its geometry.
+    // All of its ancestors are marked as having a descendant that needs layout.
+    bool needs_layout() const { return m_needs_layout; }
+    bool child_needs_layout() const { return m_child_needs_layout; }
+    void set_needs_layout();
+    void clear_needs_layout_in_subtree();
+
     u32 initial_quote_nesting_level() const { return m_initial_quote_nesting_level; }
     void set_initial_quote_nesting_level(u32 value) { m_initial_quote_nesting_level = value; }
 
@@ -190,6 +197,8 @@ private:
     bool m_anonymous { false };
     bool m_has_style { false };
     bool m_children_are_inline { false };
+    bool m_needs_layout { false };
+    bool m_child_needs_layout { false };
 
     bool m_is_flex_item { false };
     bool m_is_grid_item { false };
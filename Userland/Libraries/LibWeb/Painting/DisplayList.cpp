@@ -13,7 +13,7 @@ void DisplayList::append(Command&& command, Optional<i32> scroll_frame_id)
     m_commands.append({ scroll_frame_id, move(command) });
 }
 
-static Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
+Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
 {
     return command.visit(
         [&](auto const& command) -> Optional<Gfx::IntRect> {
@@ -76,9 +76,13 @@ void DisplayList::mark_unnecessary_commands()
     VERIFY(sample_blit_ranges.is_empty());
 }
 
-void DisplayListPlayer::execute(DisplayList& display_list)
+void DisplayListPlayer::execute(DisplayList& display_list, Optional<ReadonlySpan<u32>> command_indices)
 {
     auto& commands = display_list.commands();
+    auto command_count = command_indices.has_value() ? command_indices->size() : commands.size();
+    auto command_at = [&](size_t position) -> DisplayList::CommandListItem const& {
+        return commands[command_indices.has_value() ? (*command_indices)[position] : position];
+    };
     prepare_to_execute(display_list.corner_clip_max_depth());
 
     if (needs_prepare_glyphs_texture()) {
@@ -116,13 +120,13 @@ void DisplayListPlayer::execute(DisplayList& display_list)
     size_t next_command_index = 0;
     Vector<DisplayListPlayer&, 16> executor_stack;
     DisplayListPlayer* current_executor = this;
-    while (next_command_index < commands.size()) {
-        if (commands[next_command_index].skip) {
+    while (next_command_index < command_count) {
+        if (command_at(next_command_index).skip) {
             next_command_index++;
             continue;
         }
 
-        auto& command = commands[next_command_index++].command;
+        auto& command = command_at(next_command_index++).command;
         auto bounding_rect = command_bounding_rectangle(command);
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || current_executor->would_be_fully_clipped_by_painter(*bounding_rect))) {
             if (command.has<SampleUnderCorners>()) {
@@ -188,10 +192,10 @@ void DisplayListPlayer::execute(DisplayList& display_list)
             current_executor = &executor_stack.take_last();
         } else if (result == CommandResult::SkipStackingContext) {
             auto stacking_context_nesting_level = 1;
-            while (next_command_index < commands.size()) {
-                if (commands[next_command_index].command.has<PushStackingContext>()) {
+            while (next_command_index < command_count) {
+                if (command_at(next_command_index).command.has<PushStackingContext>()) {
                     stacking_context_nesting_level++;
-                } else if (commands[next_command_index].command.has<PopStackingContext>()) {
+                } else if (command_at(next_command_index).command.has<PopStackingContext>()) {
                     stacking_context_nesting_level--;
                 }
 
@@ -46,11 +46,14 @@ enum class CommandResult {
 
 class DisplayList;
 
+Optional<Gfx::IntRect> command_bounding_rectangle(Command const&);
+
 class DisplayListPlayer {
 public:
     virtual ~DisplayListPlayer() = default;
 
-    void execute(DisplayList& display_list);
+    // Replays the commands of `display_list`, or only the ones at `command_indices` if given.
+    void execute(DisplayList& display_list, Optional<ReadonlySpan<u32>> command_indices = {});
 
 private:
     virtual CommandResult draw_glyph_run(DrawGlyphRun const&) = 0;
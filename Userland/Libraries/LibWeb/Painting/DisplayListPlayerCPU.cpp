@@ -4,8 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
+#include <AK/StringHash.h>
 #include <LibGfx/Filters/StackBlurFilter.h>
 #include <LibGfx/StylePainter.h>
+#include <LibThreading/WorkStealingThreadPool.h>
 #include <LibWeb/CSS/ComputedValues.h>
 #include <LibWeb/Painting/BorderRadiusCornerClipper.h>
 #include <LibWeb/Painting/DisplayListPlayerCPU.h>
@@ -15,6 +18,28 @@
 
 namespace Web::Painting {
 
+class SharedResourcesLocker {
+    AK_MAKE_NONCOPYABLE(SharedResourcesLocker);
+    AK_MAKE_NONMOVABLE(SharedResourcesLocker);
+
+public:
+    explicit SharedResourcesLocker(Threading::Mutex* mutex)
+        : m_mutex(mutex)
+    {
+        if (m_mutex)
+            m_mutex->lock();
+    }
+
+    ~SharedResourcesLocker()
+    {
+        if (m_mutex)
+            m_mutex->unlock();
+    }
+
+private:
+    Threading::Mutex* m_mutex { nullptr };
+};
+
 DisplayListPlayerCPU::DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor)
     : m_target_bitmap(bitmap)
     , m_enable_affine_command_executor(enable_affine_command_executor)
@@ -25,10 +50,19 @@ DisplayListPlayerCPU::DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affi
         .scaling_mode = {} });
 }
 
+DisplayListPlayerCPU::DisplayListPlayerCPU(Gfx::Bitmap& tile_bitmap, Gfx::IntPoint tile_location, Threading::Mutex& shared_resources_mutex)
+    : DisplayListPlayerCPU(tile_bitmap)
+{
+    m_base_translation = -tile_location;
+    m_shared_resources_mutex = &shared_resources_mutex;
+    painter().translate(m_base_translation);
+}
+
 DisplayListPlayerCPU::~DisplayListPlayerCPU() = default;
 
 CommandResult DisplayListPlayerCPU::draw_glyph_run(DrawGlyphRun const& command)
 {
+    SharedResourcesLocker locker(m_shared_resources_mutex);
     auto& painter = this->painter();
     auto const& glyphs = command.glyph_run->glyphs();
     auto const& font = command.glyph_run->font();
@@ -112,8 +146,11 @@ CommandResult DisplayListPlayerCPU::push_stacking_context(PushStackingContext co
     }
 
     painter().save();
-    if (command.is_fixed_position)
-        painter().translate(-painter().translation());
+    if (command.is_fixed_position) {
+        // Fixed position contents are placed relative to the whole target, even if this player only paints a tile of it.
+        auto base_translation = &painter() == &*stacking_contexts.first().painter ? m_base_translation : Gfx::IntPoint {};
+        painter().translate(base_translation - painter().translation());
+    }
 
     if (command.mask.has_value()) {
         // TODO: Support masks and other stacking context features at the same time.
@@ -257,20 +294,23 @@ CommandResult DisplayListPlayerCPU::paint_text_shadow(PaintTextShadow const& com
     // FIXME: "Spread" the shadow somehow.
     Gfx::IntPoint const baseline_start(command.text_rect.x(), command.text_rect.y());
     shadow_painter.translate(baseline_start);
-    auto const& glyphs = command.glyph_run->glyphs();
-    auto const& font = command.glyph_run->font();
-    auto scaled_font = font.with_size(font.point_size() * static_cast<float>(command.glyph_run_scale));
-    for (auto const& glyph_or_emoji : glyphs) {
-        auto transformed_glyph = glyph_or_emoji;
-        transformed_glyph.visit([&](auto& glyph) {
-            glyph.position = glyph.position.scaled(command.glyph_run_scale);
-        });
-        if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
-            auto& glyph = transformed_glyph.get<Gfx::DrawGlyph>();
-            shadow_painter.draw_glyph(glyph.position, glyph.code_point, *scaled_font, command.color);
-        } else {
-            auto& emoji = transformed_glyph.get<Gfx::DrawEmoji>();
-            shadow_painter.draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, *scaled_font);
+    {
+        SharedResourcesLocker locker(m_shared_resources_mutex);
+        auto const& glyphs = command.glyph_run->glyphs();
+        auto const& font = command.glyph_run->font();
+        auto scaled_font = font.with_size(font.point_size() * static_cast<float>(command.glyph_run_scale));
+        for (auto const& glyph_or_emoji : glyphs) {
+            auto transformed_glyph = glyph_or_emoji;
+            transformed_glyph.visit([&](auto& glyph) {
+                glyph.position = glyph.position.scaled(command.glyph_run_scale);
+            });
+            if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
+                auto& glyph = transformed_glyph.get<Gfx::DrawGlyph>();
+                shadow_painter.draw_glyph(glyph.position, glyph.code_point, *scaled_font, command.color);
+            } else {
+                auto& emoji = transformed_glyph.get<Gfx::DrawEmoji>();
+                shadow_painter.draw_emoji(emoji.position.to_type<int>(), *emoji.emoji, *scaled_font);
+            }
         }
     }
 
@@ -312,6 +352,7 @@ CommandResult DisplayListPlayerCPU::fill_path_using_color(FillPathUsingColor con
 
 CommandResult DisplayListPlayerCPU::fill_path_using_paint_style(FillPathUsingPaintStyle const& command)
 {
+    SharedResourcesLocker locker(m_shared_resources_mutex);
     Gfx::AntiAliasingPainter aa_painter(painter());
     auto gfx_paint_style = command.paint_style->create_gfx_paint_style();
     aa_painter.translate(command.aa_translation);
@@ -329,6 +370,7 @@ CommandResult DisplayListPlayerCPU::stroke_path_using_color(StrokePathUsingColor
 
 CommandResult DisplayListPlayerCPU::stroke_path_using_paint_style(StrokePathUsingPaintStyle const& command)
 {
+    SharedResourcesLocker locker(m_shared_resources_mutex);
     Gfx::AntiAliasingPainter aa_painter(painter());
     auto gfx_paint_style = command.paint_style->create_gfx_paint_style();
     aa_painter.translate(command.aa_translation);
@@ -461,4 +503,545 @@ bool DisplayListPlayerCPU::would_be_fully_clipped_by_painter(Gfx::IntRect rect)
     return !painter().clip_rect().intersects(rect.translated(painter().translation()));
 }
 
+Gfx::Bitmap* TileCache::find(u32 fingerprint_hash, ReadonlyBytes fingerprint) const
+{
+    auto it = m_tiles.find(fingerprint_hash);
+    if (it == m_tiles.end())
+        return nullptr;
+    for (auto const& tile : it->value) {
+        if (tile.fingerprint.span() == fingerprint)
+            return tile.bitmap.ptr();
+    }
+    return nullptr;
+}
+
+// A display list can only be split into tiles if every command paints within its bounding rect, as seen from the
+// coordinate space of the whole target.
+static bool can_execute_in_tiles(DisplayList const& display_list)
+{
+    for (auto const& command_with_scroll_id : display_list.commands()) {
+        if (command_with_scroll_id.skip)
+            continue;
+        auto const& command = command_with_scroll_id.command;
+        // Backdrop filters sample everything painted below them, regardless of which tile it ended up in.
+        if (command.has<ApplyBackdropFilter>())
+            return false;
+        if (auto const* push_stacking_context = command.get_pointer<PushStackingContext>()) {
+            // Scaled or rotated contents don't map to the same place in every tile.
+            if (!Gfx::extract_2d_affine_transform(push_stacking_context->transform.matrix).is_identity_or_translation())
+                return false;
+            // Masks are copied into every stacking context that uses them, and their reference counts can't be
+            // touched from several threads at once.
+            if (push_stacking_context->mask.has_value())
+                return false;
+        }
+    }
+    return true;
+}
+
+// Cached tiles can only be reused if nothing that was in the target before shows through them, which is the case when
+// the display list starts by filling the whole target with an opaque color.
+static bool starts_with_opaque_fill(DisplayList const& display_list, Gfx::IntRect const& target_rect)
+{
+    auto const& commands = display_list.commands();
+    if (commands.size() == 0 || commands[0].skip)
+        return false;
+    auto const* fill_rect = commands[0].command.get_pointer<FillRect>();
+    return fill_rect && !fill_rect->text_clip && fill_rect->color.alpha() == 255 && fill_rect->rect.contains(target_rect);
+}
+
+template<typename T>
+static void append_to_fingerprint(Vector<u8>& fingerprint, T const& value)
+{
+    static_assert(IsTriviallyCopyable<T>);
+    fingerprint.append(reinterpret_cast<u8 const*>(&value), sizeof(value));
+}
+
+static void append_color_stops_to_fingerprint(Vector<u8>& fingerprint, ColorStopData const& color_stops)
+{
+    append_to_fingerprint(fingerprint, color_stops.list.size());
+    for (auto const& color_stop : color_stops.list) {
+        append_to_fingerprint(fingerprint, color_stop.color);
+        append_to_fingerprint(fingerprint, color_stop.position);
+        append_to_fingerprint(fingerprint, color_stop.transition_hint.value_or(AK::NaN<float>));
+    }
+    append_to_fingerprint(fingerprint, color_stops.repeat_length.value_or(AK::NaN<float>));
+}
+
+static void append_box_shadow_params_to_fingerprint(Vector<u8>& fingerprint, PaintBoxShadowParams params, Gfx::IntPoint offset)
+{
+    params.device_content_rect.translate_by(offset);
+    append_to_fingerprint(fingerprint, params);
+}
+
+// Appends everything that affects the pixels painted by `command` to the fingerprint of a tile, with positions moved by
+// `offset` to be relative to the tile. Returns false for commands whose output can't be identified this way, e.g.
+// because they paint a bitmap that may have changed in place since the last frame.
+static bool append_command_to_fingerprint(Vector<u8>& fingerprint, Command const& command, Gfx::IntPoint offset)
+{
+    append_to_fingerprint(fingerprint, command.index());
+    return command.visit(
+        [&](DrawGlyphRun const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.glyph_run.ptr());
+            append_to_fingerprint(fingerprint, command.color);
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.translation.translated(offset.to_type<float>()));
+            append_to_fingerprint(fingerprint, command.scale);
+            return true;
+        },
+        [&](FillRect const& command) -> bool {
+            if (command.text_clip)
+                return false;
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.color);
+            return true;
+        },
+        [&](DrawScaledImmutableBitmap const& command) -> bool {
+            if (command.text_clip)
+                return false;
+            append_to_fingerprint(fingerprint, command.dst_rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.bitmap.ptr());
+            append_to_fingerprint(fingerprint, command.src_rect);
+            append_to_fingerprint(fingerprint, command.scaling_mode);
+            return true;
+        },
+        [&](SetClipRect const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            return true;
+        },
+        [&](ClearClipRect const&) -> bool {
+            return true;
+        },
+        [&](PushStackingContext const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.opacity);
+            append_to_fingerprint(fingerprint, command.is_fixed_position);
+            append_to_fingerprint(fingerprint, command.source_paintable_rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.post_transform_translation);
+            append_to_fingerprint(fingerprint, command.image_rendering);
+            append_to_fingerprint(fingerprint, command.transform.origin.translated(offset.to_type<float>()));
+            append_to_fingerprint(fingerprint, Gfx::extract_2d_affine_transform(command.transform.matrix).translation());
+            return true;
+        },
+        [&](PopStackingContext const&) -> bool {
+            return true;
+        },
+        [&](PaintLinearGradient const& command) -> bool {
+            if (command.text_clip)
+                return false;
+            append_to_fingerprint(fingerprint, command.gradient_rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.linear_gradient_data.gradient_angle);
+            append_color_stops_to_fingerprint(fingerprint, command.linear_gradient_data.color_stops);
+            return true;
+        },
+        [&](PaintRadialGradient const& command) -> bool {
+            if (command.text_clip)
+                return false;
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.center);
+            append_to_fingerprint(fingerprint, command.size);
+            append_color_stops_to_fingerprint(fingerprint, command.radial_gradient_data.color_stops);
+            return true;
+        },
+        [&](PaintConicGradient const& command) -> bool {
+            if (command.text_clip)
+                return false;
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.position);
+            append_to_fingerprint(fingerprint, command.conic_gradient_data.start_angle);
+            append_color_stops_to_fingerprint(fingerprint, command.conic_gradient_data.color_stops);
+            return true;
+        },
+        [&](PaintOuterBoxShadow const& command) -> bool {
+            append_box_shadow_params_to_fingerprint(fingerprint, command.box_shadow_params, offset);
+            return true;
+        },
+        [&](PaintInnerBoxShadow const& command) -> bool {
+            append_box_shadow_params_to_fingerprint(fingerprint, command.box_shadow_params, offset);
+            return true;
+        },
+        [&](PaintTextShadow const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.blur_radius);
+            append_to_fingerprint(fingerprint, command.shadow_bounding_rect);
+            append_to_fingerprint(fingerprint, command.text_rect);
+            append_to_fingerprint(fingerprint, command.glyph_run.ptr());
+            append_to_fingerprint(fingerprint, command.glyph_run_scale);
+            append_to_fingerprint(fingerprint, command.color);
+            append_to_fingerprint(fingerprint, command.draw_location.translated(offset));
+            return true;
+        },
+        [&](FillRectWithRoundedCorners const& command) -> bool {
+            if (command.text_clip)
+                return false;
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.color);
+            append_to_fingerprint(fingerprint, command.corner_radii);
+            return true;
+        },
+        [&](DrawEllipse const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.color);
+            append_to_fingerprint(fingerprint, command.thickness);
+            return true;
+        },
+        [&](FillEllipse const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.color);
+            return true;
+        },
+        [&](DrawLine const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.color);
+            append_to_fingerprint(fingerprint, command.from.translated(offset));
+            append_to_fingerprint(fingerprint, command.to.translated(offset));
+            append_to_fingerprint(fingerprint, command.thickness);
+            append_to_fingerprint(fingerprint, command.style);
+            append_to_fingerprint(fingerprint, command.alternate_color);
+            return true;
+        },
+        [&](DrawRect const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.color);
+            append_to_fingerprint(fingerprint, command.rough);
+            return true;
+        },
+        [&](DrawTriangleWave const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.p1.translated(offset));
+            append_to_fingerprint(fingerprint, command.p2.translated(offset));
+            append_to_fingerprint(fingerprint, command.color);
+            append_to_fingerprint(fingerprint, command.amplitude);
+            append_to_fingerprint(fingerprint, command.thickness);
+            return true;
+        },
+        [&](SampleUnderCorners const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.corner_radii);
+            append_to_fingerprint(fingerprint, command.border_rect.translated(offset));
+            append_to_fingerprint(fingerprint, command.corner_clip);
+            return true;
+        },
+        [&](BlitCornerClipping const& command) -> bool {
+            append_to_fingerprint(fingerprint, command.border_rect.translated(offset));
+            return true;
+        },
+        [&](auto const&) -> bool {
+            // FIXME: Paths could be fingerprinted as well, and DrawScaledBitmap paints bitmaps that can change in place.
+            return false;
+        });
+}
+
+// Lines and triangle waves don't have a bounding rect of their own, as they are never culled by the player. For splitting
+// them into tiles, they're given a generous one covering everything they could paint.
+static Optional<Gfx::IntRect> tile_bounding_rectangle(Command const& command)
+{
+    if (auto const* draw_line = command.get_pointer<DrawLine>()) {
+        auto rect = Gfx::IntRect::from_two_points(draw_line->from, draw_line->to);
+        return rect.inflated(draw_line->thickness * 2 + 2, draw_line->thickness * 2 + 2);
+    }
+    if (auto const* draw_triangle_wave = command.get_pointer<DrawTriangleWave>()) {
+        auto rect = Gfx::IntRect::from_two_points(draw_triangle_wave->p1, draw_triangle_wave->p2);
+        auto extent = draw_triangle_wave->amplitude + draw_triangle_wave->thickness * 2 + 2;
+        return rect.inflated(extent * 2, extent * 2);
+    }
+    return command_bounding_rectangle(command);
+}
+
+struct TileGrid {
+    Gfx::IntRect target_rect;
+    Gfx::IntPoint first_tile_location;
+    int columns { 0 };
+    int rows { 0 };
+
+    static TileGrid create(Gfx::IntRect const& target_rect, Gfx::IntPoint origin)
+    {
+        auto first_tile_offset = [](int origin) {
+            return -(((origin % DisplayListPlayerCPU::tile_size) + DisplayListPlayerCPU::tile_size) % DisplayListPlayerCPU::tile_size);
+        };
+        TileGrid grid { target_rect, { first_tile_offset(origin.x()), first_tile_offset(origin.y()) } };
+        grid.columns = max(0, ceil_div(target_rect.width() - grid.first_tile_location.x(), DisplayListPlayerCPU::tile_size));
+        grid.rows = max(0, ceil_div(target_rect.height() - grid.first_tile_location.y(), DisplayListPlayerCPU::tile_size));
+        return grid;
+    }
+
+    size_t tile_count() const { return columns * rows; }
+
+    Gfx::IntRect tile_rect(size_t index) const
+    {
+        auto column = static_cast<int>(index % columns);
+        auto row = static_cast<int>(index / columns);
+        auto location = first_tile_location.translated(column * DisplayListPlayerCPU::tile_size, row * DisplayListPlayerCPU::tile_size);
+        return Gfx::IntRect { location, { DisplayListPlayerCPU::tile_size, DisplayListPlayerCPU::tile_size } }.intersected(target_rect);
+    }
+
+    template<typename Callback>
+    void for_each_tile_intersecting(Gfx::IntRect rect, Callback callback) const
+    {
+        rect.intersect(target_rect);
+        if (rect.is_empty())
+            return;
+        auto first_column = (rect.left() - first_tile_location.x()) / DisplayListPlayerCPU::tile_size;
+        auto last_column = (rect.right() - 1 - first_tile_location.x()) / DisplayListPlayerCPU::tile_size;
+        auto first_row = (rect.top() - first_tile_location.y()) / DisplayListPlayerCPU::tile_size;
+        auto last_row = (rect.bottom() - 1 - first_tile_location.y()) / DisplayListPlayerCPU::tile_size;
+        for (auto row = first_row; row <= last_row; ++row) {
+            for (auto column = first_column; column <= last_column; ++column)
+                callback(row * columns + column);
+        }
+    }
+};
+
+struct TileCommands {
+    Gfx::IntRect rect;
+    Vector<u32> command_indices;
+    bool is_cacheable { false };
+    Vector<u8> fingerprint;
+
+    struct OpenStackingContext {
+        size_t command_count { 0 };
+        size_t fingerprint_size { 0 };
+    };
+    Vector<OpenStackingContext> open_stacking_contexts;
+    Vector<u32> open_corner_clips;
+};
+
+// Sorts the commands into the tiles they paint into. Commands that change the clip or stacking context state are replayed
+// in every tile they could affect, and stacking contexts that end up not painting anything into a tile are left out of it.
+static Vector<TileCommands> bucket_commands_by_tile(DisplayList const& display_list, TileGrid const& grid, bool is_cacheable)
+{
+    Vector<TileCommands> tiles;
+    tiles.ensure_capacity(grid.tile_count());
+    for (size_t i = 0; i < grid.tile_count(); ++i) {
+        tiles.unchecked_append({ .rect = grid.tile_rect(i), .is_cacheable = is_cacheable });
+        if (is_cacheable)
+            append_to_fingerprint(tiles.last().fingerprint, tiles.last().rect.size());
+    }
+
+    // The part of the player's state that decides where commands end up in the target.
+    struct State {
+        Gfx::IntPoint translation;
+        Optional<Gfx::IntRect> clip_rect;
+        // Stacking contexts with opacity are painted into a bitmap of their own, which starts out without a clip, but is
+        // still clipped by whatever clip was set when it's blitted back.
+        Optional<Gfx::IntRect> layer_clip_rect;
+        bool is_inside_layer { false };
+        // Set for contents whose position in the target isn't known, which are then replayed in every tile.
+        bool is_unbounded { false };
+    };
+    State state;
+    Vector<State> saved_states;
+
+    auto visible_rect = [&](Gfx::IntRect rect) {
+        if (state.clip_rect.has_value())
+            rect.intersect(*state.clip_rect);
+        if (state.layer_clip_rect.has_value())
+            rect.intersect(*state.layer_clip_rect);
+        return rect;
+    };
+
+    auto add_command = [&](TileCommands& tile, u32 index, Command const& command) {
+        tile.command_indices.append(index);
+        if (tile.is_cacheable)
+            tile.is_cacheable = !state.is_unbounded && append_command_to_fingerprint(tile.fingerprint, command, state.translation - tile.rect.location());
+    };
+
+    auto const& commands = display_list.commands();
+    for (u32 index = 0; index < commands.size(); ++index) {
+        if (commands[index].skip)
+            continue;
+        auto const& command = commands[index].command;
+
+        if (auto const* push_stacking_context = command.get_pointer<PushStackingContext>()) {
+            for (auto& tile : tiles) {
+                tile.open_stacking_contexts.append({ tile.command_indices.size(), tile.fingerprint.size() });
+                add_command(tile, index, command);
+            }
+            saved_states.append(state);
+            if (push_stacking_context->is_fixed_position) {
+                // The player only knows where the target is while painting directly into it.
+                if (state.is_inside_layer)
+                    state.is_unbounded = true;
+                state.translation = {};
+            }
+            auto affine_transform = Gfx::extract_2d_affine_transform(push_stacking_context->transform.matrix);
+            state.translation.translate_by(affine_transform.translation().to_rounded<int>() + push_stacking_context->post_transform_translation);
+            if (push_stacking_context->opacity != 1.0f) {
+                if (state.clip_rect.has_value())
+                    state.layer_clip_rect = state.layer_clip_rect.has_value() ? state.layer_clip_rect->intersected(*state.clip_rect) : *state.clip_rect;
+                state.clip_rect = {};
+                state.is_inside_layer = true;
+            }
+            continue;
+        }
+
+        if (command.has<PopStackingContext>()) {
+            state = saved_states.take_last();
+            for (auto& tile : tiles) {
+                auto open_stacking_context = tile.open_stacking_contexts.take_last();
+                if (tile.command_indices.size() == open_stacking_context.command_count + 1) {
+                    tile.command_indices.shrink(open_stacking_context.command_count, true);
+                    tile.fingerprint.shrink(open_stacking_context.fingerprint_size, true);
+                    continue;
+                }
+                add_command(tile, index, command);
+            }
+            continue;
+        }
+
+        if (command.has<ClearClipRect>()) {
+            state.clip_rect = {};
+            for (auto& tile : tiles) {
+                // The clip of tiles that have nothing painted since it was last cleared is still clear.
+                if (tile.command_indices.is_empty() || commands[tile.command_indices.last()].command.has<ClearClipRect>())
+                    continue;
+                add_command(tile, index, command);
+            }
+            continue;
+        }
+
+        if (auto const* blit_corner_clipping = command.get_pointer<BlitCornerClipping>()) {
+            // Blits have to be replayed in exactly the tiles that sampled the corners first.
+            for (auto& tile : tiles) {
+                if (tile.open_corner_clips.is_empty() || tile.open_corner_clips.last() != blit_corner_clipping->id)
+                    continue;
+                tile.open_corner_clips.take_last();
+                add_command(tile, index, command);
+            }
+            continue;
+        }
+
+        auto add_command_to_tiles = [&](Optional<Gfx::IntRect> const& rect) {
+            auto add = [&](TileCommands& tile) {
+                add_command(tile, index, command);
+                if (auto const* sample_under_corners = command.get_pointer<SampleUnderCorners>())
+                    tile.open_corner_clips.append(sample_under_corners->id);
+            };
+            if (!rect.has_value()) {
+                for (auto& tile : tiles)
+                    add(tile);
+                return;
+            }
+            grid.for_each_tile_intersecting(*rect, [&](size_t tile_index) { add(tiles[tile_index]); });
+        };
+
+        if (state.is_unbounded) {
+            add_command_to_tiles({});
+            continue;
+        }
+
+        if (auto const* set_clip_rect = command.get_pointer<SetClipRect>()) {
+            auto clip_rect = set_clip_rect->rect.translated(state.translation);
+            state.clip_rect = clip_rect;
+            // Tiles that this clip rect doesn't touch keep whatever clip they had, but nothing is painted into them
+            // until the clip changes again.
+            add_command_to_tiles(visible_rect(clip_rect));
+            continue;
+        }
+
+        auto bounding_rect = tile_bounding_rectangle(command);
+        if (!bounding_rect.has_value()) {
+            add_command_to_tiles({});
+            continue;
+        }
+
+        auto rect = visible_rect(bounding_rect->translated(state.translation));
+        if (rect.is_empty())
+            continue;
+        add_command_to_tiles(rect);
+    }
+
+    return tiles;
+}
+
+static void copy_pixels(Gfx::Bitmap const& source, Gfx::Bitmap& destination)
+{
+    VERIFY(source.size() == destination.size());
+    for (int y = 0; y < source.height(); ++y)
+        memcpy(destination.scanline(y), source.scanline(y), source.width() * sizeof(Gfx::ARGB32));
+}
+
+void DisplayListPlayerCPU::execute_in_tiles(DisplayList& display_list, TileCache* tile_cache, Gfx::IntPoint tile_grid_origin)
+{
+    auto& target = m_target_bitmap;
+    auto grid = TileGrid::create(target.rect(), tile_grid_origin);
+    if (m_enable_affine_command_executor || target.scale() != 1 || grid.tile_count() < 2 || !can_execute_in_tiles(display_list)) {
+        if (tile_cache)
+            tile_cache->clear();
+        execute(display_list);
+        return;
+    }
+
+    auto tiles = bucket_commands_by_tile(display_list, grid, tile_cache && starts_with_opaque_fill(display_list, target.rect()));
+
+    Vector<NonnullRefPtr<Gfx::Bitmap>> tile_bitmaps;
+    tile_bitmaps.ensure_capacity(tiles.size());
+    for (auto const& tile : tiles) {
+        auto* tile_pixels = target.scanline_u8(tile.rect.y()) + tile.rect.x() * sizeof(Gfx::ARGB32);
+        auto tile_bitmap_or_error = Gfx::Bitmap::create_wrapper(target.format(), tile.rect.size(), 1, target.pitch(), tile_pixels);
+        if (tile_bitmap_or_error.is_error()) {
+            if (tile_cache)
+                tile_cache->clear();
+            execute(display_list);
+            return;
+        }
+        tile_bitmaps.unchecked_append(tile_bitmap_or_error.release_value());
+    }
+
+    // Tiles are painted straight into the target, through bitmaps that wrap its pixels. Nothing reads or writes outside
+    // of the tile it belongs to, so no two threads touch the same pixels.
+    Threading::Mutex shared_resources_mutex;
+    Vector<u32> fingerprint_hashes;
+    fingerprint_hashes.resize(tiles.size());
+    // NOTE: Cached tiles are only remembered by pointer until all tiles are done, as reference counts can't be changed
+    //       from several threads at once.
+    Vector<Gfx::Bitmap*> reused_tile_bitmaps;
+    reused_tile_bitmaps.resize(tiles.size());
+    Vector<RefPtr<Gfx::Bitmap>> painted_tile_bitmaps;
+    painted_tile_bitmaps.resize(tiles.size());
+
+    Threading::WorkStealingThreadPool::the().parallel_for_range(tiles.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto const& tile = tiles[i];
+            auto const& tile_bitmap = tile_bitmaps[i];
+
+            if (tile.is_cacheable) {
+                fingerprint_hashes[i] = string_hash(reinterpret_cast<char const*>(tile.fingerprint.data()), tile.fingerprint.size());
+                if (auto* cached_bitmap = tile_cache->find(fingerprint_hashes[i], tile.fingerprint.span())) {
+                    copy_pixels(*cached_bitmap, *tile_bitmap);
+                    reused_tile_bitmaps[i] = cached_bitmap;
+                    continue;
+                }
+            }
+
+            DisplayListPlayerCPU player(*tile_bitmap, tile.rect.location(), shared_resources_mutex);
+            player.execute(display_list, tile.command_indices.span());
+
+            if (tile.is_cacheable) {
+                if (auto bitmap_or_error = Gfx::Bitmap::create(target.format(), tile.rect.size()); !bitmap_or_error.is_error()) {
+                    copy_pixels(*tile_bitmap, *bitmap_or_error.value());
+                    painted_tile_bitmaps[i] = bitmap_or_error.release_value();
+                }
+            }
+        }
+    });
+
+    if (!tile_cache)
+        return;
+
+    tile_cache->m_reused_tile_count = 0;
+    HashMap<u32, Vector<TileCache::Tile, 1>> cached_tiles;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        auto& tile = tiles[i];
+        RefPtr<Gfx::Bitmap> bitmap = painted_tile_bitmaps[i];
+        if (reused_tile_bitmaps[i]) {
+            bitmap = reused_tile_bitmaps[i];
+            ++tile_cache->m_reused_tile_count;
+        }
+        if (!tile.is_cacheable || !bitmap)
+            continue;
+        auto& entries = cached_tiles.ensure(fingerprint_hashes[i], [] { return Vector<TileCache::Tile, 1> {}; });
+        if (any_of(entries, [&](auto const& entry) { return entry.fingerprint == tile.fingerprint; }))
+            continue;
+        entries.append({ move(tile.fingerprint), bitmap.release_nonnull() });
+    }
+    tile_cache->m_tiles = move(cached_tiles);
+    tile_cache->m_display_list = &display_list;
+}
+
 }
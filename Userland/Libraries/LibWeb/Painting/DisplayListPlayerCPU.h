@@ -6,20 +6,64 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/MaybeOwned.h>
 #include <LibGfx/ScalingMode.h>
+#include <LibThreading/Mutex.h>
 #include <LibWeb/Painting/AffineDisplayListPlayerCPU.h>
 #include <LibWeb/Painting/DisplayListRecorder.h>
 
 namespace Web::Painting {
 
+// Tiles painted by DisplayListPlayerCPU::execute_in_tiles(), keyed by a fingerprint of the commands that touched them
+// (with positions relative to the tile). A tile whose fingerprint didn't change since the previous frame, e.g. because
+// the page was scrolled or something elsewhere was repainted, is copied from here instead of being painted again.
+class TileCache {
+public:
+    void clear()
+    {
+        m_tiles.clear();
+        m_display_list = nullptr;
+        m_reused_tile_count = 0;
+    }
+
+    // The number of tiles that were copied from here instead of being painted during the last frame.
+    size_t reused_tile_count() const { return m_reused_tile_count; }
+
+private:
+    friend class DisplayListPlayerCPU;
+
+    struct Tile {
+        Vector<u8> fingerprint;
+        NonnullRefPtr<Gfx::Bitmap> bitmap;
+    };
+
+    Gfx::Bitmap* find(u32 fingerprint_hash, ReadonlyBytes fingerprint) const;
+
+    HashMap<u32, Vector<Tile, 1>> m_tiles;
+
+    // Fingerprints refer to glyph runs and bitmaps by address, so the display list they came from has to stay alive
+    // for as long as they can be matched against.
+    RefPtr<DisplayList> m_display_list;
+
+    size_t m_reused_tile_count { 0 };
+};
+
 class DisplayListPlayerCPU : public DisplayListPlayer {
 public:
+    static constexpr int tile_size = 256;
+
     DisplayListPlayerCPU(Gfx::Bitmap& bitmap, bool enable_affine_command_executor = false);
 
     ~DisplayListPlayerCPU();
 
+    // Splits the target bitmap into tiles aligned to `tile_grid_origin`, and replays the commands touching each tile
+    // in parallel. Display lists that can't be split up this way are replayed with execute() instead.
+    void execute_in_tiles(DisplayList&, TileCache* = nullptr, Gfx::IntPoint tile_grid_origin = {});
+
 private:
+    DisplayListPlayerCPU(Gfx::Bitmap& tile_bitmap, Gfx::IntPoint tile_location, Threading::Mutex& shared_resources_mutex);
+
     template<typename Callback>
     void apply_mask_painted_from(Gfx::IntRect const& rect, Callback callback, DisplayList& display_list)
     {
@@ -106,6 +150,13 @@ private:
     Gfx::Bitmap& m_target_bitmap;
     bool m_enable_affine_command_executor { false };
 
+    // The translation that maps the coordinates of the whole target into the bitmap painted by this player. This is
+    // only non-zero for players that paint a single tile.
+    Gfx::IntPoint m_base_translation;
+
+    // Held while using fonts and paint styles, which aren't safe to use from several tiles at once.
+    Threading::Mutex* m_shared_resources_mutex { nullptr };
+
     Vector<RefPtr<BorderRadiusCornerClipper>> m_corner_clippers_stack;
 
     struct StackingContext {
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <RequestServer/CachedRequest.h>
+#include <RequestServer/DiskCache.h>
+
+namespace RequestServer {
+
+CachedRequest::CachedRequest(ConnectionFromClient& client, URL::URL url, NonnullOwnPtr<Core::File>&& output_stream, i32 request_id)
+    : Request(client, move(output_stream), request_id)
+    , m_url(move(url))
+{
+}
+
+NonnullOwnPtr<CachedRequest> CachedRequest::create(ConnectionFromClient& client, URL::URL url, NonnullOwnPtr<CacheEntry> entry, NonnullOwnPtr<Core::File>&& output_stream, i32 request_id)
+{
+    auto request = adopt_own(*new CachedRequest(client, move(url), move(output_stream), request_id));
+
+    // The client only learns about the request once this returns, so hold off until then.
+    // NOTE: The client may stop the request before we get to it, so don't hold on to a raw pointer.
+    Core::deferred_invoke([weak_request = request->make_weak_ptr<CachedRequest>(), entry = move(entry)]() mutable {
+        if (weak_request)
+            weak_request->serve_cache_entry(move(entry));
+    });
+
+    return request;
+}
+
+}
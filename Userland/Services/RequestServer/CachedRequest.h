@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <LibCore/Forward.h>
+#include <RequestServer/Request.h>
+
+namespace RequestServer {
+
+// A request that is answered with a fresh response from the disk cache, without going to the network.
+class CachedRequest final : public Request {
+public:
+    virtual ~CachedRequest() override = default;
+    static NonnullOwnPtr<CachedRequest> create(ConnectionFromClient&, URL::URL, NonnullOwnPtr<CacheEntry>, NonnullOwnPtr<Core::File>&&, i32);
+
+    virtual URL::URL url() const override { return m_url; }
+
+private:
+    explicit CachedRequest(ConnectionFromClient&, URL::URL, NonnullOwnPtr<Core::File>&&, i32);
+
+    URL::URL m_url;
+};
+
+}
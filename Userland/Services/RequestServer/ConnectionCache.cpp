@@ -14,6 +14,37 @@ namespace RequestServer::ConnectionCache {
 Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<Core::TCPSocket, Core::Socket>>>>>> g_tcp_connection_cache {};
 Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<TLS::TLSv12>>>>>> g_tls_connection_cache {};
 Threading::RWLockProtected<HashMap<ByteString, InferredServerProperties>> g_inferred_server_properties;
+Threading::RWLockProtected<OrderedHashMap<ConnectionKey, TLS::Session>> g_tls_session_cache;
+
+void set_up_session_resumption(TLS::Options& options, ConnectionKey key)
+{
+    auto session = g_tls_session_cache.with_write_locked([&](auto& cache) -> Optional<TLS::Session> {
+        auto session = cache.get(key).copy();
+        if (session.has_value() && session->has_expired()) {
+            cache.remove(key);
+            return {};
+        }
+        return session;
+    });
+    if (session.has_value()) {
+        dbgln_if(REQUESTSERVER_DEBUG, "Offering to resume the TLS session with {}:{}", key.hostname, key.port);
+        options.set_session_to_resume(session.release_value());
+    }
+
+    options.set_new_session_handler([key = move(key)](TLS::Session const& session) {
+        g_tls_session_cache.with_write_locked([&](auto& cache) {
+            // Re-insert the session so it becomes the newest one.
+            cache.remove(key);
+            cache.set(key, session);
+
+            if (cache.size() > MaxCachedTLSSessions) {
+                cache.remove_all_matching([](auto const&, auto const& session) { return session.has_expired(); });
+                while (cache.size() > MaxCachedTLSSessions)
+                    cache.remove(cache.begin());
+            }
+        });
+    });
+}
 
 void request_did_finish(URL::URL const& url, Core::Socket const* socket)
 {
@@ -174,6 +174,11 @@ struct InferredServerProperties {
 extern Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<Core::TCPSocket, Core::Socket>>>>>> g_tcp_connection_cache;
 extern Threading::RWLockProtected<HashMap<ConnectionKey, NonnullOwnPtr<Vector<NonnullOwnPtr<Connection<TLS::TLSv12>>>>>> g_tls_connection_cache;
 extern Threading::RWLockProtected<HashMap<ByteString, InferredServerProperties>> g_inferred_server_properties;
+// Ordered by when each session was last stored, so the oldest ones can be dropped once there are too many.
+extern Threading::RWLockProtected<OrderedHashMap<ConnectionKey, TLS::Session>> g_tls_session_cache;
+
+// Makes new TLS connections to the same server resume the last session we had with it, and remember the new ones.
+void set_up_session_resumption(TLS::Options&, ConnectionKey);
 
 void request_did_finish(URL::URL const&, Core::Socket const*);
 void dump_jobs();
@@ -181,6 +186,7 @@ void dump_jobs();
 constexpr static size_t MaxConcurrentConnectionsPerURL = 4;
 constexpr static size_t ConnectionKeepAliveTimeMilliseconds = 10'000;
 constexpr static size_t ConnectionCacheQueueHighWatermark = 4;
+constexpr static size_t MaxCachedTLSSessions = 256;
 
 template<typename T>
 Coroutine<ErrorOr<void>> recreate_socket_if_needed(T& connection, URL::URL const& url)
@@ -215,6 +221,7 @@ Coroutine<ErrorOr<void>> recreate_socket_if_needed(T& connection, URL::URL const
                     return connection.job_data->provide_client_certificates();
                 return {};
             });
+            set_up_session_resumption(options, { CO_TRY(url.serialized_host()).to_byte_string(), url.port_or_default(), connection.proxy.data });
             CO_TRY(set_socket(CO_TRY(co_await (connection.proxy.template tunnel<SocketType, SocketStorageType>(url, move(options))))));
         } else {
             CO_TRY(set_socket(CO_TRY(co_await (connection.proxy.template tunnel<SocketType, SocketStorageType>(url)))));
@@ -267,7 +274,15 @@ Coroutine<void> async_get_or_create_connection(auto& cache, URL::URL url, auto j
             socket_for_url->is_being_started = false;
         };
 
-        auto connection_result = co_await proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url);
+        auto connection_result = co_await [&]() -> Coroutine<ErrorOr<NonnullOwnPtr<typename ConnectionType::StorageType>>> {
+            if constexpr (IsSame<TLS::TLSv12, typename ConnectionType::SocketType>) {
+                TLS::Options options;
+                set_up_session_resumption(options, { CO_TRY(url.serialized_host()).to_byte_string(), url.port_or_default(), proxy_data });
+                co_return co_await proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url, move(options));
+            } else {
+                co_return co_await proxy.tunnel<typename ConnectionType::SocketType, typename ConnectionType::StorageType>(url);
+            }
+        }();
         if (connection_result.is_error()) {
             dbgln("ConnectionCache: Connection to {} failed: {}", url, connection_result.error());
             Core::deferred_invoke([job] {
@@ -0,0 +1,541 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Endian.h>
+#include <AK/GenericShorthands.h>
+#include <AK/Hex.h>
+#include <AK/MemoryStream.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DateTime.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA1.h>
+#include <RequestServer/DiskCache.h>
+
+namespace RequestServer {
+
+// Every cache file starts with this header, followed by the URL, the response headers and the body.
+static constexpr u32 cache_file_magic = 0x43485352; // "RSHC"
+static constexpr u32 cache_file_version = 1;
+static constexpr StringView temporary_file_extension = ".tmp"sv;
+
+// An upper bound for lifetimes guessed from Last-Modified, which RFC 9111 leaves up to the cache.
+static constexpr i64 maximum_heuristic_freshness_lifetime = 7 * 24 * 60 * 60;
+
+static OwnPtr<DiskCache> s_disk_cache;
+
+// https://httpwg.org/specs/rfc9111.html#storing.fields
+static bool is_exempted_for_storage(StringView header_name)
+{
+    return header_name.is_one_of_ignoring_ascii_case(
+        "Connection"sv,
+        "Proxy-Connection"sv,
+        "Keep-Alive"sv,
+        "TE"sv,
+        "Transfer-Encoding"sv,
+        "Upgrade"sv);
+}
+
+// https://httpwg.org/specs/rfc9111.html#update
+static bool is_exempted_for_updating(StringView header_name)
+{
+    return is_exempted_for_storage(header_name) || header_name.equals_ignoring_ascii_case("Content-Length"sv);
+}
+
+// https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+static bool is_heuristically_cacheable(u32 status_code)
+{
+    return first_is_one_of(status_code, 200u, 203u, 204u, 206u, 300u, 301u, 308u, 404u, 405u, 410u, 414u, 501u);
+}
+
+// https://httpwg.org/specs/rfc9111.html#field.cache-control
+template<typename Callback>
+static void for_each_cache_control_directive(HTTP::HeaderMap const& headers, Callback callback)
+{
+    for (auto const& header : headers.headers()) {
+        if (!header.name.equals_ignoring_ascii_case("Cache-Control"sv))
+            continue;
+
+        for (auto directive : header.value.split_view(',')) {
+            directive = directive.trim_whitespace();
+            auto equals_sign = directive.find('=');
+            auto name = directive.substring_view(0, equals_sign.value_or(directive.length())).trim_whitespace();
+
+            Optional<StringView> argument;
+            if (equals_sign.has_value())
+                argument = directive.substring_view(*equals_sign + 1).trim_whitespace().trim("\""sv);
+
+            callback(name, argument);
+        }
+    }
+}
+
+static bool has_cache_control_directive(HTTP::HeaderMap const& headers, StringView name)
+{
+    bool found = false;
+    for_each_cache_control_directive(headers, [&](StringView directive, Optional<StringView>) {
+        if (directive.equals_ignoring_ascii_case(name))
+            found = true;
+    });
+    return found;
+}
+
+static Optional<i64> cache_control_delta_seconds(HTTP::HeaderMap const& headers, StringView name)
+{
+    Optional<i64> seconds;
+    for_each_cache_control_directive(headers, [&](StringView directive, Optional<StringView> argument) {
+        if (!seconds.has_value() && directive.equals_ignoring_ascii_case(name) && argument.has_value())
+            seconds = argument->to_number<i64>();
+    });
+    return seconds;
+}
+
+// https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+static bool may_use_heuristic_freshness(u32 status_code, HTTP::HeaderMap const& response_headers)
+{
+    // The public directive makes a response cacheable whatever its status code.
+    return is_heuristically_cacheable(status_code) || has_cache_control_directive(response_headers, "public"sv);
+}
+
+// https://httpwg.org/specs/rfc9110.html#http.date
+static Optional<UnixDateTime> parse_http_date(StringView date)
+{
+    // FIXME: Also accept the obsolete RFC 850 and asctime() formats.
+    // HTTP dates are always in GMT. Matching that literally means we don't need time zone data to parse them, but
+    // DateTime then treats the time as local, so take its parts instead of its timestamp.
+    auto date_time = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S GMT"sv, date);
+    if (!date_time.has_value())
+        return {};
+    return UnixDateTime::from_unix_time_parts(date_time->year(), date_time->month(), date_time->day(), date_time->hour(), date_time->minute(), date_time->second(), 0);
+}
+
+static Optional<UnixDateTime> date_header(HTTP::HeaderMap const& headers, ByteString const& name)
+{
+    auto value = headers.get(name);
+    if (!value.has_value())
+        return {};
+    return parse_http_date(*value);
+}
+
+ErrorOr<NonnullOwnPtr<CacheEntry>> CacheEntry::open(StringView path, URL::URL const& url)
+{
+    auto file = TRY(Core::MappedFile::map(path));
+
+    if (TRY(file->read_value<LittleEndian<u32>>()) != cache_file_magic)
+        return Error::from_string_literal("Not a disk cache file");
+    if (TRY(file->read_value<LittleEndian<u32>>()) != cache_file_version)
+        return Error::from_string_literal("Unsupported disk cache file version");
+
+    auto read_string = [&]() -> ErrorOr<StringView> {
+        auto length = TRY(file->read_value<LittleEndian<u32>>());
+        return StringView { TRY(file->read_in_place<u8 const>(length)) };
+    };
+
+    u32 status_code = TRY(file->read_value<LittleEndian<u32>>());
+    auto request_time = UnixDateTime::from_seconds_since_epoch(TRY(file->read_value<LittleEndian<i64>>()));
+    auto response_time = UnixDateTime::from_seconds_since_epoch(TRY(file->read_value<LittleEndian<i64>>()));
+
+    // Different URLs may hash to the same file name.
+    if (TRY(read_string()) != url.serialize())
+        return Error::from_string_literal("Disk cache file belongs to another URL");
+
+    HTTP::HeaderMap headers;
+    auto header_count = TRY(file->read_value<LittleEndian<u32>>());
+    for (u32 i = 0; i < header_count; ++i) {
+        auto name = TRY(read_string());
+        auto value = TRY(read_string());
+        headers.set(name, value);
+    }
+
+    auto body_size = TRY(file->read_value<LittleEndian<u64>>());
+    auto body = TRY(file->read_in_place<u8 const>(body_size));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) CacheEntry(move(file), status_code, move(headers), body, request_time, response_time));
+}
+
+CacheEntry::CacheEntry(NonnullOwnPtr<Core::MappedFile> file, u32 status_code, HTTP::HeaderMap headers, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time)
+    : m_file(move(file))
+    , m_status_code(status_code)
+    , m_headers(move(headers))
+    , m_body(body)
+    , m_request_time(request_time)
+    , m_response_time(response_time)
+{
+}
+
+bool CacheEntry::is_fresh(UnixDateTime now) const
+{
+    return DiskCache::is_fresh(m_status_code, m_headers, m_request_time, m_response_time, now);
+}
+
+// https://httpwg.org/specs/rfc9111.html#validation.sent
+bool CacheEntry::has_validators() const
+{
+    return m_headers.contains("ETag") || m_headers.contains("Last-Modified");
+}
+
+void CacheEntry::add_validators(HTTP::HeaderMap& request_headers) const
+{
+    if (auto etag = m_headers.get("ETag"); etag.has_value())
+        request_headers.set("If-None-Match", etag.release_value());
+    if (auto last_modified = m_headers.get("Last-Modified"); last_modified.has_value())
+        request_headers.set("If-Modified-Since", last_modified.release_value());
+}
+
+ErrorOr<void> DiskCache::enable(ByteString directory, u64 maximum_size)
+{
+    VERIFY(!s_disk_cache);
+
+    (void)TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes, 0700));
+
+    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(move(directory), maximum_size)));
+    TRY(disk_cache->load_index());
+
+    s_disk_cache = move(disk_cache);
+    return {};
+}
+
+DiskCache* DiskCache::the()
+{
+    return s_disk_cache.ptr();
+}
+
+DiskCache::DiskCache(ByteString directory, u64 maximum_size)
+    : m_directory(move(directory))
+    , m_maximum_size(maximum_size)
+{
+}
+
+// https://httpwg.org/specs/rfc9111.html#constructing.responses.from.caches
+bool DiskCache::can_use_cache_for(StringView method, HTTP::HeaderMap const& request_headers)
+{
+    if (!method.equals_ignoring_ascii_case("GET"sv))
+        return false;
+
+    // Only whole responses are stored, so ranges and the client's own conditional requests go straight to the server.
+    for (auto const* name : { "Range", "If-Match", "If-None-Match", "If-Modified-Since", "If-Unmodified-Since", "If-Range" }) {
+        if (request_headers.contains(name))
+            return false;
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#caching.authenticated.responses
+    if (request_headers.contains("Authorization"))
+        return false;
+
+    return !has_cache_control_directive(request_headers, "no-store"sv);
+}
+
+bool DiskCache::request_requires_revalidation(HTTP::HeaderMap const& request_headers)
+{
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive.no-cache
+    if (has_cache_control_directive(request_headers, "no-cache"sv))
+        return true;
+
+    // https://httpwg.org/specs/rfc9111.html#cache-request-directive.max-age
+    if (cache_control_delta_seconds(request_headers, "max-age"sv) == 0)
+        return true;
+
+    // https://httpwg.org/specs/rfc9111.html#field.pragma
+    if (!request_headers.contains("Cache-Control"))
+        return request_headers.get("Pragma").map([](auto const& value) { return value.equals_ignoring_ascii_case("no-cache"sv); }).value_or(false);
+
+    return false;
+}
+
+// https://httpwg.org/specs/rfc9111.html#response.cacheability
+bool DiskCache::is_storable(u32 status_code, HTTP::HeaderMap const& response_headers)
+{
+    // Partial and Not Modified responses only update other responses, which this cache doesn't combine them with.
+    if (status_code < 200 || status_code == 206 || status_code == 304)
+        return false;
+
+    if (has_cache_control_directive(response_headers, "no-store"sv))
+        return false;
+
+    // https://httpwg.org/specs/rfc9111.html#cache-response-directive.private
+    // This cache is shared by all clients, so it mustn't keep responses that are meant for a single user.
+    if (has_cache_control_directive(response_headers, "private"sv))
+        return false;
+
+    // Responses are stored by their URL alone, so they can't vary on request headers. The exception is
+    // Accept-Encoding, as the stored body is what was written to the client, after content decoding.
+    if (auto vary = response_headers.get("Vary"); vary.has_value()) {
+        for (auto field_name : vary->split_view(',')) {
+            if (!field_name.trim_whitespace().equals_ignoring_ascii_case("Accept-Encoding"sv))
+                return false;
+        }
+    }
+
+    bool has_explicit_lifetime = cache_control_delta_seconds(response_headers, "s-maxage"sv).has_value()
+        || cache_control_delta_seconds(response_headers, "max-age"sv).has_value()
+        || response_headers.contains("Expires");
+    if (!has_explicit_lifetime && !may_use_heuristic_freshness(status_code, response_headers))
+        return false;
+
+    // A response that can neither be fresh nor be validated is of no use later.
+    return has_explicit_lifetime || response_headers.contains("ETag") || response_headers.contains("Last-Modified");
+}
+
+// https://httpwg.org/specs/rfc9111.html#expiration.model
+bool DiskCache::is_fresh(u32 status_code, HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now)
+{
+    return freshness_lifetime(status_code, response_headers, response_time) > current_age(response_headers, request_time, response_time, now);
+}
+
+// https://httpwg.org/specs/rfc9111.html#calculating.freshness.lifetime
+i64 DiskCache::freshness_lifetime(u32 status_code, HTTP::HeaderMap const& response_headers, UnixDateTime response_time)
+{
+    // A response with the no-cache directive has to be validated every time it's used.
+    if (has_cache_control_directive(response_headers, "no-cache"sv))
+        return 0;
+
+    // This cache is shared by all clients, so s-maxage overrides max-age.
+    if (auto s_maxage = cache_control_delta_seconds(response_headers, "s-maxage"sv); s_maxage.has_value())
+        return *s_maxage;
+    if (auto max_age = cache_control_delta_seconds(response_headers, "max-age"sv); max_age.has_value())
+        return *max_age;
+
+    auto date = date_header(response_headers, "Date").value_or(response_time);
+
+    if (auto expires = response_headers.get("Expires"); expires.has_value()) {
+        // Invalid dates, like "0", represent a time in the past.
+        auto expiration_date = parse_http_date(*expires);
+        if (!expiration_date.has_value())
+            return 0;
+        return (*expiration_date - date).to_seconds();
+    }
+
+    // https://httpwg.org/specs/rfc9111.html#heuristic.freshness
+    if (may_use_heuristic_freshness(status_code, response_headers)) {
+        if (auto last_modified = date_header(response_headers, "Last-Modified"); last_modified.has_value())
+            return clamp((date - *last_modified).to_seconds() / 10, 0, maximum_heuristic_freshness_lifetime);
+    }
+
+    return 0;
+}
+
+// https://httpwg.org/specs/rfc9111.html#age.calculations
+i64 DiskCache::current_age(HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now)
+{
+    i64 age_value = 0;
+    if (auto age = response_headers.get("Age"); age.has_value())
+        age_value = age->to_number<i64>().value_or(0);
+
+    auto date_value = date_header(response_headers, "Date").value_or(response_time);
+
+    auto apparent_age = max<i64>(0, (response_time - date_value).to_seconds());
+    auto response_delay = (response_time - request_time).to_seconds();
+    auto corrected_age_value = age_value + response_delay;
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+
+    auto resident_time = (now - response_time).to_seconds();
+    return corrected_initial_age + resident_time;
+}
+
+// https://httpwg.org/specs/rfc9111.html#update
+HTTP::HeaderMap DiskCache::freshened_headers(HTTP::HeaderMap const& stored_headers, HTTP::HeaderMap const& not_modified_headers)
+{
+    HTTP::HeaderMap headers;
+    for (auto const& header : stored_headers.headers()) {
+        if (is_exempted_for_updating(header.name) || !not_modified_headers.contains(header.name))
+            headers.set(header.name, header.value);
+    }
+    for (auto const& header : not_modified_headers.headers()) {
+        if (!is_exempted_for_updating(header.name))
+            headers.set(header.name, header.value);
+    }
+    return headers;
+}
+
+ErrorOr<void> DiskCache::load_index()
+{
+    struct CacheFile {
+        ByteString name;
+        u64 size { 0 };
+        time_t modification_time { 0 };
+    };
+    Vector<CacheFile> files;
+
+    TRY(Core::Directory::for_each_entry(m_directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const& directory) -> ErrorOr<IterationDecision> {
+        if (entry.type != Core::DirectoryEntry::Type::File)
+            return IterationDecision::Continue;
+
+        // This was left behind by a write that didn't finish.
+        if (entry.name.ends_with(temporary_file_extension)) {
+            (void)Core::System::unlink(path_for(entry.name));
+            return IterationDecision::Continue;
+        }
+
+        auto stat = directory.stat(entry.name, 0);
+        if (stat.is_error())
+            return IterationDecision::Continue;
+
+        files.append({ entry.name, static_cast<u64>(stat.value().st_size), stat.value().st_mtime });
+        return IterationDecision::Continue;
+    }));
+
+    // Files are touched whenever they are used, so their modification times give the order in which they were last used.
+    quick_sort(files, [](auto const& a, auto const& b) { return a.modification_time < b.modification_time; });
+
+    Threading::MutexLocker locker(m_mutex);
+    for (auto& file : files) {
+        m_size += file.size;
+        m_entry_sizes.set(move(file.name), file.size);
+    }
+    evict_least_recently_used_entries();
+
+    return {};
+}
+
+ByteString DiskCache::file_name_for(URL::URL const& url) const
+{
+    auto digest = Crypto::Hash::SHA1::hash(url.serialize());
+    return encode_hex(digest.bytes());
+}
+
+ByteString DiskCache::path_for(StringView file_name) const
+{
+    return ByteString::formatted("{}/{}", m_directory, file_name);
+}
+
+OwnPtr<CacheEntry> DiskCache::open_entry(URL::URL const& url)
+{
+    auto file_name = file_name_for(url);
+    auto path = path_for(file_name);
+
+    auto entry = CacheEntry::open(path, url);
+    if (entry.is_error()) {
+        if (!entry.error().is_errno() || entry.error().code() != ENOENT)
+            dbgln("DiskCache: Failed to open the entry for {}: {}", url, entry.error());
+        return {};
+    }
+
+    // Touching the file keeps its modification time at its last use, which is what the index is ordered by.
+    (void)Core::System::utime(path, {});
+    did_use_entry(file_name, entry.value()->file_size());
+
+    return entry.release_value();
+}
+
+static Atomic<u32> s_next_temporary_file_id;
+
+static ErrorOr<void> write_entry(StringView path, URL::URL const& url, u32 status_code, HTTP::HeaderMap const& headers, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time)
+{
+    AllocatingMemoryStream metadata;
+
+    auto write_string = [&](StringView string) -> ErrorOr<void> {
+        TRY(metadata.write_value<LittleEndian<u32>>(string.length()));
+        TRY(metadata.write_until_depleted(string.bytes()));
+        return {};
+    };
+
+    TRY(metadata.write_value<LittleEndian<u32>>(cache_file_magic));
+    TRY(metadata.write_value<LittleEndian<u32>>(cache_file_version));
+    TRY(metadata.write_value<LittleEndian<u32>>(status_code));
+    TRY(metadata.write_value<LittleEndian<i64>>(request_time.seconds_since_epoch()));
+    TRY(metadata.write_value<LittleEndian<i64>>(response_time.seconds_since_epoch()));
+    TRY(write_string(url.serialize()));
+
+    Vector<HTTP::Header const&> stored_headers;
+    for (auto const& header : headers.headers()) {
+        if (!is_exempted_for_storage(header.name))
+            stored_headers.append(header);
+    }
+    TRY(metadata.write_value<LittleEndian<u32>>(stored_headers.size()));
+    for (auto const& header : stored_headers) {
+        TRY(write_string(header.name));
+        TRY(write_string(header.value));
+    }
+
+    TRY(metadata.write_value<LittleEndian<u64>>(body.size()));
+
+    // Entries are written to a temporary file that replaces the old one at once, so no reader ever sees half an entry.
+    // Readers that still have the old file mapped keep reading the old response.
+    auto temporary_path = ByteString::formatted("{}.{}.{}{}", path, getpid(), s_next_temporary_file_id++, temporary_file_extension);
+    auto result = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate, 0600));
+        TRY(file->write_until_depleted(TRY(metadata.read_until_eof())));
+        TRY(file->write_until_depleted(body));
+        file->close();
+        TRY(Core::System::rename(temporary_path, path));
+        return {};
+    }();
+
+    if (result.is_error())
+        (void)Core::System::unlink(temporary_path);
+    return result;
+}
+
+void DiskCache::store(URL::URL const& url, u32 status_code, HTTP::HeaderMap const& headers, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time)
+{
+    if (body.size() > maximum_entry_size())
+        return;
+
+    auto file_name = file_name_for(url);
+    auto path = path_for(file_name);
+
+    if (auto result = write_entry(path, url, status_code, headers, body, request_time, response_time); result.is_error()) {
+        dbgln("DiskCache: Failed to store the response for {}: {}", url, result.error());
+        return;
+    }
+
+    auto stat = Core::System::stat(path);
+    if (stat.is_error())
+        return;
+    did_use_entry(file_name, stat.value().st_size);
+}
+
+// https://httpwg.org/specs/rfc9111.html#freshening.responses
+HTTP::HeaderMap DiskCache::freshen(URL::URL const& url, CacheEntry const& entry, HTTP::HeaderMap const& not_modified_headers, UnixDateTime request_time, UnixDateTime response_time)
+{
+    auto headers = freshened_headers(entry.headers(), not_modified_headers);
+    store(url, entry.status_code(), headers, entry.body(), request_time, response_time);
+    return headers;
+}
+
+// https://httpwg.org/specs/rfc9111.html#invalidation
+void DiskCache::remove(URL::URL const& url)
+{
+    auto file_name = file_name_for(url);
+    if (auto result = Core::System::unlink(path_for(file_name)); result.is_error() && result.error().code() != ENOENT)
+        dbgln("DiskCache: Failed to remove the entry for {}: {}", url, result.error());
+
+    Threading::MutexLocker locker(m_mutex);
+    if (auto size = m_entry_sizes.take(file_name); size.has_value())
+        m_size -= *size;
+}
+
+void DiskCache::did_use_entry(ByteString const& file_name, u64 size)
+{
+    Threading::MutexLocker locker(m_mutex);
+
+    // Re-inserting the entry moves it to the back of the queue.
+    if (auto old_size = m_entry_sizes.take(file_name); old_size.has_value())
+        m_size -= *old_size;
+    m_entry_sizes.set(file_name, size);
+    m_size += size;
+
+    evict_least_recently_used_entries();
+}
+
+// m_mutex has to be locked when calling this.
+void DiskCache::evict_least_recently_used_entries()
+{
+    while (m_size > m_maximum_size && !m_entry_sizes.is_empty()) {
+        auto it = m_entry_sizes.begin();
+        auto path = path_for(it->key);
+        m_size -= it->value;
+        m_entry_sizes.remove(it);
+
+        // Requests that are still sending the entry keep it mapped, so its data stays around until they're done.
+        if (auto result = Core::System::unlink(path); result.is_error() && result.error().code() != ENOENT)
+            dbgln("DiskCache: Failed to evict {}: {}", path, result.error());
+    }
+}
+
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/Time.h>
+#include <LibCore/MappedFile.h>
+#include <LibHTTP/HeaderMap.h>
+#include <LibThreading/Mutex.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+// A response read back from the disk cache. Its body stays mapped into memory for as long as the entry is alive.
+class CacheEntry {
+    AK_MAKE_NONCOPYABLE(CacheEntry);
+    AK_MAKE_NONMOVABLE(CacheEntry);
+
+public:
+    static ErrorOr<NonnullOwnPtr<CacheEntry>> open(StringView path, URL::URL const&);
+
+    u32 status_code() const { return m_status_code; }
+    HTTP::HeaderMap const& headers() const { return m_headers; }
+    ReadonlyBytes body() const { return m_body; }
+    UnixDateTime request_time() const { return m_request_time; }
+    UnixDateTime response_time() const { return m_response_time; }
+    u64 file_size() const { return m_file->bytes().size(); }
+
+    bool is_fresh(UnixDateTime now) const;
+    bool has_validators() const;
+    void add_validators(HTTP::HeaderMap& request_headers) const;
+
+private:
+    CacheEntry(NonnullOwnPtr<Core::MappedFile>, u32 status_code, HTTP::HeaderMap, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time);
+
+    NonnullOwnPtr<Core::MappedFile> m_file;
+    u32 m_status_code { 0 };
+    HTTP::HeaderMap m_headers;
+    ReadonlyBytes m_body;
+    UnixDateTime m_request_time;
+    UnixDateTime m_response_time;
+};
+
+// A persistent HTTP cache (RFC 9111) for responses to GET requests, shared by all clients of this RequestServer.
+// Every response lives in its own file, named after a hash of its URL. When the files grow past the size budget,
+// the least recently used ones are deleted.
+class DiskCache {
+    AK_MAKE_NONCOPYABLE(DiskCache);
+    AK_MAKE_NONMOVABLE(DiskCache);
+
+public:
+    static constexpr u64 default_maximum_size = 256 * MiB;
+
+    static ErrorOr<void> enable(ByteString directory, u64 maximum_size = default_maximum_size);
+
+    // Returns null unless the cache was enabled.
+    static DiskCache* the();
+
+    static bool can_use_cache_for(StringView method, HTTP::HeaderMap const& request_headers);
+    static bool request_requires_revalidation(HTTP::HeaderMap const& request_headers);
+    static bool is_storable(u32 status_code, HTTP::HeaderMap const& response_headers);
+
+    // These work on the parts of a stored response, so they can be used without an entry on disk. Ages and lifetimes are in seconds.
+    static bool is_fresh(u32 status_code, HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now);
+    static i64 freshness_lifetime(u32 status_code, HTTP::HeaderMap const& response_headers, UnixDateTime response_time);
+    static i64 current_age(HTTP::HeaderMap const& response_headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now);
+    static HTTP::HeaderMap freshened_headers(HTTP::HeaderMap const& stored_headers, HTTP::HeaderMap const& not_modified_headers);
+
+    u64 maximum_entry_size() const { return m_maximum_size / 8; }
+
+    OwnPtr<CacheEntry> open_entry(URL::URL const&);
+    void store(URL::URL const&, u32 status_code, HTTP::HeaderMap const&, ReadonlyBytes body, UnixDateTime request_time, UnixDateTime response_time);
+
+    // Updates a stored response with the headers of a 304 (Not Modified) response, and returns its new headers.
+    HTTP::HeaderMap freshen(URL::URL const&, CacheEntry const&, HTTP::HeaderMap const& not_modified_headers, UnixDateTime request_time, UnixDateTime response_time);
+
+    void remove(URL::URL const&);
+
+private:
+    DiskCache(ByteString directory, u64 maximum_size);
+
+    ErrorOr<void> load_index();
+    ByteString file_name_for(URL::URL const&) const;
+    ByteString path_for(StringView file_name) const;
+
+    void did_use_entry(ByteString const& file_name, u64 size);
+    void evict_least_recently_used_entries();
+
+    ByteString m_directory;
+    u64 m_maximum_size { 0 };
+
+    Threading::Mutex m_mutex;
+    u64 m_size { 0 };
+    OrderedHashMap<ByteString, u64> m_entry_sizes; // Least recently used first.
+};
+
+}
@@ -8,7 +8,10 @@
 
 namespace RequestServer {
 
+class CacheEntry;
+class CachedRequest;
 class ConnectionFromClient;
+class DiskCache;
 class Request;
 class GeminiProtocol;
 class HttpRequest;
@@ -14,8 +14,10 @@
 #include <AK/OwnPtr.h>
 #include <AK/Types.h>
 #include <LibHTTP/HttpRequest.h>
+#include <RequestServer/CachedRequest.h>
 #include <RequestServer/ConnectionCache.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Request.h>
 
 namespace RequestServer::Detail {
@@ -24,15 +26,28 @@ template<typename TSelf, typename TJob>
 void init(TSelf* self, TJob job)
 {
     job->on_headers_received = [self](auto& headers, auto response_code) {
+        if (response_code == 304u && self->did_revalidate_cache_entry(headers))
+            return;
         if (response_code.has_value())
             self->set_status_code(response_code.value());
         self->set_response_headers(headers);
     };
 
+    job->on_body_data_written = [self](ReadonlyBytes data) {
+        self->did_write_body_data(data);
+    };
+
     job->on_finish = [self](bool success) {
         Core::deferred_invoke([url = self->job().url(), socket = self->job().socket()] {
             ConnectionCache::request_did_finish(url, socket);
         });
+
+        // The server told us that our cached response is still good, so that's what the client gets.
+        if (self->is_serving_cache_entry()) {
+            self->send_cache_entry_body();
+            return;
+        }
+
         if (auto* response = self->job().response()) {
             self->set_status_code(response->code());
             self->set_response_headers(response->headers());
@@ -44,6 +59,8 @@ void init(TSelf* self, TJob job)
         if (!self->total_size().has_value())
             self->did_progress(self->downloaded_size(), self->downloaded_size());
 
+        if (success)
+            self->store_response_in_disk_cache();
         self->did_finish(success);
     };
     job->on_progress = [self](Optional<u64> total, u64 current) {
@@ -90,7 +107,32 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, Connec
     else
         request.set_method(HTTP::HttpRequest::Method::GET);
     request.set_url(url);
-    request.set_headers(headers);
+
+    auto* disk_cache = DiskCache::the();
+    bool use_disk_cache = disk_cache && DiskCache::can_use_cache_for(method, headers);
+    OwnPtr<CacheEntry> cache_entry;
+    if (use_disk_cache) {
+        cache_entry = disk_cache->open_entry(url);
+        if (cache_entry && cache_entry->is_fresh(UnixDateTime::now()) && !DiskCache::request_requires_revalidation(headers)) {
+            auto output_stream = MUST(Core::File::adopt_fd(pipe_result.value().write_fd, Core::File::OpenMode::Write));
+            auto cached_request = CachedRequest::create(client, url, cache_entry.release_nonnull(), move(output_stream), request_id);
+            cached_request->set_request_fd(pipe_result.value().read_fd);
+            return cached_request;
+        }
+        if (cache_entry && !cache_entry->has_validators())
+            cache_entry = nullptr;
+    } else if (disk_cache && request.method() != HTTP::HttpRequest::Method::GET && request.method() != HTTP::HttpRequest::Method::HEAD) {
+        // A request with an unsafe method may change the resource, so the stored response can't be trusted anymore.
+        disk_cache->remove(url);
+    }
+
+    if (cache_entry) {
+        auto conditional_headers = headers;
+        cache_entry->add_validators(conditional_headers);
+        request.set_headers(conditional_headers);
+    } else {
+        request.set_headers(headers);
+    }
 
     auto allocated_body_result = ByteBuffer::copy(body);
     if (allocated_body_result.is_error())
@@ -101,6 +143,8 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, Connec
     auto job = TJob::construct(move(request), *output_stream);
     auto protocol_request = TRequest::create_with_job(forward<TBadgedProtocol>(protocol), client, (TJob&)*job, move(output_stream), request_id);
     protocol_request->set_request_fd(pipe_result.value().read_fd);
+    if (use_disk_cache)
+        protocol_request->use_disk_cache(move(cache_entry));
 
     Core::deferred_invoke([=] {
         if constexpr (IsSame<typename TBadgedProtocol::Type, HttpsProtocol>)
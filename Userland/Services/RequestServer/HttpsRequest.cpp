@@ -27,6 +27,7 @@ HttpsRequest::~HttpsRequest()
 {
     m_job->on_finish = nullptr;
     m_job->on_progress = nullptr;
+    m_job->on_body_data_written = nullptr;
     m_job->cancel();
 }
 
@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/File.h>
+#include <LibCore/Notifier.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/DiskCache.h>
 #include <RequestServer/Request.h>
 
 namespace RequestServer {
@@ -16,6 +19,15 @@ Request::Request(ConnectionFromClient& client, NonnullOwnPtr<Core::File>&& outpu
 {
 }
 
+Request::~Request()
+{
+    // The notifier may still be registered with the event loop, make sure it doesn't call back into us.
+    if (m_cache_entry_body_notifier) {
+        m_cache_entry_body_notifier->on_activation = nullptr;
+        m_cache_entry_body_notifier->set_enabled(false);
+    }
+}
+
 void Request::stop()
 {
     m_client.did_finish_request({}, *this, false);
@@ -24,6 +36,20 @@ void Request::stop()
 void Request::set_response_headers(HTTP::HeaderMap response_headers)
 {
     m_response_headers = move(response_headers);
+
+    if (m_disk_cache_state == DiskCacheState::AwaitingResponse) {
+        m_response_time = UnixDateTime::now();
+        if (m_status_code.has_value() && DiskCache::is_storable(*m_status_code, m_response_headers)) {
+            m_disk_cache_state = DiskCacheState::StoringResponse;
+        } else {
+            m_disk_cache_state = DiskCacheState::NotStoringResponse;
+            // The server replaced the entry we asked it to revalidate with something we may not store.
+            if (m_cache_entry)
+                DiskCache::the()->remove(url());
+        }
+        m_cache_entry = nullptr;
+    }
+
     m_client.did_receive_headers({}, *this);
 }
 
@@ -48,4 +74,104 @@ void Request::did_request_certificates()
     m_client.did_request_certificates({}, *this);
 }
 
+void Request::use_disk_cache(OwnPtr<CacheEntry> entry_to_revalidate)
+{
+    VERIFY(DiskCache::the());
+    m_cache_entry = move(entry_to_revalidate);
+    m_disk_cache_state = DiskCacheState::AwaitingResponse;
+    m_request_time = UnixDateTime::now();
+}
+
+bool Request::did_revalidate_cache_entry(HTTP::HeaderMap const& not_modified_headers)
+{
+    if (m_disk_cache_state != DiskCacheState::AwaitingResponse || !m_cache_entry)
+        return false;
+
+    m_response_time = UnixDateTime::now();
+    auto headers = DiskCache::the()->freshen(url(), *m_cache_entry, not_modified_headers, m_request_time, m_response_time);
+
+    m_disk_cache_state = DiskCacheState::ServingEntry;
+    set_status_code(m_cache_entry->status_code());
+    set_response_headers(move(headers));
+    return true;
+}
+
+void Request::did_write_body_data(ReadonlyBytes data)
+{
+    if (m_disk_cache_state != DiskCacheState::StoringResponse)
+        return;
+
+    if (m_body_to_store.size() + data.size() > DiskCache::the()->maximum_entry_size() || m_body_to_store.try_append(data).is_error()) {
+        m_disk_cache_state = DiskCacheState::NotStoringResponse;
+        m_body_to_store.clear();
+    }
+}
+
+void Request::store_response_in_disk_cache()
+{
+    if (m_disk_cache_state != DiskCacheState::StoringResponse)
+        return;
+
+    DiskCache::the()->store(url(), m_status_code.value(), m_response_headers, m_body_to_store, m_request_time, m_response_time);
+    m_disk_cache_state = DiskCacheState::NotStoringResponse;
+    m_body_to_store.clear();
+}
+
+void Request::serve_cache_entry(NonnullOwnPtr<CacheEntry> entry)
+{
+    m_cache_entry = move(entry);
+    m_disk_cache_state = DiskCacheState::ServingEntry;
+    set_status_code(m_cache_entry->status_code());
+    set_response_headers(m_cache_entry->headers());
+    send_cache_entry_body();
+}
+
+void Request::send_cache_entry_body()
+{
+    VERIFY(is_serving_cache_entry());
+    m_cache_entry_body_to_send = m_cache_entry->body();
+    continue_sending_cache_entry_body();
+}
+
+void Request::continue_sending_cache_entry_body()
+{
+    while (!m_cache_entry_body_to_send.is_empty()) {
+        auto result = m_output_stream->write_some(m_cache_entry_body_to_send);
+        if (result.is_error()) {
+            if (result.error().is_errno() && result.error().code() == EAGAIN) {
+                // The pipe to the client is full, carry on once it has read some of it.
+                if (!m_cache_entry_body_notifier) {
+                    m_cache_entry_body_notifier = Core::Notifier::construct(m_output_stream->fd(), Core::Notifier::Type::Write);
+                    m_cache_entry_body_notifier->on_activation = [weak_this = make_weak_ptr()] {
+                        if (weak_this)
+                            weak_this->continue_sending_cache_entry_body();
+                    };
+                }
+                m_cache_entry_body_notifier->set_enabled(true);
+                return;
+            }
+
+            dbgln("Request::continue_sending_cache_entry_body: Failed to write to the client: {}", result.error());
+            did_send_cache_entry_body(false);
+            return;
+        }
+        m_cache_entry_body_to_send = m_cache_entry_body_to_send.slice(result.value());
+    }
+
+    did_send_cache_entry_body(true);
+}
+
+void Request::did_send_cache_entry_body(bool success)
+{
+    if (m_cache_entry_body_notifier)
+        m_cache_entry_body_notifier->set_enabled(false);
+
+    auto sent_size = m_cache_entry->body().size() - m_cache_entry_body_to_send.size();
+    set_downloaded_size(sent_size);
+    did_progress(sent_size, sent_size);
+
+    // NOTE: This destroys the request.
+    did_finish(success);
+}
+
 }
@@ -10,14 +10,18 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefCounted.h>
+#include <AK/Time.h>
+#include <AK/Weakable.h>
+#include <LibCore/Forward.h>
+#include <LibHTTP/HeaderMap.h>
 #include <LibURL/URL.h>
 #include <RequestServer/Forward.h>
 
 namespace RequestServer {
 
-class Request {
+class Request : public Weakable<Request> {
 public:
-    virtual ~Request() = default;
+    virtual ~Request();
 
     i32 id() const { return m_id; }
     virtual URL::URL url() const = 0;
@@ -42,10 +46,33 @@ public:
     void set_downloaded_size(size_t size) { m_downloaded_size = size; }
     Core::File const& output_stream() const { return *m_output_stream; }
 
+    // Stores the response in the disk cache if it's storable. If the request carries the validators of a stale
+    // cache entry, a 304 (Not Modified) response gets the client that entry instead.
+    void use_disk_cache(OwnPtr<CacheEntry> entry_to_revalidate);
+    bool did_revalidate_cache_entry(HTTP::HeaderMap const& not_modified_headers);
+    void did_write_body_data(ReadonlyBytes);
+    void store_response_in_disk_cache();
+
+    bool is_serving_cache_entry() const { return m_disk_cache_state == DiskCacheState::ServingEntry; }
+    void send_cache_entry_body();
+
 protected:
     explicit Request(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&, i32 request_id);
 
+    void serve_cache_entry(NonnullOwnPtr<CacheEntry>);
+
 private:
+    enum class DiskCacheState {
+        Unused,
+        AwaitingResponse,
+        StoringResponse,
+        NotStoringResponse,
+        ServingEntry,
+    };
+
+    void continue_sending_cache_entry_body();
+    void did_send_cache_entry_body(bool success);
+
     ConnectionFromClient& m_client;
     i32 m_id { 0 };
     int m_request_fd { -1 }; // Passed to client.
@@ -54,6 +81,14 @@ private:
     size_t m_downloaded_size { 0 };
     NonnullOwnPtr<Core::File> m_output_stream;
     HTTP::HeaderMap m_response_headers;
+
+    DiskCacheState m_disk_cache_state { DiskCacheState::Unused };
+    OwnPtr<CacheEntry> m_cache_entry;
+    UnixDateTime m_request_time;
+    UnixDateTime m_response_time;
+    ByteBuffer m_body_to_store;
+    ReadonlyBytes m_cache_entry_body_to_send;
+    RefPtr<Core::Notifier> m_cache_entry_body_notifier;
 };
 
 }
@@ -13,6 +13,8 @@ namespace SQLServer {
 static HashMap<SQL::ConnectionID, NonnullRefPtr<DatabaseConnection>> s_connections;
 static SQL::ConnectionID s_next_connection_id = 0;
 
+static constexpr size_t group_commit_size = 64;
+
 static ErrorOr<NonnullRefPtr<SQL::Database>> find_or_create_database(StringView database_path, StringView database_name)
 {
     for (auto const& connection : s_connections) {
@@ -43,6 +45,11 @@ ErrorOr<NonnullRefPtr<DatabaseConnection>> DatabaseConnection::create(StringView
             warnln("Could not open database: {}", result.error().error_string());
             return Error::from_string_view("Could not open database"sv);
         }
+
+        // Statements that are executed back to back are written back and synced together, and clients only hear
+        // back about them once that is done, see SQLStatement::execute().
+        database->set_group_commit_size(group_commit_size);
+        database->set_sync_policy(SQL::Heap::SyncPolicy::OnWriteBack);
     }
 
     return adopt_nonnull_ref_or_enomem(new (nothrow) DatabaseConnection(move(database), move(database_name), client_id));
@@ -71,42 +71,62 @@ Optional<SQL::ExecutionID> SQLStatement::execute(Vector<SQL::Value> placeholder_
     auto execution_id = m_next_execution_id++;
 
     Core::deferred_invoke([this, strong_this = NonnullRefPtr(*this), placeholder_values = move(placeholder_values), execution_id] {
-        auto execution_result = m_statement->execute(connection().database(), placeholder_values);
+        auto database = connection().database();
+        auto execution_result = m_statement->execute(database, placeholder_values);
 
         if (execution_result.is_error()) {
             report_error(execution_result.release_error(), execution_id);
             return;
         }
 
-        auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
-        if (!client_connection) {
-            warnln("Cannot return statement execution results. Client disconnected");
-            return;
+        // Write back the changes of this and any other statements executed in the meantime once we run out of queued work.
+        if (database->has_pending_commits()) {
+            Core::deferred_invoke([database] {
+                if (auto result = database->flush(); result.is_error())
+                    warnln("Could not write back database changes: {}", result.error());
+            });
         }
 
-        auto result = execution_result.release_value();
-        auto result_size = result.size();
-
-        if (should_send_result_rows(result)) {
-            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
-
-            m_ongoing_executions.set(execution_id, { move(result), result_size });
-            ready_for_next_result(execution_id);
-        } else {
-            if (result.command() == SQL::SQLCommand::Insert)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
-            else if (result.command() == SQL::SQLCommand::Update)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
-            else if (result.command() == SQL::SQLCommand::Delete)
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
-            else
-                client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
-        }
+        // Only tell the client about the statement once its changes have actually made it to the disk.
+        database->when_written_back([this, strong_this = NonnullRefPtr(*this), result = execution_result.release_value(), execution_id](ErrorOr<void> write_back_result) mutable {
+            if (write_back_result.is_error()) {
+                report_error(SQL::Result { result.command(), SQL::SQLErrorCode::InternalError, ByteString::formatted("{}", write_back_result.error()) }, execution_id);
+                return;
+            }
+            send_execution_result(execution_id, move(result));
+        });
     });
 
     return execution_id;
 }
 
+void SQLStatement::send_execution_result(SQL::ExecutionID execution_id, SQL::ResultSet result)
+{
+    auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
+    if (!client_connection) {
+        warnln("Cannot return statement execution results. Client disconnected");
+        return;
+    }
+
+    auto result_size = result.size();
+
+    if (should_send_result_rows(result)) {
+        client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), true, 0, 0, 0);
+
+        m_ongoing_executions.set(execution_id, { move(result), result_size });
+        ready_for_next_result(execution_id);
+    } else {
+        if (result.command() == SQL::SQLCommand::Insert)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, result_size, 0, 0);
+        else if (result.command() == SQL::SQLCommand::Update)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, result_size, 0);
+        else if (result.command() == SQL::SQLCommand::Delete)
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, result_size);
+        else
+            client_connection->async_execution_success(statement_id(), execution_id, result.column_names(), false, 0, 0, 0);
+    }
+}
+
 void SQLStatement::ready_for_next_result(SQL::ExecutionID execution_id)
 {
     auto client_connection = ConnectionFromClient::client_connection_for(connection().client_id());
@@ -137,6 +157,7 @@ bool SQLStatement::should_send_result_rows(SQL::ResultSet const& result) const
 
     switch (result.command()) {
     case SQL::SQLCommand::Describe:
+    case SQL::SQLCommand::Explain:
     case SQL::SQLCommand::Select:
         return true;
     default:
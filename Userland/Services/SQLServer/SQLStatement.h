@@ -33,6 +33,7 @@ private:
 
     bool should_send_result_rows(SQL::ResultSet const& result) const;
     void report_error(SQL::Result, SQL::ExecutionID execution_id);
+    void send_execution_result(SQL::ExecutionID, SQL::ResultSet);
 
     DatabaseConnection& m_connection;
     SQL::StatementID m_statement_id { 0 };
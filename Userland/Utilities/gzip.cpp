@@ -20,11 +20,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     bool keep_input_files { false };
     bool write_to_stdout { false };
     bool decompress { false };
+    Optional<size_t> thread_count;
 
     Core::ArgsParser args_parser;
     args_parser.add_option(keep_input_files, "Keep (don't delete) input files", "keep", 'k');
     args_parser.add_option(write_to_stdout, "Write to stdout, keep original files unchanged", "stdout", 'c');
     args_parser.add_option(decompress, "Decompress", "decompress", 'd');
+    args_parser.add_option(thread_count, "Compress using this many threads", "threads", 'p', "count");
     args_parser.add_positional_argument(filenames, "Files", "FILES", Core::ArgsParser::Required::No);
     args_parser.parse(arguments);
 
@@ -71,17 +73,21 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
         // Buffer reads, which yields a significant performance improvement.
         NonnullOwnPtr<Stream> input_stream = TRY(Core::InputBufferedFile::create(move(input_file), 1 * MiB));
 
-        if (decompress) {
-            input_stream = TRY(try_make<Compress::GzipDecompressor>(move(input_stream)));
+        if (!decompress && thread_count.has_value()) {
+            TRY(Compress::GzipCompressor::compress_in_parallel(*input_stream, *output_stream, thread_count.value()));
         } else {
-            output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull()));
-        }
+            if (decompress) {
+                input_stream = TRY(try_make<Compress::GzipDecompressor>(move(input_stream)));
+            } else {
+                output_stream = TRY(try_make<Compress::GzipCompressor>(output_stream.release_nonnull()));
+            }
 
-        auto buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
+            auto buffer = TRY(ByteBuffer::create_uninitialized(1 * MiB));
 
-        while (!input_stream->is_eof()) {
-            auto span = TRY(input_stream->read_some(buffer));
-            TRY(output_stream->write_until_depleted(span));
+            while (!input_stream->is_eof()) {
+                auto span = TRY(input_stream->read_some(buffer));
+                TRY(output_stream->write_until_depleted(span));
+            }
         }
 
         if (!keep_input_files)
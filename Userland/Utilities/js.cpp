@@ -14,10 +14,12 @@
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Console.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Parser.h>
 #include <LibJS/Print.h>
 #include <LibJS/Runtime/ConsoleObject.h>
@@ -58,6 +60,7 @@ private:
     JS_DECLARE_NATIVE_FUNCTION(load_json);
     JS_DECLARE_NATIVE_FUNCTION(last_value_getter);
     JS_DECLARE_NATIVE_FUNCTION(print);
+    JS_DECLARE_NATIVE_FUNCTION(dump_inline_cache_statistics);
 };
 
 class ScriptObject final : public JS::GlobalObject {
@@ -332,6 +335,7 @@ void ReplObject::initialize(JS::Realm& realm)
     define_native_function(realm, "loadINI", load_ini, 1, attr);
     define_native_function(realm, "loadJSON", load_json, 1, attr);
     define_native_function(realm, "print", print, 1, attr);
+    define_native_function(realm, "dumpInlineCacheStatistics", dump_inline_cache_statistics, 0, attr);
 
     define_native_accessor(
         realm,
@@ -377,6 +381,7 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::exit_interpreter)
 JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
 {
     warnln("REPL commands:");
+    warnln("    dumpInlineCacheStatistics(): print hit/miss counts of every property lookup cache to stderr.");
     warnln("    exit(code): exit the REPL with specified code. Defaults to 0.");
     warnln("    help(): display this menu");
     warnln("    loadINI(file): load the given file as INI.");
@@ -386,6 +391,12 @@ JS_DEFINE_NATIVE_FUNCTION(ReplObject::repl_help)
     return JS::js_undefined();
 }
 
+JS_DEFINE_NATIVE_FUNCTION(ReplObject::dump_inline_cache_statistics)
+{
+    JS::Bytecode::Executable::dump_property_lookup_cache_statistics_for_all_executables();
+    return JS::js_undefined();
+}
+
 JS_DEFINE_NATIVE_FUNCTION(ReplObject::load_ini)
 {
     return load_ini_impl(vm);
@@ -535,9 +546,12 @@ private:
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
-    TRY(Core::System::pledge("stdio rpath wpath cpath fattr tty sigaction map_fixed"));
+    TRY(Core::System::pledge("stdio rpath wpath cpath fattr tty sigaction map_fixed prot_exec"));
 
     bool gc_on_every_allocation = false;
+    bool dump_gc_pause_histograms = false;
+    bool dump_inline_cache_statistics = false;
+    bool use_jit = false;
     bool disable_syntax_highlight = false;
     bool disable_debug_printing = false;
     bool use_test262_global = false;
@@ -553,6 +567,9 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(dump_gc_pause_histograms, "Dump GC pause histograms on exit", "dump-gc-pause-histograms", {});
+    args_parser.add_option(dump_inline_cache_statistics, "Dump inline cache statistics on exit", "dump-inline-cache-statistics", {});
+    args_parser.add_option(use_jit, "Compile hot functions to native code", "jit", {});
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
@@ -562,6 +579,13 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
     bool syntax_highlight = !disable_syntax_highlight;
 
+    if (use_jit)
+        JS::JIT::Compiler::set_enabled(true);
+
+    // Only the JIT needs to map executable memory, so drop prot_exec unless it's in use (via --jit or LIBJS_JIT).
+    if (!JS::JIT::Compiler::is_enabled())
+        TRY(Core::System::pledge("stdio rpath wpath cpath fattr tty sigaction map_fixed"));
+
     AK::set_debug_enabled(!disable_debug_printing);
     s_history_path = TRY(String::formatted("{}/.js-history", Core::StandardPaths::home_directory()));
 
@@ -865,5 +889,10 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
             return 1;
     }
 
+    if (dump_gc_pause_histograms)
+        g_vm->heap().dump_pause_histograms();
+    if (dump_inline_cache_statistics)
+        JS::Bytecode::Executable::dump_property_lookup_cache_statistics_for_all_executables();
+
     return s_exit_code;
 }
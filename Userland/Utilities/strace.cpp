@@ -221,6 +221,8 @@ HANDLE(PR_SET_PROCESS_NAME)
 HANDLE(PR_GET_PROCESS_NAME)
 HANDLE(PR_SET_THREAD_NAME)
 HANDLE(PR_GET_THREAD_NAME)
+HANDLE(PR_SET_THREAD_PREFERRED_CPU)
+HANDLE(PR_GET_THREAD_PREFERRED_CPU)
 END_VALUES_TO_NAMES()
 
 static int g_pid = -1;